@@ -41,6 +41,10 @@ macro(global_set_flags)
         add_definitions(-DEASYLOGGINGPP_ASYNC)
     endif()
 
+    if (LRS_MIN_LOG_LEVEL)
+        add_definitions(-DLRS_MIN_LOG_LEVEL=${LRS_MIN_LOG_LEVEL})
+    endif()
+
     if(TRACE_API)
         add_definitions(-DTRACE_API)
     endif()
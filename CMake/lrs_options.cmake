@@ -6,6 +6,7 @@ option(BUILD_WITH_OPENMP "Use OpenMP" OFF)
 option(ENABLE_ZERO_COPY "Enable zero copy functionality" OFF)
 option(BUILD_WITH_TM2 "Build with support for Intel TM2 tracking device" ON)
 option(BUILD_EASYLOGGINGPP "Build EasyLogging++ as a part of the build" ON)
+set(LRS_MIN_LOG_LEVEL 0 CACHE STRING "Remove the log statements below this severity at compile time: 0 debug, 1 info, 2 warning, 3 error")
 option(BUILD_WITH_STATIC_CRT "Build with static link CRT" ON)
 option(HWM_OVER_XU "Send HWM commands over UVC XU control" ON)
 option(COM_MULTITHREADED "Set OFF to initialize COM library with COINIT_APARTMENTTHREADED (Windows only)" ON)
@@ -88,6 +88,17 @@ rs2_metadata_type rs2_get_frame_metadata(const rs2_frame* frame, rs2_frame_metad
 */
 int rs2_supports_frame_metadata(const rs2_frame* frame, rs2_frame_metadata_value frame_metadata, rs2_error** error);
 
+/**
+* retrieve all the metadata attributes of the frame at once, parsing the frame metadata only once
+* \param[in] frame         handle returned from a callback
+* \param[out] values       array indexed by rs2_frame_metadata_value, receives the values of the supported attributes
+* \param[out] supported    array indexed by rs2_frame_metadata_value, receives 1 for the supported attributes and 0 for the others
+* \param[in] count         number of elements of values and supported, at most RS2_FRAME_METADATA_COUNT
+* \param[out] error        if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return                  the number of supported attributes
+*/
+int rs2_get_frame_metadata_all(const rs2_frame* frame, rs2_metadata_type* values, int* supported, int count, rs2_error** error);
+
 /**
 * retrieve timestamp domain from frame handle. timestamps can only be comparable if they are in common domain
 * (for example, depth timestamp might come from system time while color timestamp might come from the device)
@@ -339,6 +350,19 @@ void rs2_synthetic_frame_ready(rs2_source* source, rs2_frame* frame, rs2_error**
 */
 void rs2_pose_frame_get_pose_data(const rs2_frame* frame, rs2_pose* pose, rs2_error** error);
 
+/**
+* Provide the memory of the frames produced by a sensor or a processing block from a user allocator, for example pinned or huge-page memory.
+* The allocator is used for video, depth, disparity and points frames; buffers must be aligned to the requested alignment (64 bytes).
+* A buffer is handed back to deallocate once the last reference to its frame is released, possibly after the sensor or block was destroyed.
+* When allocate returns null or a misaligned buffer, the frame falls back to the internal buffer pool.
+* \param[in] options     Sensor or processing block to configure
+* \param[in] allocate    Allocation function, called with the buffer size, its required alignment and user; pass null to restore the internal buffer pool
+* \param[in] deallocate  Deallocation function, called with a buffer returned by allocate, its size and user
+* \param[in] user        Auxiliary data passed to the allocation functions
+* \param[out] error      If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_set_frame_allocator(rs2_options* options, rs2_frame_buffer_allocate_ptr allocate, rs2_frame_buffer_deallocate_ptr deallocate, void* user, rs2_error** error);
+
 #ifdef __cplusplus
 }
 #endif
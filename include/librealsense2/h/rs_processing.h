@@ -140,6 +140,39 @@ void rs2_process_frame(rs2_processing_block* block, rs2_frame* frame, rs2_error*
 */
 void rs2_delete_processing_block(rs2_processing_block* block);
 
+/**
+* Creates a pool of worker threads to run processing blocks asynchronously, see rs2_set_processing_block_executor
+* \param[in] threads_count  Number of worker threads, use 1 for a dedicated worker
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return           new processing pool, to be released by rs2_delete_processing_pool
+*/
+rs2_processing_pool* rs2_create_processing_pool(int threads_count, rs2_error** error);
+
+/**
+* Deletes the processing pool. The worker threads stop once no processing block uses them
+* \param[in] pool           Processing pool
+*/
+void rs2_delete_processing_pool(rs2_processing_pool* pool);
+
+/**
+* Process the frames passed to the block on the workers of a processing pool instead of the invoking thread.
+* Frames of the block are processed in order, one at a time, while blocks sharing the pool run concurrently,
+* so a chain of blocks processes consecutive frames in parallel. The output is delivered from the worker threads
+* \param[in] block          Processing block
+* \param[in] pool           Processing pool, or null to restore synchronous processing
+* \param[in] queue_size     Maximal number of frames waiting for the block, older frames are dropped unless they are blocking
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_set_processing_block_executor(rs2_processing_block* block, rs2_processing_pool* pool, int queue_size, rs2_error** error);
+
+/**
+* Check whether the block processes its frames on a processing pool
+* \param[in] block          Processing block
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return           true if the block was assigned a processing pool
+*/
+int rs2_is_processing_block_asynchronous(const rs2_processing_block* block, rs2_error** error);
+
 /**
 * create frame queue. frame queues are the simplest x-platform synchronization primitive provided by librealsense
 * to help developers who are not using async APIs
@@ -9,6 +9,8 @@
 #ifndef LIBREALSENSE_RS2_TYPES_H
 #define LIBREALSENSE_RS2_TYPES_H
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -272,6 +274,7 @@ typedef struct rs2_syncer rs2_syncer;
 typedef struct rs2_device_serializer rs2_device_serializer;
 typedef struct rs2_source rs2_source;
 typedef struct rs2_processing_block rs2_processing_block;
+typedef struct rs2_processing_pool rs2_processing_pool;
 typedef struct rs2_frame_processor_callback rs2_frame_processor_callback;
 typedef struct rs2_playback_status_changed_callback rs2_playback_status_changed_callback;
 typedef struct rs2_update_progress_callback rs2_update_progress_callback;
@@ -295,6 +298,8 @@ typedef void (*rs2_devices_changed_callback_ptr)(rs2_device_list*, rs2_device_li
 typedef void (*rs2_frame_callback_ptr)(rs2_frame*, void*);
 typedef void (*rs2_frame_processor_callback_ptr)(rs2_frame*, rs2_source*, void*);
 typedef void(*rs2_update_progress_callback_ptr)(const float, void*);
+typedef void* (*rs2_frame_buffer_allocate_ptr)(size_t size, size_t alignment, void* user);
+typedef void (*rs2_frame_buffer_deallocate_ptr)(void* buffer, size_t size, void* user);
 
 typedef double      rs2_time_t;     /**< Timestamp format. units are milliseconds */
 typedef long long   rs2_metadata_type; /**< Metadata attribute type is defined as 64 bit signed integer*/
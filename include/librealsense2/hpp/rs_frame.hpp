@@ -507,6 +507,25 @@ namespace rs2
             return r != 0;
         }
 
+        /** retrieve all the frame_metadata attributes supported by the frame, at the cost of a single query
+        * \return            the supported frame_metadata attributes with their values
+        */
+        std::vector<std::pair<rs2_frame_metadata_value, rs2_metadata_type>> get_frame_metadata_all() const
+        {
+            rs2_metadata_type values[RS2_FRAME_METADATA_COUNT];
+            int supported[RS2_FRAME_METADATA_COUNT];
+
+            rs2_error* e = nullptr;
+            rs2_get_frame_metadata_all(frame_ref, values, supported, RS2_FRAME_METADATA_COUNT, &e);
+            error::handle(e);
+
+            std::vector<std::pair<rs2_frame_metadata_value, rs2_metadata_type>> results;
+            for (int i = 0; i < RS2_FRAME_METADATA_COUNT; i++)
+                if (supported[i])
+                    results.emplace_back(static_cast<rs2_frame_metadata_value>(i), values[i]);
+            return results;
+        }
+
         /**
         * retrieve frame number (from frame handle)
         * \return               the frame number of the frame, in milliseconds since the device was started
@@ -227,6 +227,30 @@ namespace rs2
         bool _keep;
     };
 
+    /**
+    * Pool of worker threads running processing blocks asynchronously, see processing_block::set_executor
+    */
+    class processing_pool
+    {
+    public:
+        /**
+        * \param[in] threads_count  number of worker threads, use 1 for a dedicated worker
+        */
+        explicit processing_pool(int threads_count = 1)
+        {
+            rs2_error* e = nullptr;
+            _pool = std::shared_ptr<rs2_processing_pool>(
+                rs2_create_processing_pool(threads_count, &e),
+                rs2_delete_processing_pool);
+            error::handle(e);
+        }
+
+        rs2_processing_pool* get() const { return _pool.get(); }
+
+    private:
+        std::shared_ptr<rs2_processing_pool> _pool;
+    };
+
     /**
     * Define the processing block flow, inherit this class to generate your own processing_block. Please refer to the viewer class in examples.hpp for a detailed usage example.
     */
@@ -327,6 +351,55 @@ namespace rs2
             error::handle(e);
             return result;
         }
+
+        /**
+        * Process the frames on the workers of a processing pool instead of the invoking thread.
+        * Frames of the block keep their order, while blocks sharing the pool run concurrently,
+        * so chained blocks process consecutive frames in parallel. The output is delivered from the pool threads
+        * \param[in] pool          workers to run the block on
+        * \param[in] queue_size    maximal number of frames waiting for the block, older frames are dropped unless they are blocking
+        */
+        void set_executor(const processing_pool& pool, int queue_size = 1) const
+        {
+            rs2_error* e = nullptr;
+            rs2_set_processing_block_executor(_block.get(), pool.get(), queue_size, &e);
+            error::handle(e);
+        }
+
+        /**
+        * Restore processing on the invoking thread, dropping the frames waiting for the processing pool
+        */
+        void set_synchronous() const
+        {
+            rs2_error* e = nullptr;
+            rs2_set_processing_block_executor(_block.get(), nullptr, 1, &e);
+            error::handle(e);
+        }
+
+        /**
+        * Check whether the processing block runs on a processing pool
+        * \return            true if the block was assigned a processing pool
+        */
+        bool is_asynchronous() const
+        {
+            rs2_error* e = nullptr;
+            auto res = rs2_is_processing_block_asynchronous(_block.get(), &e);
+            error::handle(e);
+            return res > 0;
+        }
+
+        /**
+        * Obtain the buffers of the frames produced by the processing block from a user allocator
+        * \param[in] allocate      allocation function, receives the size and the required (64 bytes) alignment; null restores the internal buffer pool
+        * \param[in] deallocate    deallocation function, receives a buffer returned by allocate and its size
+        * \param[in] user          auxiliary data passed to both functions
+        */
+        void set_frame_allocator(rs2_frame_buffer_allocate_ptr allocate, rs2_frame_buffer_deallocate_ptr deallocate, void* user = nullptr) const
+        {
+            rs2_error* e = nullptr;
+            rs2_set_frame_allocator((rs2_options*)_block.get(), allocate, deallocate, user, &e);
+            error::handle(e);
+        }
     protected:
         void register_simple_option(rs2_option option_id, option_range range) {
             rs2_error * e = nullptr;
@@ -353,7 +426,7 @@ namespace rs2
         {
             invoke(frame);
             rs2::frame f;
-            if (!_queue.poll_for_frame(&f))
+            if (!_queue.poll_for_frame(&f) && !(is_asynchronous() && _queue.try_wait_for_frame(&f)))
                 throw std::runtime_error("Error occured during execution of the processing block! See the log for more info");
             return f;
         }
@@ -212,6 +212,19 @@ namespace rs2
             error::handle(e);
         }
 
+        /**
+        * Obtain the buffers of the frames produced by the sensor from a user allocator
+        * \param[in] allocate      allocation function, receives the size and the required (64 bytes) alignment; null restores the internal buffer pool
+        * \param[in] deallocate    deallocation function, receives a buffer returned by allocate and its size
+        * \param[in] user          auxiliary data passed to both functions
+        */
+        void set_frame_allocator(rs2_frame_buffer_allocate_ptr allocate, rs2_frame_buffer_deallocate_ptr deallocate, void* user = nullptr) const
+        {
+            rs2_error* e = nullptr;
+            rs2_set_frame_allocator((rs2_options*)_sensor.get(), allocate, deallocate, user, &e);
+            error::handle(e);
+        }
+
         /**
         * Retrieves the list of stream profiles supported by the sensor.
         * \return   list of stream profiles that given sensor can provide
@@ -106,6 +106,53 @@ const char * rs2_get_full_log_message( rs2_log_message const * msg, rs2_error**
  */
 void rs2_log(rs2_log_severity severity, const char * message, rs2_error ** error);
 
+/**
+* Start or stop recording the latency of the stages every frame goes through inside the library:
+* backend delivery, timestamp reading, allocation, copy, processing blocks (including the syncer), callbacks and queue waits.
+* Every frame is given a span ID, shared by the frames derived from it, to follow it across the stages and threads.
+* Tracing is disabled by default
+* \param[in] enable  non-zero to start recording, zero to stop
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_enable_latency_tracing(int enable, rs2_error** error);
+
+/**
+* Write the recorded stages to a file, in the Chrome trace event JSON format (chrome://tracing, Perfetto).
+* Only the latest events of every thread are kept, the events of the threads that have exited are discarded once written
+* \param[in] file_path  path of the JSON file to write
+* \param[out] error     if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_export_latency_trace(const char* file_path, rs2_error** error);
+
+/**
+* Discard the recorded stages
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_clear_latency_trace(rs2_error** error);
+
+/**
+* Start or stop keeping the log statements of the frame hot path (frame arrival, user callbacks) in memory.
+* They are stored as fixed-size binary records and formatted only when dumped, so recording them costs far less
+* than logging them. Only the latest records of every thread are kept. Recording is disabled by default
+* \param[in] min_severity  the minimum severity of the recorded statements, RS2_LOG_SEVERITY_NONE to stop recording
+* \param[out] error        if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_log_to_flight_recorder(rs2_log_severity min_severity, rs2_error** error);
+
+/**
+* Write the recorded statements to a text file, oldest first, in the same layout as the log file.
+* The statements of the threads that have exited are discarded once written
+* \param[in] file_path  path of the file to write
+* \param[out] error     if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_dump_flight_recorder(const char* file_path, rs2_error** error);
+
+/**
+* Discard the recorded statements
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_clear_flight_recorder(rs2_error** error);
+
 /**
 * Given the 2D depth coordinate (x,y) provide the corresponding depth in metric units
 * \param[in] frame_ref  2D depth pixel coordinates (Left-Upper corner origin)
@@ -50,6 +50,52 @@ namespace rs2
         rs2_enable_rolling_log_file( max_size, &e );
         error::handle( e );
     }
+
+    // Start or stop recording the latency of the stages every frame goes through inside the library
+    inline void enable_latency_tracing(bool enable)
+    {
+        rs2_error* e = nullptr;
+        rs2_enable_latency_tracing(enable ? 1 : 0, &e);
+        error::handle(e);
+    }
+
+    // Write the recorded stages to a file, in the Chrome trace event JSON format
+    inline void export_latency_trace(const char* file_path)
+    {
+        rs2_error* e = nullptr;
+        rs2_export_latency_trace(file_path, &e);
+        error::handle(e);
+    }
+
+    inline void clear_latency_trace()
+    {
+        rs2_error* e = nullptr;
+        rs2_clear_latency_trace(&e);
+        error::handle(e);
+    }
+
+    // Keep the log statements of the frame hot path in memory, formatted only when dumped
+    inline void log_to_flight_recorder(rs2_log_severity min_severity)
+    {
+        rs2_error* e = nullptr;
+        rs2_log_to_flight_recorder(min_severity, &e);
+        error::handle(e);
+    }
+
+    // Write the recorded statements to a text file, oldest first
+    inline void dump_flight_recorder(const char* file_path)
+    {
+        rs2_error* e = nullptr;
+        rs2_dump_flight_recorder(file_path, &e);
+        error::handle(e);
+    }
+
+    inline void clear_flight_recorder()
+    {
+        rs2_error* e = nullptr;
+        rs2_clear_flight_recorder(&e);
+        error::handle(e);
+    }
     
     /*
         Interface to the log message data we expose.
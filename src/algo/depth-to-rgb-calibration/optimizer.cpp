@@ -11,101 +11,13 @@
 #include "k-to-dsm.h"
 #include "debug.h"
 #include "utils.h"
+#include "sobel.h"
 
 using namespace librealsense::algo::depth_to_rgb_calibration;
 
 
 namespace
 {
-    std::vector<double> calc_intensity( std::vector<double> const & image1, std::vector<double> const & image2 )
-    {
-        std::vector<double> res( image1.size(), 0 );
-
-        for( auto i = 0; i < image1.size(); i++ )
-        {
-            res[i] = sqrt( pow( image1[i], 2 ) + pow( image2[i], 2 ) );
-        }
-        return res;
-    }
-
-    template<class T>
-    double dot_product( std::vector<T> const & sub_image, std::vector<double> const & mask )
-    {
-        double res = 0;
-
-        for( auto i = 0; i < sub_image.size(); i++ )
-        {
-            res += sub_image[i] * mask[i];
-        }
-
-        return res;
-    }
-
-    template<class T>
-    std::vector<double> convolution(std::vector<T> const& image,
-        size_t image_width, size_t image_height,
-        size_t mask_width, size_t mask_height,
-        std::function< double(std::vector<T> const& sub_image) > convolution_operation
-        )
-    {
-        std::vector<double> res(image.size(), 0);
-
-        for (auto i = 0; i < image_height - mask_height + 1; i++)
-        {
-            for (size_t j = 0; j < image_width - mask_width + 1; j++)
-            {
-                std::vector<T> sub_image(mask_width * mask_height, 0);
-                auto ind = 0;
-                for (size_t l = 0; l < mask_height; l++)
-                {
-                    for (size_t k = 0; k < mask_width; k++)
-                    {
-                        size_t p = (i + l) * image_width + j + k;
-                        sub_image[ind++] = (image[p]);
-                    }
-
-                }
-                auto mid = (i + mask_height / 2) * image_width + j + mask_width / 2;
-                res[mid] = convolution_operation(sub_image);
-            }
-        }
-        return res;
-    }
-   
-    template<class T>
-    std::vector<double> calc_horizontal_gradient( std::vector<T> const & image, size_t image_width, size_t image_height )
-    {
-        std::vector<double> horizontal_gradients = { -1, -2, -1,
-                                                      0,  0,  0,
-                                                      1,  2,  1 };
-
-        return convolution<T>( image, image_width, image_height, 3, 3, [&]( std::vector<T> const & sub_image )
-            {return dot_product( sub_image, horizontal_gradients ) / (double)8; } );
-    }
-
-    template<class T>
-    std::vector<double> calc_vertical_gradient( std::vector<T> const & image, size_t image_width, size_t image_height )
-    {
-        std::vector<double> vertical_gradients = { -1, 0, 1,
-                                                   -2, 0, 2,
-                                                   -1, 0, 1 };
-
-        return convolution<T>( image, image_width, image_height, 3, 3, [&]( std::vector<T> const & sub_image )
-            {return dot_product( sub_image, vertical_gradients ) / (double)8; } );;
-    }
-
-    template<class T>
-    std::vector<double> calc_edges( std::vector<T> const & image, size_t image_width, size_t image_height )
-    {
-        auto vertical_edge = calc_vertical_gradient( image, image_width, image_height );
-
-        auto horizontal_edge = calc_horizontal_gradient( image, image_width, image_height );
-
-        auto edges = calc_intensity( vertical_edge, horizontal_edge );
-
-        return edges;
-    }
-
     std::pair<int, int> const dir_map[direction::deg_none] =
     {
         { 1, 0},  // dir_0
@@ -473,10 +385,10 @@ void optimizer::set_z_data( std::vector< z_t > && depth_data,
 
     _z.frame = std::move(depth_data);
 
-    auto z_gradient_x = calc_vertical_gradient(_z.frame, depth_intrinsics.width, depth_intrinsics.height);
-    auto z_gradient_y = calc_horizontal_gradient( _z.frame, depth_intrinsics.width, depth_intrinsics.height );
-    auto ir_gradient_x = calc_vertical_gradient( _ir.ir_frame, depth_intrinsics.width, depth_intrinsics.height );
-    auto ir_gradient_y = calc_horizontal_gradient( _ir.ir_frame, depth_intrinsics.width, depth_intrinsics.height );
+    std::vector< double > z_gradient_x, z_gradient_y;
+    calc_gradients( _z.frame, depth_intrinsics.width, depth_intrinsics.height, z_gradient_x, z_gradient_y );
+    std::vector< double > ir_gradient_x, ir_gradient_y;
+    calc_gradients( _ir.ir_frame, depth_intrinsics.width, depth_intrinsics.height, ir_gradient_x, ir_gradient_y );
 
     // set margin of 2 pixels to 0
     zero_margin( z_gradient_x, 2, _z.width, _z.height );
@@ -484,10 +396,12 @@ void optimizer::set_z_data( std::vector< z_t > && depth_data,
     zero_margin( ir_gradient_x, 2, _z.width, _z.height );
     zero_margin( ir_gradient_y, 2, _z.width, _z.height );
 
-    auto ir_edges = calc_intensity( ir_gradient_x, ir_gradient_y );
+    std::vector< double > ir_edges;
+    calc_intensity( ir_gradient_x, ir_gradient_y, ir_edges );
     std::vector< byte > valid_edge_pixels_by_ir;
     {
-        auto z_edges = calc_intensity( z_gradient_x, z_gradient_y );
+        std::vector< double > z_edges;
+        calc_intensity( z_gradient_x, z_gradient_y, z_edges );
         valid_edge_pixels_by_ir.reserve( ir_edges.size() );
         
         for( auto ir = ir_edges.begin(), z = z_edges.begin();
@@ -1012,10 +926,14 @@ void optimizer::set_yuy_data(
     lum_frame = get_luminance_from_yuy2( _yuy.orig_frame );
     prev_lum_frame = get_luminance_from_yuy2( _yuy.prev_frame );
 
-    auto edges = calc_edges( lum_frame, _yuy.width, _yuy.height );
+    std::vector< double > edges;
+    calc_edges( lum_frame, _yuy.width, _yuy.height, edges );
 
+    // Scratch for the edges of the previous images, which are only compared to the current ones
+    std::vector< double > other_edges;
     {
-        auto prev_edges = calc_edges( prev_lum_frame, _yuy.width, _yuy.height );
+        auto & prev_edges = other_edges;
+        calc_edges( prev_lum_frame, _yuy.width, _yuy.height, prev_edges );
 
         _yuy.movement_from_prev_frame
             = is_movement_in_images( { prev_edges, prev_lum_frame },
@@ -1032,7 +950,8 @@ void optimizer::set_yuy_data(
     if( ! _settings.is_manual_trigger && ! _yuy.last_successful_frame.empty() )
     {
         last_successful_lum_frame = get_luminance_from_yuy2( _yuy.last_successful_frame );
-        auto last_successful_edges = calc_edges( last_successful_lum_frame, _yuy.width, _yuy.height );
+        auto & last_successful_edges = other_edges;
+        calc_edges( last_successful_lum_frame, _yuy.width, _yuy.height, last_successful_edges );
 
         _yuy.movement_from_last_success = is_movement_in_images(
             { last_successful_edges, last_successful_lum_frame },
@@ -1046,8 +965,7 @@ void optimizer::set_yuy_data(
         _yuy.movement_from_last_success = true;
 
     _yuy.edges_IDT = blur_edges( edges, _yuy.width, _yuy.height );
-    _yuy.edges_IDTx = calc_vertical_gradient( _yuy.edges_IDT, _yuy.width, _yuy.height );
-    _yuy.edges_IDTy = calc_horizontal_gradient( _yuy.edges_IDT, _yuy.width, _yuy.height );
+    calc_gradients( _yuy.edges_IDT, _yuy.width, _yuy.height, _yuy.edges_IDTx, _yuy.edges_IDTy );
 
     // Get a map for each pixel to its corresponding section
     std::vector< byte > section_map_rgb( _yuy.width * _yuy.height );
@@ -0,0 +1,133 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "sobel.h"
+#include <algorithm>
+#include <cstdint>
+#include <math.h>
+
+using namespace librealsense::algo::depth_to_rgb_calibration;
+
+
+namespace
+{
+    // The zero taps of the masks only add +0 to the sum, so they are skipped without changing the result
+
+    template< class T >
+    inline double vertical_sobel( T const * up, T const * mid, T const * down, size_t x )
+    {
+        return ( 0. - up[x - 1] + up[x + 1]
+                 - 2. * mid[x - 1] + 2. * mid[x + 1]
+                 - down[x - 1] + down[x + 1] ) / 8.;
+    }
+
+    template< class T >
+    inline double horizontal_sobel( T const * up, T const * down, size_t x )
+    {
+        return ( 0. - up[x - 1] - 2. * up[x] - up[x + 1]
+                 + down[x - 1] + 2. * down[x] + down[x + 1] ) / 8.;
+    }
+
+    // Resizes the output to the image and zeroes the pixels that the 3x3 masks do not cover
+    void prepare_output( std::vector< double > & output, size_t size, size_t image_width, size_t image_height )
+    {
+        output.resize( size );
+        if( image_width < 3 || image_height < 3 )
+        {
+            std::fill( output.begin(), output.end(), 0. );
+            return;
+        }
+
+        std::fill( output.begin(), output.begin() + image_width, 0. );
+        std::fill( output.begin() + ( image_height - 1 ) * image_width, output.end(), 0. );
+        for( size_t y = 1; y < image_height - 1; y++ )
+        {
+            output[y * image_width] = 0;
+            output[y * image_width + image_width - 1] = 0;
+        }
+    }
+}
+
+
+namespace librealsense {
+namespace algo {
+namespace depth_to_rgb_calibration {
+
+    template< class T >
+    void calc_gradients( std::vector< T > const & image,
+                         size_t image_width,
+                         size_t image_height,
+                         std::vector< double > & vertical_gradient,
+                         std::vector< double > & horizontal_gradient )
+    {
+        prepare_output( vertical_gradient, image.size(), image_width, image_height );
+        prepare_output( horizontal_gradient, image.size(), image_width, image_height );
+        if( image_width < 3 || image_height < 3 )
+            return;
+
+        const int last_row = static_cast< int >( image_height - 1 );
+#pragma omp parallel for
+        for( int y = 1; y < last_row; y++ )
+        {
+            auto up = image.data() + ( y - 1 ) * image_width;
+            auto mid = up + image_width;
+            auto down = mid + image_width;
+            auto vertical = vertical_gradient.data() + y * image_width;
+            auto horizontal = horizontal_gradient.data() + y * image_width;
+
+            for( size_t x = 1; x < image_width - 1; x++ )
+            {
+                vertical[x] = vertical_sobel( up, mid, down, x );
+                horizontal[x] = horizontal_sobel( up, down, x );
+            }
+        }
+    }
+
+    template< class T >
+    void calc_edges( std::vector< T > const & image,
+                     size_t image_width,
+                     size_t image_height,
+                     std::vector< double > & edges )
+    {
+        prepare_output( edges, image.size(), image_width, image_height );
+        if( image_width < 3 || image_height < 3 )
+            return;
+
+        const int last_row = static_cast< int >( image_height - 1 );
+#pragma omp parallel for
+        for( int y = 1; y < last_row; y++ )
+        {
+            auto up = image.data() + ( y - 1 ) * image_width;
+            auto mid = up + image_width;
+            auto down = mid + image_width;
+            auto out = edges.data() + y * image_width;
+
+            for( size_t x = 1; x < image_width - 1; x++ )
+            {
+                auto vertical = vertical_sobel( up, mid, down, x );
+                auto horizontal = horizontal_sobel( up, down, x );
+                out[x] = sqrt( vertical * vertical + horizontal * horizontal );
+            }
+        }
+    }
+
+    void calc_intensity( std::vector< double > const & image1,
+                         std::vector< double > const & image2,
+                         std::vector< double > & intensity )
+    {
+        intensity.resize( image1.size() );
+        for( size_t i = 0; i < image1.size(); i++ )
+            intensity[i] = sqrt( image1[i] * image1[i] + image2[i] * image2[i] );
+    }
+
+    template void calc_gradients( std::vector< uint8_t > const &, size_t, size_t, std::vector< double > &, std::vector< double > & );
+    template void calc_gradients( std::vector< uint16_t > const &, size_t, size_t, std::vector< double > &, std::vector< double > & );
+    template void calc_gradients( std::vector< double > const &, size_t, size_t, std::vector< double > &, std::vector< double > & );
+
+    template void calc_edges( std::vector< uint8_t > const &, size_t, size_t, std::vector< double > & );
+    template void calc_edges( std::vector< uint16_t > const &, size_t, size_t, std::vector< double > & );
+    template void calc_edges( std::vector< double > const &, size_t, size_t, std::vector< double > & );
+
+}
+}
+}
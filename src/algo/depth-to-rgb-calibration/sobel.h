@@ -0,0 +1,44 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+namespace librealsense {
+namespace algo {
+namespace depth_to_rgb_calibration {
+
+    // The 3x3 Sobel responses of an image, divided by 8:
+    //
+    //      vertical gradient       horizontal gradient
+    //         -1  0  1                -1 -2 -1
+    //         -2  0  2                 0  0  0
+    //         -1  0  1                 1  2  1
+    //
+    // The outputs are resized to the image and their 1-pixel border is zero. They may be reused between calls
+    // to avoid allocations. The taps are accumulated in the order of a row-major 3x3 dot product, so the
+    // results are bit-exact with a plain convolution.
+    template< class T >
+    void calc_gradients( std::vector< T > const & image,
+                         size_t image_width,
+                         size_t image_height,
+                         std::vector< double > & vertical_gradient,
+                         std::vector< double > & horizontal_gradient );
+
+    // The magnitude of the two Sobel gradients, sqrt( v^2 + h^2 ), without storing the gradients
+    template< class T >
+    void calc_edges( std::vector< T > const & image,
+                     size_t image_width,
+                     size_t image_height,
+                     std::vector< double > & edges );
+
+    // The magnitude of two gradient images, sqrt( image1^2 + image2^2 )
+    void calc_intensity( std::vector< double > const & image1,
+                         std::vector< double > const & image2,
+                         std::vector< double > & intensity );
+
+}
+}
+}
@@ -3,9 +3,11 @@
 #include "metadata-parser.h"
 #include "archive.h"
 #include <fstream>
+#include <thread>
 #include "core/processing.h"
 #include "core/video.h"
 #include "frame-archive.h"
+#include "flight-recorder.h"
 
 #define MIN_DISTANCE 1e-6
 
@@ -25,8 +27,7 @@ namespace librealsense
 
     float3* points::get_vertices()
     {
-        get_frame_data(); // call GetData to ensure data is in main memory
-        auto xyz = (float3*)data.data();
+        auto xyz = (float3*)get_frame_data(); // call GetData to ensure data is in main memory
         return xyz;
     }
 
@@ -143,13 +144,12 @@ namespace librealsense
 
     size_t points::get_vertex_count() const
     {
-        return data.size() / (sizeof(float3) + sizeof(int2));
+        return get_frame_data_size() / (sizeof(float3) + sizeof(int2));
     }
 
     float2* points::get_texture_coordinates()
     {
-        get_frame_data(); // call GetData to ensure data is in main memory
-        auto xyz = (float3*)data.data();
+        auto xyz = (float3*)get_frame_data(); // call GetData to ensure data is in main memory
         auto ijs = (float2*)(xyz + get_vertex_count());
         return ijs;
     }
@@ -158,30 +158,31 @@ namespace librealsense
     std::shared_ptr<archive_interface> make_archive(rs2_extension type,
         std::atomic<uint32_t>* in_max_frame_queue_size,
         std::shared_ptr<platform::time_service> ts,
-        std::shared_ptr<metadata_parser_map> parsers)
+        std::shared_ptr<metadata_parser_map> parsers,
+        std::shared_ptr<frame_pool_stats> pool_stats)
     {
         switch (type)
         {
         case RS2_EXTENSION_VIDEO_FRAME:
-            return std::make_shared<frame_archive<video_frame>>(in_max_frame_queue_size, ts, parsers);
+            return std::make_shared<frame_archive<video_frame>>(in_max_frame_queue_size, ts, parsers, pool_stats);
 
         case RS2_EXTENSION_COMPOSITE_FRAME:
-            return std::make_shared<frame_archive<composite_frame>>(in_max_frame_queue_size, ts, parsers);
+            return std::make_shared<frame_archive<composite_frame>>(in_max_frame_queue_size, ts, parsers, pool_stats);
 
         case RS2_EXTENSION_MOTION_FRAME:
-            return std::make_shared<frame_archive<motion_frame>>(in_max_frame_queue_size, ts, parsers);
+            return std::make_shared<frame_archive<motion_frame>>(in_max_frame_queue_size, ts, parsers, pool_stats);
 
         case RS2_EXTENSION_POINTS:
-            return std::make_shared<frame_archive<points>>(in_max_frame_queue_size, ts, parsers);
+            return std::make_shared<frame_archive<points>>(in_max_frame_queue_size, ts, parsers, pool_stats);
 
         case RS2_EXTENSION_DEPTH_FRAME:
-            return std::make_shared<frame_archive<depth_frame>>(in_max_frame_queue_size, ts, parsers);
+            return std::make_shared<frame_archive<depth_frame>>(in_max_frame_queue_size, ts, parsers, pool_stats);
 
         case RS2_EXTENSION_POSE_FRAME:
-            return std::make_shared<frame_archive<pose_frame>>(in_max_frame_queue_size, ts, parsers);
+            return std::make_shared<frame_archive<pose_frame>>(in_max_frame_queue_size, ts, parsers, pool_stats);
 
         case RS2_EXTENSION_DISPARITY_FRAME:
-            return std::make_shared<frame_archive<disparity_frame>>(in_max_frame_queue_size, ts, parsers);
+            return std::make_shared<frame_archive<disparity_frame>>(in_max_frame_queue_size, ts, parsers, pool_stats);
 
         default:
             throw std::runtime_error("Requested frame type is not supported!");
@@ -192,8 +193,12 @@ namespace librealsense
     {
         if (ref_count.fetch_sub(1) == 1)
         {
+            // The content of a frame that was never read is not needed anymore
+            _deferred_producer = nullptr;
+            _data_deferred = false;
             unpublish();
             on_release();
+            _borrowed = false;
             owner->unpublish_frame(this);
         }
     }
@@ -202,6 +207,23 @@ namespace librealsense
     {
         if (!_kept.exchange(true))
         {
+            // A kept frame must not hold the frames its content is produced from
+            if (_data_deferred)
+                produce_deferred_data();
+
+            // A frame that borrows a backend buffer cannot be held indefinitely without
+            // starving the backend, so its content is materialized before releasing the buffer.
+            // The readers switch to the copy before the buffer is returned
+            frame_continuation borrowed;
+            if (_borrowed)
+            {
+                std::lock_guard<std::mutex> lock(_deferred_mutex);
+                auto buffer = static_cast<const byte*>(on_release.get_data());
+                data.assign(buffer, buffer + on_release.get_data_size());
+                borrowed = std::move(on_release);
+                _borrowed = false;
+            }
+            borrowed();
             owner->keep_frame(this);
         }
     }
@@ -213,19 +235,79 @@ namespace librealsense
         return owner->publish_frame(this);
     }
 
+    std::shared_ptr<const frame_metadata_cache> frame::parse_metadata() const
+    {
+        // The frame this thread is parsing the metadata of. Parsers may query other attributes of the frame,
+        // such as ACTUAL_FPS reading ACTUAL_EXPOSURE, which must not wait for the parse they are part of
+        static thread_local const frame* parsing = nullptr;
+
+        auto generation = _metadata_generation.load();
+        auto md = std::atomic_load(&_metadata);
+        if (md && md->generation == generation)
+            return md;
+        if (parsing == this)
+            return nullptr;
+
+        std::lock_guard<std::mutex> lock(_metadata_mutex);
+        generation = _metadata_generation.load();
+        md = std::atomic_load(&_metadata);
+        if (md && md->generation == generation)
+            return md;
+
+        auto parsed = std::make_shared<frame_metadata_cache>();
+        parsed->generation = generation;
+
+        auto outer = parsing;
+        parsing = this;
+        for (auto&& parser : *metadata_parsers)
+        {
+            auto id = parser.first;
+            if (id < 0 || id >= ::RS2_FRAME_METADATA_COUNT)
+                continue;
+
+            // A parser that throws is left to throw again when its attribute is queried alone
+            try
+            {
+                if (!parser.second->supports(*this))
+                {
+                    parsed->known.set(id);
+                    continue;
+                }
+                parsed->supported.set(id);
+                parsed->known.set(id);
+
+                parsed->values[id] = parser.second->get(*this);
+                parsed->valid.set(id);
+            }
+            catch (...) {}
+        }
+        parsing = outer;
+
+        // A change during the parse leaves the cache behind the current generation, to be parsed again
+        std::atomic_store(&_metadata, std::shared_ptr<const frame_metadata_cache>(parsed));
+        return parsed;
+    }
+
     rs2_metadata_type frame::get_frame_metadata(const rs2_frame_metadata_value& frame_metadata) const
     {
         if (!metadata_parsers)
             throw invalid_value_exception(to_string() << "metadata not available for "
                 << get_string(get_stream()->get_stream_type()) << " stream");
 
+        if (frame_metadata >= 0 && frame_metadata < ::RS2_FRAME_METADATA_COUNT)
+        {
+            auto md = parse_metadata();
+            if (md && md->valid.test(frame_metadata))
+                return md->values[frame_metadata];
+        }
+
         auto it = metadata_parsers.get()->find(frame_metadata);
         if (it == metadata_parsers.get()->end())          // Possible user error - md attribute is not supported by this frame type
             throw invalid_value_exception(to_string() << get_string(frame_metadata)
                 << " attribute is not applicable for "
                 << get_string(get_stream()->get_stream_type()) << " stream ");
 
-        // Proceed to parse and extract the required data attribute
+        // Proceed to parse and extract the required data attribute, to report why it is not available
         return it->second->get(*this);
     }
 
@@ -235,6 +317,13 @@ namespace librealsense
         if (!metadata_parsers)
             return false;                         // No parsers are available or no metadata was attached
 
+        if (frame_metadata >= 0 && frame_metadata < ::RS2_FRAME_METADATA_COUNT)
+        {
+            auto md = parse_metadata();
+            if (md && md->known.test(frame_metadata))
+                return md->supported.test(frame_metadata);
+        }
+
         auto it = metadata_parsers.get()->find(frame_metadata);
         if (it == metadata_parsers.get()->end())          // Possible user error - md attribute is not supported by this frame type
             return false;
@@ -242,13 +331,77 @@ namespace librealsense
         return it->second->supports(*this);
     }
 
+    int frame::get_frame_metadata_all(rs2_metadata_type* values, int* supported, int count) const
+    {
+        count = std::min(count, static_cast<int>(::RS2_FRAME_METADATA_COUNT));
+        std::fill(supported, supported + count, 0);
+        if (!metadata_parsers)
+            return 0;
+
+        auto md = parse_metadata();
+        int found = 0;
+        for (int id = 0; id < count; id++)
+        {
+            auto value = static_cast<rs2_frame_metadata_value>(id);
+            if (!(md && md->known.test(id) ? md->supported.test(id) : supports_frame_metadata(value)))
+                continue;
+
+            // The attributes are supported as rs2_supports_frame_metadata reports them, and an attribute
+            // whose value cannot be read fails as rs2_get_frame_metadata does
+            values[id] = md && md->valid.test(id) ? md->values[id] : get_frame_metadata(value);
+            supported[id] = 1;
+            found++;
+        }
+        return found;
+    }
+
     int frame::get_frame_data_size() const
     {
+        std::unique_lock<std::mutex> lock(_deferred_mutex, std::defer_lock);
+        if (_borrowed)
+            lock.lock();
+
+        if (on_release.get_data() && on_release.get_data_size())
+            return (int)on_release.get_data_size();
+
         return (int)data.size();
     }
 
+    void frame::defer_data(std::function<void()> producer)
+    {
+        std::lock_guard<std::mutex> lock(_deferred_mutex);
+        _deferred_producer = std::move(producer);
+        _data_deferred = true;
+    }
+
+    void frame::produce_deferred_data() const
+    {
+        std::lock_guard<std::mutex> lock(_deferred_mutex);
+        if (!_data_deferred)
+            return;
+
+        auto producer = std::move(_deferred_producer);
+        _deferred_producer = nullptr;
+        try
+        {
+            producer();
+        }
+        catch (const std::exception& ex)
+        {
+            LOG_ERROR("Failed producing the frame data: " << ex.what());
+        }
+        _data_deferred = false;
+    }
+
     const byte* frame::get_frame_data() const
     {
+        if (_data_deferred)
+            produce_deferred_data();
+
+        std::unique_lock<std::mutex> lock(_deferred_mutex, std::defer_lock);
+        if (_borrowed)
+            lock.lock();
+
         const byte* frame_data = data.data();
 
         if (on_release.get_data())
@@ -282,6 +435,7 @@ namespace librealsense
     void frame::update_frame_callback_start_ts(rs2_time_t ts)
     {
         additional_data.frame_callback_started = ts;
+        invalidate_metadata();
     }
 
     rs2_time_t frame::get_frame_callback_start_time_point() const
@@ -292,7 +446,7 @@ namespace librealsense
     void frame::log_callback_start(rs2_time_t timestamp)
     {
         update_frame_callback_start_ts(timestamp);
-        LOG_DEBUG("CallbackStarted," << std::dec << librealsense::get_string(get_stream()->get_stream_type()) << "," << get_frame_number() << ",DispatchedAt," << std::fixed << timestamp);
+        LOG_RECORD_DEBUG("CallbackStarted,{},{},DispatchedAt,{}", librealsense::get_string(get_stream()->get_stream_type()), get_frame_number(), timestamp);
     }
 
     void frame::log_callback_end(rs2_time_t timestamp) const
@@ -300,8 +454,7 @@ namespace librealsense
         auto callback_warning_duration = 1000.f / (get_stream()->get_framerate() + 1);
         auto callback_duration = timestamp - get_frame_callback_start_time_point();
 
-        LOG_DEBUG("CallbackFinished," << librealsense::get_string(get_stream()->get_stream_type()) << ","
-                    << std::dec << get_frame_number() << ",DispatchedAt," << std::fixed << timestamp);
+        LOG_RECORD_DEBUG("CallbackFinished,{},{},DispatchedAt,{}", librealsense::get_string(get_stream()->get_stream_type()), get_frame_number(), timestamp);
 
         if (callback_duration > callback_warning_duration)
         {
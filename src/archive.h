@@ -7,6 +7,7 @@
 #include "core/streaming.h"
 #include <atomic>
 #include <array>
+#include <bitset>
 #include <math.h>
 
 namespace librealsense
@@ -40,6 +41,7 @@ namespace librealsense
                                                  // if the recorder was configured to realtime mode or not
                                                  // if true, this will force any queue receiving this frame not to drop it
         uint32_t            raw_size = 0;   // The frame transmitted size (payload only)
+        uint64_t            trace_span = 0; // identifies the frame and the frames derived from it in the latency trace
 
         frame_additional_data() {}
 
@@ -69,6 +71,49 @@ namespace librealsense
         }
     };
 
+    // Frame buffer pool counters, shared by all the archives of a frame source
+    struct frame_pool_stats
+    {
+        std::atomic<uint64_t> hits{ 0 };           // allocations served by a recycled buffer
+        std::atomic<uint64_t> misses{ 0 };         // allocations that required a new buffer
+        std::atomic<uint64_t> evictions{ 0 };      // buffers released back to the system
+        std::atomic<int64_t>  resident_bytes{ 0 }; // bytes held by idle buffers waiting for reuse
+    };
+
+    // Alignment of the frame buffers obtained from a user-provided allocator,
+    // wide enough for aligned AVX-512 loads and stores
+    const size_t FRAME_BUFFER_ALIGNMENT = 64;
+
+    class frame_allocator_interface
+    {
+    public:
+        virtual void* allocate(size_t size, size_t alignment) = 0;
+        virtual void deallocate(void* buffer, size_t size) = 0;
+        virtual ~frame_allocator_interface() = default;
+    };
+
+    typedef std::shared_ptr<frame_allocator_interface> frame_allocator_ptr;
+
+    class frame_allocator : public frame_allocator_interface
+    {
+        rs2_frame_buffer_allocate_ptr _allocate;
+        rs2_frame_buffer_deallocate_ptr _deallocate;
+        void* _user;
+    public:
+        frame_allocator(rs2_frame_buffer_allocate_ptr allocate, rs2_frame_buffer_deallocate_ptr deallocate, void* user)
+            : _allocate(allocate), _deallocate(deallocate), _user(user) {}
+
+        void* allocate(size_t size, size_t alignment) override
+        {
+            return _allocate(size, alignment, _user);
+        }
+
+        void deallocate(void* buffer, size_t size) override
+        {
+            _deallocate(buffer, size, _user);
+        }
+    };
+
     class archive_interface : public sensor_part
     {
     public:
@@ -76,6 +121,12 @@ namespace librealsense
 
         virtual frame_interface* alloc_and_track(const size_t size, const frame_additional_data& additional_data, bool requires_memory) = 0;
 
+        // Pre-allocate buffers of the given size so that the first frames of a stream are served from the pool
+        virtual void prewarm(size_t size, size_t count) = 0;
+
+        // Serve the frame buffers from the given allocator instead of the internal pool (nullptr restores the pool)
+        virtual void set_allocator(frame_allocator_ptr allocator) = 0;
+
         virtual std::shared_ptr<metadata_parser_map> get_md_parsers() const = 0;
 
         virtual void flush() = 0;
@@ -86,10 +137,21 @@ namespace librealsense
         virtual ~archive_interface() = default;
     };
 
+    // The metadata attributes of a frame, parsed once and indexed by rs2_frame_metadata_value
+    struct frame_metadata_cache
+    {
+        std::array<rs2_metadata_type, ::RS2_FRAME_METADATA_COUNT> values;
+        std::bitset<::RS2_FRAME_METADATA_COUNT> supported; // the parser reports the attribute as supported
+        std::bitset<::RS2_FRAME_METADATA_COUNT> known;     // the support was determined without errors
+        std::bitset<::RS2_FRAME_METADATA_COUNT> valid;     // values holds the parsed attribute
+        uint32_t generation = 0;                            // the generation of the frame it was parsed from
+    };
+
     std::shared_ptr<archive_interface> make_archive(rs2_extension type,
         std::atomic<uint32_t>* in_max_frame_queue_size,
         std::shared_ptr<platform::time_service> ts,
-        std::shared_ptr<metadata_parser_map> parsers);
+        std::shared_ptr<metadata_parser_map> parsers,
+        std::shared_ptr<frame_pool_stats> pool_stats = nullptr);
 
     // Define a movable but explicitly noncopyable buffer type to hold our frame data
     class LRS_EXTENSION_API frame : public frame_interface
@@ -116,7 +178,11 @@ namespace librealsense
             ref_count = r.ref_count.exchange(0);
             _kept = r._kept.exchange(false);
             on_release = std::move(r.on_release);
+            _borrowed = r._borrowed.exchange(false);
             additional_data = std::move(r.additional_data);
+            invalidate_metadata();
+            _deferred_producer = std::move(r._deferred_producer);
+            _data_deferred = r._data_deferred.exchange(false);
             r.owner.reset();
             if (owner) metadata_parsers = owner->get_md_parsers();
             if (r.metadata_parsers) metadata_parsers = std::move(r.metadata_parsers);
@@ -126,15 +192,27 @@ namespace librealsense
         virtual ~frame() { on_release.reset(); }
         rs2_metadata_type get_frame_metadata(const rs2_frame_metadata_value& frame_metadata) const override;
         bool supports_frame_metadata(const rs2_frame_metadata_value& frame_metadata) const override;
+        int get_frame_metadata_all(rs2_metadata_type* values, int* supported, int count) const override;
         int get_frame_data_size() const override;
         const byte* get_frame_data() const override;
         rs2_time_t get_frame_timestamp() const override;
         rs2_timestamp_domain get_frame_timestamp_domain() const override;
-        void set_timestamp(double new_ts) override { additional_data.timestamp = new_ts; }
+        void set_timestamp(double new_ts) override
+        {
+            additional_data.timestamp = new_ts;
+            invalidate_metadata();
+        }
         unsigned long long get_frame_number() const override;
         void set_timestamp_domain(rs2_timestamp_domain timestamp_domain) override
         {
             additional_data.timestamp_domain = timestamp_domain;
+            invalidate_metadata();
+        }
+        // Replaces the additional data, the metadata parsers read it
+        void set_additional_data(const frame_additional_data& data)
+        {
+            additional_data = data;
+            invalidate_metadata();
         }
 
         rs2_time_t get_frame_system_time() const override;
@@ -144,6 +222,7 @@ namespace librealsense
 
         rs2_time_t get_frame_callback_start_time_point() const override;
         void update_frame_callback_start_ts(rs2_time_t ts) override;
+        uint64_t get_trace_span() const override { return additional_data.trace_span; }
 
         void acquire() override { ref_count.fetch_add(1); }
         void release() override;
@@ -151,8 +230,16 @@ namespace librealsense
 
         frame_interface* publish(std::shared_ptr<archive_interface> new_owner) override;
         void unpublish() override {}
-        void attach_continuation(frame_continuation&& continuation) override { on_release = std::move(continuation); }
-        void disable_continuation() override { on_release.reset(); }
+        void attach_continuation(frame_continuation&& continuation) override
+        {
+            on_release = std::move(continuation);
+            _borrowed = on_release.get_data() && on_release.get_data_size() && !on_release.owns_data();
+        }
+        void disable_continuation() override { on_release.reset(); _borrowed = false; }
+
+        // Defers the production of the frame content to the first read of its data: the producer runs once,
+        // concurrent readers wait for it, and it is dropped without running if the frame is released unread
+        void defer_data(std::function<void()> producer);
 
         archive_interface* get_owner() const override { return owner.get(); }
 
@@ -166,10 +253,35 @@ namespace librealsense
         void mark_fixed() override { _fixed = true; }
         bool is_fixed() const override { return _fixed; }
 
-        void set_blocking(bool state) override { additional_data.is_blocking = state; }
+        void set_blocking(bool state) override
+        {
+            additional_data.is_blocking = state;
+            invalidate_metadata();
+        }
         bool is_blocking() const override { return additional_data.is_blocking; }
 
     private:
+        // Parses all the metadata attributes of the frame on the first query, the next queries read the cache.
+        // Every change of the additional data starts a new generation, since parsers read it, and the next
+        // query parses a new cache. A cache is never modified once published, so readers need no lock.
+        // Returns null to a parser that queries the frame being parsed, which then reads its parsers directly
+        std::shared_ptr<const frame_metadata_cache> parse_metadata() const;
+        void invalidate_metadata() { _metadata_generation.fetch_add(1); }
+
+        std::atomic<uint32_t> _metadata_generation{ 1 };
+        mutable std::mutex _metadata_mutex;                            // serializes the parses
+        mutable std::shared_ptr<const frame_metadata_cache> _metadata; // accessed with atomic_load/atomic_store
+
+        void produce_deferred_data() const;
+
+        mutable std::atomic_bool _data_deferred{ false };
+        mutable std::mutex _deferred_mutex; // also guards the data of a borrowed frame against keep()
+        mutable std::function<void()> _deferred_producer;
+
+        // The data is a backend buffer, which keep() copies and returns. Only then may the data change
+        // while the frame is read, so the readers of other frames take no lock
+        std::atomic_bool _borrowed{ false };
+
         // TODO: check boost::intrusive_ptr or an alternative
         std::atomic<int> ref_count; // the reference count is on how many times this placeholder has been observed (not lifetime, not content)
         std::shared_ptr<archive_interface> owner; // pointer to the owner to be returned to by last observe
@@ -232,6 +344,10 @@ namespace librealsense
         {
             return first()->supports_frame_metadata(frame_metadata);
         }
+        int get_frame_metadata_all(rs2_metadata_type* values, int* supported, int count) const override
+        {
+            return first()->get_frame_metadata_all(values, supported, count);
+        }
         int get_frame_data_size() const override
         {
             return first()->get_frame_data_size();
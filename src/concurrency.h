@@ -8,6 +8,8 @@
 #include <thread>
 #include <atomic>
 #include <functional>
+#include <memory>
+#include <cstdint>
 
 const int QUEUE_MAX_SIZE = 10;
 // Simplest implementation of a blocking concurrent queue for thread messaging
@@ -32,6 +34,13 @@ public:
     {}
 
     void enqueue(T&& item)
+    {
+        enqueue(std::move(item), [](const T&) {});
+    }
+
+    // Calls dropped with the oldest item before dropping it to make room
+    template<class Dropped>
+    void enqueue(T&& item, Dropped dropped)
     {
         std::unique_lock<std::mutex> lock(_mutex);
         if (_accepting)
@@ -39,6 +48,7 @@ public:
             _queue.push_back(std::move(item));
             if (_queue.size() > _cap)
             {
+                dropped(_queue.front());
                 _queue.pop_front();
             }
         }
@@ -46,6 +56,25 @@ public:
         _deq_cv.notify_one();
     }
 
+    // Enqueues the item only if there is room for it, without dropping or waiting
+    bool try_enqueue(T&& item)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (_accepting)
+        {
+            if (_queue.size() >= _cap && !_need_to_flush)
+                return false;
+            _queue.push_back(std::move(item));
+            if (_queue.size() > _cap)
+            {
+                _queue.pop_front();
+            }
+        }
+        lock.unlock();
+        _deq_cv.notify_one();
+        return true;
+    }
+
     void blocking_enqueue(T&& item)
     {
         auto pred = [this]()->bool { return _queue.size() < _cap || _need_to_flush; };
@@ -110,6 +139,13 @@ public:
     }
 
     void clear()
+    {
+        clear([](const T&) {});
+    }
+
+    // Calls dropped with every item before dropping it
+    template<class Dropped>
+    void clear(Dropped dropped)
     {
         std::unique_lock<std::mutex> lock(_mutex);
 
@@ -121,6 +157,7 @@ public:
         {
             auto item = std::move(_queue.front());
             _queue.pop_front();
+            dropped(item);
         }
         _deq_cv.notify_all();
     }
@@ -139,13 +176,292 @@ public:
     }
 };
 
+// Bounded multi-producer / multi-consumer lock-free ring (D. Vyukov's algorithm)
+// Every cell carries a sequence number that tells producers and consumers whether it is
+// free for writing or ready for reading, so push and pop never block and never allocate
+template<class T>
+class lockfree_ring
+{
+    struct cell
+    {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    std::unique_ptr<cell[]> _cells;
+    size_t _mask;
+    std::atomic<size_t> _enqueue_pos;
+    std::atomic<size_t> _dequeue_pos;
+
+public:
+    // Capacity is rounded up to the nearest power of two
+    explicit lockfree_ring(size_t capacity = QUEUE_MAX_SIZE)
+        : _enqueue_pos(0), _dequeue_pos(0)
+    {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        _cells.reset(new cell[size]);
+        _mask = size - 1;
+        for (size_t i = 0; i < size; i++)
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    lockfree_ring(const lockfree_ring&) = delete;
+    lockfree_ring& operator=(const lockfree_ring&) = delete;
+
+    bool try_push(T&& item)
+    {
+        cell* c;
+        auto pos = _enqueue_pos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            c = &_cells[pos & _mask];
+            auto seq = c->sequence.load(std::memory_order_acquire);
+            auto diff = (intptr_t)seq - (intptr_t)pos;
+            if (diff == 0)
+            {
+                if (_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+                return false; // full
+            else
+                pos = _enqueue_pos.load(std::memory_order_relaxed);
+        }
+        c->data = std::move(item);
+        c->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T* item)
+    {
+        cell* c;
+        auto pos = _dequeue_pos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            c = &_cells[pos & _mask];
+            auto seq = c->sequence.load(std::memory_order_acquire);
+            auto diff = (intptr_t)seq - (intptr_t)(pos + 1);
+            if (diff == 0)
+            {
+                if (_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+                return false; // empty
+            else
+                pos = _dequeue_pos.load(std::memory_order_relaxed);
+        }
+        *item = std::move(c->data);
+        c->data = T();
+        c->sequence.store(pos + _mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t capacity() const { return _mask + 1; }
+
+    // Approximate when other threads are pushing or popping concurrently
+    size_t size() const
+    {
+        auto enq = _enqueue_pos.load(std::memory_order_relaxed);
+        auto deq = _dequeue_pos.load(std::memory_order_relaxed);
+        return enq > deq ? enq - deq : 0;
+    }
+};
+
+// Drop-in replacement for single_consumer_queue (same drop-oldest / blocking-enqueue semantics)
+// that does not take a lock to enqueue or dequeue: items are kept in a lockfree_ring, and the mutex
+// is only used to park consumers on an empty queue and blocking producers on a full one.
+// Producers dropping the oldest item pop from the ring as well, hence the multi-consumer ring.
+// peek is not supported, since a producer may drop the peeked item
 template<class T>
+class lockfree_queue
+{
+    // Short waits are spent yielding rather than parking, avoiding the wake-up latency of the condition variables
+    static const int SPIN_COUNT = 64;
+
+    lockfree_ring<T> _ring;
+    unsigned int _cap;
+    std::atomic<bool> _accepting;
+
+    // flush mechanism is required to abort wait on cv
+    // when need to stop
+    std::atomic<bool> _need_to_flush;
+
+    std::mutex _mutex;
+    std::condition_variable _deq_cv; // not empty signal
+    std::condition_variable _enq_cv; // not full signal
+    std::atomic<int> _waiting_consumers;
+    std::atomic<int> _waiting_producers;
+
+    // The fences pair with the ones in wait(): either the waiter sees the change,
+    // or the notifier sees the waiter and wakes it under the mutex
+    void notify(std::atomic<int>& waiting, std::condition_variable& cv)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiting.load(std::memory_order_relaxed))
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            cv.notify_one();
+        }
+    }
+
+    template<class Duration, class Pred>
+    bool wait(std::atomic<int>& waiting, std::condition_variable& cv, Duration timeout, Pred ready)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        ++waiting;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto res = cv.wait_for(lock, timeout, ready);
+        --waiting;
+        return res;
+    }
+
+    template<class Dropped>
+    void drop_oldest(Dropped& dropped)
+    {
+        T item;
+        if (_ring.try_pop(&item))
+            dropped(item);
+    }
+
+public:
+    explicit lockfree_queue(unsigned int cap = QUEUE_MAX_SIZE)
+        : _ring(cap), _cap(cap), _accepting(true), _need_to_flush(false), _waiting_consumers(0), _waiting_producers(0)
+    {}
+
+    void enqueue(T&& item)
+    {
+        enqueue(std::move(item), [](const T&) {});
+    }
+
+    // Calls dropped with the oldest items before dropping them to make room
+    template<class Dropped>
+    void enqueue(T&& item, Dropped dropped)
+    {
+        if (_accepting)
+        {
+            while (!_ring.try_push(std::move(item)))
+                drop_oldest(dropped);
+            // The ring capacity is rounded up to a power of two
+            while (_ring.size() > _cap)
+                drop_oldest(dropped);
+        }
+        notify(_waiting_consumers, _deq_cv);
+    }
+
+    // Enqueues the item only if there is room for it, without dropping or waiting
+    bool try_enqueue(T&& item)
+    {
+        if (_accepting)
+        {
+            if (_need_to_flush)
+            {
+                enqueue(std::move(item));
+                return true;
+            }
+            if (_ring.size() >= _cap || !_ring.try_push(std::move(item)))
+                return false;
+        }
+        notify(_waiting_consumers, _deq_cv);
+        return true;
+    }
+
+    void blocking_enqueue(T&& item)
+    {
+        if (_accepting)
+        {
+            int spins = 0;
+            while (true)
+            {
+                if (_need_to_flush)
+                {
+                    enqueue(std::move(item));
+                    return;
+                }
+                if (_ring.size() < _cap && _ring.try_push(std::move(item)))
+                    break;
+                if (++spins < SPIN_COUNT)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                wait(_waiting_producers, _enq_cv, std::chrono::hours(999999),
+                    [this]() { return _ring.size() < _cap || _need_to_flush; });
+            }
+        }
+        notify(_waiting_consumers, _deq_cv);
+    }
+
+    bool dequeue(T* item, unsigned int timeout_ms)
+    {
+        _accepting = true;
+        auto popped = _ring.try_pop(item);
+        for (int i = 0; !popped && i < SPIN_COUNT; i++)
+        {
+            std::this_thread::yield();
+            popped = _ring.try_pop(item);
+        }
+        if (!popped)
+        {
+            wait(_waiting_consumers, _deq_cv, std::chrono::milliseconds(timeout_ms),
+                [&]() { return (popped = _ring.try_pop(item)) || _need_to_flush; });
+        }
+        if (popped)
+            notify(_waiting_producers, _enq_cv);
+        return popped;
+    }
+
+    bool try_dequeue(T* item)
+    {
+        _accepting = true;
+        if (!_ring.try_pop(item))
+            return false;
+        notify(_waiting_producers, _enq_cv);
+        return true;
+    }
+
+    void clear()
+    {
+        clear([](const T&) {});
+    }
+
+    // Calls dropped with every item before dropping it
+    template<class Dropped>
+    void clear(Dropped dropped)
+    {
+        _accepting = false;
+        _need_to_flush = true;
+
+        T item;
+        while (_ring.try_pop(&item))
+            dropped(item);
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _enq_cv.notify_all();
+        _deq_cv.notify_all();
+    }
+
+    void start()
+    {
+        _need_to_flush = false;
+        _accepting = true;
+    }
+
+    size_t size()
+    {
+        return _ring.size();
+    }
+};
+
+// Queue is either single_consumer_queue or lockfree_queue
+template<class T, template<class> class Queue = single_consumer_queue>
 class single_consumer_frame_queue
 {
-    single_consumer_queue<T> _queue;
+    Queue<T> _queue;
 
 public:
-    single_consumer_frame_queue<T>(unsigned int cap = QUEUE_MAX_SIZE) : _queue(cap) {}
+    single_consumer_frame_queue(unsigned int cap = QUEUE_MAX_SIZE) : _queue(cap) {}
 
     void enqueue(T&& item)
     {
@@ -155,6 +471,22 @@ public:
             _queue.enqueue(std::move(item));
     }
 
+    // Calls dropped with the items dropped to make room, blocking items wait for room instead
+    template<class Dropped>
+    void enqueue(T&& item, Dropped dropped)
+    {
+        if (item.is_blocking())
+            _queue.blocking_enqueue(std::move(item));
+        else
+            _queue.enqueue(std::move(item), dropped);
+    }
+
+    // Enqueues the item only if there is room for it, blocking or not
+    bool try_enqueue(T&& item)
+    {
+        return _queue.try_enqueue(std::move(item));
+    }
+
     bool dequeue(T* item, unsigned int timeout_ms)
     {
         return _queue.dequeue(item, timeout_ms);
@@ -175,6 +507,13 @@ public:
         _queue.clear();
     }
 
+    // Calls dropped with every item before dropping it
+    template<class Dropped>
+    void clear(Dropped dropped)
+    {
+        _queue.clear(dropped);
+    }
+
     void start()
     {
         _queue.start();
@@ -186,13 +525,15 @@ public:
     }
 };
 
-class dispatcher
+// Stop state of a dispatcher, kept out of the queue-specific part
+// so that all the dispatcher flavours share the same cancellable_timer type
+class dispatcher_base
 {
 public:
     class cancellable_timer
     {
     public:
-        cancellable_timer(dispatcher* owner)
+        cancellable_timer(dispatcher_base* owner)
             : _owner(owner)
         {}
 
@@ -206,12 +547,23 @@ public:
         }
 
     private:
-        dispatcher* _owner;
+        dispatcher_base* _owner;
     };
 
-    dispatcher(unsigned int cap)
+protected:
+    dispatcher_base() : _was_stopped(true) {}
+
+    std::atomic<bool> _was_stopped;
+    std::condition_variable _was_stopped_cv;
+    std::mutex _was_stopped_mutex;
+};
+
+template<template<class> class Queue>
+class basic_dispatcher : public dispatcher_base
+{
+public:
+    basic_dispatcher(unsigned int cap)
         : _queue(cap),
-          _was_stopped(true),
           _was_flushed(false),
           _is_alive(true)
     {
@@ -264,7 +616,7 @@ public:
 
         //action
         auto func = std::move(item);
-        invoke([&, func](dispatcher::cancellable_timer c)
+        invoke([&, func](cancellable_timer c)
         {
             std::lock_guard<std::mutex> lk(_blocking_invoke_mutex);
             func(c);
@@ -310,7 +662,7 @@ public:
         _queue.start();
     }
 
-    ~dispatcher()
+    ~basic_dispatcher()
     {
         stop();
         _queue.clear();
@@ -349,14 +701,9 @@ public:
     }
 
 private:
-    friend cancellable_timer;
-    single_consumer_queue<std::function<void(cancellable_timer)>> _queue;
+    Queue<std::function<void(cancellable_timer)>> _queue;
     std::thread _thread;
 
-    std::atomic<bool> _was_stopped;
-    std::condition_variable _was_stopped_cv;
-    std::mutex _was_stopped_mutex;
-
     std::atomic<bool> _was_flushed;
     std::condition_variable _was_flushed_cv;
     std::mutex _was_flushed_mutex;
@@ -367,6 +714,9 @@ private:
     std::atomic<bool> _is_alive;
 };
 
+typedef basic_dispatcher<single_consumer_queue> dispatcher;
+typedef basic_dispatcher<lockfree_queue> lockfree_dispatcher;
+
 template<class T = std::function<void(dispatcher::cancellable_timer)>>
 class active_object
 {
@@ -84,6 +84,7 @@ namespace librealsense
     public:
         virtual rs2_metadata_type get_frame_metadata(const rs2_frame_metadata_value& frame_metadata) const = 0;
         virtual bool supports_frame_metadata(const rs2_frame_metadata_value& frame_metadata) const = 0;
+        virtual int get_frame_metadata_all(rs2_metadata_type* values, int* supported, int count) const = 0;
         virtual int get_frame_data_size() const = 0;
         virtual const byte* get_frame_data() const = 0;
         virtual rs2_time_t get_frame_timestamp() const = 0;
@@ -98,6 +99,7 @@ namespace librealsense
 
         virtual rs2_time_t get_frame_callback_start_time_point() const = 0;
         virtual void update_frame_callback_start_ts(rs2_time_t ts) = 0;
+        virtual uint64_t get_trace_span() const = 0;
 
         virtual void acquire() = 0;
         virtual void release() = 0;
@@ -0,0 +1,190 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "flight-recorder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+namespace librealsense
+{
+    std::string format_log_message(const char* format, const log_record_arg* args, int count)
+    {
+        std::ostringstream out;
+        out << std::fixed;
+        int next = 0;
+        for (auto p = format; *p; ++p)
+        {
+            if (p[0] == '{' && p[1] == '}' && next < count)
+            {
+                auto&& arg = args[next++];
+                switch (arg.type)
+                {
+                case log_record_arg::signed_integer: out << arg.i; break;
+                case log_record_arg::unsigned_integer: out << arg.u; break;
+                case log_record_arg::real: out << arg.d; break;
+                case log_record_arg::text: out << (arg.s ? arg.s : "(null)"); break;
+                }
+                ++p;
+            }
+            else
+                out << *p;
+        }
+        return out.str();
+    }
+
+    static const char* severity_name(rs2_log_severity severity)
+    {
+        switch (severity)
+        {
+        case RS2_LOG_SEVERITY_DEBUG: return "DEBUG";
+        case RS2_LOG_SEVERITY_INFO: return "INFO";
+        case RS2_LOG_SEVERITY_WARN: return "WARNING";
+        case RS2_LOG_SEVERITY_ERROR: return "ERROR";
+        case RS2_LOG_SEVERITY_FATAL: return "FATAL";
+        default: return "UNKNOWN";
+        }
+    }
+
+    std::string format_log_record(const log_record& r)
+    {
+        // Same layout as the log file lines
+        auto seconds = static_cast<time_t>(r.time / 1000000);
+        tm local = {};
+#ifdef _WIN32
+        localtime_s(&local, &seconds);
+#else
+        localtime_r(&seconds, &local);
+#endif
+        auto file = r.file;
+        for (auto p = r.file; *p; ++p)
+            if (*p == '/' || *p == '\\')
+                file = p + 1;
+
+        std::ostringstream out;
+        out << std::setfill('0')
+            << " " << std::setw(2) << local.tm_mday << "/" << std::setw(2) << local.tm_mon + 1
+            << " " << std::setw(2) << local.tm_hour << ":" << std::setw(2) << local.tm_min << ":" << std::setw(2) << local.tm_sec
+            << "," << std::setw(3) << (r.time / 1000) % 1000
+            << " " << severity_name(r.severity) << " [" << r.thread_id << "] (" << file << ":" << r.line << ") "
+            << format_log_message(r.format, r.args, r.count);
+        return out.str();
+    }
+
+    log_ring::log_ring(uint32_t thread_id, size_t capacity)
+        : _capacity(capacity), _written(0), _thread_id(thread_id)
+    {}
+
+    void log_ring::push(const log_record& r)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_records.size() < _capacity)
+            _records.push_back(r);
+        else
+            _records[_written % _capacity] = r;
+        ++_written;
+    }
+
+    void log_ring::copy_to(std::vector<log_record>& records) const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto count = std::min<uint64_t>(_written, _records.size());
+        for (auto i = _written - count; i < _written; ++i)
+            records.push_back(_records[i % _records.size()]);
+    }
+
+    void log_ring::clear()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _records.clear();
+        _written = 0;
+    }
+
+    std::atomic<int> flight_recorder::_min_severity{ RS2_LOG_SEVERITY_NONE };
+
+    flight_recorder& flight_recorder::instance()
+    {
+        // Never destroyed, as threads may still record while the library is unloaded
+        static auto recorder = new flight_recorder();
+        return *recorder;
+    }
+
+    int64_t flight_recorder::now()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    log_ring& flight_recorder::local_ring()
+    {
+        // Hands the ring over to the recorder when the thread exits
+        struct thread_ring
+        {
+            std::shared_ptr<log_ring> ring;
+            ~thread_ring()
+            {
+                if (ring)
+                    flight_recorder::instance().ring_exited(std::move(ring));
+            }
+        };
+
+        static thread_local thread_ring local;
+        if (!local.ring)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            local.ring = std::make_shared<log_ring>(++_threads, records_per_thread);
+            _rings.push_back(local.ring);
+        }
+        return *local.ring;
+    }
+
+    void flight_recorder::ring_exited(std::shared_ptr<log_ring> ring)
+    {
+        // The last records of the thread are kept until they are dumped, so they are not lost
+        std::lock_guard<std::mutex> lock(_mutex);
+        _rings.erase(std::remove(_rings.begin(), _rings.end(), ring), _rings.end());
+        _exited_rings.push_back(std::move(ring));
+        if (_exited_rings.size() > max_exited_rings)
+            _exited_rings.erase(_exited_rings.begin());
+    }
+
+    void flight_recorder::push(log_record& r)
+    {
+        auto&& ring = local_ring();
+        r.thread_id = ring.thread_id();
+        ring.push(r);
+    }
+
+    std::string flight_recorder::dump()
+    {
+        std::vector<log_record> records;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (auto rings : { &_rings, &_exited_rings })
+                for (auto&& ring : *rings)
+                    ring->copy_to(records);
+            _exited_rings.clear();
+        }
+
+        std::stable_sort(records.begin(), records.end(), [](const log_record& a, const log_record& b)
+        {
+            return a.time < b.time;
+        });
+
+        std::string out;
+        for (auto&& r : records)
+            out += format_log_record(r) + "\n";
+        return out;
+    }
+
+    void flight_recorder::clear()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _exited_rings.clear();
+        for (auto&& ring : _rings)
+            ring->clear();
+    }
+}
@@ -0,0 +1,174 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "types.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace librealsense
+{
+    // An argument of a log record, stored as-is and formatted only when the record is printed
+    struct log_record_arg
+    {
+        enum kind : uint8_t { signed_integer, unsigned_integer, real, text };
+
+        union
+        {
+            int64_t i;
+            uint64_t u;
+            double d;
+            const char* s; // string literal, or a string that lives as long as the library
+        };
+        kind type;
+
+        log_record_arg() : i(0), type(signed_integer) {}
+        log_record_arg(int v) : i(v), type(signed_integer) {}
+        log_record_arg(long v) : i(v), type(signed_integer) {}
+        log_record_arg(long long v) : i(v), type(signed_integer) {}
+        log_record_arg(unsigned v) : u(v), type(unsigned_integer) {}
+        log_record_arg(unsigned long v) : u(v), type(unsigned_integer) {}
+        log_record_arg(unsigned long long v) : u(v), type(unsigned_integer) {}
+        log_record_arg(double v) : d(v), type(real) {}
+        log_record_arg(const char* v) : s(v), type(text) {}
+    };
+
+    // A log statement of the frame hot path. Fixed-sized so that recording never allocates nor formats
+    struct log_record
+    {
+        static const int max_args = 10;
+
+        int64_t time;               // system clock, in microseconds
+        const char* format;         // string literal, where every "{}" is replaced by the next argument
+        const char* file;
+        int line;
+        rs2_log_severity severity;
+        uint32_t thread_id;
+        int count;
+        log_record_arg args[max_args];
+    };
+
+    // Formats the message of a record. Doubles are printed in fixed notation
+    std::string format_log_message(const char* format, const log_record_arg* args, int count);
+
+    // The formatted log line of a record: time, severity, thread, file, line and message
+    std::string format_log_record(const log_record& r);
+
+    // Records written by a single thread. The ring grows with the records up to its capacity,
+    // once full the oldest records are overwritten
+    class log_ring
+    {
+    public:
+        log_ring(uint32_t thread_id, size_t capacity);
+
+        void push(const log_record& r);
+        // Appends the recorded records, oldest first
+        void copy_to(std::vector<log_record>& records) const;
+        void clear();
+
+        uint32_t thread_id() const { return _thread_id; }
+
+    private:
+        mutable std::mutex _mutex; // contended only while the records are dumped
+        std::vector<log_record> _records;
+        const size_t _capacity;
+        uint64_t _written;
+        const uint32_t _thread_id;
+    };
+
+    // Keeps the latest records of the LOG_RECORD statements in memory, as binary records that are formatted
+    // only when dumped, for the statements of the frame hot path that are too frequent to format as they occur.
+    // Disabled by default, at the cost of a relaxed atomic load per statement
+    class flight_recorder
+    {
+    public:
+        static const size_t records_per_thread = 1024;
+
+        static flight_recorder& instance();
+
+        static bool is_enabled(rs2_log_severity severity)
+        {
+            return severity >= _min_severity.load(std::memory_order_relaxed);
+        }
+        // Records the statements from min_severity on, RS2_LOG_SEVERITY_NONE stops recording
+        void enable(rs2_log_severity min_severity) { _min_severity = min_severity; }
+
+        template<class... Args>
+        void record(rs2_log_severity severity, const char* file, int line, const char* format, Args... args)
+        {
+            static_assert(sizeof...(Args) <= log_record::max_args, "Too many arguments for a log record");
+            log_record r{ now(), format, file, line, severity, 0, static_cast<int>(sizeof...(Args)), { log_record_arg(args)... } };
+            push(r);
+        }
+
+        // The formatted records of all the threads, oldest first.
+        // The rings of the threads that have exited are released once dumped
+        std::string dump();
+        void clear();
+
+    private:
+        // Rings of exited threads kept until the next dump, the oldest ones are released first
+        static const size_t max_exited_rings = 16;
+
+        flight_recorder() = default;
+
+        static int64_t now();
+        void push(log_record& r);
+        log_ring& local_ring();
+        void ring_exited(std::shared_ptr<log_ring> ring);
+
+        static std::atomic<int> _min_severity;
+
+        mutable std::mutex _mutex;
+        std::vector<std::shared_ptr<log_ring>> _rings;
+        std::vector<std::shared_ptr<log_ring>> _exited_rings;
+        uint32_t _threads = 0;
+    };
+
+    template<class... Args>
+    std::string format_log_message(const char* format, Args... args)
+    {
+        const log_record_arg list[] = { log_record_arg(args)... };
+        return format_log_message(format, list, static_cast<int>(sizeof...(Args)));
+    }
+
+    inline std::string format_log_message(const char* format)
+    {
+        return format_log_message(format, nullptr, 0);
+    }
+}
+
+// Logs a statement of the frame hot path, given as a format string literal and arguments of fixed size types.
+// The statement goes to the flight recorder as a binary record when it records the severity,
+// and is formatted for the log outputs only when they consume the severity
+#define LOG_RECORD_(severity, log, ...) do { \
+    if (librealsense::flight_recorder::is_enabled(severity)) \
+        librealsense::flight_recorder::instance().record(severity, __FILE__, __LINE__, __VA_ARGS__); \
+    log(librealsense::format_log_message(__VA_ARGS__)); } while(false)
+
+#if LRS_MIN_LOG_LEVEL <= 0
+#define LOG_RECORD_DEBUG(...)   LOG_RECORD_(RS2_LOG_SEVERITY_DEBUG, LOG_DEBUG, __VA_ARGS__)
+#else
+#define LOG_RECORD_DEBUG(...)   do { ; } while(false)
+#endif
+#if LRS_MIN_LOG_LEVEL <= 1
+#define LOG_RECORD_INFO(...)    LOG_RECORD_(RS2_LOG_SEVERITY_INFO, LOG_INFO, __VA_ARGS__)
+#else
+#define LOG_RECORD_INFO(...)    do { ; } while(false)
+#endif
+#if LRS_MIN_LOG_LEVEL <= 2
+#define LOG_RECORD_WARNING(...) LOG_RECORD_(RS2_LOG_SEVERITY_WARN, LOG_WARNING, __VA_ARGS__)
+#else
+#define LOG_RECORD_WARNING(...) do { ; } while(false)
+#endif
+#if LRS_MIN_LOG_LEVEL <= 3
+#define LOG_RECORD_ERROR(...)   LOG_RECORD_(RS2_LOG_SEVERITY_ERROR, LOG_ERROR, __VA_ARGS__)
+#else
+#define LOG_RECORD_ERROR(...)   do { ; } while(false)
+#endif
@@ -3,9 +3,146 @@
 #pragma once
 
 #include "archive.h"
+#include "concurrency.h"
 
 namespace librealsense
 {
+    // Recycles frame buffers without locking. Buffers are kept in a few buckets, one per buffer size,
+    // so finding a buffer for a frame is O(1) and reusing it never resizes (nor zero-fills) it.
+    // Buckets that were not used for over a second are drained to release memory when streams change.
+    // Idleness is measured from the first use of a bucket, so that prewarmed buffers wait for the first frame.
+    class frame_buffer_pool
+    {
+    public:
+        static const size_t MAX_BUCKETS = 8;
+        static const size_t BUCKET_CAPACITY = 16;
+
+        explicit frame_buffer_pool(std::shared_ptr<frame_pool_stats> stats)
+            : _stats(stats ? stats : std::make_shared<frame_pool_stats>())
+        {}
+
+        ~frame_buffer_pool() { clear(); }
+
+        // Returns true when a recycled buffer of exactly the requested size was found
+        bool acquire(size_t size, rs2_time_t now, std::vector<byte>& buffer)
+        {
+            evict_stale(now);
+
+            auto b = find_bucket(size);
+            if (b)
+            {
+                b->last_used = now;
+                std::vector<byte> recycled;
+                while (b->buffers.try_pop(&recycled))
+                {
+                    _stats->resident_bytes -= recycled.size();
+                    // A bucket may have been drained and reassigned while a buffer was returned to it
+                    if (recycled.size() == size)
+                    {
+                        buffer = std::move(recycled);
+                        ++_stats->hits;
+                        return true;
+                    }
+                    ++_stats->evictions;
+                }
+            }
+            ++_stats->misses;
+            return false;
+        }
+
+        void release(std::vector<byte>&& buffer, rs2_time_t now)
+        {
+            auto size = buffer.size();
+            if (!size) return;
+
+            auto b = find_bucket(size);
+            if (!b) b = claim_bucket(size);
+            if (b && b->buffers.try_push(std::move(buffer)))
+            {
+                b->last_used = now;
+                _stats->resident_bytes += size;
+                return;
+            }
+            ++_stats->evictions;
+        }
+
+        void prewarm(size_t size, size_t count, rs2_time_t now)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                std::vector<byte> buffer(size);
+                release(std::move(buffer), now);
+            }
+            // The first frame often arrives over a second after the sensor is opened
+            if (auto b = find_bucket(size))
+                b->last_used = 0;
+        }
+
+        void clear()
+        {
+            for (auto&& b : _buckets)
+                drain(b);
+        }
+
+    private:
+        struct bucket
+        {
+            bucket() : buffers(BUCKET_CAPACITY), size(0), last_used(0) {}
+
+            lockfree_ring<std::vector<byte>> buffers;
+            std::atomic<size_t> size;
+            std::atomic<rs2_time_t> last_used; // 0 until the bucket is used
+        };
+
+        bucket* find_bucket(size_t size)
+        {
+            for (auto&& b : _buckets)
+                if (b.size.load(std::memory_order_acquire) == size)
+                    return &b;
+            return nullptr;
+        }
+
+        bucket* claim_bucket(size_t size)
+        {
+            for (auto&& b : _buckets)
+            {
+                size_t expected = 0;
+                if (b.size.compare_exchange_strong(expected, size))
+                    return &b;
+                if (expected == size)
+                    return &b;
+            }
+            return nullptr;
+        }
+
+        void evict_stale(rs2_time_t now)
+        {
+            for (auto&& b : _buckets)
+            {
+                auto last_used = b.last_used.load(std::memory_order_relaxed);
+                if (b.size.load(std::memory_order_relaxed) && last_used && now > last_used + 1000)
+                {
+                    drain(b);
+                    b.size = 0;
+                }
+            }
+        }
+
+        void drain(bucket& b)
+        {
+            std::vector<byte> buffer;
+            while (b.buffers.try_pop(&buffer))
+            {
+                _stats->resident_bytes -= buffer.size();
+                ++_stats->evictions;
+                buffer = std::vector<byte>();
+            }
+        }
+
+        std::array<bucket, MAX_BUCKETS> _buckets;
+        std::shared_ptr<frame_pool_stats> _stats;
+    };
+
     // Defines general frames storage model
     template<class T>
     class frame_archive : public std::enable_shared_from_this<frame_archive<T>>, public archive_interface
@@ -16,7 +153,8 @@ namespace librealsense
         std::shared_ptr<metadata_parser_map> _metadata_parsers = nullptr;
         callbacks_heap callback_inflight;
 
-        std::vector<T> freelist; // return frames here
+        frame_buffer_pool buffer_pool; // return frame buffers here
+        frame_allocator_ptr _allocator; // when set, frame buffers are obtained from it instead of the pool
         std::atomic<bool> recycle_frames;
         int pending_frames = 0;
         std::recursive_mutex mutex;
@@ -29,37 +167,13 @@ namespace librealsense
         T alloc_frame(const size_t size, const frame_additional_data& additional_data, bool requires_memory)
         {
             T backbuffer;
-            //const size_t size = modes[stream].get_image_size(stream);
-            {
-                std::lock_guard<std::recursive_mutex> guard(mutex);
-
-                if (requires_memory)
-                {
-                    // Attempt to obtain a buffer of the appropriate size from the freelist
-                    for (auto it = begin(freelist); it != end(freelist); ++it)
-                    {
-                        if (it->data.size() == size)
-                        {
-                            backbuffer = std::move(*it);
-                            freelist.erase(it);
-                            break;
-                        }
-                    }
-                }
-
-                // Discard buffers that have been in the freelist for longer than 1s
-                for (auto it = begin(freelist); it != end(freelist);)
-                {
-                    if (additional_data.timestamp > it->additional_data.timestamp + 1000) it = freelist.erase(it);
-                    else ++it;
-                }
-            }
-
             if (requires_memory)
             {
-                backbuffer.data.resize(size, 0); // TODO: Allow users to provide a custom allocator for frame buffers
+                // Attempt to obtain a buffer from the user allocator, and then from the pool
+                if (!allocate_from_user(size, backbuffer) && !buffer_pool.acquire(size, get_time(), backbuffer.data))
+                    backbuffer.data.resize(size, 0);
             }
-            backbuffer.additional_data = additional_data;
+            backbuffer.set_additional_data(additional_data);
             return backbuffer;
         }
 
@@ -75,6 +189,7 @@ namespace librealsense
             }
 
             LOG_DEBUG("publish(...) failed");
+            f.attach_continuation(frame_continuation()); // hand a user-allocated buffer back
             return nullptr;
         }
 
@@ -90,7 +205,7 @@ namespace librealsense
 
                 if (recycle_frames)
                 {
-                    freelist.push_back(std::move(*f));
+                    buffer_pool.release(std::move(f->data), get_time());
                 }
                 lock.unlock();
 
@@ -159,14 +274,44 @@ namespace librealsense
 
         std::shared_ptr<metadata_parser_map> get_md_parsers() const override { return _metadata_parsers; };
 
+        rs2_time_t get_time() const { return _time_service ? _time_service->get_time() : 0; }
+
+        // User-allocated buffers are owned by the frame continuation and bypass the pool.
+        // A failing or misaligned allocation falls back to the internal buffers
+        bool allocate_from_user(const size_t size, T& backbuffer)
+        {
+            auto allocator = std::atomic_load(&_allocator);
+            if (!allocator || !size)
+                return false;
+
+            auto buffer = static_cast<byte*>(allocator->allocate(size, FRAME_BUFFER_ALIGNMENT));
+            if (!buffer)
+            {
+                LOG_WARNING("Frame allocator failed to provide " << size << " bytes");
+                return false;
+            }
+            if (reinterpret_cast<uintptr_t>(buffer) % FRAME_BUFFER_ALIGNMENT)
+            {
+                LOG_WARNING("Frame allocator returned a buffer that is not " << FRAME_BUFFER_ALIGNMENT << "-byte aligned");
+                allocator->deallocate(buffer, size);
+                return false;
+            }
+
+            backbuffer.attach_continuation(frame_continuation([allocator, buffer, size]() {
+                allocator->deallocate(buffer, size);
+            }, buffer, size, true));
+            return true;
+        }
+
         friend class frame;
 
     public:
         explicit frame_archive(std::atomic<uint32_t>* in_max_frame_queue_size,
             std::shared_ptr<platform::time_service> ts,
-            std::shared_ptr<metadata_parser_map> parsers)
+            std::shared_ptr<metadata_parser_map> parsers,
+            std::shared_ptr<frame_pool_stats> pool_stats = nullptr)
             : max_frame_queue_size(in_max_frame_queue_size),
-            recycle_frames(true), mutex(), _time_service(ts),
+            buffer_pool(pool_stats), recycle_frames(true), mutex(), _time_service(ts),
             _metadata_parsers(parsers)
         {
             published_frames_count = 0;
@@ -188,6 +333,19 @@ namespace librealsense
             return track_frame(frame);
         }
 
+        void prewarm(size_t size, size_t count) override
+        {
+            if (!std::atomic_load(&_allocator))
+                buffer_pool.prewarm(size, count, get_time());
+        }
+
+        void set_allocator(frame_allocator_ptr allocator) override
+        {
+            std::atomic_store(&_allocator, allocator);
+            if (allocator)
+                buffer_pool.clear();
+        }
+
         void flush() override
         {
             published_frames.stop_allocation();
@@ -202,10 +360,7 @@ namespace librealsense
             // wait until user is done with all the stuff he chose to borrow
             callback_inflight.wait_until_empty();
 
-            {
-                std::lock_guard<std::recursive_mutex> guard(mutex);
-                freelist.clear();
-            }
+            buffer_pool.clear();
 
             pending_frames = published_frames.get_size();
             if (pending_frames > 0)
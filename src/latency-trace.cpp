@@ -0,0 +1,173 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "latency-trace.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace librealsense
+{
+    trace_ring::trace_ring(uint32_t thread_id, size_t capacity)
+        : _events(capacity), _written(0), _thread_id(thread_id)
+    {}
+
+    void trace_ring::push(const trace_event& e)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _events[_written++ % _events.size()] = e;
+    }
+
+    void trace_ring::copy_to(std::vector<trace_event>& events) const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto count = std::min<uint64_t>(_written, _events.size());
+        for (auto i = _written - count; i < _written; ++i)
+            events.push_back(_events[i % _events.size()]);
+    }
+
+    void trace_ring::clear()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _written = 0;
+    }
+
+    std::atomic<bool> latency_tracer::_enabled{ false };
+
+    latency_tracer& latency_tracer::instance()
+    {
+        // Never destroyed, as threads may still record while the library is unloaded
+        static auto tracer = new latency_tracer();
+        return *tracer;
+    }
+
+    const char* latency_tracer::intern(const std::string& name)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _names.insert(name).first->c_str();
+    }
+
+    trace_ring& latency_tracer::local_ring()
+    {
+        // Hands the ring over to the tracer when the thread exits
+        struct thread_ring
+        {
+            std::shared_ptr<trace_ring> ring;
+            ~thread_ring()
+            {
+                if (ring)
+                    latency_tracer::instance().ring_exited(std::move(ring));
+            }
+        };
+
+        static thread_local thread_ring local;
+        if (!local.ring)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            local.ring = std::make_shared<trace_ring>(++_threads, events_per_thread);
+            _rings.push_back(local.ring);
+        }
+        return *local.ring;
+    }
+
+    void latency_tracer::ring_exited(std::shared_ptr<trace_ring> ring)
+    {
+        // The last events of the thread are kept until they are exported, so they are not lost
+        std::lock_guard<std::mutex> lock(_mutex);
+        _rings.erase(std::remove(_rings.begin(), _rings.end(), ring), _rings.end());
+        _exited_rings.push_back(std::move(ring));
+        if (_exited_rings.size() > max_exited_rings)
+            _exited_rings.erase(_exited_rings.begin());
+    }
+
+    void latency_tracer::record(const char* name, uint64_t span, int64_t start, int64_t end)
+    {
+        local_ring().push({ name, span, start, end - start, 'X' });
+    }
+
+    void latency_tracer::begin_wait(const char* name, uint64_t span)
+    {
+        local_ring().push({ name, span, now(), 0, 'b' });
+    }
+
+    void latency_tracer::end_wait(const char* name, uint64_t span)
+    {
+        local_ring().push({ name, span, now(), 0, 'e' });
+    }
+
+    static void write_json_string(std::ostream& out, const char* str)
+    {
+        out << '"';
+        for (; *str; ++str)
+        {
+            if (*str == '"' || *str == '\\')
+                out << '\\' << *str;
+            else if (static_cast<unsigned char>(*str) < 0x20)
+                out << ' ';
+            else
+                out << *str;
+        }
+        out << '"';
+    }
+
+    std::string latency_tracer::to_json()
+    {
+        struct thread_event
+        {
+            trace_event event;
+            uint32_t thread_id;
+        };
+
+        std::vector<thread_event> events;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            std::vector<trace_event> ring_events;
+            for (auto rings : { &_rings, &_exited_rings })
+            {
+                for (auto&& ring : *rings)
+                {
+                    ring_events.clear();
+                    ring->copy_to(ring_events);
+                    for (auto&& e : ring_events)
+                        events.push_back({ e, ring->thread_id() });
+                }
+            }
+            _exited_rings.clear();
+        }
+
+        std::stable_sort(events.begin(), events.end(), [](const thread_event& a, const thread_event& b)
+        {
+            return a.event.start < b.event.start;
+        });
+        auto origin = events.empty() ? 0 : events.front().event.start;
+
+        // Chrome trace timestamps and durations are in microseconds
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(3);
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        for (size_t i = 0; i < events.size(); ++i)
+        {
+            auto&& e = events[i].event;
+            out << (i ? ",\n" : "\n") << "{\"name\":";
+            write_json_string(out, e.name);
+            out << ",\"cat\":\"librealsense\",\"ph\":\"" << e.phase << "\",\"pid\":1,\"tid\":" << events[i].thread_id
+                << ",\"ts\":" << (e.start - origin) / 1000.;
+            if (e.phase == 'X')
+                out << ",\"dur\":" << e.duration / 1000.;
+            else
+                out << ",\"id\":" << e.span;
+            out << ",\"args\":{\"span\":" << e.span << "}}";
+        }
+        out << "\n]}\n";
+        return out.str();
+    }
+
+    void latency_tracer::clear()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _exited_rings.clear();
+        for (auto&& ring : _rings)
+            ring->clear();
+    }
+}
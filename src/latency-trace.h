@@ -0,0 +1,140 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace librealsense
+{
+    // A stage of the frame pipeline, as recorded by the latency tracer.
+    // Fixed-sized so that recording never allocates
+    struct trace_event
+    {
+        const char* name;       // string literal, or a string interned by the tracer
+        uint64_t span;          // span ID of the frame the stage worked on, 0 when not related to a frame
+        int64_t start;          // steady clock, in nanoseconds
+        int64_t duration;       // in nanoseconds, 0 for asynchronous events
+        char phase;             // Chrome trace event phase: 'X' for a stage, 'b' / 'e' for the begin / end of a wait
+    };
+
+    // Events recorded by a single thread. Once full, the oldest events are overwritten
+    class trace_ring
+    {
+    public:
+        trace_ring(uint32_t thread_id, size_t capacity);
+
+        void push(const trace_event& e);
+        // Appends the recorded events, oldest first
+        void copy_to(std::vector<trace_event>& events) const;
+        void clear();
+
+        uint32_t thread_id() const { return _thread_id; }
+
+    private:
+        mutable std::mutex _mutex; // contended only while the trace is exported
+        std::vector<trace_event> _events;
+        uint64_t _written;
+        const uint32_t _thread_id;
+    };
+
+    // Records the latency of the pipeline stages every frame goes through, from its arrival
+    // to the user callback or queue, to be inspected in chrome://tracing or Perfetto.
+    // Every frame is given a span ID when allocated by its sensor, which is inherited by the frames
+    // derived from it, so all the stages of a frame can be found by the "span" argument of the events.
+    // Disabled by default, at the cost of a relaxed atomic load per stage
+    class latency_tracer
+    {
+    public:
+        static const size_t events_per_thread = 8192;
+
+        static latency_tracer& instance();
+
+        static bool is_enabled() { return _enabled.load(std::memory_order_relaxed); }
+        void enable(bool state) { _enabled = state; }
+
+        static int64_t now()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        uint64_t new_span() { return _next_span.fetch_add(1, std::memory_order_relaxed); }
+
+        // Returns a copy of the name that is valid as long as the library is loaded
+        const char* intern(const std::string& name);
+
+        // Records a stage of the frame, between the two time points
+        void record(const char* name, uint64_t span, int64_t start, int64_t end);
+        // Records the time a frame waits in a queue, from begin_wait to end_wait with the same name and span
+        void begin_wait(const char* name, uint64_t span);
+        void end_wait(const char* name, uint64_t span);
+
+        // Chrome trace event format JSON of the recorded events.
+        // The rings of the threads that have exited are released once exported
+        std::string to_json();
+        void clear();
+
+    private:
+        // Rings of exited threads kept until the next export, the oldest ones are released first
+        static const size_t max_exited_rings = 16;
+
+        latency_tracer() = default;
+
+        trace_ring& local_ring();
+        void ring_exited(std::shared_ptr<trace_ring> ring);
+
+        static std::atomic<bool> _enabled;
+        std::atomic<uint64_t> _next_span{ 1 };
+
+        mutable std::mutex _mutex;
+        std::vector<std::shared_ptr<trace_ring>> _rings;
+        std::vector<std::shared_ptr<trace_ring>> _exited_rings;
+        std::set<std::string> _names;
+        uint32_t _threads = 0;
+    };
+
+    // Ends the waits of the frames a queue drops, so that no wait is left open in the trace
+    class trace_dropped_wait
+    {
+    public:
+        explicit trace_dropped_wait(const char* name) : _name(name) {}
+
+        template<class Frame>
+        void operator()(Frame& f) const
+        {
+            if (latency_tracer::is_enabled() && f)
+                latency_tracer::instance().end_wait(_name, f->get_trace_span());
+        }
+
+    private:
+        const char* _name;
+    };
+
+    // Records the scope as a stage of the frame
+    class trace_scope
+    {
+    public:
+        trace_scope(const char* name, uint64_t span)
+            : _name(name), _span(span), _start(latency_tracer::is_enabled() ? latency_tracer::now() : -1)
+        {}
+
+        ~trace_scope()
+        {
+            if (_start >= 0)
+                latency_tracer::instance().record(_name, _span, _start, latency_tracer::now());
+        }
+
+    private:
+        const char* _name;
+        uint64_t _span;
+        int64_t _start;
+    };
+}
@@ -43,6 +43,7 @@ namespace librealsense
         rs2_log_severity minimum_log_severity = RS2_LOG_SEVERITY_NONE;
         rs2_log_severity minimum_console_severity = RS2_LOG_SEVERITY_NONE;
         rs2_log_severity minimum_file_severity = RS2_LOG_SEVERITY_NONE;
+        rs2_log_severity minimum_callback_severity = RS2_LOG_SEVERITY_NONE;
 
         std::mutex log_mutex;
         std::ofstream log_file;
@@ -83,8 +84,16 @@ namespace librealsense
             }
         }
 
+        // Statements below all the outputs are skipped before they are formatted
+        void update_severity_floor() const
+        {
+            log_severity_floor() = std::min({ minimum_console_severity, minimum_file_severity, minimum_callback_severity });
+        }
+
         void open() const
         {
+            update_severity_floor();
+
             el::Configurations defaultConf;
             defaultConf.setToDefault();
             // To set GLOBAL configurations you may use
@@ -127,6 +136,7 @@ namespace librealsense
             defaultConf.setGlobally(el::ConfigurationType::ToStandardOutput, "false");
 
             el::Loggers::reconfigureLogger(log_id, defaultConf);
+            update_severity_floor();
         }
 
 
@@ -238,6 +248,9 @@ namespace librealsense
                 auto dispatcher = el::Helpers::logDispatchCallback< elpp_dispatcher >( dispatch_name );
                 dispatcher->callback = callback;
                 dispatcher->min_severity = min_severity;
+
+                minimum_callback_severity = std::min(minimum_callback_severity, min_severity);
+                update_severity_floor();
                 
                 // Remove the default logger (which will log to standard out/err) or it'll still be active
                 //el::Helpers::uninstallLogDispatchCallback< el::base::DefaultLogDispatchCallback >( "DefaultLogDispatchCallback" );
@@ -255,6 +268,8 @@ namespace librealsense
             minimum_log_severity = RS2_LOG_SEVERITY_NONE;
             minimum_console_severity = RS2_LOG_SEVERITY_NONE;
             minimum_file_severity = RS2_LOG_SEVERITY_NONE;
+            minimum_callback_severity = RS2_LOG_SEVERITY_NONE;
+            update_severity_floor();
         }
 
         // Callback: called by EL++ when the current log file has reached a certain maximum size.
@@ -77,7 +77,7 @@ namespace librealsense
         frame_callback_ptr m_user_callback;
         notifications_processor _notifications_processor;
         using stream_unique_id = int;
-        std::map<stream_unique_id, std::shared_ptr<dispatcher>> m_dispatchers;
+        std::map<stream_unique_id, std::shared_ptr<lockfree_dispatcher>> m_dispatchers;
         std::atomic<bool> m_is_started;
         device_serializer::sensor_snapshot m_sensor_description;
         uint32_t m_sensor_id;
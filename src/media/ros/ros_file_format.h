@@ -589,6 +589,19 @@ namespace librealsense
         return rs2rosinternal::Time(secs.count());
     }
 
+    // Serialized as a sensor_msgs::Image, referring to the pixels of the frame or of the mapped file rather than holding a copy of them
+    struct image_view
+    {
+        std_msgs::Header header;
+        uint32_t height;
+        uint32_t width;
+        std::string encoding;
+        uint8_t is_bigendian;
+        uint32_t step;
+        const uint8_t* data;
+        uint32_t data_size;
+    };
+
     namespace legacy_file_format
     {
         constexpr const char* USB_DESCRIPTOR = "{ 0x94b5fb99, 0x79f2, 0x4d66,{ 0x85, 0x06, 0xb1, 0x5e, 0x8b, 0x8c, 0x9d, 0xa1 } }";
@@ -857,3 +870,76 @@ namespace librealsense
         }
     }
 }
+
+namespace rs2rosinternal
+{
+    namespace message_traits
+    {
+        template<> struct IsFixedSize<librealsense::image_view> : FalseType {};
+        template<> struct IsMessage<librealsense::image_view> : TrueType {};
+        template<> struct HasHeader<librealsense::image_view> : TrueType {};
+
+        template<> struct MD5Sum<librealsense::image_view>
+        {
+            static const char* value() { return MD5Sum<sensor_msgs::Image>::value(); }
+            static const char* value(const librealsense::image_view&) { return value(); }
+        };
+
+        template<> struct DataType<librealsense::image_view>
+        {
+            static const char* value() { return DataType<sensor_msgs::Image>::value(); }
+            static const char* value(const librealsense::image_view&) { return value(); }
+        };
+
+        template<> struct Definition<librealsense::image_view>
+        {
+            static const char* value() { return Definition<sensor_msgs::Image>::value(); }
+            static const char* value(const librealsense::image_view&) { return value(); }
+        };
+    }
+
+    namespace serialization
+    {
+        // Read in place from a mapped file, the pixels remain where they were serialized
+        template<> struct Serializer<librealsense::image_view>
+        {
+            inline static void read(IStream& stream, librealsense::image_view& m)
+            {
+                stream.next(m.header);
+                stream.next(m.height);
+                stream.next(m.width);
+                stream.next(m.encoding);
+                stream.next(m.is_bigendian);
+                stream.next(m.step);
+                stream.next(m.data_size);
+                m.data = stream.advance(m.data_size);
+            }
+
+            template<typename Stream>
+            inline static void write(Stream& stream, const librealsense::image_view& m)
+            {
+                stream.next(m.header);
+                stream.next(m.height);
+                stream.next(m.width);
+                stream.next(m.encoding);
+                stream.next(m.is_bigendian);
+                stream.next(m.step);
+                stream.next(m.data_size);
+                memcpy(stream.advance(m.data_size), m.data, m.data_size);
+            }
+
+            inline static uint32_t serializedLength(const librealsense::image_view& m)
+            {
+                LStream stream;
+                stream.next(m.header);
+                stream.next(m.height);
+                stream.next(m.width);
+                stream.next(m.encoding);
+                stream.next(m.is_bigendian);
+                stream.next(m.step);
+                stream.next(m.data_size);
+                return stream.getLength() + m.data_size;
+            }
+        };
+    }
+}
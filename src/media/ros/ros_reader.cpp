@@ -2,6 +2,7 @@
 // Copyright(c) 2019 Intel Corporation. All Rights Reserved.
 
 #include <cstring>
+#include <iomanip>
 #include "ros_reader.h"
 #include "ds5/ds5-device.h"
 #include "ivcam/sr300.h"
@@ -17,11 +18,15 @@
 #include "proc/hdr-merge.h"
 #include "proc/sequence-id-filter.h"
 #include "std_msgs/Float32MultiArray.h"
+#include "rosbag/mapped_file.h"
 
 namespace librealsense
 {
     using namespace device_serializer;
 
+    // Chunks are ~768KB of messages or a single larger frame
+    static const uint32_t READ_AHEAD_CHUNKS = 8;
+
     ros_reader::ros_reader(const std::string& file, const std::shared_ptr<context>& ctx) :
         m_metadata_parser_map(md_constant_parser::create_metadata_parser_map()),
         m_total_duration(0),
@@ -29,6 +34,11 @@ namespace librealsense
         m_context(ctx),
         m_version(0)
     {
+        // Chunks read ahead of playback, and connection indexes cached next to large files so reopening them does not seek through the whole file
+        m_file.setPrefetchDepth(READ_AHEAD_CHUNKS);
+        m_file.setIndexCache(true);
+        // Images of uncompressed files are published in place from the mapped file. A 32-bit process may lack the address space
+        m_file.setMappedRead(sizeof(void*) >= 8);
         try
         {
             reset(); //Note: calling a virtual function inside c'tor, safe while base function is pure virtual
@@ -41,6 +51,22 @@ namespace librealsense
         }
     }
 
+    ros_reader::~ros_reader()
+    {
+        log_read_ahead_stats();
+    }
+
+    void ros_reader::log_read_ahead_stats() const
+    {
+        auto hits = m_file.getPrefetchHits();
+        auto misses = m_file.getPrefetchMisses();
+        if (hits + misses > 0)
+        {
+            LOG_INFO("Playback of " << m_file_path << " read " << hits + misses << " chunks, " << hits << " of them ahead ("
+                << std::fixed << std::setprecision(1) << 100. * hits / (hits + misses) << "% read-ahead hit rate)");
+        }
+    }
+
     device_snapshot ros_reader::query_device_description(const nanoseconds& time)
     {
         return read_device_description(time);
@@ -116,31 +142,19 @@ namespace librealsense
     std::vector<std::shared_ptr<serialized_data>> ros_reader::fetch_last_frames(const nanoseconds& seek_time)
     {
         std::vector<std::shared_ptr<serialized_data>> result;
-        rosbag::View view(m_file, FalseQuery());
         auto as_rostime = to_rostime(seek_time);
         auto start_time = to_rostime(get_static_file_info_timestamp());
 
+        // The last frame of each stream is looked up in the topic index, without walking the messages before it
         for (auto topic : m_enabled_streams_topics)
         {
-            view.addQuery(m_file, rosbag::TopicQuery(topic), start_time, as_rostime);
-        }
-        std::map<device_serializer::stream_identifier, rs2rosinternal::Time> last_frames;
-        for (auto&& m : view)
-        {
-            if (m.isType<sensor_msgs::Image>() || m.isType<sensor_msgs::Imu>())
+            rosbag::View view(m_file, rosbag::TopicQuery(topic), start_time, as_rostime);
+            auto msg = view.last();
+            if (msg != view.end() && (msg->isType<sensor_msgs::Image>() || msg->isType<sensor_msgs::Imu>()))
             {
-                auto id = ros_topic::get_stream_identifier(m.getTopic());
-                last_frames[id] = m.getTime();
+                result.push_back(create_frame(*msg));
             }
         }
-        for (auto&& kvp : last_frames)
-        {
-            auto topic = ros_topic::frame_data_topic(kvp.first);
-            rosbag::View view(m_file, rosbag::TopicQuery(topic), kvp.second, kvp.second);
-            auto msg = view.begin();
-            auto new_frame = create_frame(*msg);
-            result.push_back(new_frame);
-        }
         return result;
     }
     nanoseconds ros_reader::query_duration() const
@@ -150,6 +164,7 @@ namespace librealsense
 
     void ros_reader::reset()
     {
+        log_read_ahead_stats();
         m_file.close();
         m_file.open(m_file_path, rosbag::BagMode::Read);
         m_version = read_file_version(m_file);
@@ -406,11 +421,19 @@ namespace librealsense
     frame_holder ros_reader::create_image_from_message(const rosbag::MessageInstance &image_data) const
     {
         LOG_DEBUG("Trying to create an image frame from message");
-        auto msg = instantiate_msg<sensor_msgs::Image>(image_data);
+        image_view msg{};
+        sensor_msgs::Image::ConstPtr image_msg;
+        std::shared_ptr<const rosbag::MappedFile> mapping;
+        if (!read_mapped_image(image_data, msg, mapping))
+        {
+            image_msg = instantiate_msg<sensor_msgs::Image>(image_data);
+            msg = { image_msg->header, image_msg->height, image_msg->width, image_msg->encoding, image_msg->is_bigendian, image_msg->step,
+                    image_msg->data.data(), static_cast<uint32_t>(image_msg->data.size()) };
+        }
         frame_additional_data additional_data{};
-        std::chrono::duration<double, std::milli> timestamp_ms(std::chrono::duration<double>(msg->header.stamp.toSec()));
+        std::chrono::duration<double, std::milli> timestamp_ms(std::chrono::duration<double>(msg.header.stamp.toSec()));
         additional_data.timestamp = timestamp_ms.count();
-        additional_data.frame_number = msg->header.seq;
+        additional_data.frame_number = msg.header.seq;
         additional_data.fisheye_ae_mode = false;
 
         stream_identifier stream_id;
@@ -429,28 +452,49 @@ namespace librealsense
         }
 
         frame_interface* frame = m_frame_source->alloc_frame((stream_id.stream_type == RS2_STREAM_DEPTH) ? RS2_EXTENSION_DEPTH_FRAME : RS2_EXTENSION_VIDEO_FRAME,
-            msg->data.size(), additional_data, true);
+            msg.data_size, additional_data, !mapping);
         if (frame == nullptr)
         {
             LOG_WARNING("Failed to allocate new frame");
             return nullptr;
         }
         librealsense::video_frame* video_frame = static_cast<librealsense::video_frame*>(frame);
-        video_frame->assign(msg->width, msg->height, msg->step, msg->step / msg->width * 8);
+        video_frame->assign(msg.width, msg.height, msg.step, msg.step / msg.width * 8);
         rs2_format stream_format;
-        convert(msg->encoding, stream_format);
+        convert(msg.encoding, stream_format);
         //attaching a temp stream to the frame. Playback sensor should assign the real stream
         frame->set_stream(std::make_shared<video_stream_profile>(platform::stream_profile{}));
         frame->get_stream()->set_format(stream_format);
         frame->get_stream()->set_stream_index(int(stream_id.stream_index));
         frame->get_stream()->set_stream_type(stream_id.stream_type);
-        video_frame->data = std::move(msg->data);
+        if (mapping)
+        {
+            // The frame holds the mapping, which outlives the file and any reset of the reader
+            video_frame->attach_continuation(frame_continuation([mapping]() {}, msg.data, msg.data_size, true));
+        }
+        else
+        {
+            video_frame->data.assign(msg.data, msg.data + msg.data_size);
+        }
         librealsense::frame_holder fh{ video_frame };
         LOG_DEBUG("Created image frame: " << stream_id << " " << video_frame->get_width() << "x" << video_frame->get_height() << " " << stream_format);
 
         return fh;
     }
 
+    bool ros_reader::read_mapped_image(const rosbag::MessageInstance& image_data, image_view& msg, std::shared_ptr<const rosbag::MappedFile>& mapping)
+    {
+        const uint8_t* data;
+        uint32_t size;
+        if (!image_data.getMappedData(data, size, mapping))
+            return false;
+
+        // The message is not written to, the stream only reads it in place
+        rs2rosinternal::serialization::IStream stream(const_cast<uint8_t*>(data), size);
+        rs2rosinternal::serialization::deserialize(stream, msg);
+        return true;
+    }
+
     frame_holder ros_reader::create_motion_sample(const rosbag::MessageInstance &motion_data) const
     {
         LOG_DEBUG("Trying to create a motion frame from message");
@@ -14,6 +14,7 @@ namespace librealsense
     {
     public:
         ros_reader(const std::string& file, const std::shared_ptr<context>& ctx);
+        ~ros_reader();
         device_snapshot query_device_description(const nanoseconds& time) override;
         std::shared_ptr<serialized_data> read_next_data() override;
         void seek_to_time(const nanoseconds& seek_time) override;
@@ -42,6 +43,7 @@ namespace librealsense
         }
 
         std::shared_ptr<serialized_frame> create_frame(const rosbag::MessageInstance& msg);
+        void log_read_ahead_stats() const;
         static nanoseconds get_file_duration(const rosbag::Bag& file, uint32_t version);
         static void get_legacy_frame_metadata(const rosbag::Bag& bag,
             const device_serializer::stream_identifier& stream_id,
@@ -69,6 +71,7 @@ namespace librealsense
             const rosbag::MessageInstance &msg,
             frame_additional_data& additional_data);
         frame_holder create_image_from_message(const rosbag::MessageInstance &image_data) const;
+        static bool read_mapped_image(const rosbag::MessageInstance& image_data, image_view& msg, std::shared_ptr<const rosbag::MappedFile>& mapping);
         frame_holder create_motion_sample(const rosbag::MessageInstance &motion_data) const;
         static inline float3 to_float3(const geometry_msgs::Vector3& v);
         static inline float4 to_float4(const geometry_msgs::Quaternion& q);
@@ -27,6 +27,10 @@ namespace librealsense
         {
             m_bag.setCompression(rosbag::CompressionType::LZ4);
         }
+        // Compress and write the chunks in parallel, off the recording thread
+        auto write_threads = std::max(1u, std::thread::hardware_concurrency());
+        m_bag.setWriteThreads(write_threads);
+        LOG_INFO("Writing " << file << " with " << write_threads << " threads");
         write_file_version();
     }
 
@@ -173,7 +177,7 @@ namespace librealsense
 
     void ros_writer::write_video_frame(const stream_identifier& stream_id, const nanoseconds& timestamp, frame_holder&& frame)
     {
-        sensor_msgs::Image image;
+        image_view image;
         auto vid_frame = dynamic_cast<librealsense::video_frame*>(frame.frame);
         assert(vid_frame != nullptr);
 
@@ -182,9 +186,9 @@ namespace librealsense
         image.step = static_cast<uint32_t>(vid_frame->get_stride());
         convert(vid_frame->get_stream()->get_format(), image.encoding);
         image.is_bigendian = is_big_endian();
-        auto size = vid_frame->get_stride() * vid_frame->get_height();
-        auto p_data = vid_frame->get_frame_data();
-        image.data.assign(p_data, p_data + size);
+        // Serialized into the bag straight from the frame
+        image.data = vid_frame->get_frame_data();
+        image.data_size = static_cast<uint32_t>(vid_frame->get_stride() * vid_frame->get_height());
         image.header.seq = static_cast<uint32_t>(vid_frame->get_frame_number());
         std::chrono::duration<double, std::milli> timestamp_ms(vid_frame->get_frame_timestamp());
         image.header.stamp = rs2rosinternal::Time(std::chrono::duration<double>(timestamp_ms).count());
@@ -4,6 +4,7 @@
 #include <algorithm>
 #include "stream.h"
 #include "aggregator.h"
+#include "latency-trace.h"
 
 namespace librealsense
 {
@@ -11,7 +12,7 @@ namespace librealsense
     {
         aggregator::aggregator(const std::vector<int>& streams_to_aggregate, const std::vector<int>& streams_to_sync) :
             processing_block("aggregator"),
-            _queue(new single_consumer_frame_queue<frame_holder>(1)),
+            _queue(new single_consumer_frame_queue<frame_holder, lockfree_queue>(1)),
             _streams_to_aggregate_ids(streams_to_aggregate),
             _streams_to_sync_ids(streams_to_sync),
             _accepting(true)
@@ -77,7 +78,9 @@ namespace librealsense
                 source->frame_ready(async_fref.clone());
 
                 // for sync pipeline usage - push the aggregated to the output queue
-                _queue->enqueue(sync_fref.clone());
+                if (latency_tracer::is_enabled())
+                    latency_tracer::instance().begin_wait("frame queue", sync_fref->get_trace_span());
+                _queue->enqueue(sync_fref.clone(), trace_dropped_wait("frame queue"));
             }
             else
             {
@@ -97,19 +100,29 @@ namespace librealsense
                         return;
                     }
                     // for sync pipeline usage - push the aggregated to the output queue
-                    _queue->enqueue(sync_fref.clone());
+                    if (latency_tracer::is_enabled())
+                        latency_tracer::instance().begin_wait("frame queue", sync_fref->get_trace_span());
+                    _queue->enqueue(sync_fref.clone(), trace_dropped_wait("frame queue"));
                 }
             }
         }
 
         bool aggregator::dequeue(frame_holder* item, unsigned int timeout_ms)
         {
-            return _queue->dequeue(item, timeout_ms);
+            if (!_queue->dequeue(item, timeout_ms))
+                return false;
+            if (latency_tracer::is_enabled())
+                latency_tracer::instance().end_wait("frame queue", (*item)->get_trace_span());
+            return true;
         }
 
         bool aggregator::try_dequeue(frame_holder* item)
         {
-            return _queue->try_dequeue(item);
+            if (!_queue->try_dequeue(item))
+                return false;
+            if (latency_tracer::is_enabled())
+                latency_tracer::instance().end_wait("frame queue", (*item)->get_trace_span());
+            return true;
         }
 
         void aggregator::start()
@@ -120,7 +133,7 @@ namespace librealsense
         void aggregator::stop()
         {
             _accepting = false;
-            _queue->clear();
+            _queue->clear(trace_dropped_wait("frame queue"));
         }
     }
 }
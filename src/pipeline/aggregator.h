@@ -15,7 +15,7 @@ namespace librealsense
         {
             std::mutex _mutex;
             std::map<stream_id, frame_holder> _last_set;
-            std::unique_ptr<single_consumer_frame_queue<frame_holder>> _queue;
+            std::unique_ptr<single_consumer_frame_queue<frame_holder, lockfree_queue>> _queue;
             std::vector<int> _streams_to_aggregate_ids;
             std::vector<int> _streams_to_sync_ids;
             std::atomic<bool> _accepting;
@@ -15,31 +15,98 @@ namespace librealsense
 {
     template<int N> struct bytes { byte b[N]; };
 
-    template<class GET_DEPTH, class TRANSFER_PIXEL>
-    void align_images(const rs2_intrinsics& depth_intrin, const rs2_extrinsics& depth_to_other,
-        const rs2_intrinsics& other_intrin, GET_DEPTH get_depth, TRANSFER_PIXEL transfer_pixel)
+    // Transfers between every mapped depth pixel and the rectangle it covers on the other image.
+    // The rows of the depth image are transferred concurrently only when the writes of different
+    // depth pixels cannot reach the same output pixel
+    template<class TRANSFER_PIXEL>
+    void align_images(const rs2_intrinsics& depth_intrin, const rs2_intrinsics& other_intrin,
+        const int2* top_left, const int2* bottom_right, bool parallel, TRANSFER_PIXEL transfer_pixel)
     {
-        // Iterate over the pixels of the depth image
+#pragma omp parallel for schedule(dynamic) if(parallel)
+        for (int depth_y = 0; depth_y < depth_intrin.height; ++depth_y)
+        {
+            int depth_pixel_index = depth_y * depth_intrin.width;
+            for (int depth_x = 0; depth_x < depth_intrin.width; ++depth_x, ++depth_pixel_index)
+            {
+                // Pixels without depth, or mapped outside of the other image, are not transferred
+                if (top_left[depth_pixel_index].x < 0)
+                    continue;
+
+                for (int y = top_left[depth_pixel_index].y; y <= bottom_right[depth_pixel_index].y; ++y)
+                {
+                    for (int x = top_left[depth_pixel_index].x; x <= bottom_right[depth_pixel_index].x; ++x)
+                    {
+                        transfer_pixel(depth_pixel_index, y * other_intrin.width + x);
+                    }
+                }
+            }
+        }
+    }
+
+    align::align(rs2_stream to_stream) : align(to_stream, "Align")
+    {}
+
+    void align::update_depth_rays(const rs2_intrinsics& depth_intrin)
+    {
+        if (_rays_intrinsics && *_rays_intrinsics == depth_intrin)
+            return;
+
+        auto size = depth_intrin.width * depth_intrin.height;
+        _top_left_rays.resize(size);
+        _bottom_right_rays.resize(size);
+        _top_left_pixels.resize(size);
+        _bottom_right_pixels.resize(size);
+
+        for (int depth_y = 0; depth_y < depth_intrin.height; ++depth_y)
+        {
+            for (int depth_x = 0; depth_x < depth_intrin.width; ++depth_x)
+            {
+                auto depth_pixel_index = depth_y * depth_intrin.width + depth_x;
+                float depth_pixel[2] = { depth_x - 0.5f, depth_y - 0.5f }, ray[3];
+                rs2_deproject_pixel_to_point(ray, &depth_intrin, depth_pixel, 1.f);
+                _top_left_rays[depth_pixel_index] = { ray[0], ray[1] };
+
+                depth_pixel[0] = depth_x + 0.5f; depth_pixel[1] = depth_y + 0.5f;
+                rs2_deproject_pixel_to_point(ray, &depth_intrin, depth_pixel, 1.f);
+                _bottom_right_rays[depth_pixel_index] = { ray[0], ray[1] };
+            }
+        }
+        _rays_intrinsics = depth_intrin;
+    }
+
+    void align::map_depth_pixels(const uint16_t* z_pixels, float z_scale, const rs2_intrinsics& depth_intrin,
+        const rs2_extrinsics& depth_to_other, const rs2_intrinsics& other_intrin)
+    {
+        update_depth_rays(depth_intrin);
+
+        auto top_left_rays = _top_left_rays.data();
+        auto bottom_right_rays = _bottom_right_rays.data();
+        auto top_left = _top_left_pixels.data();
+        auto bottom_right = _bottom_right_pixels.data();
+
+        // Every depth pixel writes only its own entries, so the rows can be mapped concurrently
 #pragma omp parallel for schedule(dynamic)
         for (int depth_y = 0; depth_y < depth_intrin.height; ++depth_y)
         {
             int depth_pixel_index = depth_y * depth_intrin.width;
             for (int depth_x = 0; depth_x < depth_intrin.width; ++depth_x, ++depth_pixel_index)
             {
+                top_left[depth_pixel_index] = { -1, -1 };
+
                 // Skip over depth pixels with the value of zero, we have no depth data so we will not write anything into our aligned images
-                if (float depth = get_depth(depth_pixel_index))
+                if (float depth = z_scale * z_pixels[depth_pixel_index])
                 {
                     // Map the top-left corner of the depth pixel onto the other image
-                    float depth_pixel[2] = { depth_x - 0.5f, depth_y - 0.5f }, depth_point[3], other_point[3], other_pixel[2];
-                    rs2_deproject_pixel_to_point(depth_point, &depth_intrin, depth_pixel, depth);
+                    float depth_point[3] = { depth * top_left_rays[depth_pixel_index].x, depth * top_left_rays[depth_pixel_index].y, depth };
+                    float other_point[3], other_pixel[2];
                     rs2_transform_point_to_point(other_point, &depth_to_other, depth_point);
                     rs2_project_point_to_pixel(other_pixel, &other_intrin, other_point);
                     const int other_x0 = static_cast<int>(other_pixel[0] + 0.5f);
                     const int other_y0 = static_cast<int>(other_pixel[1] + 0.5f);
 
                     // Map the bottom-right corner of the depth pixel onto the other image
-                    depth_pixel[0] = depth_x + 0.5f; depth_pixel[1] = depth_y + 0.5f;
-                    rs2_deproject_pixel_to_point(depth_point, &depth_intrin, depth_pixel, depth);
+                    depth_point[0] = depth * bottom_right_rays[depth_pixel_index].x;
+                    depth_point[1] = depth * bottom_right_rays[depth_pixel_index].y;
                     rs2_transform_point_to_point(other_point, &depth_to_other, depth_point);
                     rs2_project_point_to_pixel(other_pixel, &other_intrin, other_point);
                     const int other_x1 = static_cast<int>(other_pixel[0] + 0.5f);
@@ -48,22 +115,13 @@ namespace librealsense
                     if (other_x0 < 0 || other_y0 < 0 || other_x1 >= other_intrin.width || other_y1 >= other_intrin.height)
                         continue;
 
-                    // Transfer between the depth pixels and the pixels inside the rectangle on the other image
-                    for (int y = other_y0; y <= other_y1; ++y)
-                    {
-                        for (int x = other_x0; x <= other_x1; ++x)
-                        {
-                            transfer_pixel(depth_pixel_index, y * other_intrin.width + x);
-                        }
-                    }
+                    top_left[depth_pixel_index] = { other_x0, other_y0 };
+                    bottom_right[depth_pixel_index] = { other_x1, other_y1 };
                 }
             }
         }
     }
 
-    align::align(rs2_stream to_stream) : align(to_stream, "Align")
-    {}
-
     void align::align_z_to_other(rs2::video_frame& aligned, 
         const rs2::video_frame& depth, const rs2::video_stream_profile& other_profile, float z_scale)
     {
@@ -80,8 +138,11 @@ namespace librealsense
         auto z_pixels = reinterpret_cast<const uint16_t*>(depth.get_data());
         auto out_z = (uint16_t *)(aligned_data);
 
-        align_images(z_intrin, z_to_other, other_intrin,
-            [z_pixels, z_scale](int z_pixel_index) { return z_scale * z_pixels[z_pixel_index]; },
+        map_depth_pixels(z_pixels, z_scale, z_intrin, z_to_other, other_intrin);
+
+        // Several depth pixels may cover the same pixel of the other image, so the z-buffer
+        // is resolved in a single pass, keeping the nearest depth regardless of thread scheduling
+        align_images(z_intrin, other_intrin, _top_left_pixels.data(), _bottom_right_pixels.data(), false,
             [out_z, z_pixels](int z_pixel_index, int other_pixel_index)
         {
             out_z[other_pixel_index] = out_z[other_pixel_index] ?
@@ -90,34 +151,36 @@ namespace librealsense
         });
     }
 
-    template<int N, class GET_DEPTH>
-    void align_other_to_depth_bytes(byte* other_aligned_to_depth, GET_DEPTH get_depth, const rs2_intrinsics& depth_intrin, const rs2_extrinsics& depth_to_other, const rs2_intrinsics& other_intrin, const byte* other_pixels)
+    template<int N>
+    void align_other_to_depth_bytes(byte* other_aligned_to_depth, const rs2_intrinsics& depth_intrin, const rs2_intrinsics& other_intrin,
+        const int2* top_left, const int2* bottom_right, const byte* other_pixels)
     {
         auto in_other = (const bytes<N> *)(other_pixels);
         auto out_other = (bytes<N> *)(other_aligned_to_depth);
-        align_images(depth_intrin, depth_to_other, other_intrin, get_depth,
+        // Every depth pixel writes only its own output pixel
+        align_images(depth_intrin, other_intrin, top_left, bottom_right, true,
             [out_other, in_other](int depth_pixel_index, int other_pixel_index) { out_other[depth_pixel_index] = in_other[other_pixel_index]; });
     }
 
-    template<class GET_DEPTH>
-    void align_other_to_depth(byte* other_aligned_to_depth, GET_DEPTH get_depth, const rs2_intrinsics& depth_intrin, const rs2_extrinsics & depth_to_other, const rs2_intrinsics& other_intrin, const byte* other_pixels, rs2_format other_format)
+    void align_other_to_depth(byte* other_aligned_to_depth, const rs2_intrinsics& depth_intrin, const rs2_intrinsics& other_intrin,
+        const int2* top_left, const int2* bottom_right, const byte* other_pixels, rs2_format other_format)
     {
         switch (other_format)
         {
         case RS2_FORMAT_Y8:
-            align_other_to_depth_bytes<1>(other_aligned_to_depth, get_depth, depth_intrin, depth_to_other, other_intrin, other_pixels);
+            align_other_to_depth_bytes<1>(other_aligned_to_depth, depth_intrin, other_intrin, top_left, bottom_right, other_pixels);
             break;
         case RS2_FORMAT_Y16:
         case RS2_FORMAT_Z16:
-            align_other_to_depth_bytes<2>(other_aligned_to_depth, get_depth, depth_intrin, depth_to_other, other_intrin, other_pixels);
+            align_other_to_depth_bytes<2>(other_aligned_to_depth, depth_intrin, other_intrin, top_left, bottom_right, other_pixels);
             break;
         case RS2_FORMAT_RGB8:
         case RS2_FORMAT_BGR8:
-            align_other_to_depth_bytes<3>(other_aligned_to_depth, get_depth, depth_intrin, depth_to_other, other_intrin, other_pixels);
+            align_other_to_depth_bytes<3>(other_aligned_to_depth, depth_intrin, other_intrin, top_left, bottom_right, other_pixels);
             break;
         case RS2_FORMAT_RGBA8:
         case RS2_FORMAT_BGRA8:
-            align_other_to_depth_bytes<4>(other_aligned_to_depth, get_depth, depth_intrin, depth_to_other, other_intrin, other_pixels);
+            align_other_to_depth_bytes<4>(other_aligned_to_depth, depth_intrin, other_intrin, top_left, bottom_right, other_pixels);
             break;
         default:
             assert(false); // NOTE: rs2_align_other_to_depth_bytes<2>(...) is not appropriate for RS2_FORMAT_YUYV/RS2_FORMAT_RAW10 images, no logic prevents U/V channels from being written to one another
@@ -140,8 +203,9 @@ namespace librealsense
         auto z_pixels = reinterpret_cast<const uint16_t*>(depth.get_data());
         auto other_pixels = reinterpret_cast<const byte*>(other.get_data());
 
-        align_other_to_depth(aligned_data, [z_pixels, z_scale](int z_pixel_index) { return z_scale * z_pixels[z_pixel_index]; },
-            z_intrin, z_to_other, other_intrin, other_pixels, other_profile.format());
+        map_depth_pixels(z_pixels, z_scale, z_intrin, z_to_other, other_intrin);
+        align_other_to_depth(aligned_data, z_intrin, other_intrin, _top_left_pixels.data(), _bottom_right_pixels.data(),
+            other_pixels, other_profile.format());
     }
 
     std::shared_ptr<rs2::video_stream_profile> align::create_aligned_profile(
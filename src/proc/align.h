@@ -52,5 +52,20 @@ namespace librealsense
     private:
         rs2::video_frame allocate_aligned_frame(const rs2::frame_source& source, const rs2::video_frame& from, const rs2::video_frame& to);
         void align_frames(rs2::video_frame& aligned, const rs2::video_frame& from, const rs2::video_frame& to);
+
+        void update_depth_rays(const rs2_intrinsics& depth_intrin);
+        // Maps the corners of every depth pixel onto the other image. Pixels without depth,
+        // or mapped outside of the other image, get a negative top-left x
+        void map_depth_pixels(const uint16_t* z_pixels, float z_scale, const rs2_intrinsics& depth_intrin,
+            const rs2_extrinsics& depth_to_other, const rs2_intrinsics& other_intrin);
+
+        // Rays through the top-left and bottom-right corners of the depth pixels at depth 1,
+        // cached until the depth intrinsics change (e.g. after a calibration update)
+        optional_value<rs2_intrinsics> _rays_intrinsics;
+        std::vector<float2> _top_left_rays;
+        std::vector<float2> _bottom_right_rays;
+        // The rectangle of the other image covered by each depth pixel
+        std::vector<int2> _top_left_pixels;
+        std::vector<int2> _bottom_right_pixels;
     };
 }
@@ -20,7 +20,10 @@ rs2::frame librealsense::auto_exposure_processor::process_frame(const rs2::frame
 {
     // We dont actually modify the frame, only calculate and process the exposure values.
     auto&& fi = (frame_interface*)f.get();
-    ((librealsense::frame*)fi)->additional_data.fisheye_ae_mode = true;
+    auto&& fr = (librealsense::frame*)fi;
+    auto additional_data = fr->additional_data;
+    additional_data.fisheye_ae_mode = true;
+    fr->set_additional_data(additional_data);
 
     fi->acquire();
     auto&& auto_exposure = _enable_ae_option.get_auto_exposure();
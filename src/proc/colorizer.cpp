@@ -10,6 +10,7 @@
 #include "option.h"
 #include "colorizer.h"
 #include "disparity-transform.h"
+#include "proc/sse/sse-colorizer.h"
 
 namespace librealsense
 {
@@ -274,18 +275,28 @@ namespace librealsense
                 auto pixels = (float)_hist_data[MAX_DEPTH - 1];
                 return (hist_data / pixels);
             };
+            auto update_equalized_lut = [&, this](decltype(coloring_function)& coloring) {
+                _lut_cropped = false;
+                if (_hist_data[MAX_DEPTH - 1])
+                    update_lut(max_histogram_value(), coloring);
+                else
+                    _lut.assign(1, 0); // No valid pixels to equalize
+            };
 
+            // The colors depend on the histogram position of the pixels only, so each value present is colored once
             if (depth_format == RS2_FORMAT_DISPARITY32)
             {
                 auto depth_data = reinterpret_cast<const float*>(depth.get_data());
                 update_histogram(_hist_data, depth_data, w, h);
-                make_rgb_data<float>(depth_data, rgb_data, w, h, coloring_function);
+                update_equalized_lut(coloring_function);
+                make_rgb_data_lut(depth_data, rgb_data, w, h);
             }
             else if (depth_format == RS2_FORMAT_Z16)
             {
                 auto depth_data = reinterpret_cast<const uint16_t*>(depth.get_data());
                 update_histogram(_hist_data, depth_data, w, h);
-                make_rgb_data<uint16_t>(depth_data, rgb_data, w, h, coloring_function);
+                update_equalized_lut(coloring_function);
+                make_rgb_data_lut(depth_data, rgb_data, w, h);
             }
         };
 
@@ -318,7 +329,18 @@ namespace librealsense
                     if (min >= max) return 0.f;
                     return (data * _depth_units - min) / (max - min);
                 };
-                make_rgb_data<uint16_t>(depth_data, rgb_data, w, h, coloring_function);
+
+                // The colors of all the depth values are kept until the range, the units or the color map change
+                if (!_lut_cropped || _lut_map_index != _map_index || _lut_min != min || _lut_max != max || _lut_depth_units != _depth_units)
+                {
+                    update_lut(MAX_DEPTH - 1, coloring_function);
+                    _lut_cropped = true;
+                    _lut_map_index = _map_index;
+                    _lut_min = min;
+                    _lut_max = max;
+                    _lut_depth_units = _depth_units;
+                }
+                make_rgb_data_lut(depth_data, rgb_data, w, h);
             }
         };
 
@@ -334,4 +356,44 @@ namespace librealsense
 
         return ret;
     }
+
+    void colorizer::make_rgb_data_lut(const uint16_t* depth_data, uint8_t* rgb_data, int width, int height)
+    {
+        _lut[0] = 0;
+        auto lut = _lut.data();
+#ifdef __SSSE3__
+        colorize_lut_sse(depth_data, rgb_data, width * height, lut);
+#else
+#pragma omp parallel for
+        for (int i = 0; i < width * height; ++i)
+        {
+            auto c = lut[depth_data[i]];
+            rgb_data[i * 3 + 0] = (uint8_t)c;
+            rgb_data[i * 3 + 1] = (uint8_t)(c >> 8);
+            rgb_data[i * 3 + 2] = (uint8_t)(c >> 16);
+        }
+#endif
+    }
+
+    void colorizer::make_rgb_data_lut(const float* depth_data, uint8_t* rgb_data, int width, int height)
+    {
+        // Disparities below 1 share the color of 0, so the zero pixels are told apart by their value
+        auto lut = _lut.data();
+#pragma omp parallel for
+        for (int i = 0; i < width * height; ++i)
+        {
+            auto d = depth_data[i];
+            auto c = d ? lut[(int)d] : 0;
+            rgb_data[i * 3 + 0] = (uint8_t)c;
+            rgb_data[i * 3 + 1] = (uint8_t)(c >> 8);
+            rgb_data[i * 3 + 2] = (uint8_t)(c >> 16);
+        }
+    }
+
+    int colorizer::max_histogram_value() const
+    {
+        // The histogram is cumulative from 1, so the largest value is the first one to count all the valid pixels
+        auto pixels = _hist_data[MAX_DEPTH - 1];
+        return (int)(std::lower_bound(_hist_data + 1, _hist_data + MAX_DEPTH, pixels) - _hist_data);
+    }
 }
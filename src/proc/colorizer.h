@@ -3,8 +3,12 @@
 
 #pragma once
 
+#include <algorithm>
 #include <map>
 #include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace rs2
 {
@@ -104,7 +108,36 @@ namespace librealsense {
         static void update_histogram(int* hist, const T* depth_data, int w, int h)
         {
             memset(hist, 0, MAX_DEPTH * sizeof(int));
-            for (auto i = 0; i < w*h; ++i)
+            const int pixels = w * h;
+#ifdef _OPENMP
+            // Every thread counts its share of the pixels into a histogram of its own, and the histograms are then summed.
+            // Small frames are not worth summing the histograms
+            const int threads = std::min(omp_get_max_threads(), pixels / MAX_DEPTH);
+            if (threads > 1)
+            {
+                static thread_local std::vector<int> partial;
+                partial.assign((threads - 1) * MAX_DEPTH, 0);
+                auto partial_data = partial.data();
+
+#pragma omp parallel for num_threads(threads)
+                for (int t = 0; t < threads; ++t)
+                {
+                    int* part = t ? partial_data + (t - 1) * MAX_DEPTH : hist;
+                    const int end = static_cast<int>(static_cast<int64_t>(pixels) * (t + 1) / threads);
+                    for (auto i = static_cast<int>(static_cast<int64_t>(pixels) * t / threads); i < end; ++i)
+                        part[static_cast< int >( depth_data[i] )] += 1;
+                }
+
+#pragma omp parallel for num_threads(threads)
+                for (int index = 0; index < MAX_DEPTH; ++index)
+                {
+                    for (int t = 1; t < threads; ++t)
+                        hist[index] += partial_data[(t - 1) * MAX_DEPTH + index];
+                }
+            }
+            else
+#endif
+            for (auto i = 0; i < pixels; ++i)
             {
                 T depth_val = depth_data[i];
                 int index = static_cast< int >( depth_val );
@@ -134,6 +167,30 @@ namespace librealsense {
             }
         }
 
+        // Fills the color table of the depth values 0 to max_value with the colors picked by colorize_pixel,
+        // R, G and B in the low bytes of each entry, so that the pixels are colored by table lookups
+        template<typename F>
+        void update_lut(int max_value, F coloring_func)
+        {
+            auto cm = _maps[_map_index];
+            _lut.resize(max_value + 1);
+            auto lut = _lut.data();
+
+#pragma omp parallel for
+            for (int i = 0; i <= max_value; ++i)
+            {
+                auto c = cm->get(coloring_func((float)i));
+                lut[i] = (uint32_t)(uint8_t)c.x | ((uint32_t)(uint8_t)c.y << 8) | ((uint32_t)(uint8_t)c.z << 16);
+            }
+        }
+
+        // Colors the pixels by the color table, the zero pixels black
+        void make_rgb_data_lut(const uint16_t* depth_data, uint8_t* rgb_data, int width, int height);
+        void make_rgb_data_lut(const float* depth_data, uint8_t* rgb_data, int width, int height);
+
+        // The largest value counted by the histogram, 0 if all the pixels are 0
+        int max_histogram_value() const;
+
         template<typename T, typename F>
         void colorize_pixel(uint8_t* rgb_data, int idx, color_map* cm, T data, F coloring_func)
         {
@@ -162,6 +219,12 @@ namespace librealsense {
         std::vector<int> _histogram;
         int* _hist_data;
 
+        std::vector<uint32_t> _lut;
+        // The settings of the color table of the value cropped depth frames, which is kept between the frames
+        bool _lut_cropped = false;
+        int _lut_map_index = 0;
+        float _lut_min = 0.f, _lut_max = 0.f, _lut_depth_units = 0.f;
+
         int _preset = 0;
         rs2::stream_profile _target_stream_profile;
         rs2::stream_profile _source_stream_profile;
@@ -0,0 +1,278 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2017 Intel Corporation. All Rights Reserved.
+
+#include <vector>
+
+#include "proc/decimation-filter-passes.h"
+
+#define PIX_SORT(a,b) { if ((a)>(b)) PIX_SWAP((a),(b)); }
+#define PIX_SWAP(a,b) { pixelvalue temp=(a);(a)=(b);(b)=temp; }
+#define PIX_MIN(a,b) ((a)>(b)) ? (b) : (a)
+#define PIX_MAX(a,b) ((a)>(b)) ? (a) : (b)
+
+namespace librealsense
+{
+    /*----------------------------------------------------------------------------
+    Function :   opt_med3()
+    In       :   pointer to array of 3 pixel values
+    Out      :   a pixelvalue
+    Job      :   optimized search of the median of 3 pixel values
+    Notice   :   found on sci.image.processing
+    cannot go faster unless assumptions are made
+    on the nature of the input signal.
+    ---------------------------------------------------------------------------*/
+    template <class pixelvalue>
+    inline pixelvalue opt_med3(pixelvalue * p)
+    {
+        PIX_SORT(p[0], p[1]);
+        PIX_SORT(p[1], p[2]);
+        PIX_SORT(p[0], p[1]);
+        return p[1];
+    }
+
+    /*
+    ** opt_med4()
+    hacked version
+    **/
+    template <class pixelvalue>
+    inline pixelvalue opt_med4(pixelvalue * p)
+    {
+        PIX_SORT(p[0], p[1]);
+        PIX_SORT(p[2], p[3]);
+        PIX_SORT(p[0], p[2]);
+        PIX_SORT(p[1], p[3]);
+        return PIX_MIN(p[1], p[2]);
+    }
+
+    /*----------------------------------------------------------------------------
+    Function :   opt_med5()
+    In       :   pointer to array of 5 pixel values
+    Out      :   a pixelvalue
+    Job      :   optimized search of the median of 5 pixel values
+    Notice   :   found on sci.image.processing
+    cannot go faster unless assumptions are made
+    on the nature of the input signal.
+    ---------------------------------------------------------------------------*/
+    template <class pixelvalue>
+    inline pixelvalue opt_med5(pixelvalue * p)
+    {
+        PIX_SORT(p[0], p[1]);
+        PIX_SORT(p[3], p[4]);
+        p[3] = PIX_MAX(p[0], p[3]);
+        p[1] = PIX_MIN(p[1], p[4]);
+        PIX_SORT(p[1], p[2]);
+        p[2] = PIX_MIN(p[2], p[3]);
+        return PIX_MAX(p[1], p[2]);
+    }
+
+    /*----------------------------------------------------------------------------
+    Function :   opt_med6()
+    In       :   pointer to array of 6 pixel values
+    Out      :   a pixelvalue
+    Job      :   optimized search of the median of 6 pixel values
+    Notice   :   from Christoph_John@gmx.de
+    based on a selection network which was proposed in
+    "FAST, EFFICIENT MEDIAN FILTERS WITH EVEN LENGTH WINDOWS"
+    J.P. HAVLICEK, K.A. SAKADY, G.R.KATZ
+    If you need larger even length kernels check the paper
+    ---------------------------------------------------------------------------*/
+    template <class pixelvalue>
+    inline pixelvalue opt_med6(pixelvalue * p)
+    {
+        PIX_SORT(p[1], p[2]);
+        PIX_SORT(p[3], p[4]);
+        PIX_SORT(p[0], p[1]);
+        PIX_SORT(p[2], p[3]);
+        PIX_SORT(p[4], p[5]);
+        PIX_SORT(p[1], p[2]);
+        PIX_SORT(p[3], p[4]);
+        PIX_SORT(p[0], p[1]);
+        PIX_SORT(p[2], p[3]);
+        p[4] = PIX_MIN(p[4], p[5]);
+        p[2] = PIX_MAX(p[1], p[2]);
+        p[3] = PIX_MIN(p[3], p[4]);
+        return PIX_MIN(p[2], p[3]);
+    }
+
+    /*----------------------------------------------------------------------------
+    Function :   opt_med7()
+    In       :   pointer to array of 7 pixel values
+    Out      :   a pixelvalue
+    Job      :   optimized search of the median of 7 pixel values
+    Notice   :   found on sci.image.processing
+    cannot go faster unless assumptions are made
+    on the nature of the input signal.
+    ---------------------------------------------------------------------------*/
+    template <class pixelvalue>
+    inline pixelvalue opt_med7(pixelvalue * p)
+    {
+        PIX_SORT(p[0], p[5]);
+        PIX_SORT(p[0], p[3]);
+        PIX_SORT(p[1], p[6]);
+        PIX_SORT(p[2], p[4]);
+        PIX_SORT(p[0], p[1]);
+        PIX_SORT(p[3], p[5]);
+        PIX_SORT(p[2], p[6]);
+        p[3] = PIX_MAX(p[2], p[3]);
+        p[3] = PIX_MIN(p[3], p[6]);
+        p[4] = PIX_MIN(p[4], p[5]);
+        PIX_SORT(p[1], p[4]);
+        p[3] = PIX_MAX(p[1], p[3]);
+        return PIX_MIN(p[3], p[4]);
+    }
+
+    /*----------------------------------------------------------------------------
+    Function :   opt_med9()
+    Hacked version of opt_med9()
+    */
+    template <class pixelvalue>
+    inline pixelvalue opt_med8(pixelvalue * p)
+    {
+        PIX_SORT(p[0], p[1]);
+        PIX_SORT(p[3], p[4]);
+        PIX_SORT(p[6], p[7]);
+        PIX_SORT(p[2], p[3]);
+        PIX_SORT(p[5], p[6]);
+        PIX_SORT(p[3], p[4]);
+        PIX_SORT(p[6], p[7]);
+        p[4] = PIX_MIN(p[4], p[7]);
+        PIX_SORT(p[3], p[6]);
+        p[5] = PIX_MAX(p[2], p[5]);
+        p[3] = PIX_MAX(p[0], p[3]);
+        p[1] = PIX_MIN(p[1], p[4]);
+        p[3] = PIX_MIN(p[3], p[6]);
+        PIX_SORT(p[3], p[1]);
+        p[3] = PIX_MAX(p[5], p[3]);
+        return PIX_MIN(p[3], p[1]);
+    }
+
+    /*----------------------------------------------------------------------------
+    Function :   opt_med9()
+    In       :   pointer to an array of 9 pixelvalues
+    Out      :   a pixelvalue
+    Job      :   optimized search of the median of 9 pixelvalues
+    Notice   :   in theory, cannot go faster without assumptions on the
+    signal.
+    Formula from:
+    XILINX XCELL magazine, vol. 23 by John L. Smith
+
+    The input array is modified in the process
+    The result array is guaranteed to contain the median
+    value
+    in middle position, but other elements are NOT sorted.
+    ---------------------------------------------------------------------------*/
+    template <class pixelvalue>
+    inline pixelvalue opt_med9(pixelvalue * p)
+    {
+        PIX_SORT(p[1], p[2]);
+        PIX_SORT(p[4], p[5]);
+        PIX_SORT(p[7], p[8]);
+        PIX_SORT(p[0], p[1]);
+        PIX_SORT(p[3], p[4]);
+        PIX_SORT(p[6], p[7]);
+        PIX_SORT(p[1], p[2]);
+        PIX_SORT(p[4], p[5]);
+        PIX_SORT(p[7], p[8]);
+        p[3] = PIX_MAX(p[0], p[3]);
+        p[5] = PIX_MIN(p[5], p[8]);
+        PIX_SORT(p[4], p[7]);
+        p[6] = PIX_MAX(p[3], p[6]);
+        p[4] = PIX_MAX(p[1], p[4]);
+        p[2] = PIX_MIN(p[2], p[5]);
+        p[4] = PIX_MIN(p[4], p[7]);
+        PIX_SORT(p[4], p[2]);
+        p[4] = PIX_MAX(p[6], p[4]);
+        return PIX_MIN(p[4], p[2]);
+    }
+
+    void decimate_depth_median(const uint16_t* frame_data_in, uint16_t* frame_data_out,
+        size_t width_in, size_t real_width, size_t real_height, size_t padded_width, size_t scale)
+    {
+        std::vector<uint16_t> working_kernel(scale * scale);
+        auto wk_begin = working_kernel.data();
+        auto wk_itr = wk_begin;
+        std::vector<uint16_t*> pixel_raws(scale);
+        uint16_t* block_start = const_cast<uint16_t*>(frame_data_in);
+
+        for (size_t j = 0; j < real_height; j++)
+        {
+            uint16_t *p{};
+            // Mark the beginning of each of the N lines that the filter will run upon
+            for (size_t i = 0; i < pixel_raws.size(); i++)
+                pixel_raws[i] = block_start + (width_in*i);
+
+            for (size_t i = 0, chunk_offset = 0; i < real_width; i++)
+            {
+                wk_itr = wk_begin;
+                // extract data the kernel to process
+                for (size_t n = 0; n < scale; ++n)
+                {
+                    p = pixel_raws[n] + chunk_offset;
+                    for (size_t m = 0; m < scale; ++m)
+                    {
+                        if (*(p + m))
+                            *wk_itr++ = *(p + m);
+                    }
+                }
+
+                // For even-size kernels pick the member one below the middle
+                auto ks = (int)(wk_itr - wk_begin);
+                if (ks == 0)
+                    *frame_data_out++ = 0;
+                else
+                {
+                    switch (ks)
+                    {
+                    case 1:
+                        *frame_data_out++ = working_kernel[0];
+                        break;
+                    case 2:
+                        *frame_data_out++ = PIX_MIN(working_kernel[0], working_kernel[1]);
+                        break;
+                    case 3:
+                        *frame_data_out++ = opt_med3<uint16_t>(working_kernel.data());
+                        break;
+                    case 4:
+                        *frame_data_out++ = opt_med4<uint16_t>(working_kernel.data());
+                        break;
+                    case 5:
+                        *frame_data_out++ = opt_med5<uint16_t>(working_kernel.data());
+                        break;
+                    case 6:
+                        *frame_data_out++ = opt_med6<uint16_t>(working_kernel.data());
+                        break;
+                    case 7:
+                        *frame_data_out++ = opt_med7<uint16_t>(working_kernel.data());
+                        break;
+                    case 8:
+                        *frame_data_out++ = opt_med8<uint16_t>(working_kernel.data());
+                        break;
+                    case 9:
+                        *frame_data_out++ = opt_med9<uint16_t>(working_kernel.data());
+                        break;
+                    }
+                }
+
+                chunk_offset += scale;
+            }
+
+            // Fill-in the padded colums with zeros
+            for (size_t i = real_width; i < padded_width; i++)
+                *frame_data_out++ = 0;
+
+            // Skip N lines to the beginnig of the next processing segment
+            block_start += width_in * scale;
+        }
+    }
+
+    void sum_rows(const uint8_t* first_row, size_t stride, size_t rows, size_t length, uint16_t* sums)
+    {
+        for (size_t x = 0; x < length; x++)
+        {
+            uint16_t sum = 0;
+            for (size_t n = 0; n < rows; n++)
+                sum += first_row[n * stride + x];
+            sums[x] = sum;
+        }
+    }
+}
@@ -0,0 +1,21 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2017 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace librealsense
+{
+    // Scalar passes of the decimation filter
+
+    // Median decimation of depth frames by 2 or 3: every output pixel is the median of the non-zero pixels
+    // of its patch, the one below the middle for an even count, and zero for a patch without valid pixels.
+    // Writes real_height rows of padded_width pixels, the padding columns set to zero
+    void decimate_depth_median(const uint16_t* frame_data_in, uint16_t* frame_data_out,
+        size_t width_in, size_t real_width, size_t real_height, size_t padded_width, size_t scale);
+
+    // Sums of length bytes over rows consecutive rows
+    void sum_rows(const uint8_t* first_row, size_t stride, size_t rows, size_t length, uint16_t* sums);
+}
@@ -12,188 +12,12 @@
 #include "core/video.h"
 #include "proc/synthetic-stream.h"
 #include "proc/decimation-filter.h"
+#include "proc/decimation-filter-passes.h"
+#include "proc/sse/sse-decimation-filter.h"
 
 
-#define PIX_SORT(a,b) { if ((a)>(b)) PIX_SWAP((a),(b)); }
-#define PIX_SWAP(a,b) { pixelvalue temp=(a);(a)=(b);(b)=temp; }
-#define PIX_MIN(a,b) ((a)>(b)) ? (b) : (a)
-#define PIX_MAX(a,b) ((a)>(b)) ? (a) : (b)
-
 namespace librealsense
 {
-    /*----------------------------------------------------------------------------
-    Function :   opt_med3()
-    In       :   pointer to array of 3 pixel values
-    Out      :   a pixelvalue
-    Job      :   optimized search of the median of 3 pixel values
-    Notice   :   found on sci.image.processing
-    cannot go faster unless assumptions are made
-    on the nature of the input signal.
-    ---------------------------------------------------------------------------*/
-    template <class pixelvalue>
-    inline pixelvalue opt_med3(pixelvalue * p)
-    {
-        PIX_SORT(p[0], p[1]);
-        PIX_SORT(p[1], p[2]);
-        PIX_SORT(p[0], p[1]);
-        return p[1];
-    }
-
-    /*
-    ** opt_med4()
-    hacked version
-    **/
-    template <class pixelvalue>
-    inline pixelvalue opt_med4(pixelvalue * p)
-    {
-        PIX_SORT(p[0], p[1]);
-        PIX_SORT(p[2], p[3]);
-        PIX_SORT(p[0], p[2]);
-        PIX_SORT(p[1], p[3]);
-        return PIX_MIN(p[1], p[2]);
-    }
-
-    /*----------------------------------------------------------------------------
-    Function :   opt_med5()
-    In       :   pointer to array of 5 pixel values
-    Out      :   a pixelvalue
-    Job      :   optimized search of the median of 5 pixel values
-    Notice   :   found on sci.image.processing
-    cannot go faster unless assumptions are made
-    on the nature of the input signal.
-    ---------------------------------------------------------------------------*/
-    template <class pixelvalue>
-    inline pixelvalue opt_med5(pixelvalue * p)
-    {
-        PIX_SORT(p[0], p[1]);
-        PIX_SORT(p[3], p[4]);
-        p[3] = PIX_MAX(p[0], p[3]);
-        p[1] = PIX_MIN(p[1], p[4]);
-        PIX_SORT(p[1], p[2]);
-        p[2] = PIX_MIN(p[2], p[3]);
-        return PIX_MAX(p[1], p[2]);
-    }
-
-    /*----------------------------------------------------------------------------
-    Function :   opt_med6()
-    In       :   pointer to array of 6 pixel values
-    Out      :   a pixelvalue
-    Job      :   optimized search of the median of 6 pixel values
-    Notice   :   from Christoph_John@gmx.de
-    based on a selection network which was proposed in
-    "FAST, EFFICIENT MEDIAN FILTERS WITH EVEN LENGTH WINDOWS"
-    J.P. HAVLICEK, K.A. SAKADY, G.R.KATZ
-    If you need larger even length kernels check the paper
-    ---------------------------------------------------------------------------*/
-    template <class pixelvalue>
-    inline pixelvalue opt_med6(pixelvalue * p)
-    {
-        PIX_SORT(p[1], p[2]);
-        PIX_SORT(p[3], p[4]);
-        PIX_SORT(p[0], p[1]);
-        PIX_SORT(p[2], p[3]);
-        PIX_SORT(p[4], p[5]);
-        PIX_SORT(p[1], p[2]);
-        PIX_SORT(p[3], p[4]);
-        PIX_SORT(p[0], p[1]);
-        PIX_SORT(p[2], p[3]);
-        p[4] = PIX_MIN(p[4], p[5]);
-        p[2] = PIX_MAX(p[1], p[2]);
-        p[3] = PIX_MIN(p[3], p[4]);
-        return PIX_MIN(p[2], p[3]);
-    }
-
-    /*----------------------------------------------------------------------------
-    Function :   opt_med7()
-    In       :   pointer to array of 7 pixel values
-    Out      :   a pixelvalue
-    Job      :   optimized search of the median of 7 pixel values
-    Notice   :   found on sci.image.processing
-    cannot go faster unless assumptions are made
-    on the nature of the input signal.
-    ---------------------------------------------------------------------------*/
-    template <class pixelvalue>
-    inline pixelvalue opt_med7(pixelvalue * p)
-    {
-        PIX_SORT(p[0], p[5]);
-        PIX_SORT(p[0], p[3]);
-        PIX_SORT(p[1], p[6]);
-        PIX_SORT(p[2], p[4]);
-        PIX_SORT(p[0], p[1]);
-        PIX_SORT(p[3], p[5]);
-        PIX_SORT(p[2], p[6]);
-        p[3] = PIX_MAX(p[2], p[3]);
-        p[3] = PIX_MIN(p[3], p[6]);
-        p[4] = PIX_MIN(p[4], p[5]);
-        PIX_SORT(p[1], p[4]);
-        p[3] = PIX_MAX(p[1], p[3]);
-        return PIX_MIN(p[3], p[4]);
-    }
-
-    /*----------------------------------------------------------------------------
-    Function :   opt_med9()
-    Hacked version of opt_med9()
-    */
-    template <class pixelvalue>
-    inline pixelvalue opt_med8(pixelvalue * p)
-    {
-        PIX_SORT(p[0], p[1]);
-        PIX_SORT(p[3], p[4]);
-        PIX_SORT(p[6], p[7]);
-        PIX_SORT(p[2], p[3]);
-        PIX_SORT(p[5], p[6]);
-        PIX_SORT(p[3], p[4]);
-        PIX_SORT(p[6], p[7]);
-        p[4] = PIX_MIN(p[4], p[7]);
-        PIX_SORT(p[3], p[6]);
-        p[5] = PIX_MAX(p[2], p[5]);
-        p[3] = PIX_MAX(p[0], p[3]);
-        p[1] = PIX_MIN(p[1], p[4]);
-        p[3] = PIX_MIN(p[3], p[6]);
-        PIX_SORT(p[3], p[1]);
-        p[3] = PIX_MAX(p[5], p[3]);
-        return PIX_MIN(p[3], p[1]);
-    }
-
-    /*----------------------------------------------------------------------------
-    Function :   opt_med9()
-    In       :   pointer to an array of 9 pixelvalues
-    Out      :   a pixelvalue
-    Job      :   optimized search of the median of 9 pixelvalues
-    Notice   :   in theory, cannot go faster without assumptions on the
-    signal.
-    Formula from:
-    XILINX XCELL magazine, vol. 23 by John L. Smith
-
-    The input array is modified in the process
-    The result array is guaranteed to contain the median
-    value
-    in middle position, but other elements are NOT sorted.
-    ---------------------------------------------------------------------------*/
-    template <class pixelvalue>
-    inline pixelvalue opt_med9(pixelvalue * p)
-    {
-        PIX_SORT(p[1], p[2]);
-        PIX_SORT(p[4], p[5]);
-        PIX_SORT(p[7], p[8]);
-        PIX_SORT(p[0], p[1]);
-        PIX_SORT(p[3], p[4]);
-        PIX_SORT(p[6], p[7]);
-        PIX_SORT(p[1], p[2]);
-        PIX_SORT(p[4], p[5]);
-        PIX_SORT(p[7], p[8]);
-        p[3] = PIX_MAX(p[0], p[3]);
-        p[5] = PIX_MIN(p[5], p[8]);
-        PIX_SORT(p[4], p[7]);
-        p[6] = PIX_MAX(p[3], p[6]);
-        p[4] = PIX_MAX(p[1], p[4]);
-        p[2] = PIX_MIN(p[2], p[5]);
-        p[4] = PIX_MIN(p[4], p[7]);
-        PIX_SORT(p[4], p[2]);
-        p[4] = PIX_MAX(p[6], p[4]);
-        return PIX_MIN(p[4], p[2]);
-    }
-
     const uint8_t decimation_min_val = 1;
     const uint8_t decimation_max_val = 8;    // Decimation levels according to the reference design
     const uint8_t decimation_default_val = 2;
@@ -357,87 +181,22 @@ namespace librealsense
     void decimation_filter::decimate_depth(const uint16_t * frame_data_in, uint16_t * frame_data_out,
         size_t width_in, size_t height_in, size_t scale)
     {
-        // Use median filtering
-        std::vector<uint16_t> working_kernel(_kernel_size);
-        auto wk_begin = working_kernel.data();
-        auto wk_itr = wk_begin;
-        std::vector<uint16_t*> pixel_raws(scale);
-        uint16_t* block_start = const_cast<uint16_t*>(frame_data_in);
-
         if (scale == 2 || scale == 3)
         {
-            for (int j = 0; j < _real_height; j++)
-            {
-                uint16_t *p{};
-                // Mark the beginning of each of the N lines that the filter will run upon
-                for (size_t i = 0; i < pixel_raws.size(); i++)
-                    pixel_raws[i] = block_start + (width_in*i);
-
-                for (size_t i = 0, chunk_offset = 0; i < _real_width; i++)
-                {
-                    wk_itr = wk_begin;
-                    // extract data the kernel to process
-                    for (size_t n = 0; n < scale; ++n)
-                    {
-                        p = pixel_raws[n] + chunk_offset;
-                        for (size_t m = 0; m < scale; ++m)
-                        {
-                            if (*(p + m))
-                                *wk_itr++ = *(p + m);
-                        }
-                    }
-
-                    // For even-size kernels pick the member one below the middle
-                    auto ks = (int)(wk_itr - wk_begin);
-                    if (ks == 0)
-                        *frame_data_out++ = 0;
-                    else
-                    {
-                        switch (ks)
-                        {
-                        case 1:
-                            *frame_data_out++ = working_kernel[0];
-                            break;
-                        case 2:
-                            *frame_data_out++ = PIX_MIN(working_kernel[0], working_kernel[1]);
-                            break;
-                        case 3:
-                            *frame_data_out++ = opt_med3<uint16_t>(working_kernel.data());
-                            break;
-                        case 4:
-                            *frame_data_out++ = opt_med4<uint16_t>(working_kernel.data());
-                            break;
-                        case 5:
-                            *frame_data_out++ = opt_med5<uint16_t>(working_kernel.data());
-                            break;
-                        case 6:
-                            *frame_data_out++ = opt_med6<uint16_t>(working_kernel.data());
-                            break;
-                        case 7:
-                            *frame_data_out++ = opt_med7<uint16_t>(working_kernel.data());
-                            break;
-                        case 8:
-                            *frame_data_out++ = opt_med8<uint16_t>(working_kernel.data());
-                            break;
-                        case 9:
-                            *frame_data_out++ = opt_med9<uint16_t>(working_kernel.data());
-                            break;
-                        }
-                    }
-
-                    chunk_offset += scale;
-                }
-
-                // Fill-in the padded colums with zeros
-                for (int j = _real_width; j < _padded_width; j++)
-                    *frame_data_out++ = 0;
-
-                // Skip N lines to the beginnig of the next processing segment
-                block_start += width_in * scale;
-            }
+#ifdef __SSSE3__
+            // Vectorized and multi-threaded, with the same results as decimate_depth_median
+            decimate_depth_median_sse(frame_data_in, frame_data_out, width_in, _real_width, _real_height, _padded_width, scale);
+#else
+            // Use median filtering
+            decimate_depth_median(frame_data_in, frame_data_out, width_in, _real_width, _real_height, _padded_width, scale);
+#endif
+            frame_data_out += _real_height * _padded_width;
         }
         else
         {
+            std::vector<uint16_t*> pixel_raws(scale);
+            uint16_t* block_start = const_cast<uint16_t*>(frame_data_in);
+
             for (int j = 0; j < _real_height; j++)
             {
                 uint16_t *p{};
@@ -485,314 +244,142 @@ namespace librealsense
         }
     }
 
-    void decimation_filter::decimate_others(rs2_format format, const void * frame_data_in, void * frame_data_out,
-        size_t width_in, size_t height_in, size_t scale)
+    // Averages the patches of one output row from the column sums of its input rows.
+    // sum / patch_size is computed as (sum * reciprocal) >> 32, which is exact for the sums of up to 64 bytes
+    static void average_row(rs2_format format, const uint16_t* sums, uint8_t* q,
+        size_t real_width, size_t scale, uint64_t reciprocal)
     {
+        auto average = [reciprocal](int sum) { return (uint8_t)((sum * reciprocal) >> 32); };
+        const uint16_t* p = nullptr;
         int sum = 0;
-        auto patch_size = scale * scale;
 
         switch (format)
         {
         case RS2_FORMAT_YUYV:
+        case RS2_FORMAT_UYVY:
         {
-            uint8_t* from = (uint8_t*)frame_data_in;
-            uint8_t* p = nullptr;
-            uint8_t* q = (uint8_t*)frame_data_out;
-
-            auto w_2 = width_in >> 1;
-            auto rw_2 = _real_width >> 1;
-            auto pw_2 = _padded_width >> 1;
+            // Luma at offsets 0 and 2 of the YUYV macro pixels, and 1 and 3 of the UYVY ones
+            const int luma = (format == RS2_FORMAT_YUYV) ? 0 : 1;
+            const int chroma = 1 - luma;
+            auto rw_2 = real_width >> 1;
             auto s2 = scale >> 1;
             bool odd = (scale & 1);
-            for (int j = 0; j < _real_height; ++j)
-            {
-                for (int i = 0; i < rw_2; ++i)
-                {
-                    p = from + scale * (j * w_2 + i) * 4;
-                    sum = 0;
-                    for (int n = 0; n < scale; ++n)
-                    {
-                        for (int m = 0; m < scale; ++m)
-                            sum += p[m * 2];
 
-                        p += w_2 * 4;
-                    }
-                    *q++ = (uint8_t)(sum / patch_size);
-
-                    p = from + scale * (j * w_2 + i) * 4 + 1;
-                    sum = 0;
-                    for (int n = 0; n < scale; ++n)
-                    {
-                        for (int m = 0; m < s2; ++m)
-                            sum += 2 * p[m * 4];
-
-                        if (odd)
-                            sum += p[s2 * 4];
-
-                        p += w_2 * 4;
-                    }
-                    *q++ = (uint8_t)(sum / patch_size);
-
-                    p = from + scale * (j * w_2 + i) * 4 + s2 * 4 + (odd ? 2 : 0);
-                    sum = 0;
-                    for (int n = 0; n < scale; ++n)
-                    {
-                        for (int m = 0; m < scale; ++m)
-                            sum += p[m * 2];
-
-                        p += w_2 * 4;
-                    }
-                    *q++ = (uint8_t)(sum / patch_size);
-
-                    p = from + scale * (j * w_2 + i) * 4 + 3;
-                    sum = 0;
-                    for (int n = 0; n < scale; ++n)
-                    {
-                        for (int m = 0; m < s2; ++m)
-                            sum += 2 * p[m * 4];
-
-                        if (odd)
-                            sum += p[s2 * 4];
-
-                        p += w_2 * 4;
-                    }
-                    *q++ = (uint8_t)(sum / patch_size);
-                }
-
-                for (int i = rw_2; i < pw_2; ++i)
-                {
-                    *q++ = 0;
-                    *q++ = 0;
-                    *q++ = 0;
-                    *q++ = 0;
-                }
-            }
-
-            for (int j = _real_height; j < _padded_height; ++j)
+            for (size_t i = 0; i < rw_2; ++i)
             {
-                for (int i = 0; i < _padded_width; ++i)
-                {
-                    *q++ = 0;
-                    *q++ = 0;
-                }
-            }
-        }
-        break;
-
-        case RS2_FORMAT_UYVY:
-        {
-            uint8_t* from = (uint8_t*)frame_data_in;
-            uint8_t* p = nullptr;
-            uint8_t* q = (uint8_t*)frame_data_out;
+                auto base = sums + scale * i * 4;
+                uint8_t pixel[4];
 
-            auto w_2 = width_in >> 1;
-            auto rw_2 = _real_width >> 1;
-            auto pw_2 = _padded_width >> 1;
-            auto s2 = scale >> 1;
-            bool odd = (scale & 1);
-            for (int j = 0; j < _real_height; ++j)
-            {
-                for (int i = 0; i < rw_2; ++i)
+                for (int k = 0; k < 2; ++k)
                 {
-                    p = from + scale * (j * w_2 + i) * 4;
-                    sum = 0;
-                    for (int n = 0; n < scale; ++n)
-                    {
-                        for (int m = 0; m < s2; ++m)
-                            sum += 2 * p[m * 4];
-
-                        if (odd)
-                            sum += p[s2 * 4];
-
-                        p += w_2 * 4;
-                    }
-                    *q++ = (uint8_t)(sum / patch_size);
-
-                    p = from + scale * (j * w_2 + i) * 4 + 1;
-                    sum = 0;
-                    for (int n = 0; n < scale; ++n)
-                    {
-                        for (int m = 0; m < scale; ++m)
-                            sum += p[m * 2];
-
-                        p += w_2 * 4;
-                    }
-                    *q++ = (uint8_t)(sum / patch_size);
-
-                    p = from + scale * (j * w_2 + i) * 4 + 2;
+                    // Luma of the first and of the second pixel
+                    p = base + luma + (k ? s2 * 4 + (odd ? 2 : 0) : 0);
                     sum = 0;
-                    for (int n = 0; n < scale; ++n)
-                    {
-                        for (int m = 0; m < s2; ++m)
-                            sum += 2 * p[m * 4];
-
-                        if (odd)
-                            sum += p[s2 * 4];
+                    for (size_t m = 0; m < scale; ++m)
+                        sum += p[m * 2];
+                    pixel[luma + 2 * k] = average(sum);
 
-                        p += w_2 * 4;
-                    }
-                    *q++ = (uint8_t)(sum / patch_size);
-
-                    p = from + scale * (j * w_2 + i) * 4 + s2 * 4 + (odd ? 3 : 1);
+                    // Chroma, shared by the pixels of the macro pixels
+                    p = base + chroma + 2 * k;
                     sum = 0;
-                    for (int n = 0; n < scale; ++n)
-                    {
-                        for (int m = 0; m < scale; ++m)
-                            sum += p[m * 2];
-
-                        p += w_2 * 4;
-                    }
-                    *q++ = (uint8_t)(sum / patch_size);
+                    for (size_t m = 0; m < s2; ++m)
+                        sum += 2 * p[m * 4];
+                    if (odd)
+                        sum += p[s2 * 4];
+                    pixel[chroma + 2 * k] = average(sum);
                 }
 
-                for (int i = rw_2; i < pw_2; ++i)
-                {
-                    *q++ = 0;
-                    *q++ = 0;
-                    *q++ = 0;
-                    *q++ = 0;
-                }
-            }
-
-            for (int j = _real_height; j < _padded_height; ++j)
-            {
-                for (int i = 0; i < _padded_width; ++i)
-                {
-                    *q++ = 0;
-                    *q++ = 0;
-                }
+                for (int k = 0; k < 4; ++k)
+                    *q++ = pixel[k];
             }
         }
         break;
 
         case RS2_FORMAT_RGB8:
         case RS2_FORMAT_BGR8:
-        {
-            uint8_t* from = (uint8_t*)frame_data_in;
-            uint8_t* p = nullptr;
-            uint8_t* q = (uint8_t*)frame_data_out;;
-
-            for (int j = 0; j < _real_height; ++j)
-            {
-                for (int i = 0; i < _real_width; ++i)
-                {
-                    for (int k = 0; k < 3; ++k)
-                    {
-                        p = from + scale * (j * width_in + i) * 3 + k;
-                        sum = 0;
-                        for (int n = 0; n < scale; ++n)
-                        {
-                            for (int m = 0; m < scale; ++m)
-                                sum += p[m * 3];
-
-                            p += width_in * 3;
-                        }
-
-                        *q++ = (uint8_t)(sum / patch_size);
-                    }
-                }
-
-                for (int i = _real_width; i < _padded_width; ++i)
-                {
-                    *q++ = 0;
-                    *q++ = 0;
-                    *q++ = 0;
-                }
-            }
-
-            for (int j = _real_height; j < _padded_height; ++j)
-            {
-                for (int i = 0; i < _padded_width; ++i)
-                {
-                    *q++ = 0;
-                    *q++ = 0;
-                    *q++ = 0;
-                }
-            }
-        }
-        break;
-
         case RS2_FORMAT_RGBA8:
         case RS2_FORMAT_BGRA8:
+        case RS2_FORMAT_Y8:
         {
-            uint8_t* from = (uint8_t*)frame_data_in;
-            uint8_t* p = nullptr;
-            uint8_t* q = (uint8_t*)frame_data_out;
+            const size_t channels = (format == RS2_FORMAT_Y8) ? 1 :
+                (format == RS2_FORMAT_RGB8 || format == RS2_FORMAT_BGR8) ? 3 : 4;
 
-            for (int j = 0; j < _real_height; ++j)
+            for (size_t i = 0; i < real_width; ++i)
             {
-                for (int i = 0; i < _real_width; ++i)
-                {
-                    for (int k = 0; k < 4; ++k)
-                    {
-                        p = from + scale * (j * width_in + i) * 4 + k;
-                        sum = 0;
-                        for (int n = 0; n < scale; ++n)
-                        {
-                            for (int m = 0; m < scale; ++m)
-                                sum += p[m * 4];
-
-                            p += width_in * 4;
-                        }
-
-                        *q++ = (uint8_t)(sum / patch_size);
-                    }
-                }
-
-                for (int i = _real_width; i < _padded_width; ++i)
+                for (size_t k = 0; k < channels; ++k)
                 {
-                    *q++ = 0;
-                    *q++ = 0;
-                    *q++ = 0;
-                    *q++ = 0;
-                }
-            }
+                    p = sums + scale * i * channels + k;
+                    sum = 0;
+                    for (size_t m = 0; m < scale; ++m)
+                        sum += p[m * channels];
 
-            for (int j = _real_height; j < _padded_height; ++j)
-            {
-                for (int i = 0; i < _padded_width; ++i)
-                {
-                    *q++ = 0;
-                    *q++ = 0;
-                    *q++ = 0;
-                    *q++ = 0;
+                    *q++ = average(sum);
                 }
             }
         }
         break;
 
+        default:
+            break;
+        }
+    }
+
+    void decimation_filter::decimate_others(rs2_format format, const void * frame_data_in, void * frame_data_out,
+        size_t width_in, size_t height_in, size_t scale)
+    {
+        int sum = 0;
+        auto patch_size = scale * scale;
+
+        switch (format)
+        {
+        case RS2_FORMAT_YUYV:
+        case RS2_FORMAT_UYVY:
+        case RS2_FORMAT_RGB8:
+        case RS2_FORMAT_BGR8:
+        case RS2_FORMAT_RGBA8:
+        case RS2_FORMAT_BGRA8:
         case RS2_FORMAT_Y8:
         {
-            uint8_t* from = (uint8_t*)frame_data_in;
-            uint8_t* p = nullptr;
-            uint8_t* q = (uint8_t*)frame_data_out;
-
-            for (int j = 0; j < _real_height; ++j)
+            // The input rows of every output row are summed first, 16 bytes at a time, so that the patches are
+            // then summed along the row only. The output rows are independent and are distributed between threads
+            const size_t bpp = (format == RS2_FORMAT_Y8) ? 1 :
+                (format == RS2_FORMAT_YUYV || format == RS2_FORMAT_UYVY) ? 2 :
+                (format == RS2_FORMAT_RGB8 || format == RS2_FORMAT_BGR8) ? 3 : 4;
+            // YUYV and UYVY rows are made of whole macro pixels
+            const size_t stride_in = (bpp == 2) ? (width_in >> 1) * 4 : width_in * bpp;
+            const size_t stride_out = _padded_width * bpp;
+            const size_t row_length = _real_width * scale * bpp;
+            // The odd last pixel of YUYV and UYVY rows has no macro pixel of its own and is left out
+            const size_t real_length = (bpp == 2) ? (_real_width >> 1) * 4 : _real_width * bpp;
+            const uint64_t reciprocal = ((uint64_t(1) << 32) + patch_size - 1) / patch_size;
+            const int real_height = _real_height;
+            const size_t real_width = _real_width;
+
+            const uint8_t* from = (const uint8_t*)frame_data_in;
+            uint8_t* to = (uint8_t*)frame_data_out;
+
+#pragma omp parallel
             {
-                for (int i = 0; i < _real_width; ++i)
-                {
-                    p = from + scale * (j * width_in + i);
-                    sum = 0;
-                    for (int n = 0; n < scale; ++n)
-                    {
-                        for (int m = 0; m < scale; ++m)
-                            sum += p[m];
+                std::vector<uint16_t> sums(row_length);
 
-                        p += width_in;
-                    }
-
-                    *q++ = (uint8_t)(sum / patch_size);
+#pragma omp for
+                for (int j = 0; j < real_height; ++j)
+                {
+                    uint8_t* q = to + j * stride_out;
+#ifdef __SSSE3__
+                    sum_rows_sse(from + j * scale * stride_in, stride_in, scale, row_length, sums.data());
+#else
+                    sum_rows(from + j * scale * stride_in, stride_in, scale, row_length, sums.data());
+#endif
+                    average_row(format, sums.data(), q, real_width, scale, reciprocal);
+
+                    // Fill-in the padded colums with zeros
+                    std::fill(q + real_length, q + stride_out, 0);
                 }
-
-                for (int i = _real_width; i < _padded_width; ++i)
-                    *q++ = 0;
             }
 
-            for (int j = _real_height; j < _padded_height; ++j)
-            {
-                for (int i = 0; i < _padded_width; ++i)
-                    *q++ = 0;
-            }
+            // Fill-in the padded rows with zeros
+            std::fill(to + _real_height * stride_out, to + _padded_height * stride_out, 0);
         }
         break;
 
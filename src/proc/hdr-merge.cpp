@@ -2,13 +2,18 @@
 // Copyright(c) 2020 Intel Corporation. All Rights Reserved.
 
 #include "hdr-merge.h"
+#include "latency-trace.h"
+#ifdef __SSSE3__
+#include "sse/sse-hdr-merge.h"
+#endif
 
 namespace librealsense
 {
     hdr_merge::hdr_merge()
         : generic_processing_block("HDR Merge"),
         _previous_depth_frame_counter(0),
-        _frames_without_requested_metadata_counter(0)
+        _frames_without_requested_metadata_counter(0),
+        _sequence_size(0)
     {}
 
     // processing only framesets
@@ -42,7 +47,7 @@ namespace librealsense
         }
 
         auto depth_seq_size = depth_frame.get_frame_metadata(RS2_FRAME_METADATA_SEQUENCE_SIZE);
-        if (depth_seq_size != 2)
+        if (depth_seq_size < 2)
             return false;
 
         return true;
@@ -64,8 +69,8 @@ namespace librealsense
         // steps:
         // 1. get depth frame from incoming frameset
         // 2. add the frameset to vector of framesets
-        // 3. check if size of this vector is at least 2 (if not - return latest merge frame)
-        // 4. pop out both framesets from the vector
+        // 3. check if the whole sequence was received (if not - return latest merge frame)
+        // 4. pop out all the framesets from the vector
         // 5. apply merge algo
         // 6. save merge frame as latest merge frame
         // 7. return the merge frame
@@ -75,40 +80,47 @@ namespace librealsense
         auto depth_frame = fs.get_depth_frame();
 
         // 2. add the frameset to vector of framesets
+        auto depth_seq_size = static_cast<size_t>(depth_frame.get_frame_metadata(RS2_FRAME_METADATA_SEQUENCE_SIZE));
         auto depth_seq_id = depth_frame.get_frame_metadata(RS2_FRAME_METADATA_SEQUENCE_ID);
 
+        // a new sequence size, or the first frame of a sequence, restarts the sequence
+        // so that frames missing in the previous sequence do not delay the next merge
+        if (depth_seq_size != _sequence_size || depth_seq_id == 0)
+        {
+            _framesets.clear();
+            _sequence_size = depth_seq_size;
+        }
+
         // condition added to ensure that frames are saved in the right order
         // to prevent for example the saving of frame with sequence id 1 before
         // saving frame of sequence id 0
-        // so that the merging with be deterministic - always done with frame n and n+1
+        // so that the merging with be deterministic - always done with frames n to n+N-1
         // with frame n as basis
         if (_framesets.size() == depth_seq_id)
         {
-            _framesets[(int)depth_seq_id] = fs;
+            _framesets.push_back(fs);
         }
 
         // discard merged frame if not relevant
         discard_depth_merged_frame_if_needed(f);
 
-        // 3. check if size of this vector is at least 2 (if not - return latest merge frame)
-        if (_framesets.size() >= 2)
+        // 3. check if the whole sequence was received (if not - return latest merge frame)
+        if (_framesets.size() >= _sequence_size)
         {
-            // 4. pop out both framesets from the vector
-            rs2::frameset fs_0 = _framesets[0];
-            rs2::frameset fs_1 = _framesets[1];
-            _framesets.clear();
-
             bool use_ir = false;
-            if (check_frames_mergeability(fs_0, fs_1, use_ir))
+            if (check_frames_mergeability(_framesets, use_ir))
             {
                 // 5. apply merge algo
-                rs2::frame new_frame = merging_algorithm(source, fs_0, fs_1, use_ir);
+                rs2::frame new_frame = merging_algorithm(source, _framesets, use_ir);
                 if (new_frame)
                 {
                     // 6. save merge frame as latest merge frame
                     _depth_merged_frame = new_frame;
                 }
             }
+
+            // 4. pop out all the framesets from the vector, keeping its storage
+            _framesets.clear();
         }
 
         // 7. return the merge frame
@@ -142,42 +154,44 @@ namespace librealsense
         }
     }
 
-    bool hdr_merge::check_frames_mergeability(const rs2::frameset first_fs, const rs2::frameset second_fs,
-        bool& use_ir) const
+    bool hdr_merge::check_frames_mergeability(const std::vector<rs2::frameset>& framesets, bool& use_ir) const
     {
-        auto first_depth = first_fs.get_depth_frame();
-        auto second_depth = second_fs.get_depth_frame();
-        auto first_ir = first_fs.get_infrared_frame();
-        auto second_ir = second_fs.get_infrared_frame();
-
-        auto first_fs_frame_counter = first_depth.get_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER);
-        auto second_fs_frame_counter = second_depth.get_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER);
+        auto first_depth = framesets[0].get_depth_frame();
+        auto previous_frame_counter = first_depth.get_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER);
 
-        // The aim of this checking is that the output merged frame will have frame counter n and
-        // frame counter n and will be created by frames n and n+1
-        if (first_fs_frame_counter + 1 != second_fs_frame_counter)
-            return false;
-        // Depth dimensions must align
-        if ((first_depth.get_height() != second_depth.get_height()) ||
-            (first_depth.get_width() != second_depth.get_width()))
-            return false;
+        for (size_t i = 1; i < framesets.size(); i++)
+        {
+            auto depth = framesets[i].get_depth_frame();
+            auto frame_counter = depth.get_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER);
+
+            // The aim of this checking is that the output merged frame will have frame counter n and
+            // will be created by frames n to n+N-1
+            if (previous_frame_counter + 1 != frame_counter)
+                return false;
+            previous_frame_counter = frame_counter;
+
+            // Depth dimensions must align
+            if ((first_depth.get_height() != depth.get_height()) ||
+                (first_depth.get_width() != depth.get_width()))
+                return false;
+        }
 
-        use_ir = should_ir_be_used_for_merging(first_depth, first_ir, second_depth, second_ir);
+        use_ir = should_ir_be_used_for_merging(framesets);
 
         return true;
     }
 
-    rs2::frame hdr_merge::merging_algorithm(const rs2::frame_source& source, const rs2::frameset first_fs, const rs2::frameset second_fs, const bool use_ir) const
+    rs2::frame hdr_merge::merging_algorithm(const rs2::frame_source& source, const std::vector<rs2::frameset>& framesets, const bool use_ir)
     {
-        auto first = first_fs;
-        auto second = second_fs;
+        auto first_depth = framesets[0].get_depth_frame();
+        auto first_ir = framesets[0].get_infrared_frame();
 
-        auto first_depth = first.get_depth_frame();
-        auto second_depth = second.get_depth_frame();
-        auto first_ir = first.get_infrared_frame();
-        auto second_ir = second.get_infrared_frame();
+        // the merge is recorded in the latency trace as a stage of the first depth frame
+        auto first_interface = (librealsense::frame_interface*)first_depth.get();
+        trace_scope merge_stage("HDR Merge: merge", first_interface->get_trace_span());
+        auto started = std::chrono::steady_clock::now();
 
-        // new frame allocation
+        // new frame allocation, the frame buffers are recycled by the frame archive
         auto vf = first_depth.as<rs2::depth_frame>();
         auto width = vf.get_width();
         auto height = vf.get_height();
@@ -187,111 +201,121 @@ namespace librealsense
         if (new_f)
         {
             auto ptr = dynamic_cast<librealsense::depth_frame*>((librealsense::frame_interface*)new_f.get());
-            auto orig = dynamic_cast<librealsense::depth_frame*>((librealsense::frame_interface*)first_depth.get());
+            auto orig = dynamic_cast<librealsense::depth_frame*>(first_interface);
 
-            auto d0 = (uint16_t*)first_depth.get_data();
-            auto d1 = (uint16_t*)second_depth.get_data();
+            _depth_planes.clear();
+            for (auto&& fs : framesets)
+                _depth_planes.push_back((const uint16_t*)fs.get_depth_frame().get_data());
 
             auto new_data = (uint16_t*)ptr->get_frame_data();
 
             ptr->set_sensor(orig->get_sensor());
 
-            memset(new_data, 0, width * height * sizeof(uint16_t));
-
+            // every pixel of the merged frame is written by the merge
             int width_height_product = width * height;
 
-            if (use_ir)
+            if (use_ir && (first_ir.get_profile().format() == RS2_FORMAT_Y8 || first_ir.get_profile().format() == RS2_FORMAT_Y16))
             {
-                if (first_ir.get_profile().format() == RS2_FORMAT_Y8)
-                {
-                    merge_frames_using_ir<uint8_t>(new_data, d0, d1, first_ir, second_ir, width_height_product);
-                }
-                else if (first_ir.get_profile().format() == RS2_FORMAT_Y16)
-                {
-                    merge_frames_using_ir<uint16_t>(new_data, d0, d1, first_ir, second_ir, width_height_product);
-                }
-                else
-                {
-                    merge_frames_using_only_depth(new_data, d0, d1, width_height_product);
-                }
+                merge_frames_using_ir(new_data, framesets, width_height_product);
             }
             else
             {
-                merge_frames_using_only_depth(new_data, d0, d1, width_height_product);
+                merge_frames_using_only_depth(new_data, width_height_product);
             }
 
+            LOG_DEBUG("HDR Merge of " << framesets.size() << " frames" << (use_ir ? " using infrared" : "") << " took "
+                << std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - started).count() << " us");
+
             return new_f;
         }
-        return first_fs;
+        return framesets[0];
     }
 
-    void hdr_merge::merge_frames_using_only_depth(uint16_t* new_data, uint16_t* d0, uint16_t* d1, int width_height_prod) const
+    void hdr_merge::merge_frames_using_ir(uint16_t* new_data, const std::vector<rs2::frameset>& framesets, int width_height_prod)
     {
-        for (int i = 0; i < width_height_prod; i++)
+        auto format = framesets[0].get_infrared_frame().get_profile().format();
+        if (format == RS2_FORMAT_Y8)
         {
-            if (d0[i])
-                new_data[i] = d0[i];
-            else if (d1[i])
-                new_data[i] = d1[i];
-            else
-                new_data[i] = 0;
+            _ir_y8_planes.clear();
+            for (auto&& fs : framesets)
+                _ir_y8_planes.push_back((const uint8_t*)fs.get_infrared_frame().get_data());
+#ifdef __SSSE3__
+            merge_depth_with_ir_sse(new_data, _depth_planes.data(), _ir_y8_planes.data(), _depth_planes.size(), width_height_prod,
+                IR_UNDER_SATURATED_VALUE_Y8, IR_OVER_SATURATED_VALUE_Y8);
+#else
+            merge_frames_using_ir<uint8_t>(new_data, _ir_y8_planes.data(), format, width_height_prod);
+#endif
+        }
+        else
+        {
+            _ir_y16_planes.clear();
+            for (auto&& fs : framesets)
+                _ir_y16_planes.push_back((const uint16_t*)fs.get_infrared_frame().get_data());
+#ifdef __SSSE3__
+            merge_depth_with_ir_sse(new_data, _depth_planes.data(), _ir_y16_planes.data(), _depth_planes.size(), width_height_prod,
+                IR_UNDER_SATURATED_VALUE_Y16, IR_OVER_SATURATED_VALUE_Y16);
+#else
+            merge_frames_using_ir<uint16_t>(new_data, _ir_y16_planes.data(), format, width_height_prod);
+#endif
         }
     }
 
-    bool hdr_merge::should_ir_be_used_for_merging(const rs2::depth_frame& first_depth, const rs2::video_frame& first_ir,
-        const rs2::depth_frame& second_depth, const rs2::video_frame& second_ir) const
+    void hdr_merge::merge_frames_using_only_depth(uint16_t* new_data, int width_height_prod) const
     {
-        // checking ir frames are not null
-        bool use_ir = (first_ir && second_ir);
-
-        if (use_ir)
+#ifdef __SSSE3__
+        merge_depth_sse(new_data, _depth_planes.data(), _depth_planes.size(), width_height_prod);
+#else
+        for (int i = 0; i < width_height_prod; i++)
         {
-            // IR and Depth dimensions must be aligned
-            if ((first_depth.get_height() != first_ir.get_height()) ||
-                (first_depth.get_width() != first_ir.get_width()) ||
-                (second_ir.get_height() != first_ir.get_height()) ||
-                (second_ir.get_width() != first_ir.get_width()))
-                use_ir = false;
+            new_data[i] = 0;
+            for (auto&& depth : _depth_planes)
+            {
+                if (depth[i])
+                {
+                    new_data[i] = depth[i];
+                    break;
+                }
+            }
         }
+#endif
+    }
 
-        // checking frame counter of first depth and ir are the same
-        if (use_ir)
+    bool hdr_merge::should_ir_be_used_for_merging(const std::vector<rs2::frameset>& framesets) const
+    {
+        auto first_depth = framesets[0].get_depth_frame();
+        auto first_ir = framesets[0].get_infrared_frame();
+
+        for (auto&& fs : framesets)
         {
-            int depth_frame_counter = static_cast<int>(first_depth.get_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER));
-            int ir_frame_counter = static_cast<int>(first_ir.get_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER));
-            use_ir = (depth_frame_counter == ir_frame_counter);
+            auto depth = fs.get_depth_frame();
+            auto ir = fs.get_infrared_frame();
 
-            // checking frame counter of second depth and ir are the same
-            if (use_ir)
-            {
-                depth_frame_counter = static_cast<int>(second_depth.get_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER));
-                ir_frame_counter = static_cast<int>(second_ir.get_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER));
-                use_ir = (depth_frame_counter == ir_frame_counter);
+            // checking ir frames are not null
+            if (!ir)
+                return false;
 
-                // checking sequence id of first depth and ir are the same
-                if (use_ir)
-                {
-                    auto depth_seq_id = first_depth.get_frame_metadata(RS2_FRAME_METADATA_SEQUENCE_ID);
-                    auto ir_seq_id = first_ir.get_frame_metadata(RS2_FRAME_METADATA_SEQUENCE_ID);
-                    use_ir = (depth_seq_id == ir_seq_id);
-
-                    // checking sequence id of second depth and ir are the same
-                    if (use_ir)
-                    {
-                        depth_seq_id = second_depth.get_frame_metadata(RS2_FRAME_METADATA_SEQUENCE_ID);
-                        ir_seq_id = second_ir.get_frame_metadata(RS2_FRAME_METADATA_SEQUENCE_ID);
-                        use_ir = (depth_seq_id == ir_seq_id);
-
-                        // checking both ir have the same format
-                        if (use_ir)
-                        {
-                            use_ir = (first_ir.get_profile().format() == second_ir.get_profile().format());
-                        }
-                    }
-                }
-            }
+            // IR and Depth dimensions must be aligned
+            if ((first_depth.get_height() != ir.get_height()) ||
+                (first_depth.get_width() != ir.get_width()))
+                return false;
+
+            // checking frame counter of depth and ir are the same
+            int depth_frame_counter = static_cast<int>(depth.get_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER));
+            int ir_frame_counter = static_cast<int>(ir.get_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER));
+            if (depth_frame_counter != ir_frame_counter)
+                return false;
+
+            // checking sequence id of depth and ir are the same
+            auto depth_seq_id = depth.get_frame_metadata(RS2_FRAME_METADATA_SEQUENCE_ID);
+            auto ir_seq_id = ir.get_frame_metadata(RS2_FRAME_METADATA_SEQUENCE_ID);
+            if (depth_seq_id != ir_seq_id)
+                return false;
+
+            // checking all ir have the same format
+            if (first_ir.get_profile().format() != ir.get_profile().format())
+                return false;
         }
 
-        return use_ir;
+        return true;
     }
 }
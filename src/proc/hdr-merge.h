@@ -32,42 +32,45 @@ namespace librealsense
         void reset_warning_counter_on_pipe_restart(const rs2::depth_frame& depth_frame);
         void discard_depth_merged_frame_if_needed(const rs2::frame& f);
 
-        bool check_frames_mergeability(const rs2::frameset first_fs, const rs2::frameset second_fs, bool& use_ir) const;
-        bool should_ir_be_used_for_merging(const rs2::depth_frame& first_depth, const rs2::video_frame& first_ir,
-            const rs2::depth_frame& second_depth, const rs2::video_frame& second_ir) const;
-        rs2::frame merging_algorithm(const rs2::frame_source& source, const rs2::frameset first_fs,
-            const rs2::frameset second_fs, const bool use_ir) const;
+        bool check_frames_mergeability(const std::vector<rs2::frameset>& framesets, bool& use_ir) const;
+        bool should_ir_be_used_for_merging(const std::vector<rs2::frameset>& framesets) const;
+        rs2::frame merging_algorithm(const rs2::frame_source& source, const std::vector<rs2::frameset>& framesets,
+            const bool use_ir);
         template <typename T>
         bool is_infrared_valid(T ir_value, rs2_format ir_format) const;
+        void merge_frames_using_ir(uint16_t* new_data, const std::vector<rs2::frameset>& framesets, int width_height_prod);
         template <typename T>
-        void merge_frames_using_ir(uint16_t* new_data, uint16_t* d0, uint16_t* d1,
-            const rs2::video_frame& first_ir, const rs2::video_frame& second_ir, int width_height_prod) const;
-        void merge_frames_using_only_depth(uint16_t* new_data, uint16_t* d0, uint16_t* d1, int width_height_prod) const;
+        void merge_frames_using_ir(uint16_t* new_data, const T* const ir[], rs2_format ir_format, int width_height_prod) const;
+        void merge_frames_using_only_depth(uint16_t* new_data, int width_height_prod) const;
 
         unsigned long long _previous_depth_frame_counter;
         int _frames_without_requested_metadata_counter;
-        std::map<int, rs2::frameset> _framesets;
+        size_t _sequence_size;
+        std::vector<rs2::frameset> _framesets; // the framesets of the current sequence, in sequence id order
+
+        // The planes of the framesets being merged, kept between merges to avoid allocations
+        std::vector<const uint16_t*> _depth_planes;
+        std::vector<const uint8_t*> _ir_y8_planes;
+        std::vector<const uint16_t*> _ir_y16_planes;
+
         rs2::frame _depth_merged_frame;
     };
     MAP_EXTENSION(RS2_EXTENSION_HDR_MERGE, librealsense::hdr_merge);
 
     template <typename T>
-    void hdr_merge::merge_frames_using_ir(uint16_t* new_data, uint16_t* d0, uint16_t* d1,
-        const rs2::video_frame& first_ir, const rs2::video_frame& second_ir, int width_height_prod) const
+    void hdr_merge::merge_frames_using_ir(uint16_t* new_data, const T* const ir[], rs2_format ir_format, int width_height_prod) const
     {
-        auto i0 = (T*)first_ir.get_data();
-        auto i1 = (T*)second_ir.get_data();
-
-        auto format = first_ir.get_profile().format();
-
         for (int i = 0; i < width_height_prod; i++)
         {
-            if (is_infrared_valid<T>(i0[i], format) && d0[i])
-                new_data[i] = d0[i];
-            else if (is_infrared_valid<T>(i1[i], format) && d1[i])
-                new_data[i] = d1[i];
-            else
-                new_data[i] = 0;
+            new_data[i] = 0;
+            for (size_t k = 0; k < _depth_planes.size(); k++)
+            {
+                if (is_infrared_valid<T>(ir[k][i], ir_format) && _depth_planes[k][i])
+                {
+                    new_data[i] = _depth_planes[k][i];
+                    break;
+                }
+            }
         }
     }
 
@@ -0,0 +1,66 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "processing-executor.h"
+#include "types.h"
+
+namespace librealsense
+{
+    static thread_local bool worker_thread = false;
+
+    bool processing_executor::is_worker_thread()
+    {
+        return worker_thread;
+    }
+
+    processing_executor::processing_executor(unsigned int threads_count)
+        : _state(std::make_shared<shared_state>())
+    {
+        if (!threads_count)
+            throw invalid_value_exception("processing executor requires at least one thread");
+
+        for (unsigned int i = 0; i < threads_count; i++)
+        {
+            auto state = _state;
+            _workers.emplace_back([state]()
+            {
+                worker_thread = true;
+                while (state->alive)
+                {
+                    std::function<void()> task;
+                    if (state->tasks.dequeue(&task, 100))
+                    {
+                        try
+                        {
+                            task();
+                        }
+                        catch (...)
+                        {
+                            LOG_ERROR("Exception was thrown by an asynchronous processing block task!");
+                        }
+                    }
+                }
+            });
+        }
+    }
+
+    processing_executor::~processing_executor()
+    {
+        _state->alive = false;
+        _state->tasks.clear();
+
+        for (auto&& worker : _workers)
+        {
+            // The last reference may be released by a task running on one of the workers
+            if (worker.get_id() == std::this_thread::get_id())
+                worker.detach();
+            else if (worker.joinable())
+                worker.join();
+        }
+    }
+
+    void processing_executor::post(std::function<void()> task)
+    {
+        _state->tasks.blocking_enqueue(std::move(task));
+    }
+}
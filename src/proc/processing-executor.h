@@ -0,0 +1,47 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "concurrency.h"
+#include <vector>
+
+namespace librealsense
+{
+    // Pool of worker threads running asynchronous processing blocks.
+    // A block posts at most one task at a time, which processes all the frames waiting for it,
+    // so frames of the same block keep their order while different blocks run concurrently
+    class processing_executor
+    {
+    public:
+        explicit processing_executor(unsigned int threads_count);
+        ~processing_executor();
+
+        processing_executor(const processing_executor&) = delete;
+        processing_executor& operator=(const processing_executor&) = delete;
+
+        void post(std::function<void()> task);
+
+        unsigned int get_threads_count() const { return static_cast<unsigned int>(_workers.size()); }
+
+        // True when called from a task running on any executor
+        static bool is_worker_thread();
+
+    private:
+        // Every attached block has at most one pending task, the capacity only bounds
+        // the number of blocks that can be ready at the same time
+        static const unsigned int MAX_PENDING_TASKS = 256;
+
+        // Shared with the workers, so that a worker detached by the destructor outlives the executor safely
+        struct shared_state
+        {
+            shared_state() : tasks(MAX_PENDING_TASKS), alive(true) {}
+
+            lockfree_queue<std::function<void()>> tasks;
+            std::atomic<bool> alive;
+        };
+
+        std::shared_ptr<shared_state> _state;
+        std::vector<std::thread> _workers;
+    };
+}
@@ -0,0 +1,451 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2017 Intel Corporation. All Rights Reserved.
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+#include "proc/spatial-filter-passes.h"
+
+namespace librealsense
+{
+    template <typename T>
+    static void recursive_filter_horizontal(void * image_data, size_t width, size_t height, float alpha, float deltaZ, uint8_t holes_filling_radius)
+    {
+        size_t v{}, u{};
+
+        // Handle conversions for invalid input data
+        bool fp = (std::is_floating_point<T>::value);
+
+        // Filtering integer values requires round-up to the nearest discrete value
+        const float round = fp ? 0.f : 0.5f;
+        // define invalid inputs
+        const T valid_threshold = fp ? static_cast<T>(std::numeric_limits<T>::epsilon()) : static_cast<T>(1);
+        const T delta_z = static_cast<T>(deltaZ);
+
+        auto image = reinterpret_cast<T*>(image_data);
+        size_t cur_fill = 0;
+
+        for (v = 0; v < height; v++)
+        {
+            // left to right
+            T *im = image + v * width;
+            T val0 = im[0];
+            cur_fill = 0;
+
+            for (u = 1; u < width - 1; u++)
+            {
+                T val1 = im[1];
+
+                if (fabs(val0) >= valid_threshold)
+                {
+                    if (fabs(val1) >= valid_threshold)
+                    {
+                        cur_fill = 0;
+                        T diff = static_cast<T>(fabs(val1 - val0));
+
+                        if (diff >= valid_threshold && diff <= delta_z)
+                        {
+                            float filtered = val1 * alpha + val0 * (1.0f - alpha);
+                            val1 = static_cast<T>(filtered + round);
+                            im[1] = val1;
+                        }
+                    }
+                    else // Only the old value is valid - appy holes filling
+                    {
+                        if (holes_filling_radius)
+                        {
+                            if (++cur_fill <holes_filling_radius)
+                                im[1] = val1 = val0;
+                        }
+                    }
+                }
+
+                val0 = val1;
+                im += 1;
+            }
+
+            // right to left
+            im = image + (v + 1) * width - 2;  // end of row - two pixels
+            T val1 = im[1];
+            cur_fill = 0;
+
+            for (u = width - 1; u > 0; u--)
+            {
+                T val0 = im[0];
+
+                if (val1 >= valid_threshold)
+                {
+                    if (val0 > valid_threshold)
+                    {
+                        cur_fill = 0;
+                        T diff = static_cast<T>(fabs(val1 - val0));
+
+                        if (diff <= delta_z)
+                        {
+                            float filtered = val0 * alpha + val1 * (1.0f - alpha);
+                            val0 = static_cast<T>(filtered + round);
+                            im[0] = val0;
+                        }
+                    }
+                    else // 'inertial' hole filling
+                    {
+                        if (holes_filling_radius)
+                        {
+                            if (++cur_fill <holes_filling_radius)
+                                im[0] = val0 = val1;
+                        }
+                    }
+                }
+
+                val1 = val0;
+                im -= 1;
+            }
+        }
+    }
+
+    template <typename T>
+    static void recursive_filter_vertical(void * image_data, size_t width, size_t height, float alpha, float deltaZ)
+    {
+        size_t v{}, u{};
+
+        // Handle conversions for invalid input data
+        bool fp = (std::is_floating_point<T>::value);
+
+        // Filtering integer values requires round-up to the nearest discrete value
+        const float round = fp ? 0.f : 0.5f;
+        // define invalid range
+        const T valid_threshold = fp ? static_cast<T>(std::numeric_limits<T>::epsilon()) : static_cast<T>(1);
+        const T delta_z = static_cast<T>(deltaZ);
+
+        auto image = reinterpret_cast<T*>(image_data);
+
+        // we'll do one row at a time, top to bottom, then bottom to top
+
+        // top to bottom
+
+        T *im = image;
+        T im0{};
+        T imw{};
+        for (v = 1; v < height; v++)
+        {
+            for (u = 0; u < width; u++)
+            {
+                im0 = im[0];
+                imw = im[width];
+
+                //if ((fabs(im0) >= valid_threshold) && (fabs(imw) >= valid_threshold))
+                {
+                    T diff = static_cast<T>(fabs(im0 - imw));
+                    if (diff < delta_z)
+                    {
+                        float filtered = imw * alpha + im0 * (1.f - alpha);
+                        im[width] = static_cast<T>(filtered + round);
+                    }
+                }
+                im += 1;
+            }
+        }
+
+        // bottom to top
+        im = image + (height - 2) * width;
+        for (v = 1; v < height; v++, im -= (width * 2))
+        {
+            for (u = 0; u < width; u++)
+            {
+                im0 = im[0];
+                imw = im[width];
+
+                if ((fabs(im0) >= valid_threshold) && (fabs(imw) >= valid_threshold))
+                {
+                    T diff = static_cast<T>(fabs(im0 - imw));
+                    if (diff < delta_z)
+                    {
+                        float filtered = im0 * alpha + imw * (1.f - alpha);
+                        im[0] = static_cast<T>(filtered + round);
+                    }
+                }
+                im += 1;
+            }
+        }
+    }
+
+    static void recursive_filter_horizontal_fp(void * image_data, size_t width, size_t height, float alpha, float deltaZ)
+    {
+        float *image = reinterpret_cast<float*>(image_data);
+
+        int v, u;
+
+        for (v = 0; v < height;) {
+            // left to right
+            float *im = image + v * width;
+            float state = *im;
+            float previousInnovation = state;
+
+            im++;
+            float innovation = *im;
+            u = int(width) - 1;
+            if (!(*(int*)&previousInnovation > 0))
+                goto CurrentlyInvalidLR;
+            // else fall through
+
+        CurrentlyValidLR:
+            for (;;) {
+                if (*(int*)&innovation > 0) {
+                    float delta = previousInnovation - innovation;
+                    bool smallDifference = delta < deltaZ && delta > -deltaZ;
+
+                    if (smallDifference) {
+                        float filtered = innovation * alpha + state * (1.0f - alpha);
+                        *im = state = filtered;
+                    }
+                    else {
+                        state = innovation;
+                    }
+                    u--;
+                    if (u <= 0)
+                        goto DoneLR;
+                    previousInnovation = innovation;
+                    im += 1;
+                    innovation = *im;
+                }
+                else {  // switch to CurrentlyInvalid state
+                    u--;
+                    if (u <= 0)
+                        goto DoneLR;
+                    previousInnovation = innovation;
+                    im += 1;
+                    innovation = *im;
+                    goto CurrentlyInvalidLR;
+                }
+            }
+
+        CurrentlyInvalidLR:
+            for (;;) {
+                u--;
+                if (u <= 0)
+                    goto DoneLR;
+                if (*(int*)&innovation > 0) { // switch to CurrentlyValid state
+                    previousInnovation = state = innovation;
+                    im += 1;
+                    innovation = *im;
+                    goto CurrentlyValidLR;
+                }
+                else {
+                    im += 1;
+                    innovation = *im;
+                }
+            }
+        DoneLR:
+
+            // right to left
+            im = image + (v + 1) * width - 2;  // end of row - two pixels
+            previousInnovation = state = im[1];
+            u = int(width) - 1;
+            innovation = *im;
+            if (!(*(int*)&previousInnovation > 0))
+                goto CurrentlyInvalidRL;
+            // else fall through
+        CurrentlyValidRL:
+            for (;;) {
+                if (*(int*)&innovation > 0) {
+                    float delta = previousInnovation - innovation;
+                    bool smallDifference = delta < deltaZ && delta > -deltaZ;
+
+                    if (smallDifference) {
+                        float filtered = innovation * alpha + state * (1.0f - alpha);
+                        *im = state = filtered;
+                    }
+                    else {
+                        state = innovation;
+                    }
+                    u--;
+                    if (u <= 0)
+                        goto DoneRL;
+                    previousInnovation = innovation;
+                    im -= 1;
+                    innovation = *im;
+                }
+                else {  // switch to CurrentlyInvalid state
+                    u--;
+                    if (u <= 0)
+                        goto DoneRL;
+                    previousInnovation = innovation;
+                    im -= 1;
+                    innovation = *im;
+                    goto CurrentlyInvalidRL;
+                }
+            }
+
+        CurrentlyInvalidRL:
+            for (;;) {
+                u--;
+                if (u <= 0)
+                    goto DoneRL;
+                if (*(int*)&innovation > 0) { // switch to CurrentlyValid state
+                    previousInnovation = state = innovation;
+                    im -= 1;
+                    innovation = *im;
+                    goto CurrentlyValidRL;
+                }
+                else {
+                    im -= 1;
+                    innovation = *im;
+                }
+            }
+        DoneRL:
+            v++;
+        }
+    }
+
+    static void recursive_filter_vertical_fp(void * image_data, size_t width, size_t height, float alpha, float deltaZ)
+    {
+        float *image = reinterpret_cast<float*>(image_data);
+
+        int v, u;
+
+        // we'll do one column at a time, top to bottom, bottom to top, left to right,
+
+        for (u = 0; u < width;) {
+
+            float *im = image + u;
+            float state = im[0];
+            float previousInnovation = state;
+
+            v = int(height) - 1;
+            im += width;
+            float innovation = *im;
+
+            if (!(*(int*)&previousInnovation > 0))
+                goto CurrentlyInvalidTB;
+            // else fall through
+
+        CurrentlyValidTB:
+            for (;;) {
+                if (*(int*)&innovation > 0) {
+                    float delta = previousInnovation - innovation;
+                    bool smallDifference = delta < deltaZ && delta > -deltaZ;
+
+                    if (smallDifference) {
+                        float filtered = innovation * alpha + state * (1.0f - alpha);
+                        *im = state = filtered;
+                    }
+                    else {
+                        state = innovation;
+                    }
+                    v--;
+                    if (v <= 0)
+                        goto DoneTB;
+                    previousInnovation = innovation;
+                    im += width;
+                    innovation = *im;
+                }
+                else {  // switch to CurrentlyInvalid state
+                    v--;
+                    if (v <= 0)
+                        goto DoneTB;
+                    previousInnovation = innovation;
+                    im += width;
+                    innovation = *im;
+                    goto CurrentlyInvalidTB;
+                }
+            }
+
+        CurrentlyInvalidTB:
+            for (;;) {
+                v--;
+                if (v <= 0)
+                    goto DoneTB;
+                if (*(int*)&innovation > 0) { // switch to CurrentlyValid state
+                    previousInnovation = state = innovation;
+                    im += width;
+                    innovation = *im;
+                    goto CurrentlyValidTB;
+                }
+                else {
+                    im += width;
+                    innovation = *im;
+                }
+            }
+        DoneTB:
+
+            im = image + u + (height - 2) * width;
+            state = im[width];
+            previousInnovation = state;
+            innovation = *im;
+            v = int(height) - 1;
+            if (!(*(int*)&previousInnovation > 0))
+                goto CurrentlyInvalidBT;
+            // else fall through
+        CurrentlyValidBT:
+            for (;;) {
+                if (*(int*)&innovation > 0) {
+                    float delta = previousInnovation - innovation;
+                    bool smallDifference = delta < deltaZ && delta > -deltaZ;
+
+                    if (smallDifference) {
+                        float filtered = innovation * alpha + state * (1.0f - alpha);
+                        *im = state = filtered;
+                    }
+                    else {
+                        state = innovation;
+                    }
+                    v--;
+                    if (v <= 0)
+                        goto DoneBT;
+                    previousInnovation = innovation;
+                    im -= width;
+                    innovation = *im;
+                }
+                else {  // switch to CurrentlyInvalid state
+                    v--;
+                    if (v <= 0)
+                        goto DoneBT;
+                    previousInnovation = innovation;
+                    im -= width;
+                    innovation = *im;
+                    goto CurrentlyInvalidBT;
+                }
+            }
+
+        CurrentlyInvalidBT:
+            for (;;) {
+                v--;
+                if (v <= 0)
+                    goto DoneBT;
+                if (*(int*)&innovation > 0) { // switch to CurrentlyValid state
+                    previousInnovation = state = innovation;
+                    im -= width;
+                    innovation = *im;
+                    goto CurrentlyValidBT;
+                }
+                else {
+                    im -= width;
+                    innovation = *im;
+                }
+            }
+        DoneBT:
+            u++;
+        }
+    }
+
+    void dxf_horizontal_pass(uint16_t* image, size_t width, size_t height, float alpha, float delta, uint8_t holes_filling_radius)
+    {
+        recursive_filter_horizontal<uint16_t>(image, width, height, alpha, delta, holes_filling_radius);
+    }
+
+    void dxf_vertical_pass(uint16_t* image, size_t width, size_t height, float alpha, float delta)
+    {
+        recursive_filter_vertical<uint16_t>(image, width, height, alpha, delta);
+    }
+
+    void dxf_horizontal_pass(float* image, size_t width, size_t height, float alpha, float delta)
+    {
+        recursive_filter_horizontal_fp(image, width, height, alpha, delta);
+    }
+
+    void dxf_vertical_pass(float* image, size_t width, size_t height, float alpha, float delta)
+    {
+        recursive_filter_vertical_fp(image, width, height, alpha, delta);
+    }
+}
@@ -0,0 +1,22 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2017 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace librealsense
+{
+    // Scalar passes of the spatial filter domain transform, filtering every row (horizontal) or
+    // column (vertical) of the image in place in both directions
+
+    // Depth frames: edge-preserving smoothing with inertial holes filling up to holes_filling_radius pixels (0 - disabled)
+    void dxf_horizontal_pass(uint16_t* image, size_t width, size_t height,
+        float alpha, float delta, uint8_t holes_filling_radius);
+    void dxf_vertical_pass(uint16_t* image, size_t width, size_t height, float alpha, float delta);
+
+    // Disparity frames: edge-preserving smoothing, the holes are filled by a separate pass
+    void dxf_horizontal_pass(float* image, size_t width, size_t height, float alpha, float delta);
+    void dxf_vertical_pass(float* image, size_t width, size_t height, float alpha, float delta);
+}
@@ -225,263 +225,4 @@ namespace librealsense
         memmove(const_cast<void*>(tgt.get_data()), f.get_data(), _current_frm_size_pixels * _bpp);
         return tgt;
     }
-
-    void spatial_filter::recursive_filter_horizontal_fp(void * image_data, float alpha, float deltaZ)
-    {
-        float *image = reinterpret_cast<float*>(image_data);
-
-        int v, u;
-
-        for (v = 0; v < _height;) {
-            // left to right
-            float *im = image + v * _width;
-            float state = *im;
-            float previousInnovation = state;
-
-            im++;
-            float innovation = *im;
-            u = int(_width) - 1;
-            if (!(*(int*)&previousInnovation > 0))
-                goto CurrentlyInvalidLR;
-            // else fall through
-
-        CurrentlyValidLR:
-            for (;;) {
-                if (*(int*)&innovation > 0) {
-                    float delta = previousInnovation - innovation;
-                    bool smallDifference = delta < deltaZ && delta > -deltaZ;
-
-                    if (smallDifference) {
-                        float filtered = innovation * alpha + state * (1.0f - alpha);
-                        *im = state = filtered;
-                    }
-                    else {
-                        state = innovation;
-                    }
-                    u--;
-                    if (u <= 0)
-                        goto DoneLR;
-                    previousInnovation = innovation;
-                    im += 1;
-                    innovation = *im;
-                }
-                else {  // switch to CurrentlyInvalid state
-                    u--;
-                    if (u <= 0)
-                        goto DoneLR;
-                    previousInnovation = innovation;
-                    im += 1;
-                    innovation = *im;
-                    goto CurrentlyInvalidLR;
-                }
-            }
-
-        CurrentlyInvalidLR:
-            for (;;) {
-                u--;
-                if (u <= 0)
-                    goto DoneLR;
-                if (*(int*)&innovation > 0) { // switch to CurrentlyValid state
-                    previousInnovation = state = innovation;
-                    im += 1;
-                    innovation = *im;
-                    goto CurrentlyValidLR;
-                }
-                else {
-                    im += 1;
-                    innovation = *im;
-                }
-            }
-        DoneLR:
-
-            // right to left
-            im = image + (v + 1) * _width - 2;  // end of row - two pixels
-            previousInnovation = state = im[1];
-            u = int(_width) - 1;
-            innovation = *im;
-            if (!(*(int*)&previousInnovation > 0))
-                goto CurrentlyInvalidRL;
-            // else fall through
-        CurrentlyValidRL:
-            for (;;) {
-                if (*(int*)&innovation > 0) {
-                    float delta = previousInnovation - innovation;
-                    bool smallDifference = delta < deltaZ && delta > -deltaZ;
-
-                    if (smallDifference) {
-                        float filtered = innovation * alpha + state * (1.0f - alpha);
-                        *im = state = filtered;
-                    }
-                    else {
-                        state = innovation;
-                    }
-                    u--;
-                    if (u <= 0)
-                        goto DoneRL;
-                    previousInnovation = innovation;
-                    im -= 1;
-                    innovation = *im;
-                }
-                else {  // switch to CurrentlyInvalid state
-                    u--;
-                    if (u <= 0)
-                        goto DoneRL;
-                    previousInnovation = innovation;
-                    im -= 1;
-                    innovation = *im;
-                    goto CurrentlyInvalidRL;
-                }
-            }
-
-        CurrentlyInvalidRL:
-            for (;;) {
-                u--;
-                if (u <= 0)
-                    goto DoneRL;
-                if (*(int*)&innovation > 0) { // switch to CurrentlyValid state
-                    previousInnovation = state = innovation;
-                    im -= 1;
-                    innovation = *im;
-                    goto CurrentlyValidRL;
-                }
-                else {
-                    im -= 1;
-                    innovation = *im;
-                }
-            }
-        DoneRL:
-            v++;
-        }
-    }
-
-    void spatial_filter::recursive_filter_vertical_fp(void * image_data, float alpha, float deltaZ)
-    {
-        float *image = reinterpret_cast<float*>(image_data);
-
-        int v, u;
-
-        // we'll do one column at a time, top to bottom, bottom to top, left to right,
-
-        for (u = 0; u < _width;) {
-
-            float *im = image + u;
-            float state = im[0];
-            float previousInnovation = state;
-
-            v = int(_height) - 1;
-            im += _width;
-            float innovation = *im;
-
-            if (!(*(int*)&previousInnovation > 0))
-                goto CurrentlyInvalidTB;
-            // else fall through
-
-        CurrentlyValidTB:
-            for (;;) {
-                if (*(int*)&innovation > 0) {
-                    float delta = previousInnovation - innovation;
-                    bool smallDifference = delta < deltaZ && delta > -deltaZ;
-
-                    if (smallDifference) {
-                        float filtered = innovation * alpha + state * (1.0f - alpha);
-                        *im = state = filtered;
-                    }
-                    else {
-                        state = innovation;
-                    }
-                    v--;
-                    if (v <= 0)
-                        goto DoneTB;
-                    previousInnovation = innovation;
-                    im += _width;
-                    innovation = *im;
-                }
-                else {  // switch to CurrentlyInvalid state
-                    v--;
-                    if (v <= 0)
-                        goto DoneTB;
-                    previousInnovation = innovation;
-                    im += _width;
-                    innovation = *im;
-                    goto CurrentlyInvalidTB;
-                }
-            }
-
-        CurrentlyInvalidTB:
-            for (;;) {
-                v--;
-                if (v <= 0)
-                    goto DoneTB;
-                if (*(int*)&innovation > 0) { // switch to CurrentlyValid state
-                    previousInnovation = state = innovation;
-                    im += _width;
-                    innovation = *im;
-                    goto CurrentlyValidTB;
-                }
-                else {
-                    im += _width;
-                    innovation = *im;
-                }
-            }
-        DoneTB:
-
-            im = image + u + (_height - 2) * _width;
-            state = im[_width];
-            previousInnovation = state;
-            innovation = *im;
-            v = int(_height) - 1;
-            if (!(*(int*)&previousInnovation > 0))
-                goto CurrentlyInvalidBT;
-            // else fall through
-        CurrentlyValidBT:
-            for (;;) {
-                if (*(int*)&innovation > 0) {
-                    float delta = previousInnovation - innovation;
-                    bool smallDifference = delta < deltaZ && delta > -deltaZ;
-
-                    if (smallDifference) {
-                        float filtered = innovation * alpha + state * (1.0f - alpha);
-                        *im = state = filtered;
-                    }
-                    else {
-                        state = innovation;
-                    }
-                    v--;
-                    if (v <= 0)
-                        goto DoneBT;
-                    previousInnovation = innovation;
-                    im -= _width;
-                    innovation = *im;
-                }
-                else {  // switch to CurrentlyInvalid state
-                    v--;
-                    if (v <= 0)
-                        goto DoneBT;
-                    previousInnovation = innovation;
-                    im -= _width;
-                    innovation = *im;
-                    goto CurrentlyInvalidBT;
-                }
-            }
-
-        CurrentlyInvalidBT:
-            for (;;) {
-                v--;
-                if (v <= 0)
-                    goto DoneBT;
-                if (*(int*)&innovation > 0) { // switch to CurrentlyValid state
-                    previousInnovation = state = innovation;
-                    im -= _width;
-                    innovation = *im;
-                    goto CurrentlyValidBT;
-                }
-                else {
-                    im -= _width;
-                    innovation = *im;
-                }
-            }
-        DoneBT:
-            u++;
-        }
-    }
 }
@@ -12,6 +12,8 @@
 
 #include "../include/librealsense2/hpp/rs_frame.hpp"
 #include "../include/librealsense2/hpp/rs_processing.hpp"
+#include "proc/spatial-filter-passes.h"
+#include "proc/sse/sse-spatial-filter.h"
 
 namespace librealsense
 {
@@ -34,186 +36,36 @@ namespace librealsense
 
             for (int i = 0; i < iterations; i++)
             {
+#ifdef __SSSE3__
+                // Vectorized and multi-threaded passes, with the same results as the scalar passes
                 if (fp)
                 {
-                    recursive_filter_horizontal_fp(frame_data, alpha, delta);
-                    recursive_filter_vertical_fp(frame_data, alpha, delta);
+                    dxf_horizontal_pass_sse(static_cast<float*>(frame_data), _width, _height, alpha, delta);
+                    dxf_vertical_pass_sse(static_cast<float*>(frame_data), _width, _height, alpha, delta);
                 }
                 else
                 {
-                    recursive_filter_horizontal<T>(frame_data, alpha, delta);
-                    recursive_filter_vertical<T>(frame_data, alpha, delta);
+                    dxf_horizontal_pass_sse(static_cast<uint16_t*>(frame_data), _width, _height, alpha, delta, _holes_filling_radius);
+                    dxf_vertical_pass_sse(static_cast<uint16_t*>(frame_data), _width, _height, alpha, delta);
                 }
-            }
-
-            // Disparity domain hole filling requires a second pass over the frame data
-            // For depth domain a more efficient in-place hole filling is performed
-            if (_holes_filling_mode && fp)
-                intertial_holes_fill<T>(static_cast<T*>(frame_data));
-        }
-
-        void recursive_filter_horizontal_fp(void * image_data, float alpha, float deltaZ);
-        void recursive_filter_vertical_fp(void * image_data, float alpha, float deltaZ);
-
-        template <typename T>
-        void  recursive_filter_horizontal(void * image_data, float alpha, float deltaZ)
-        {
-            size_t v{}, u{};
-
-            // Handle conversions for invalid input data
-            bool fp = (std::is_floating_point<T>::value);
-
-            // Filtering integer values requires round-up to the nearest discrete value
-            const float round = fp ? 0.f : 0.5f;
-            // define invalid inputs
-            const T valid_threshold = fp ? static_cast<T>(std::numeric_limits<T>::epsilon()) : static_cast<T>(1);
-            const T delta_z = static_cast<T>(deltaZ);
-
-            auto image = reinterpret_cast<T*>(image_data);
-            size_t cur_fill = 0;
-
-            for (v = 0; v < _height; v++)
-            {
-                // left to right
-                T *im = image + v * _width;
-                T val0 = im[0];
-                cur_fill = 0;
-
-                for (u = 1; u < _width - 1; u++)
-                {
-                    T val1 = im[1];
-
-                    if (fabs(val0) >= valid_threshold)
-                    {
-                        if (fabs(val1) >= valid_threshold)
-                        {
-                            cur_fill = 0;
-                            T diff = static_cast<T>(fabs(val1 - val0));
-
-                            if (diff >= valid_threshold && diff <= delta_z)
-                            {
-                                float filtered = val1 * alpha + val0 * (1.0f - alpha);
-                                val1 = static_cast<T>(filtered + round);
-                                im[1] = val1;
-                            }
-                        }
-                        else // Only the old value is valid - appy holes filling
-                        {
-                            if (_holes_filling_radius)
-                            {
-                                if (++cur_fill <_holes_filling_radius)
-                                    im[1] = val1 = val0;
-                            }
-                        }
-                    }
-
-                    val0 = val1;
-                    im += 1;
-                }
-
-                // right to left
-                im = image + (v + 1) * _width - 2;  // end of row - two pixels
-                T val1 = im[1];
-                cur_fill = 0;
-
-                for (u = _width - 1; u > 0; u--)
+#else
+                if (fp)
                 {
-                    T val0 = im[0];
-
-                    if (val1 >= valid_threshold)
-                    {
-                        if (val0 > valid_threshold)
-                        {
-                            cur_fill = 0;
-                            T diff = static_cast<T>(fabs(val1 - val0));
-
-                            if (diff <= delta_z)
-                            {
-                                float filtered = val0 * alpha + val1 * (1.0f - alpha);
-                                val0 = static_cast<T>(filtered + round);
-                                im[0] = val0;
-                            }
-                        }
-                        else // 'inertial' hole filling
-                        {
-                            if (_holes_filling_radius)
-                            {
-                                if (++cur_fill <_holes_filling_radius)
-                                    im[0] = val0 = val1;
-                            }
-                        }
-                    }
-
-                    val1 = val0;
-                    im -= 1;
+                    dxf_horizontal_pass(static_cast<float*>(frame_data), _width, _height, alpha, delta);
+                    dxf_vertical_pass(static_cast<float*>(frame_data), _width, _height, alpha, delta);
                 }
-            }
-        }
-
-        template <typename T>
-        void recursive_filter_vertical(void * image_data, float alpha, float deltaZ)
-        {
-            size_t v{}, u{};
-
-            // Handle conversions for invalid input data
-            bool fp = (std::is_floating_point<T>::value);
-
-            // Filtering integer values requires round-up to the nearest discrete value
-            const float round = fp ? 0.f : 0.5f;
-            // define invalid range
-            const T valid_threshold = fp ? static_cast<T>(std::numeric_limits<T>::epsilon()) : static_cast<T>(1);
-            const T delta_z = static_cast<T>(deltaZ);
-
-            auto image = reinterpret_cast<T*>(image_data);
-
-            // we'll do one row at a time, top to bottom, then bottom to top
-
-            // top to bottom
-
-            T *im = image;
-            T im0{};
-            T imw{};
-            for (v = 1; v < _height; v++)
-            {
-                for (u = 0; u < _width; u++)
+                else
                 {
-                    im0 = im[0];
-                    imw = im[_width];
-
-                    //if ((fabs(im0) >= valid_threshold) && (fabs(imw) >= valid_threshold))
-                    {
-                        T diff = static_cast<T>(fabs(im0 - imw));
-                        if (diff < delta_z)
-                        {
-                            float filtered = imw * alpha + im0 * (1.f - alpha);
-                            im[_width] = static_cast<T>(filtered + round);
-                        }
-                    }
-                    im += 1;
+                    dxf_horizontal_pass(static_cast<uint16_t*>(frame_data), _width, _height, alpha, delta, _holes_filling_radius);
+                    dxf_vertical_pass(static_cast<uint16_t*>(frame_data), _width, _height, alpha, delta);
                 }
+#endif
             }
 
-            // bottom to top
-            im = image + (_height - 2) * _width;
-            for (v = 1; v < _height; v++, im -= (_width * 2))
-            {
-                for (u = 0; u < _width; u++)
-                {
-                    im0 = im[0];
-                    imw = im[_width];
-
-                    if ((fabs(im0) >= valid_threshold) && (fabs(imw) >= valid_threshold))
-                    {
-                        T diff = static_cast<T>(fabs(im0 - imw));
-                        if (diff < delta_z)
-                        {
-                            float filtered = im0 * alpha + imw * (1.f - alpha);
-                            im[0] = static_cast<T>(filtered + round);
-                        }
-                    }
-                    im += 1;
-                }
-            }
+            // Disparity domain hole filling requires a second pass over the frame data
+            // For depth domain a more efficient in-place hole filling is performed
+            if (_holes_filling_mode && fp)
+                intertial_holes_fill<T>(static_cast<T*>(frame_data));
         }
 
         template<typename T>
@@ -0,0 +1,149 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "avx-deinterleave.h"
+
+#include <algorithm>
+
+#if defined(__SSSE3__) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#define AVX_DEINTERLEAVE_KERNELS
+#endif
+
+#ifdef AVX_DEINTERLEAVE_KERNELS
+
+#include <immintrin.h> // For AVX2 intrinsics
+
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_AVX2
+#endif
+
+#endif
+
+namespace librealsense
+{
+    const size_t pixels_per_block = 4096;
+
+    // Scalar implementations, used for the pixels left over by the vector loops
+    static void split_y8i_scalar(uint8_t* left, uint8_t* right, const uint8_t* source, size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            left[i] = source[i * 2];
+            right[i] = source[i * 2 + 1];
+        }
+    }
+
+    static void split_y12i_scalar(uint16_t* left, uint16_t* right, const uint8_t* source, size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            auto p = source + i * 3;
+            int l = p[2] << 4 | p[1] >> 4;
+            int r = (p[1] & 0xf) << 8 | p[0];
+            left[i] = static_cast<uint16_t>(l << 6 | l >> 4);
+            right[i] = static_cast<uint16_t>(r << 6 | r >> 4);
+        }
+    }
+
+#ifdef AVX_DEINTERLEAVE_KERNELS
+
+    // Two 128-bit loads into the lanes of a vector
+    TARGET_AVX2 static inline __m256i load_lanes(const uint8_t* low, const uint8_t* high)
+    {
+        return _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(low))),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(high)), 1);
+    }
+
+    // The lanes of a and b hold 4 groups of pixels, in the order a0 a1 b0 b1 of the
+    // unpacked halves. The 64-bit permute restores the order a0 b0 a1 b1 of the source
+    const int restore_order = _MM_SHUFFLE(3, 1, 2, 0);
+
+    TARGET_AVX2 static void split_y8i_block(uint8_t* left, uint8_t* right, const uint8_t* source, size_t begin, size_t end)
+    {
+        const __m256i split = _mm256_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15,
+                                               0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15);
+
+        size_t i = begin;
+        for (; i + 32 <= end; i += 32)
+        {
+            auto a = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i * 2)), split);
+            auto b = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i * 2 + 32)), split);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(left + i), _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(a, b), restore_order));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(right + i), _mm256_permute4x64_epi64(_mm256_unpackhi_epi64(a, b), restore_order));
+        }
+
+        split_y8i_scalar(left, right, source, i, end);
+    }
+
+    TARGET_AVX2 static inline __m256i scale_y12i(__m256i v)
+    {
+        return _mm256_or_si256(_mm256_slli_epi16(v, 6), _mm256_srli_epi16(v, 4));
+    }
+
+    TARGET_AVX2 static void split_y12i_block(uint16_t* left, uint16_t* right, const uint8_t* source, size_t begin, size_t end, size_t count)
+    {
+        // Same shuffle as the SSSE3 kernel, 4 pixels per 128-bit load
+        const __m256i split = _mm256_setr_epi8(0, 1, 3, 4, 6, 7, 9, 10, 1, 2, 4, 5, 7, 8, 10, 11,
+                                               0, 1, 3, 4, 6, 7, 9, 10, 1, 2, 4, 5, 7, 8, 10, 11);
+        const __m256i low_12_bits = _mm256_set1_epi16(0x0fff);
+
+        // The last load of a step reads 4 bytes past the 16 pixels, which must still be in the source
+        const size_t vector_end = std::min(end, count >= 2 ? count - 2 : 0);
+
+        size_t i = begin;
+        for (; i + 16 <= vector_end; i += 16)
+        {
+            auto p = source + i * 3;
+            auto a = _mm256_shuffle_epi8(load_lanes(p, p + 12), split);
+            auto b = _mm256_shuffle_epi8(load_lanes(p + 24, p + 36), split);
+
+            auto r = _mm256_and_si256(_mm256_permute4x64_epi64(_mm256_unpacklo_epi64(a, b), restore_order), low_12_bits);
+            auto l = _mm256_srli_epi16(_mm256_permute4x64_epi64(_mm256_unpackhi_epi64(a, b), restore_order), 4);
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(left + i), scale_y12i(l));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(right + i), scale_y12i(r));
+        }
+
+        split_y12i_scalar(left, right, source, i, end);
+    }
+
+#else
+
+    static void split_y8i_block(uint8_t* left, uint8_t* right, const uint8_t* source, size_t begin, size_t end)
+    {
+        split_y8i_scalar(left, right, source, begin, end);
+    }
+
+    static void split_y12i_block(uint16_t* left, uint16_t* right, const uint8_t* source, size_t begin, size_t end, size_t count)
+    {
+        split_y12i_scalar(left, right, source, begin, end);
+    }
+
+#endif
+
+    void unpack_y8_y8_from_y8i_avx2(uint8_t* left, uint8_t* right, const uint8_t* source, size_t count)
+    {
+        const int blocks = static_cast<int>((count + pixels_per_block - 1) / pixels_per_block);
+
+#pragma omp parallel for
+        for (int block = 0; block < blocks; block++)
+        {
+            const size_t begin = block * pixels_per_block;
+            split_y8i_block(left, right, source, begin, std::min(begin + pixels_per_block, count));
+        }
+    }
+
+    void unpack_y16_y16_from_y12i_10_avx2(uint16_t* left, uint16_t* right, const uint8_t* source, size_t count)
+    {
+        const int blocks = static_cast<int>((count + pixels_per_block - 1) / pixels_per_block);
+
+#pragma omp parallel for
+        for (int block = 0; block < blocks; block++)
+        {
+            const size_t begin = block * pixels_per_block;
+            split_y12i_block(left, right, source, begin, std::min(begin + pixels_per_block, count), count);
+        }
+    }
+}
@@ -0,0 +1,15 @@
+/* License: Apache 2.0. See LICENSE file in root directory. */
+/* Copyright(c) 2020 Intel Corporation. All Rights Reserved. */
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace librealsense
+{
+    // AVX2 versions of the Y8I and Y12I splitting kernels of sse-deinterleave.h, 32 and 16 pixels per step.
+    // Like the pointcloud kernels, they are compiled for AVX2 regardless of the build flags,
+    // so callers must check has_avx2_support() (cpu-features.h) before invoking them
+    void unpack_y8_y8_from_y8i_avx2(uint8_t* left, uint8_t* right, const uint8_t* source, size_t count);
+    void unpack_y16_y16_from_y12i_10_avx2(uint16_t* left, uint16_t* right, const uint8_t* source, size_t count);
+}
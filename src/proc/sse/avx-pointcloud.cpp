@@ -0,0 +1,398 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "avx-pointcloud.h"
+#include "../../../include/librealsense2/rsutil.h"
+
+#if defined(__SSSE3__) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#define AVX_POINTCLOUD_KERNELS
+#endif
+
+#ifdef AVX_POINTCLOUD_KERNELS
+
+#include <immintrin.h> // For AVX2 and AVX-512 intrinsics
+
+// The kernels are built for their own instruction set, so that the library keeps running
+// on CPUs without AVX2 and the build does not need extra compiler flags for this file
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#define TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+#define TARGET_AVX2
+#define TARGET_AVX512
+#endif
+
+// The kernels must round as the scalar code does: fusing their multiplications and additions
+// into FMA instructions, which the AVX-512 target allows, changes the results
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC optimize("fp-contract=off")
+#elif defined(__clang__)
+#pragma clang fp contract(off)
+#endif
+
+#endif
+
+namespace librealsense
+{
+    // Scalar implementations, used for the pixels left over by the vector loops
+    static void deproject_depth_scalar(float* points, const uint16_t* depth,
+        const float* map_x, const float* map_y, size_t begin, size_t end, float depth_scale)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            float z = depth_scale * depth[i];
+            points[i * 3] = z * map_x[i];
+            points[i * 3 + 1] = z * map_y[i];
+            points[i * 3 + 2] = z;
+        }
+    }
+
+    static void get_texture_map_scalar(float* texcoords, float* pixels, const float* points, size_t begin, size_t end,
+        const rs2_intrinsics& other_intrinsics, const rs2_extrinsics& extr)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            float* pixel = pixels + i * 2;
+            float* tex = texcoords + i * 2;
+            if (points[i * 3 + 2])
+            {
+                float trans[3];
+                rs2_transform_point_to_point(trans, &extr, points + i * 3);
+                rs2_project_point_to_pixel(pixel, &other_intrinsics, trans);
+                tex[0] = pixel[0] / other_intrinsics.width;
+                tex[1] = pixel[1] / other_intrinsics.height;
+            }
+            else
+            {
+                pixel[0] = pixel[1] = 0.f;
+                tex[0] = tex[1] = 0.f;
+            }
+        }
+    }
+
+    bool is_texture_map_vectorized(rs2_distortion model)
+    {
+        return model == RS2_DISTORTION_NONE
+            || model == RS2_DISTORTION_BROWN_CONRADY
+            || model == RS2_DISTORTION_MODIFIED_BROWN_CONRADY
+            || model == RS2_DISTORTION_INVERSE_BROWN_CONRADY;
+    }
+
+#ifdef AVX_POINTCLOUD_KERNELS
+
+    ////////////////
+    // AVX2 (x8) //
+    ////////////////
+
+    // Interleaves 8 x,y,z triplets, using the 4-wide shuffles of the SSE kernel in each 128-bit lane
+    TARGET_AVX2 static inline void store_xyz_avx2(float* dst, __m256 x, __m256 y, __m256 z)
+    {
+        auto x_y = _mm256_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0));
+        auto z_x = _mm256_shuffle_ps(z, x, _MM_SHUFFLE(3, 1, 2, 0));
+        auto y_z = _mm256_shuffle_ps(y, z, _MM_SHUFFLE(3, 1, 3, 1));
+
+        auto xyz0 = _mm256_shuffle_ps(x_y, z_x, _MM_SHUFFLE(2, 0, 2, 0));
+        auto xyz1 = _mm256_shuffle_ps(y_z, x_y, _MM_SHUFFLE(3, 1, 2, 0));
+        auto xyz2 = _mm256_shuffle_ps(z_x, y_z, _MM_SHUFFLE(3, 1, 3, 1));
+
+        // Low lanes hold points 0-3, high lanes hold points 4-7
+        _mm256_storeu_ps(dst, _mm256_permute2f128_ps(xyz0, xyz1, 0x20));
+        _mm256_storeu_ps(dst + 8, _mm256_permute2f128_ps(xyz2, xyz0, 0x30));
+        _mm256_storeu_ps(dst + 16, _mm256_permute2f128_ps(xyz1, xyz2, 0x31));
+    }
+
+    TARGET_AVX2 static inline void load_xyz_avx2(const float* src, __m256& x, __m256& y, __m256& z)
+    {
+        auto l0 = _mm256_loadu_ps(src);
+        auto l1 = _mm256_loadu_ps(src + 8);
+        auto l2 = _mm256_loadu_ps(src + 16);
+
+        // Gather points 0-3 to the low lanes and points 4-7 to the high lanes
+        auto xyz0 = _mm256_permute2f128_ps(l0, l1, 0x30);
+        auto xyz1 = _mm256_permute2f128_ps(l0, l2, 0x21);
+        auto xyz2 = _mm256_permute2f128_ps(l1, l2, 0x30);
+
+        auto yz = _mm256_shuffle_ps(xyz0, xyz1, _MM_SHUFFLE(1, 0, 2, 1));
+        auto xy = _mm256_shuffle_ps(xyz1, xyz2, _MM_SHUFFLE(2, 1, 3, 2));
+
+        x = _mm256_shuffle_ps(xyz0, xy, _MM_SHUFFLE(2, 0, 3, 0));
+        y = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+        z = _mm256_shuffle_ps(yz, xyz2, _MM_SHUFFLE(3, 0, 3, 1));
+    }
+
+    TARGET_AVX2 static inline void store_xy_avx2(float* dst, __m256 x, __m256 y)
+    {
+        auto lo = _mm256_unpacklo_ps(x, y);
+        auto hi = _mm256_unpackhi_ps(x, y);
+        _mm256_storeu_ps(dst, _mm256_permute2f128_ps(lo, hi, 0x20));
+        _mm256_storeu_ps(dst + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+    }
+
+    TARGET_AVX2 void deproject_depth_avx2(float* points, const uint16_t* depth,
+        const float* map_x, const float* map_y, size_t count, float depth_scale)
+    {
+        auto scale = _mm256_set1_ps(depth_scale);
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            auto d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(depth + i));
+            auto z = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(d)), scale);
+            auto x = _mm256_mul_ps(z, _mm256_loadu_ps(map_x + i));
+            auto y = _mm256_mul_ps(z, _mm256_loadu_ps(map_y + i));
+            store_xyz_avx2(points + i * 3, x, y, z);
+        }
+        deproject_depth_scalar(points, depth, map_x, map_y, i, count, depth_scale);
+    }
+
+    // The operations follow the evaluation order of rs2_project_point_to_pixel,
+    // and no FMA is used, so that the results match the scalar path bit for bit
+    TARGET_AVX2 void get_texture_map_avx2(float* texcoords, float* pixels, const float* points, size_t count,
+        const rs2_intrinsics& other_intrinsics, const rs2_extrinsics& extr)
+    {
+        __m256 r[9];
+        __m256 t[3];
+        __m256 c[5];
+
+        for (int i = 0; i < 9; ++i)
+            r[i] = _mm256_set1_ps(extr.rotation[i]);
+        for (int i = 0; i < 3; ++i)
+            t[i] = _mm256_set1_ps(extr.translation[i]);
+        for (int i = 0; i < 5; ++i)
+            c[i] = _mm256_set1_ps(other_intrinsics.coeffs[i]);
+
+        auto fx = _mm256_set1_ps(other_intrinsics.fx);
+        auto fy = _mm256_set1_ps(other_intrinsics.fy);
+        auto ppx = _mm256_set1_ps(other_intrinsics.ppx);
+        auto ppy = _mm256_set1_ps(other_intrinsics.ppy);
+        auto w = _mm256_set1_ps(float(other_intrinsics.width));
+        auto h = _mm256_set1_ps(float(other_intrinsics.height));
+        auto zero = _mm256_setzero_ps();
+        auto one = _mm256_set1_ps(1.f);
+        auto two = _mm256_set1_ps(2.f);
+        auto two_c2 = _mm256_mul_ps(two, c[2]);
+        auto two_c3 = _mm256_mul_ps(two, c[3]);
+
+        const bool distort_modified = other_intrinsics.model == RS2_DISTORTION_MODIFIED_BROWN_CONRADY
+            || other_intrinsics.model == RS2_DISTORTION_INVERSE_BROWN_CONRADY;
+        const bool distort_brown = other_intrinsics.model == RS2_DISTORTION_BROWN_CONRADY;
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 x, y, z;
+            load_xyz_avx2(points + i * 3, x, y, z);
+
+            auto p_x = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(r[0], x), _mm256_mul_ps(r[3], y)), _mm256_mul_ps(r[6], z)), t[0]);
+            auto p_y = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(r[1], x), _mm256_mul_ps(r[4], y)), _mm256_mul_ps(r[7], z)), t[1]);
+            auto p_z = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(r[2], x), _mm256_mul_ps(r[5], y)), _mm256_mul_ps(r[8], z)), t[2]);
+
+            p_x = _mm256_div_ps(p_x, p_z);
+            p_y = _mm256_div_ps(p_y, p_z);
+
+            if (distort_modified || distort_brown)
+            {
+                auto r2 = _mm256_add_ps(_mm256_mul_ps(p_x, p_x), _mm256_mul_ps(p_y, p_y));
+                auto f = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(one, _mm256_mul_ps(c[0], r2)),
+                    _mm256_mul_ps(_mm256_mul_ps(c[1], r2), r2)),
+                    _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(c[4], r2), r2), r2));
+
+                auto x_f = _mm256_mul_ps(p_x, f);
+                auto y_f = _mm256_mul_ps(p_y, f);
+
+                // The modified model applies the tangential distortion to the radially distorted point
+                if (distort_modified)
+                {
+                    p_x = x_f;
+                    p_y = y_f;
+                }
+
+                auto d_x = _mm256_add_ps(_mm256_add_ps(x_f, _mm256_mul_ps(_mm256_mul_ps(two_c2, p_x), p_y)),
+                    _mm256_mul_ps(c[3], _mm256_add_ps(r2, _mm256_mul_ps(_mm256_mul_ps(two, p_x), p_x))));
+                auto d_y = _mm256_add_ps(_mm256_add_ps(y_f, _mm256_mul_ps(_mm256_mul_ps(two_c3, p_x), p_y)),
+                    _mm256_mul_ps(c[2], _mm256_add_ps(r2, _mm256_mul_ps(_mm256_mul_ps(two, p_y), p_y))));
+
+                p_x = d_x;
+                p_y = d_y;
+            }
+
+            // Zero the pixel if z is zero
+            auto valid = _mm256_cmp_ps(z, zero, _CMP_NEQ_UQ);
+            p_x = _mm256_and_ps(_mm256_add_ps(_mm256_mul_ps(p_x, fx), ppx), valid);
+            p_y = _mm256_and_ps(_mm256_add_ps(_mm256_mul_ps(p_y, fy), ppy), valid);
+
+            store_xy_avx2(pixels + i * 2, p_x, p_y);
+            store_xy_avx2(texcoords + i * 2, _mm256_div_ps(p_x, w), _mm256_div_ps(p_y, h));
+        }
+        get_texture_map_scalar(texcoords, pixels, points, i, count, other_intrinsics, extr);
+    }
+
+    ///////////////////
+    // AVX-512 (x16) //
+    ///////////////////
+
+    TARGET_AVX512 static inline void store_xyz_avx512(float* dst, __m512 x, __m512 y, __m512 z)
+    {
+        // Each output vector picks its x,y entries first and then inserts the z entries
+        const __m512i xy0 = _mm512_setr_epi32(0, 16, 0, 1, 17, 1, 2, 18, 2, 3, 19, 3, 4, 20, 4, 5);
+        const __m512i xy1 = _mm512_setr_epi32(21, 5, 6, 22, 6, 7, 23, 7, 8, 24, 8, 9, 25, 9, 10, 26);
+        const __m512i xy2 = _mm512_setr_epi32(10, 11, 27, 11, 12, 28, 12, 13, 29, 13, 14, 30, 14, 15, 31, 15);
+        const __m512i z0 = _mm512_setr_epi32(0, 1, 16, 3, 4, 17, 6, 7, 18, 9, 10, 19, 12, 13, 20, 15);
+        const __m512i z1 = _mm512_setr_epi32(0, 21, 2, 3, 22, 5, 6, 23, 8, 9, 24, 11, 12, 25, 14, 15);
+        const __m512i z2 = _mm512_setr_epi32(26, 1, 2, 27, 4, 5, 28, 7, 8, 29, 10, 11, 30, 13, 14, 31);
+
+        _mm512_storeu_ps(dst, _mm512_permutex2var_ps(_mm512_permutex2var_ps(x, xy0, y), z0, z));
+        _mm512_storeu_ps(dst + 16, _mm512_permutex2var_ps(_mm512_permutex2var_ps(x, xy1, y), z1, z));
+        _mm512_storeu_ps(dst + 32, _mm512_permutex2var_ps(_mm512_permutex2var_ps(x, xy2, y), z2, z));
+    }
+
+    TARGET_AVX512 static inline void load_xyz_avx512(const float* src, __m512& x, __m512& y, __m512& z)
+    {
+        auto l0 = _mm512_loadu_ps(src);
+        auto l1 = _mm512_loadu_ps(src + 16);
+        auto l2 = _mm512_loadu_ps(src + 32);
+
+        // Each component gathers its entries from the first two vectors and then from the last one
+        const __m512i x01 = _mm512_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21, 24, 27, 30, 0, 0, 0, 0, 0);
+        const __m512i y01 = _mm512_setr_epi32(1, 4, 7, 10, 13, 16, 19, 22, 25, 28, 31, 0, 0, 0, 0, 0);
+        const __m512i z01 = _mm512_setr_epi32(2, 5, 8, 11, 14, 17, 20, 23, 26, 29, 0, 0, 0, 0, 0, 0);
+        const __m512i x2 = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 17, 20, 23, 26, 29);
+        const __m512i y2 = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 18, 21, 24, 27, 30);
+        const __m512i z2 = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 16, 19, 22, 25, 28, 31);
+
+        x = _mm512_permutex2var_ps(_mm512_permutex2var_ps(l0, x01, l1), x2, l2);
+        y = _mm512_permutex2var_ps(_mm512_permutex2var_ps(l0, y01, l1), y2, l2);
+        z = _mm512_permutex2var_ps(_mm512_permutex2var_ps(l0, z01, l1), z2, l2);
+    }
+
+    TARGET_AVX512 static inline void store_xy_avx512(float* dst, __m512 x, __m512 y)
+    {
+        const __m512i lo = _mm512_setr_epi32(0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+        const __m512i hi = _mm512_setr_epi32(8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31);
+        _mm512_storeu_ps(dst, _mm512_permutex2var_ps(x, lo, y));
+        _mm512_storeu_ps(dst + 16, _mm512_permutex2var_ps(x, hi, y));
+    }
+
+    TARGET_AVX512 void deproject_depth_avx512(float* points, const uint16_t* depth,
+        const float* map_x, const float* map_y, size_t count, float depth_scale)
+    {
+        auto scale = _mm512_set1_ps(depth_scale);
+
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            auto d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(depth + i));
+            auto z = _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_cvtepu16_epi32(d)), scale);
+            auto x = _mm512_mul_ps(z, _mm512_loadu_ps(map_x + i));
+            auto y = _mm512_mul_ps(z, _mm512_loadu_ps(map_y + i));
+            store_xyz_avx512(points + i * 3, x, y, z);
+        }
+        deproject_depth_scalar(points, depth, map_x, map_y, i, count, depth_scale);
+    }
+
+    TARGET_AVX512 void get_texture_map_avx512(float* texcoords, float* pixels, const float* points, size_t count,
+        const rs2_intrinsics& other_intrinsics, const rs2_extrinsics& extr)
+    {
+        __m512 r[9];
+        __m512 t[3];
+        __m512 c[5];
+
+        for (int i = 0; i < 9; ++i)
+            r[i] = _mm512_set1_ps(extr.rotation[i]);
+        for (int i = 0; i < 3; ++i)
+            t[i] = _mm512_set1_ps(extr.translation[i]);
+        for (int i = 0; i < 5; ++i)
+            c[i] = _mm512_set1_ps(other_intrinsics.coeffs[i]);
+
+        auto fx = _mm512_set1_ps(other_intrinsics.fx);
+        auto fy = _mm512_set1_ps(other_intrinsics.fy);
+        auto ppx = _mm512_set1_ps(other_intrinsics.ppx);
+        auto ppy = _mm512_set1_ps(other_intrinsics.ppy);
+        auto w = _mm512_set1_ps(float(other_intrinsics.width));
+        auto h = _mm512_set1_ps(float(other_intrinsics.height));
+        auto zero = _mm512_setzero_ps();
+        auto one = _mm512_set1_ps(1.f);
+        auto two = _mm512_set1_ps(2.f);
+        auto two_c2 = _mm512_mul_ps(two, c[2]);
+        auto two_c3 = _mm512_mul_ps(two, c[3]);
+
+        const bool distort_modified = other_intrinsics.model == RS2_DISTORTION_MODIFIED_BROWN_CONRADY
+            || other_intrinsics.model == RS2_DISTORTION_INVERSE_BROWN_CONRADY;
+        const bool distort_brown = other_intrinsics.model == RS2_DISTORTION_BROWN_CONRADY;
+
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            __m512 x, y, z;
+            load_xyz_avx512(points + i * 3, x, y, z);
+
+            auto p_x = _mm512_add_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(r[0], x), _mm512_mul_ps(r[3], y)), _mm512_mul_ps(r[6], z)), t[0]);
+            auto p_y = _mm512_add_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(r[1], x), _mm512_mul_ps(r[4], y)), _mm512_mul_ps(r[7], z)), t[1]);
+            auto p_z = _mm512_add_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(r[2], x), _mm512_mul_ps(r[5], y)), _mm512_mul_ps(r[8], z)), t[2]);
+
+            p_x = _mm512_div_ps(p_x, p_z);
+            p_y = _mm512_div_ps(p_y, p_z);
+
+            if (distort_modified || distort_brown)
+            {
+                auto r2 = _mm512_add_ps(_mm512_mul_ps(p_x, p_x), _mm512_mul_ps(p_y, p_y));
+                auto f = _mm512_add_ps(_mm512_add_ps(_mm512_add_ps(one, _mm512_mul_ps(c[0], r2)),
+                    _mm512_mul_ps(_mm512_mul_ps(c[1], r2), r2)),
+                    _mm512_mul_ps(_mm512_mul_ps(_mm512_mul_ps(c[4], r2), r2), r2));
+
+                auto x_f = _mm512_mul_ps(p_x, f);
+                auto y_f = _mm512_mul_ps(p_y, f);
+
+                if (distort_modified)
+                {
+                    p_x = x_f;
+                    p_y = y_f;
+                }
+
+                auto d_x = _mm512_add_ps(_mm512_add_ps(x_f, _mm512_mul_ps(_mm512_mul_ps(two_c2, p_x), p_y)),
+                    _mm512_mul_ps(c[3], _mm512_add_ps(r2, _mm512_mul_ps(_mm512_mul_ps(two, p_x), p_x))));
+                auto d_y = _mm512_add_ps(_mm512_add_ps(y_f, _mm512_mul_ps(_mm512_mul_ps(two_c3, p_x), p_y)),
+                    _mm512_mul_ps(c[2], _mm512_add_ps(r2, _mm512_mul_ps(_mm512_mul_ps(two, p_y), p_y))));
+
+                p_x = d_x;
+                p_y = d_y;
+            }
+
+            auto valid = _mm512_cmp_ps_mask(z, zero, _CMP_NEQ_UQ);
+            p_x = _mm512_maskz_mov_ps(valid, _mm512_add_ps(_mm512_mul_ps(p_x, fx), ppx));
+            p_y = _mm512_maskz_mov_ps(valid, _mm512_add_ps(_mm512_mul_ps(p_y, fy), ppy));
+
+            store_xy_avx512(pixels + i * 2, p_x, p_y);
+            store_xy_avx512(texcoords + i * 2, _mm512_div_ps(p_x, w), _mm512_div_ps(p_y, h));
+        }
+        get_texture_map_scalar(texcoords, pixels, points, i, count, other_intrinsics, extr);
+    }
+
+#else
+
+    void deproject_depth_avx2(float* points, const uint16_t* depth,
+        const float* map_x, const float* map_y, size_t count, float depth_scale)
+    {
+        deproject_depth_scalar(points, depth, map_x, map_y, 0, count, depth_scale);
+    }
+
+    void deproject_depth_avx512(float* points, const uint16_t* depth,
+        const float* map_x, const float* map_y, size_t count, float depth_scale)
+    {
+        deproject_depth_scalar(points, depth, map_x, map_y, 0, count, depth_scale);
+    }
+
+    void get_texture_map_avx2(float* texcoords, float* pixels, const float* points, size_t count,
+        const rs2_intrinsics& other_intrinsics, const rs2_extrinsics& extr)
+    {
+        get_texture_map_scalar(texcoords, pixels, points, 0, count, other_intrinsics, extr);
+    }
+
+    void get_texture_map_avx512(float* texcoords, float* pixels, const float* points, size_t count,
+        const rs2_intrinsics& other_intrinsics, const rs2_extrinsics& extr)
+    {
+        get_texture_map_scalar(texcoords, pixels, points, 0, count, other_intrinsics, extr);
+    }
+
+#endif
+}
@@ -0,0 +1,34 @@
+/* License: Apache 2.0. See LICENSE file in root directory. */
+/* Copyright(c) 2020 Intel Corporation. All Rights Reserved. */
+#pragma once
+
+#include "../../../include/librealsense2/h/rs_sensor.h"
+#include <cstdint>
+#include <cstddef>
+
+namespace librealsense
+{
+    // Vectorized pointcloud kernels, selected at runtime by pointcloud_sse.
+    // The kernels are compiled for their instruction set regardless of the build flags,
+    // so callers must check has_avx2_support() / has_avx512_support() (cpu-features.h) before invoking them.
+    // All the kernels handle any number of pixels and unaligned buffers,
+    // and produce the same results as the scalar rsutil.h functions
+
+    // points[i] = depth[i] * depth_scale * (map_x[i], map_y[i], 1)
+    // The maps hold the deprojection of every pixel to depth 1, so any distortion model is covered
+    void deproject_depth_avx2(float* points, const uint16_t* depth,
+        const float* map_x, const float* map_y, size_t count, float depth_scale);
+    void deproject_depth_avx512(float* points, const uint16_t* depth,
+        const float* map_x, const float* map_y, size_t count, float depth_scale);
+
+    // True for the distortion models of D400/L500 streams, which the texture map kernels implement:
+    // none, Brown-Conrady, modified Brown-Conrady and inverse Brown-Conrady
+    bool is_texture_map_vectorized(rs2_distortion model);
+
+    // Projects points to pixels of the other stream (pixels) and to normalized texture coordinates (texcoords),
+    // Points with zero depth are mapped to (0, 0)
+    void get_texture_map_avx2(float* texcoords, float* pixels, const float* points, size_t count,
+        const rs2_intrinsics& other_intrinsics, const rs2_extrinsics& extr);
+    void get_texture_map_avx512(float* texcoords, float* pixels, const float* points, size_t count,
+        const rs2_intrinsics& other_intrinsics, const rs2_extrinsics& extr);
+}
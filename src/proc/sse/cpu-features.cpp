@@ -0,0 +1,83 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "cpu-features.h"
+
+#include <cstdint>
+
+// The AVX kernels are only built with the SSE kernels, so the detection reports them unsupported otherwise
+#if defined(__SSSE3__) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#define CPU_FEATURES_DETECTION
+#ifdef _WIN32
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace librealsense
+{
+#ifdef CPU_FEATURES_DETECTION
+
+    namespace
+    {
+        void cpuid(int info[4], int leaf)
+        {
+#ifdef _WIN32
+            __cpuidex(info, leaf, 0);
+#else
+            __cpuid_count(leaf, 0, info[0], info[1], info[2], info[3]);
+#endif
+        }
+
+        // Register states enabled by the OS (XCR0)
+        unsigned long long xgetbv()
+        {
+#ifdef _WIN32
+            return _xgetbv(0);
+#else
+            uint32_t eax, edx;
+            __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+            return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+        }
+
+        // Extended features (leaf 7, EBX), or 0 when the CPU or the OS lack AVX support
+        int avx_features(unsigned long long required_xcr0)
+        {
+            int info[4];
+            cpuid(info, 0);
+            if (info[0] < 7)
+                return 0;
+
+            cpuid(info, 1);
+            const int osxsave_avx = (1 << 27) | (1 << 28);
+            if ((info[2] & osxsave_avx) != osxsave_avx)
+                return 0;
+            if ((xgetbv() & required_xcr0) != required_xcr0)
+                return 0;
+
+            cpuid(info, 7);
+            return info[1];
+        }
+    }
+
+    bool has_avx2_support()
+    {
+        // XMM and YMM states
+        return (avx_features(0x6) & (1 << 5)) != 0;
+    }
+
+    bool has_avx512_support()
+    {
+        // XMM, YMM, opmask and ZMM states
+        return (avx_features(0xE6) & (1 << 16)) != 0;
+    }
+
+#else
+
+    bool has_avx2_support() { return false; }
+    bool has_avx512_support() { return false; }
+
+#endif
+}
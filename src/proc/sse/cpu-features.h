@@ -0,0 +1,11 @@
+/* License: Apache 2.0. See LICENSE file in root directory. */
+/* Copyright(c) 2020 Intel Corporation. All Rights Reserved. */
+#pragma once
+
+namespace librealsense
+{
+    // Runtime detection of the instruction sets of the AVX kernels, which are compiled for them
+    // regardless of the build flags. Both the CPU and the OS must support the extended registers
+    bool has_avx2_support();
+    bool has_avx512_support();
+}
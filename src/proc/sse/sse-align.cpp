@@ -53,7 +53,7 @@ inline void distorte_x_y<RS2_DISTORTION_MODIFIED_BROWN_CONRADY>(const __m128& x,
     auto d_x0 = _mm_add_ps(x_f0, _mm_add_ps(_mm_mul_ps(two, _mm_mul_ps(c[2], _mm_mul_ps(x_f0, y_f0))), r4_0));
 
     auto r5_0 = _mm_mul_ps(c[2], _mm_add_ps(r2_0, _mm_mul_ps(two, _mm_mul_ps(y_f0, y_f0))));
-    auto d_y0 = _mm_add_ps(y_f0, _mm_add_ps(_mm_mul_ps(two, _mm_mul_ps(c[3], _mm_mul_ps(x_f0, y_f0))), r4_0));
+    auto d_y0 = _mm_add_ps(y_f0, _mm_add_ps(_mm_mul_ps(two, _mm_mul_ps(c[3], _mm_mul_ps(x_f0, y_f0))), r5_0));
 
     *distorted_x = d_x0;
     *distorted_y = d_y0;
@@ -202,6 +202,11 @@ image_transform::image_transform(const rs2_intrinsics& from, float depth_scale)
 {
 }
 
+bool image_transform::is_valid_for(const rs2_intrinsics& from, float depth_scale) const
+{
+    return _depth == from && _depth_scale == depth_scale;
+}
+
 void image_transform::pre_compute_x_y_map_corners()
 {
     pre_compute_x_y_map(_pre_compute_map_x_top_left, _pre_compute_map_y_top_left, -0.5f);
@@ -221,21 +226,12 @@ void image_transform::pre_compute_x_y_map(std::vector<float>& pre_compute_map_x,
         {
             const float pixel[] = { (float)w + offset, (float)h + offset };
 
-            float x = (pixel[0] - _depth.ppx) / _depth.fx;
-            float y = (pixel[1] - _depth.ppy) / _depth.fy;
+            // The ray through the pixel at depth 1, for any distortion model of the depth stream
+            float ray[3];
+            rs2_deproject_pixel_to_point(ray, &_depth, pixel, 1.f);
 
-            if (_depth.model == RS2_DISTORTION_INVERSE_BROWN_CONRADY)
-            {
-                float r2 = x * x + y * y;
-                float f = 1 + _depth.coeffs[0] * r2 + _depth.coeffs[1] * r2*r2 + _depth.coeffs[4] * r2*r2*r2;
-                float ux = x * f + 2 * _depth.coeffs[2] * x*y + _depth.coeffs[3] * (r2 + 2 * x*x);
-                float uy = y * f + 2 * _depth.coeffs[3] * x*y + _depth.coeffs[2] * (r2 + 2 * y*y);
-                x = ux;
-                y = uy;
-            }
-
-            pre_compute_map_x[h*_depth.width + w] = x;
-            pre_compute_map_y[h*_depth.width + w] = y;
+            pre_compute_map_x[h*_depth.width + w] = ray[0];
+            pre_compute_map_y[h*_depth.width + w] = ray[1];
         }
     }
 }
@@ -246,6 +242,7 @@ void image_transform::align_depth_to_other(const uint16_t* z_pixels, uint16_t* d
     switch (to.model)
     {
     case RS2_DISTORTION_MODIFIED_BROWN_CONRADY:
+    case RS2_DISTORTION_INVERSE_BROWN_CONRADY:
         align_depth_to_other_sse<RS2_DISTORTION_MODIFIED_BROWN_CONRADY>(z_pixels, dest, depth, to, from_to_other);
         break;
     default:
@@ -333,14 +330,16 @@ inline void image_transform::align_other_to_depth_sse(const uint16_t * z_pixels,
     get_texture_map_sse<dist>(z_pixels, _depth_scale, _depth.height*_depth.width, _pre_compute_map_x_top_left.data(),
         _pre_compute_map_y_top_left.data(), (byte*)_pixel_top_left_int.data(), to, from_to_other);
 
-    std::vector<int2>& bottom_right = _pixel_top_left_int;
+    // Points to the top-left corners unless the bottom-right corners are mapped too
+    const std::vector<int2>* bottom_right_ptr = &_pixel_top_left_int;
     if (to.height < _depth.height && to.width < _depth.width)
     {
         get_texture_map_sse<dist>(z_pixels, _depth_scale, _depth.height*_depth.width, _pre_compute_map_x_bottom_right.data(),
             _pre_compute_map_y_bottom_right.data(), (byte*)_pixel_bottom_right_int.data(), to, from_to_other);
 
-        bottom_right = _pixel_bottom_right_int;
+        bottom_right_ptr = &_pixel_bottom_right_int;
     }
+    auto& bottom_right = *bottom_right_ptr;
 
     switch (bpp)
     {
@@ -416,7 +415,8 @@ void align_sse::align_z_to_other(rs2::video_frame& aligned, const rs2::video_fra
 
     auto z_pixels = reinterpret_cast<const uint16_t*>(depth.get_data());
 
-    if (_stream_transform == nullptr)
+    // The maps depend on the depth intrinsics, which change when the device is recalibrated
+    if (_stream_transform == nullptr || !_stream_transform->is_valid_for(z_intrin, z_scale))
     {
         _stream_transform = std::make_shared<image_transform>(z_intrin, z_scale);
         _stream_transform->pre_compute_x_y_map_corners();
@@ -440,7 +440,8 @@ void align_sse::align_other_to_z(rs2::video_frame& aligned, const rs2::video_fra
     auto z_pixels = reinterpret_cast<const uint16_t*>(depth.get_data());
     auto other_pixels = reinterpret_cast<const byte*>(other.get_data());
 
-    if (_stream_transform == nullptr)
+    // The maps depend on the depth intrinsics, which change when the device is recalibrated
+    if (_stream_transform == nullptr || !_stream_transform->is_valid_for(z_intrin, z_scale))
     {
         _stream_transform = std::make_shared<image_transform>(z_intrin, z_scale);
         _stream_transform->pre_compute_x_y_map_corners();
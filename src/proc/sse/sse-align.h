@@ -27,6 +27,8 @@ namespace librealsense
 
         void pre_compute_x_y_map_corners();
 
+        bool is_valid_for(const rs2_intrinsics& from, float depth_scale) const;
+
     private:
 
         const rs2_intrinsics _depth;
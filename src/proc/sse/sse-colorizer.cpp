@@ -0,0 +1,65 @@
+/* License: Apache 2.0. See LICENSE file in root directory. */
+/* Copyright(c) 2020 Intel Corporation. All Rights Reserved. */
+
+#ifdef __SSSE3__
+
+#include "sse-colorizer.h"
+
+#include <algorithm>
+#include <tmmintrin.h> // For SSSE3 intrinsics
+
+namespace librealsense
+{
+    const size_t pixels_per_step = 16;
+    const size_t pixels_per_block = 64 * pixels_per_step;
+
+    // The colors of 4 pixels, packed into the low 12 bytes
+    static inline __m128i lookup4(const uint16_t* depth, const uint32_t* lut)
+    {
+        const __m128i rgb = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+
+        auto colors = _mm_setr_epi32(static_cast<int>(lut[depth[0]]), static_cast<int>(lut[depth[1]]),
+                                     static_cast<int>(lut[depth[2]]), static_cast<int>(lut[depth[3]]));
+        return _mm_shuffle_epi8(colors, rgb);
+    }
+
+    static void colorize_block(const uint16_t* depth, uint8_t* rgb, size_t pixels, const uint32_t* lut)
+    {
+        size_t i = 0;
+        for (; i + pixels_per_step <= pixels; i += pixels_per_step)
+        {
+            auto a = lookup4(depth + i, lut);
+            auto b = lookup4(depth + i + 4, lut);
+            auto c = lookup4(depth + i + 8, lut);
+            auto d = lookup4(depth + i + 12, lut);
+
+            // 4 x 12 bytes into 3 x 16 bytes
+            auto out = reinterpret_cast<__m128i*>(rgb + i * 3);
+            _mm_storeu_si128(out, _mm_or_si128(a, _mm_slli_si128(b, 12)));
+            _mm_storeu_si128(out + 1, _mm_or_si128(_mm_srli_si128(b, 4), _mm_slli_si128(c, 8)));
+            _mm_storeu_si128(out + 2, _mm_or_si128(_mm_srli_si128(c, 8), _mm_slli_si128(d, 4)));
+        }
+
+        for (; i < pixels; i++)
+        {
+            auto color = lut[depth[i]];
+            rgb[i * 3 + 0] = static_cast<uint8_t>(color);
+            rgb[i * 3 + 1] = static_cast<uint8_t>(color >> 8);
+            rgb[i * 3 + 2] = static_cast<uint8_t>(color >> 16);
+        }
+    }
+
+    void colorize_lut_sse(const uint16_t* depth, uint8_t* rgb, size_t pixels, const uint32_t* lut)
+    {
+        const int blocks = static_cast<int>((pixels + pixels_per_block - 1) / pixels_per_block);
+
+#pragma omp parallel for
+        for (int block = 0; block < blocks; block++)
+        {
+            const size_t begin = block * pixels_per_block;
+            colorize_block(depth + begin, rgb + begin * 3, std::min(pixels_per_block, pixels - begin), lut);
+        }
+    }
+}
+
+#endif // __SSSE3__
@@ -0,0 +1,17 @@
+/* License: Apache 2.0. See LICENSE file in root directory. */
+/* Copyright(c) 2020 Intel Corporation. All Rights Reserved. */
+#pragma once
+#ifdef __SSSE3__
+
+#include <cstdint>
+#include <cstddef>
+
+namespace librealsense
+{
+    // Colors the depth pixels by their entries in lut, each made of the R, G and B bytes and a zero byte.
+    // 16 pixels are looked up per step and their colors are packed into 3 vectors of RGB bytes by shuffles.
+    // Blocks of pixels are distributed between the OpenMP threads
+    void colorize_lut_sse(const uint16_t* depth, uint8_t* rgb, size_t pixels, const uint32_t* lut);
+}
+
+#endif // __SSSE3__
@@ -0,0 +1,216 @@
+/* License: Apache 2.0. See LICENSE file in root directory. */
+/* Copyright(c) 2020 Intel Corporation. All Rights Reserved. */
+
+#ifdef __SSSE3__
+
+#include "sse-decimation-filter.h"
+
+#include <tmmintrin.h> // For SSSE3 intrinsics
+
+namespace librealsense
+{
+    // Each lane holds the patch of one output pixel. The patch is sorted by a sorting network, the zero pixels
+    // first, and the lower median of the n - z valid pixels is then the element (n - 1 + z) / 2 of the patch.
+    // SSSE3 compares signed 16 bits only, so the pixels are biased by 0x8000 while sorted
+    const size_t pixels_per_step = 8;
+
+    static inline void sort2(__m128i& a, __m128i& b)
+    {
+        auto lo = _mm_min_epi16(a, b);
+        b = _mm_max_epi16(a, b);
+        a = lo;
+    }
+
+    static inline void sort4(__m128i* p)
+    {
+        sort2(p[0], p[1]); sort2(p[2], p[3]);
+        sort2(p[0], p[2]); sort2(p[1], p[3]);
+        sort2(p[1], p[2]);
+    }
+
+    static inline void sort9(__m128i* p)
+    {
+        sort2(p[0], p[1]); sort2(p[3], p[4]); sort2(p[6], p[7]);
+        sort2(p[1], p[2]); sort2(p[4], p[5]); sort2(p[7], p[8]);
+        sort2(p[0], p[1]); sort2(p[3], p[4]); sort2(p[6], p[7]);
+        sort2(p[0], p[3]); sort2(p[3], p[6]); sort2(p[0], p[3]);
+        sort2(p[1], p[4]); sort2(p[4], p[7]); sort2(p[1], p[4]);
+        sort2(p[2], p[5]); sort2(p[5], p[8]); sort2(p[2], p[5]);
+        sort2(p[1], p[3]); sort2(p[5], p[7]); sort2(p[2], p[6]);
+        sort2(p[4], p[6]); sort2(p[2], p[4]); sort2(p[2], p[3]);
+        sort2(p[5], p[6]);
+    }
+
+    // The lower median of the valid pixels of n patches of size kernel, or zero if none is valid
+    template<size_t kernel>
+    static inline __m128i lower_median(__m128i* p)
+    {
+        const __m128i bias = _mm_set1_epi16(-32768);
+
+        auto zeros = _mm_setzero_si128();
+        for (size_t k = 0; k < kernel; k++)
+        {
+            zeros = _mm_sub_epi16(zeros, _mm_cmpeq_epi16(p[k], _mm_setzero_si128()));
+            p[k] = _mm_xor_si128(p[k], bias);
+        }
+
+        if (kernel == 4)
+            sort4(p);
+        else
+            sort9(p);
+
+        auto index = _mm_srli_epi16(_mm_add_epi16(zeros, _mm_set1_epi16(kernel - 1)), 1);
+        auto median = _mm_setzero_si128();
+        for (size_t k = (kernel - 1) / 2; k < kernel; k++)
+            median = _mm_or_si128(median, _mm_and_si128(p[k], _mm_cmpeq_epi16(index, _mm_set1_epi16(static_cast<short>(k)))));
+
+        return _mm_xor_si128(median, bias);
+    }
+
+    // The same median for a single patch, for the pixels left over at the end of a row
+    static uint16_t lower_median(const uint16_t* rows[], size_t offset, size_t scale)
+    {
+        uint16_t valid[9];
+        size_t count = 0;
+        for (size_t n = 0; n < scale; n++)
+        {
+            for (size_t m = 0; m < scale; m++)
+            {
+                auto pixel = rows[n][offset + m];
+                if (!pixel)
+                    continue;
+
+                auto k = count++;
+                for (; k > 0 && valid[k - 1] > pixel; k--)
+                    valid[k] = valid[k - 1];
+                valid[k] = pixel;
+            }
+        }
+        return count ? valid[(count - 1) / 2] : 0;
+    }
+
+    // Splits 16 (scale 2) or 24 (scale 3) consecutive pixels of a row into their patch columns
+    class patch_columns
+    {
+    public:
+        patch_columns()
+        {
+            for (int c = 0; c < 3; c++)
+            {
+                for (int v = 0; v < 3; v++)
+                {
+                    uint8_t mask[16];
+                    for (int lane = 0; lane < 8; lane++)
+                    {
+                        int pixel = 3 * lane + c;
+                        bool from_v = pixel / 8 == v;
+                        mask[2 * lane] = from_v ? uint8_t(2 * (pixel % 8)) : 0x80;
+                        mask[2 * lane + 1] = from_v ? uint8_t(2 * (pixel % 8) + 1) : 0x80;
+                    }
+                    _thirds[c][v] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask));
+                }
+            }
+        }
+
+        void halves(const uint16_t* row, __m128i* columns) const
+        {
+            const __m128i even = _mm_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1);
+            const __m128i odd = _mm_setr_epi8(2, 3, 6, 7, 10, 11, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1);
+
+            auto v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row));
+            auto v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + 8));
+            columns[0] = _mm_unpacklo_epi64(_mm_shuffle_epi8(v0, even), _mm_shuffle_epi8(v1, even));
+            columns[1] = _mm_unpacklo_epi64(_mm_shuffle_epi8(v0, odd), _mm_shuffle_epi8(v1, odd));
+        }
+
+        void thirds(const uint16_t* row, __m128i* columns) const
+        {
+            __m128i v[3];
+            for (int k = 0; k < 3; k++)
+                v[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + 8 * k));
+
+            for (int c = 0; c < 3; c++)
+            {
+                columns[c] = _mm_or_si128(_mm_or_si128(
+                    _mm_shuffle_epi8(v[0], _thirds[c][0]),
+                    _mm_shuffle_epi8(v[1], _thirds[c][1])),
+                    _mm_shuffle_epi8(v[2], _thirds[c][2]));
+            }
+        }
+
+    private:
+        __m128i _thirds[3][3]; // shuffles of each of the 3 input vectors into the lanes of each column
+    };
+
+    void decimate_depth_median_sse(const uint16_t* frame_data_in, uint16_t* frame_data_out,
+        size_t width_in, size_t real_width, size_t real_height, size_t padded_width, size_t scale)
+    {
+        const patch_columns columns;
+        const int rows_out = static_cast<int>(real_height);
+
+#pragma omp parallel for
+        for (int j = 0; j < rows_out; j++)
+        {
+            const uint16_t* rows[3];
+            for (size_t n = 0; n < scale; n++)
+                rows[n] = frame_data_in + (j * scale + n) * width_in;
+            uint16_t* out = frame_data_out + j * padded_width;
+
+            size_t i = 0;
+            for (; i + pixels_per_step <= real_width; i += pixels_per_step)
+            {
+                __m128i patch[9];
+                if (scale == 2)
+                {
+                    columns.halves(rows[0] + 2 * i, patch);
+                    columns.halves(rows[1] + 2 * i, patch + 2);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), lower_median<4>(patch));
+                }
+                else
+                {
+                    columns.thirds(rows[0] + 3 * i, patch);
+                    columns.thirds(rows[1] + 3 * i, patch + 3);
+                    columns.thirds(rows[2] + 3 * i, patch + 6);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), lower_median<9>(patch));
+                }
+            }
+
+            for (; i < real_width; i++)
+                out[i] = lower_median(rows, i * scale, scale);
+
+            // Fill-in the padded colums with zeros
+            for (; i < padded_width; i++)
+                out[i] = 0;
+        }
+    }
+
+    void sum_rows_sse(const uint8_t* first_row, size_t stride, size_t rows, size_t length, uint16_t* sums)
+    {
+        const __m128i zero = _mm_setzero_si128();
+
+        size_t x = 0;
+        for (; x + 16 <= length; x += 16)
+        {
+            auto low = _mm_setzero_si128();
+            auto high = _mm_setzero_si128();
+            for (size_t n = 0; n < rows; n++)
+            {
+                auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first_row + n * stride + x));
+                low = _mm_add_epi16(low, _mm_unpacklo_epi8(v, zero));
+                high = _mm_add_epi16(high, _mm_unpackhi_epi8(v, zero));
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(sums + x), low);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(sums + x + 8), high);
+        }
+
+        for (; x < length; x++)
+        {
+            uint16_t sum = 0;
+            for (size_t n = 0; n < rows; n++)
+                sum += first_row[n * stride + x];
+            sums[x] = sum;
+        }
+    }
+}
+
+#endif // __SSSE3__
@@ -0,0 +1,23 @@
+/* License: Apache 2.0. See LICENSE file in root directory. */
+/* Copyright(c) 2020 Intel Corporation. All Rights Reserved. */
+#pragma once
+#ifdef __SSSE3__
+
+#include <cstdint>
+#include <cstddef>
+
+namespace librealsense
+{
+    // Median decimation of depth frames by 2 or 3, 8 output pixels per step from the 2 or 3 input rows
+    // of their patches, with the output rows distributed between the OpenMP threads.
+    // The zero pixels of a patch are ignored, and for an even number of valid pixels the one below
+    // the middle is picked, so that the results are identical to decimate_depth_median of decimation-filter-passes.h.
+    // Writes real_height rows of padded_width pixels, the padding columns set to zero
+    void decimate_depth_median_sse(const uint16_t* frame_data_in, uint16_t* frame_data_out,
+        size_t width_in, size_t real_width, size_t real_height, size_t padded_width, size_t scale);
+
+    // Sums of length bytes over rows consecutive rows, 16 bytes per step
+    void sum_rows_sse(const uint8_t* first_row, size_t stride, size_t rows, size_t length, uint16_t* sums);
+}
+
+#endif // __SSSE3__
@@ -0,0 +1,97 @@
+/* License: Apache 2.0. See LICENSE file in root directory. */
+/* Copyright(c) 2020 Intel Corporation. All Rights Reserved. */
+
+#ifdef __SSSE3__
+
+#include "sse-deinterleave.h"
+
+#include <algorithm>
+#include <tmmintrin.h> // For SSSE3 intrinsics
+
+namespace librealsense
+{
+    const size_t pixels_per_block = 4096;
+
+    static void split_y8i_block(uint8_t* left, uint8_t* right, const uint8_t* source, size_t begin, size_t end)
+    {
+        // Left bytes of 8 pixels to the low half, right bytes to the high half
+        const __m128i split = _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15);
+
+        size_t i = begin;
+        for (; i + 16 <= end; i += 16)
+        {
+            auto a = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 2)), split);
+            auto b = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 2 + 16)), split);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(left + i), _mm_unpacklo_epi64(a, b));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(right + i), _mm_unpackhi_epi64(a, b));
+        }
+
+        for (; i < end; i++)
+        {
+            left[i] = source[i * 2];
+            right[i] = source[i * 2 + 1];
+        }
+    }
+
+    void unpack_y8_y8_from_y8i_sse(uint8_t* left, uint8_t* right, const uint8_t* source, size_t count)
+    {
+        const int blocks = static_cast<int>((count + pixels_per_block - 1) / pixels_per_block);
+
+#pragma omp parallel for
+        for (int block = 0; block < blocks; block++)
+        {
+            const size_t begin = block * pixels_per_block;
+            split_y8i_block(left, right, source, begin, std::min(begin + pixels_per_block, count));
+        }
+    }
+
+    static inline uint16_t scale_y12i(int v)
+    {
+        return static_cast<uint16_t>(v << 6 | v >> 4);
+    }
+
+    static void split_y12i_block(uint16_t* left, uint16_t* right, const uint8_t* source, size_t begin, size_t end, size_t count)
+    {
+        // Pixel bytes b0 b1 b2 hold right = (b1 & 0xf) << 8 | b0 and left = b2 << 4 | b1 >> 4.
+        // The words (b0, b1) of 4 pixels go to the low half and the words (b1, b2) to the high half
+        const __m128i split = _mm_setr_epi8(0, 1, 3, 4, 6, 7, 9, 10, 1, 2, 4, 5, 7, 8, 10, 11);
+        const __m128i low_12_bits = _mm_set1_epi16(0x0fff);
+
+        // The second load of a step reads 4 bytes past the 8 pixels, which must still be in the source
+        const size_t vector_end = std::min(end, count >= 2 ? count - 2 : 0);
+
+        size_t i = begin;
+        for (; i + 8 <= vector_end; i += 8)
+        {
+            auto a = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 3)), split);
+            auto b = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 3 + 12)), split);
+
+            auto r = _mm_and_si128(_mm_unpacklo_epi64(a, b), low_12_bits);
+            auto l = _mm_srli_epi16(_mm_unpackhi_epi64(a, b), 4);
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(left + i), _mm_or_si128(_mm_slli_epi16(l, 6), _mm_srli_epi16(l, 4)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(right + i), _mm_or_si128(_mm_slli_epi16(r, 6), _mm_srli_epi16(r, 4)));
+        }
+
+        for (; i < end; i++)
+        {
+            auto p = source + i * 3;
+            left[i] = scale_y12i(p[2] << 4 | p[1] >> 4);
+            right[i] = scale_y12i((p[1] & 0xf) << 8 | p[0]);
+        }
+    }
+
+    void unpack_y16_y16_from_y12i_10_sse(uint16_t* left, uint16_t* right, const uint8_t* source, size_t count)
+    {
+        const int blocks = static_cast<int>((count + pixels_per_block - 1) / pixels_per_block);
+
+#pragma omp parallel for
+        for (int block = 0; block < blocks; block++)
+        {
+            const size_t begin = block * pixels_per_block;
+            split_y12i_block(left, right, source, begin, std::min(begin + pixels_per_block, count), count);
+        }
+    }
+}
+
+#endif // __SSSE3__
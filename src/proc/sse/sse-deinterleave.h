@@ -0,0 +1,21 @@
+/* License: Apache 2.0. See LICENSE file in root directory. */
+/* Copyright(c) 2020 Intel Corporation. All Rights Reserved. */
+#pragma once
+#ifdef __SSSE3__
+
+#include <cstdint>
+#include <cstddef>
+
+namespace librealsense
+{
+    // Splits count Y8I pixels, each made of a left and a right byte, into the left and right Y8 images.
+    // 16 pixels are split per step by shuffles, and blocks of pixels are distributed between the OpenMP threads
+    void unpack_y8_y8_from_y8i_sse(uint8_t* left, uint8_t* right, const uint8_t* source, size_t count);
+
+    // Splits count Y12I pixels, each made of 3 bytes holding the right and the left 12-bit values, into the
+    // left and right Y16 images, scaling the values as v << 6 | v >> 4.
+    // 8 pixels are split per step by shuffles, and blocks of pixels are distributed between the OpenMP threads
+    void unpack_y16_y16_from_y12i_10_sse(uint16_t* left, uint16_t* right, const uint8_t* source, size_t count);
+}
+
+#endif // __SSSE3__
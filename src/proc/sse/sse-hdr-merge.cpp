@@ -0,0 +1,128 @@
+/* License: Apache 2.0. See LICENSE file in root directory. */
+/* Copyright(c) 2020 Intel Corporation. All Rights Reserved. */
+
+#ifdef __SSSE3__
+
+#include "sse-hdr-merge.h"
+
+#include <algorithm>
+#include <tmmintrin.h> // For SSSE3 intrinsics
+
+namespace librealsense
+{
+    const size_t pixels_per_block = 4096;
+
+    // The infrared pixels of a step, widened to 16 bits
+    static inline __m128i load_ir(const uint8_t* ir)
+    {
+        return _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(ir)), _mm_setzero_si128());
+    }
+
+    static inline __m128i load_ir(const uint16_t* ir)
+    {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ir));
+    }
+
+    // No infrared check, for the depth only merge
+    struct no_ir {};
+
+    template<class IR>
+    static inline bool is_valid(uint16_t depth, const IR* const ir[], size_t k, size_t i, int low, int high)
+    {
+        return depth && ir[k][i] > low && ir[k][i] < high;
+    }
+
+    static inline bool is_valid(uint16_t depth, const no_ir* const ir[], size_t k, size_t i, int low, int high)
+    {
+        return depth != 0;
+    }
+
+    template<class IR>
+    static inline __m128i valid_mask(__m128i depth, const IR* const ir[], size_t k, size_t i, __m128i low, __m128i high)
+    {
+        // The infrared values are compared as signed words: values from 0x8000 fail the lower bound
+        // instead of the upper one, which gives the same result
+        auto ir_values = load_ir(ir[k] + i);
+        auto in_range = _mm_and_si128(_mm_cmpgt_epi16(ir_values, low), _mm_cmpgt_epi16(high, ir_values));
+        return _mm_andnot_si128(_mm_cmpeq_epi16(depth, _mm_setzero_si128()), in_range);
+    }
+
+    static inline __m128i valid_mask(__m128i depth, const no_ir* const ir[], size_t k, size_t i, __m128i low, __m128i high)
+    {
+        return _mm_xor_si128(_mm_cmpeq_epi16(depth, _mm_setzero_si128()), _mm_set1_epi16(-1));
+    }
+
+    template<class IR>
+    static void merge_block(uint16_t* out, const uint16_t* const depth[], const IR* const ir[],
+        size_t frames, size_t begin, size_t end, int low, int high)
+    {
+        const __m128i low_bound = _mm_set1_epi16(static_cast<short>(low));
+        const __m128i high_bound = _mm_set1_epi16(static_cast<short>(high));
+
+        size_t i = begin;
+        for (; i + 8 <= end; i += 8)
+        {
+            auto merged = _mm_setzero_si128();
+            auto taken = _mm_setzero_si128();
+            for (size_t k = 0; k < frames; k++)
+            {
+                auto d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(depth[k] + i));
+                auto valid = valid_mask(d, ir, k, i, low_bound, high_bound);
+
+                merged = _mm_or_si128(merged, _mm_and_si128(_mm_andnot_si128(taken, valid), d));
+                taken = _mm_or_si128(taken, valid);
+
+                // The next frames cannot change pixels that are already taken
+                if (_mm_movemask_epi8(taken) == 0xffff)
+                    break;
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), merged);
+        }
+
+        for (; i < end; i++)
+        {
+            out[i] = 0;
+            for (size_t k = 0; k < frames; k++)
+            {
+                if (is_valid(depth[k][i], ir, k, i, low, high))
+                {
+                    out[i] = depth[k][i];
+                    break;
+                }
+            }
+        }
+    }
+
+    template<class IR>
+    static void merge(uint16_t* out, const uint16_t* const depth[], const IR* const ir[],
+        size_t frames, size_t count, int low, int high)
+    {
+        const int blocks = static_cast<int>((count + pixels_per_block - 1) / pixels_per_block);
+
+#pragma omp parallel for
+        for (int block = 0; block < blocks; block++)
+        {
+            const size_t begin = block * pixels_per_block;
+            merge_block(out, depth, ir, frames, begin, std::min(begin + pixels_per_block, count), low, high);
+        }
+    }
+
+    void merge_depth_sse(uint16_t* out, const uint16_t* const depth[], size_t frames, size_t count)
+    {
+        merge<no_ir>(out, depth, nullptr, frames, count, 0, 0);
+    }
+
+    void merge_depth_with_ir_sse(uint16_t* out, const uint16_t* const depth[], const uint8_t* const ir[],
+        size_t frames, size_t count, int low, int high)
+    {
+        merge(out, depth, ir, frames, count, low, high);
+    }
+
+    void merge_depth_with_ir_sse(uint16_t* out, const uint16_t* const depth[], const uint16_t* const ir[],
+        size_t frames, size_t count, int low, int high)
+    {
+        merge(out, depth, ir, frames, count, low, high);
+    }
+}
+
+#endif // __SSSE3__
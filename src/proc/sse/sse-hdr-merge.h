@@ -0,0 +1,24 @@
+/* License: Apache 2.0. See LICENSE file in root directory. */
+/* Copyright(c) 2020 Intel Corporation. All Rights Reserved. */
+#pragma once
+#ifdef __SSSE3__
+
+#include <cstdint>
+#include <cstddef>
+
+namespace librealsense
+{
+    // Merges the depth of a sequence of frames: each pixel is taken from the first frame in which it is valid,
+    // or is zero if it is valid in none. A depth pixel is valid when it is not zero.
+    // 8 pixels are merged per step by masks instead of branches, and blocks of pixels are distributed
+    // between the OpenMP threads
+    void merge_depth_sse(uint16_t* out, const uint16_t* const depth[], size_t frames, size_t count);
+
+    // The same, where a depth pixel is also required to have an infrared pixel in the range (low, high)
+    void merge_depth_with_ir_sse(uint16_t* out, const uint16_t* const depth[], const uint8_t* const ir[],
+        size_t frames, size_t count, int low, int high);
+    void merge_depth_with_ir_sse(uint16_t* out, const uint16_t* const depth[], const uint16_t* const ir[],
+        size_t frames, size_t count, int low, int high);
+}
+
+#endif // __SSSE3__
@@ -8,6 +8,8 @@
 #include "environment.h"
 #include "proc/occlusion-filter.h"
 #include "proc/sse/sse-pointcloud.h"
+#include "proc/sse/avx-pointcloud.h"
+#include "proc/sse/cpu-features.h"
 #include "option.h"
 #include "environment.h"
 #include "context.h"
@@ -29,28 +31,18 @@ namespace librealsense
         _pre_compute_map_x.resize(_depth_intrinsics->width*_depth_intrinsics->height);
         _pre_compute_map_y.resize(_depth_intrinsics->width*_depth_intrinsics->height);
 
+        // The maps hold every pixel deprojected to depth 1, so that the vectorized
+        // deprojection matches rs2_deproject_pixel_to_point for any distortion model
         for (int h = 0; h < _depth_intrinsics->height; ++h)
         {
             for (int w = 0; w < _depth_intrinsics->width; ++w)
             {
                 const float pixel[] = { (float)w, (float)h };
+                float point[3];
+                rs2_deproject_pixel_to_point(point, &_depth_intrinsics.value(), pixel, 1.f);
 
-                float x = (pixel[0] - _depth_intrinsics->ppx) / _depth_intrinsics->fx;
-                float y = (pixel[1] - _depth_intrinsics->ppy) / _depth_intrinsics->fy;
-
-
-                if (_depth_intrinsics->model == RS2_DISTORTION_INVERSE_BROWN_CONRADY)
-                {
-                    float r2 = x * x + y * y;
-                    float f = 1 + _depth_intrinsics->coeffs[0] * r2 + _depth_intrinsics->coeffs[1] * r2*r2 + _depth_intrinsics->coeffs[4] * r2*r2*r2;
-                    float ux = x * f + 2 * _depth_intrinsics->coeffs[2] * x*y + _depth_intrinsics->coeffs[3] * (r2 + 2 * x*x);
-                    float uy = y * f + 2 * _depth_intrinsics->coeffs[3] * x*y + _depth_intrinsics->coeffs[2] * (r2 + 2 * y*y);
-                    x = ux;
-                    y = uy;
-                }
-
-                _pre_compute_map_x[h*_depth_intrinsics->width + w] = x;
-                _pre_compute_map_y[h*_depth_intrinsics->width + w] = y;
+                _pre_compute_map_x[h*_depth_intrinsics->width + w] = point[0];
+                _pre_compute_map_y[h*_depth_intrinsics->width + w] = point[1];
             }
         }
     }
@@ -60,6 +52,20 @@ namespace librealsense
             const rs2::depth_frame& depth_frame,
             float depth_scale)
     {
+        static const bool avx512 = has_avx512_support();
+        static const bool avx2 = has_avx2_support();
+        if (avx512 || avx2)
+        {
+            auto points = (float*)output.get_vertices();
+            auto depth = (const uint16_t*)depth_frame.get_data();
+            size_t count = size_t(depth_intrinsics.width) * depth_intrinsics.height;
+            if (avx512)
+                deproject_depth_avx512(points, depth, _pre_compute_map_x.data(), _pre_compute_map_y.data(), count, depth_scale);
+            else
+                deproject_depth_avx2(points, depth, _pre_compute_map_x.data(), _pre_compute_map_y.data(), count, depth_scale);
+            return (float3*)points;
+        }
+
 #ifdef __SSSE3__
 
         auto depth_image = (const uint16_t*)depth_frame.get_data();
@@ -149,6 +155,27 @@ namespace librealsense
     {
         auto tex_ptr = (float2*)output.get_texture_coordinates();
 
+        static const bool avx512 = has_avx512_support();
+        static const bool avx2 = has_avx2_support();
+        if ((avx512 || avx2) && is_texture_map_vectorized(other_intrinsics.model))
+        {
+            auto count = size_t(width) * height;
+            if (avx512)
+                get_texture_map_avx512((float*)tex_ptr, (float*)pixels_ptr, (const float*)points, count, other_intrinsics, extr);
+            else
+                get_texture_map_avx2((float*)tex_ptr, (float*)pixels_ptr, (const float*)points, count, other_intrinsics, extr);
+            return;
+        }
+
+        // The SSE kernel implements only the (inverse) modified Brown-Conrady distortion
+        if (other_intrinsics.model != RS2_DISTORTION_NONE &&
+            other_intrinsics.model != RS2_DISTORTION_MODIFIED_BROWN_CONRADY &&
+            other_intrinsics.model != RS2_DISTORTION_INVERSE_BROWN_CONRADY)
+        {
+            pointcloud::get_texture_map(output, points, width, height, other_intrinsics, extr, pixels_ptr);
+            return;
+        }
+
 #ifdef __SSSE3__
         auto point = reinterpret_cast<const float*>(points);
         auto res = reinterpret_cast<float*>(tex_ptr);
@@ -178,6 +205,7 @@ namespace librealsense
         auto w = _mm_set_ps1(float(other_intrinsics.width));
         auto h = _mm_set_ps1(float(other_intrinsics.height));
         auto mask_inv_brown_conrady = _mm_set_ps1(RS2_DISTORTION_INVERSE_BROWN_CONRADY);
+        auto mask_modified_brown_conrady = _mm_set_ps1(RS2_DISTORTION_MODIFIED_BROWN_CONRADY);
         auto zero = _mm_set_ps1(0);
         auto one = _mm_set_ps1(1);
         auto two = _mm_set_ps1(2);
@@ -219,15 +247,13 @@ namespace librealsense
             auto d_x = _mm_add_ps(x_f, _mm_add_ps(_mm_mul_ps(two, _mm_mul_ps(c[2], _mm_mul_ps(x_f, y_f))), r4));
 
             auto r5 = _mm_mul_ps(c[2], _mm_add_ps(r2, _mm_mul_ps(two, _mm_mul_ps(y_f, y_f))));
-            auto d_y = _mm_add_ps(y_f, _mm_add_ps(_mm_mul_ps(two, _mm_mul_ps(c[3], _mm_mul_ps(x_f, y_f))), r4));
+            auto d_y = _mm_add_ps(y_f, _mm_add_ps(_mm_mul_ps(two, _mm_mul_ps(c[3], _mm_mul_ps(x_f, y_f))), r5));
 
-            auto cmp = _mm_cmpeq_ps(mask_inv_brown_conrady, dist);
+            auto cmp = _mm_or_ps(_mm_cmpeq_ps(mask_inv_brown_conrady, dist), _mm_cmpeq_ps(mask_modified_brown_conrady, dist));
 
             p_x = _mm_or_ps(_mm_and_ps(cmp, d_x), _mm_andnot_ps(cmp, p_x));
             p_y = _mm_or_ps(_mm_and_ps(cmp, d_y), _mm_andnot_ps(cmp, p_y));
 
-            //TODO: add handle to RS2_DISTORTION_FTHETA
-
             //zero the x and y if z is zero
             cmp = _mm_cmpneq_ps(z, zero);
             p_x = _mm_and_ps(_mm_add_ps(_mm_mul_ps(p_x, fx), ppx), cmp);
@@ -0,0 +1,324 @@
+/* License: Apache 2.0. See LICENSE file in root directory. */
+/* Copyright(c) 2020 Intel Corporation. All Rights Reserved. */
+
+#ifdef __SSSE3__
+
+#include "sse-spatial-filter.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+#include <tmmintrin.h> // For SSSE3 intrinsics
+
+namespace librealsense
+{
+    // The recursive filters run along independent lines. Each step object filters 4 lines, one per lane,
+    // and every group of lines is split between two step objects so that their dependency chains overlap.
+    // The arithmetic follows the scalar filters operation by operation, so that the results are identical
+    const int lanes = 4;
+    const int lines_per_group = 2 * lanes;
+
+    static inline __m128 blend(__m128 mask, __m128 a, __m128 b)
+    {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+
+    static inline __m128 abs_ps(__m128 v)
+    {
+        return _mm_andnot_ps(_mm_set1_ps(-0.f), v);
+    }
+
+    // Conversion to the integer type of the depth frames, which rounds towards zero
+    static inline __m128 truncate(__m128 v)
+    {
+        return _mm_cvtepi32_ps(_mm_cvttps_epi32(v));
+    }
+
+    // Depth horizontal pass: smoothing of the valid neighbors and inertial holes filling.
+    // As in the scalar filter, pixels of value 1 count as holes right to left only,
+    // and neighbors of the same depth are smoothed right to left only
+    class depth_horizontal_step
+    {
+    public:
+        depth_horizontal_step(float alpha, float delta, uint8_t radius, bool left_to_right)
+            : _alpha(_mm_set1_ps(alpha)), _beta(_mm_set1_ps(1.f - alpha)),
+              _delta(_mm_set1_ps(static_cast<float>(static_cast<uint16_t>(delta)))),
+              _radius(_mm_set1_ps(radius)), _fill_holes(radius != 0),
+              _cur_threshold(_mm_set1_ps(left_to_right ? 1.f : 2.f)), _min_diff(left_to_right ? 1.f : 0.f),
+              _prev(_mm_setzero_ps()), _fill(_mm_setzero_ps())
+        {}
+
+        void init(__m128 first) { _prev = first; _fill = _mm_setzero_ps(); }
+
+        __m128 next(__m128 cur)
+        {
+            const __m128 one = _mm_set1_ps(1.f);
+            auto prev_valid = _mm_cmpge_ps(_prev, one);
+            auto cur_valid = _mm_cmpge_ps(cur, _cur_threshold);
+            auto both_valid = _mm_and_ps(prev_valid, cur_valid);
+
+            auto diff = abs_ps(_mm_sub_ps(cur, _prev));
+            auto smooth = _mm_and_ps(both_valid, _mm_and_ps(_mm_cmple_ps(diff, _delta), _mm_cmpge_ps(diff, _mm_set1_ps(_min_diff))));
+            auto filtered = _mm_add_ps(_mm_mul_ps(cur, _alpha), _mm_mul_ps(_prev, _beta));
+            auto out = blend(smooth, truncate(_mm_add_ps(filtered, _mm_set1_ps(0.5f))), cur);
+
+            if (_fill_holes)
+            {
+                auto hole = _mm_andnot_ps(cur_valid, prev_valid);
+                _fill = _mm_add_ps(_mm_andnot_ps(both_valid, _fill), _mm_and_ps(hole, one));
+                out = blend(_mm_and_ps(hole, _mm_cmplt_ps(_fill, _radius)), _prev, out);
+            }
+            _prev = out;
+            return out;
+        }
+
+    private:
+        __m128 _alpha, _beta, _delta, _radius;
+        bool _fill_holes;
+        __m128 _cur_threshold;
+        float _min_diff;
+        __m128 _prev, _fill; // the last output and the length of the current fill
+    };
+
+    // Depth vertical pass: smoothing of neighbors closer than delta, the valid ones only when bottom to top
+    class depth_vertical_step
+    {
+    public:
+        depth_vertical_step(float alpha, float delta, bool valid_only)
+            : _alpha(_mm_set1_ps(alpha)), _beta(_mm_set1_ps(1.f - alpha)),
+              _delta(_mm_set1_ps(static_cast<float>(static_cast<uint16_t>(delta)))),
+              _valid_only(valid_only), _prev(_mm_setzero_ps())
+        {}
+
+        void init(__m128 first) { _prev = first; }
+
+        __m128 next(__m128 cur)
+        {
+            auto smooth = _mm_cmplt_ps(abs_ps(_mm_sub_ps(cur, _prev)), _delta);
+            if (_valid_only)
+            {
+                const __m128 one = _mm_set1_ps(1.f);
+                smooth = _mm_and_ps(smooth, _mm_and_ps(_mm_cmpge_ps(cur, one), _mm_cmpge_ps(_prev, one)));
+            }
+            auto filtered = _mm_add_ps(_mm_mul_ps(cur, _alpha), _mm_mul_ps(_prev, _beta));
+            _prev = blend(smooth, truncate(_mm_add_ps(filtered, _mm_set1_ps(0.5f))), cur);
+            return _prev;
+        }
+
+    private:
+        __m128 _alpha, _beta, _delta;
+        bool _valid_only;
+        __m128 _prev;
+    };
+
+    // Disparity passes, in both directions: the state is reset at every edge,
+    // while the edges are detected on the unfiltered values
+    class disparity_step
+    {
+    public:
+        disparity_step(float alpha, float delta)
+            : _alpha(_mm_set1_ps(alpha)), _beta(_mm_set1_ps(1.f - alpha)),
+              _delta(_mm_set1_ps(delta)), _minus_delta(_mm_set1_ps(-delta)),
+              _state(_mm_setzero_ps()), _prev(_mm_setzero_ps()), _prev_valid(_mm_setzero_ps())
+        {}
+
+        void init(__m128 first) { _state = _prev = first; _prev_valid = is_valid(first); }
+
+        __m128 next(__m128 cur)
+        {
+            auto cur_valid = is_valid(cur);
+            auto delta = _mm_sub_ps(_prev, cur);
+            auto smooth = _mm_and_ps(_mm_and_ps(_prev_valid, cur_valid),
+                _mm_and_ps(_mm_cmplt_ps(delta, _delta), _mm_cmpgt_ps(delta, _minus_delta)));
+            auto filtered = _mm_add_ps(_mm_mul_ps(cur, _alpha), _mm_mul_ps(_state, _beta));
+
+            // The state of an invalid pixel is never used, as the next valid pixel resets it
+            _state = blend(smooth, filtered, cur);
+            _prev = cur;
+            _prev_valid = cur_valid;
+            return _state;
+        }
+
+    private:
+        // Positive values, compared as integers like the scalar filter
+        static __m128 is_valid(__m128 v)
+        {
+            return _mm_castsi128_ps(_mm_cmpgt_epi32(_mm_castps_si128(v), _mm_setzero_si128()));
+        }
+
+        __m128 _alpha, _beta, _delta, _minus_delta;
+        __m128 _state, _prev, _prev_valid;
+    };
+
+    static inline __m128 load(const uint16_t* p)
+    {
+        return _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)), _mm_setzero_si128()));
+    }
+
+    static inline void store(uint16_t* p, __m128 v)
+    {
+        const __m128i low_words = _mm_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_shuffle_epi8(_mm_cvttps_epi32(v), low_words));
+    }
+
+    static inline __m128 load(const float* p) { return _mm_loadu_ps(p); }
+    static inline void store(float* p, __m128 v) { _mm_storeu_ps(p, v); }
+
+    template<class T>
+    static inline __m128 gather(T* const* lines, size_t offset)
+    {
+        return _mm_setr_ps(float(lines[0][offset]), float(lines[1][offset]), float(lines[2][offset]), float(lines[3][offset]));
+    }
+
+    template<class T>
+    static inline void scatter(T* const* lines, size_t offset, __m128 v)
+    {
+        float values[lanes];
+        _mm_storeu_ps(values, v);
+        for (int i = 0; i < lanes; ++i)
+            lines[i][offset] = static_cast<T>(values[i]);
+    }
+
+    // Filters the rows from column first to column last, starting from the value of column first.
+    // The columns are transposed into the lanes 4x4 pixels at a time
+    template<class T, class Step>
+    static void filter_rows(T* image, size_t width, size_t height, int first, int last, const Step& prototype)
+    {
+        const int dir = last >= first ? 1 : -1;
+        const int groups = int((height + lines_per_group - 1) / lines_per_group);
+
+#pragma omp parallel for
+        for (int g = 0; g < groups; ++g)
+        {
+            // The lanes past the last row filter a copy of the first row of the group, and are discarded
+            const size_t first_row = size_t(g) * lines_per_group;
+            const int count = int(std::min<size_t>(lines_per_group, height - first_row));
+            std::vector<T> padding;
+            if (count < lines_per_group)
+                padding.assign(image + first_row * width, image + (first_row + 1) * width);
+
+            T* rows[lines_per_group];
+            for (int i = 0; i < lines_per_group; ++i)
+                rows[i] = i < count ? image + (first_row + i) * width : padding.data();
+
+            Step steps[] = { prototype, prototype };
+            for (int s = 0; s < 2; ++s)
+                steps[s].init(gather(rows + s * lanes, first));
+
+            int u = first + dir;
+            int remaining = std::abs(last - first);
+            for (; remaining >= lanes; remaining -= lanes, u += lanes * dir)
+            {
+                const size_t column = dir > 0 ? u : u - lanes + 1;
+                __m128 tiles[2][lanes];
+                for (int s = 0; s < 2; ++s)
+                {
+                    for (int i = 0; i < lanes; ++i)
+                        tiles[s][i] = load(rows[s * lanes + i] + column);
+                    _MM_TRANSPOSE4_PS(tiles[s][0], tiles[s][1], tiles[s][2], tiles[s][3]);
+                }
+                for (int i = 0; i < lanes; ++i)
+                {
+                    auto c = dir > 0 ? i : lanes - 1 - i;
+                    tiles[0][c] = steps[0].next(tiles[0][c]);
+                    tiles[1][c] = steps[1].next(tiles[1][c]);
+                }
+                for (int s = 0; s < 2; ++s)
+                {
+                    _MM_TRANSPOSE4_PS(tiles[s][0], tiles[s][1], tiles[s][2], tiles[s][3]);
+                    for (int i = 0; i < lanes; ++i)
+                        store(rows[s * lanes + i] + column, tiles[s][i]);
+                }
+            }
+            for (; remaining > 0; --remaining, u += dir)
+            {
+                for (int s = 0; s < 2; ++s)
+                    scatter(rows + s * lanes, u, steps[s].next(gather(rows + s * lanes, u)));
+            }
+        }
+    }
+
+    // Filters the columns from row first to row last, starting from the value of row first
+    template<class T, class Step>
+    static void filter_columns(T* image, size_t width, size_t height, int first, int last, const Step& prototype)
+    {
+        const int dir = last >= first ? 1 : -1;
+        const int strips = int((width + lines_per_group - 1) / lines_per_group);
+
+#pragma omp parallel for
+        for (int s = 0; s < strips; ++s)
+        {
+            const size_t column = size_t(s) * lines_per_group;
+            const bool partial = column + lines_per_group > width;
+            // The columns past the last one filter a copy of the last column, and are discarded
+            T values[lines_per_group];
+            auto line = [&](int row) -> T*
+            {
+                auto p = image + row * width + column;
+                if (!partial)
+                    return p;
+                for (int i = 0; i < lines_per_group; ++i)
+                    values[i] = p[std::min<size_t>(i, width - column - 1)];
+                return values;
+            };
+            auto write_back = [&](int row)
+            {
+                if (partial)
+                    std::copy(values, values + width - column, image + row * width + column);
+            };
+
+            Step steps[] = { prototype, prototype };
+            auto p = line(first);
+            steps[0].init(load(p));
+            steps[1].init(load(p + lanes));
+            for (int v = first + dir; v != last + dir; v += dir)
+            {
+                p = line(v);
+                auto a = steps[0].next(load(p));
+                auto b = steps[1].next(load(p + lanes));
+                store(p, a);
+                store(p + lanes, b);
+                write_back(v);
+            }
+        }
+    }
+
+    void dxf_horizontal_pass_sse(uint16_t* image, size_t width, size_t height,
+        float alpha, float delta, uint8_t holes_filling_radius)
+    {
+        if (width < 2)
+            return;
+        int last = int(width) - 1;
+        filter_rows(image, width, height, 0, last - 1, depth_horizontal_step(alpha, delta, holes_filling_radius, true));
+        filter_rows(image, width, height, last, 0, depth_horizontal_step(alpha, delta, holes_filling_radius, false));
+    }
+
+    void dxf_vertical_pass_sse(uint16_t* image, size_t width, size_t height, float alpha, float delta)
+    {
+        if (height < 2)
+            return;
+        int last = int(height) - 1;
+        filter_columns(image, width, height, 0, last, depth_vertical_step(alpha, delta, false));
+        filter_columns(image, width, height, last, 0, depth_vertical_step(alpha, delta, true));
+    }
+
+    void dxf_horizontal_pass_sse(float* image, size_t width, size_t height, float alpha, float delta)
+    {
+        if (width < 2)
+            return;
+        int last = int(width) - 1;
+        filter_rows(image, width, height, 0, last, disparity_step(alpha, delta));
+        filter_rows(image, width, height, last, 0, disparity_step(alpha, delta));
+    }
+
+    void dxf_vertical_pass_sse(float* image, size_t width, size_t height, float alpha, float delta)
+    {
+        if (height < 2)
+            return;
+        int last = int(height) - 1;
+        filter_columns(image, width, height, 0, last, disparity_step(alpha, delta));
+        filter_columns(image, width, height, last, 0, disparity_step(alpha, delta));
+    }
+}
+
+#endif // __SSSE3__
@@ -0,0 +1,26 @@
+/* License: Apache 2.0. See LICENSE file in root directory. */
+/* Copyright(c) 2020 Intel Corporation. All Rights Reserved. */
+#pragma once
+#ifdef __SSSE3__
+
+#include <cstdint>
+#include <cstddef>
+
+namespace librealsense
+{
+    // Vectorized passes of the spatial filter domain transform.
+    // Every pass filters 8 rows (horizontal) or columns (vertical) at a time, one per SIMD lane,
+    // and the groups of lines are distributed between the OpenMP threads.
+    // The results are identical to the scalar passes of spatial-filter-passes.h
+
+    // Depth frames: edge-preserving smoothing with inertial holes filling up to holes_filling_radius pixels (0 - disabled)
+    void dxf_horizontal_pass_sse(uint16_t* image, size_t width, size_t height,
+        float alpha, float delta, uint8_t holes_filling_radius);
+    void dxf_vertical_pass_sse(uint16_t* image, size_t width, size_t height, float alpha, float delta);
+
+    // Disparity frames: edge-preserving smoothing, the holes are filled by a separate pass
+    void dxf_horizontal_pass_sse(float* image, size_t width, size_t height, float alpha, float delta);
+    void dxf_vertical_pass_sse(float* image, size_t width, size_t height, float alpha, float delta);
+}
+
+#endif // __SSSE3__
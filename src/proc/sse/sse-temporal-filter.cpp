@@ -0,0 +1,268 @@
+/* License: Apache 2.0. See LICENSE file in root directory. */
+/* Copyright(c) 2020 Intel Corporation. All Rights Reserved. */
+
+#ifdef __SSSE3__
+
+#include "sse-temporal-filter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <tmmintrin.h> // For SSSE3 intrinsics
+
+namespace librealsense
+{
+    // Every step filters 8 consecutive pixels, and the frame is split into bands of rows for the OpenMP threads.
+    // The arithmetic follows temporal_filter::temp_jw_smooth operation by operation, so that the results are identical
+    const size_t pixels_per_step = 8;
+    const size_t rows_per_band = 16;
+
+    static inline __m128i blend(__m128i mask, __m128i a, __m128i b)
+    {
+        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+    }
+
+    static inline __m128 blend(__m128 mask, __m128 a, __m128 b)
+    {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+
+    // Whether the persistence map credits the history bytes in the current phase.
+    // The map is reduced to a set of 256 bits, and the byte of the set holding the bit of every history,
+    // followed by the bit itself, are looked up with byte shuffles instead of gathers
+    class persistence_lookup
+    {
+    public:
+        persistence_lookup(const uint8_t* persistence_map, uint8_t mask)
+        {
+            uint8_t bits[32] = {};
+            for (int h = 0; h < 256; h++)
+            {
+                if (persistence_map[h] & mask)
+                    bits[h >> 3] |= uint8_t(1 << (h & 7));
+            }
+            _low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bits));
+            _high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bits + 16));
+        }
+
+        // 0xff in the bytes of the credible histories, 0 in the others
+        __m128i credible(__m128i history) const
+        {
+            const __m128i bit_of = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+
+            auto index = _mm_and_si128(_mm_srli_epi16(history, 3), _mm_set1_epi8(0x1f));
+            auto high = _mm_cmpeq_epi8(_mm_and_si128(index, _mm_set1_epi8(0x10)), _mm_set1_epi8(0x10));
+            auto byte = blend(high, _mm_shuffle_epi8(_high, index), _mm_shuffle_epi8(_low, index));
+            auto bit = _mm_shuffle_epi8(bit_of, _mm_and_si128(history, _mm_set1_epi8(7)));
+            return _mm_cmpeq_epi8(_mm_and_si128(byte, bit), bit);
+        }
+
+    private:
+        __m128i _low, _high; // bytes 0-15 and 16-31 of the set
+    };
+
+    // The scalar filter, for the pixels left over at the end of a band
+    template<typename T>
+    class pixel_step
+    {
+    public:
+        pixel_step(float alpha, float one_minus_alpha, uint8_t delta, uint8_t mask, const uint8_t* persistence_map)
+            : _alpha(alpha), _one_minus_alpha(one_minus_alpha), _delta(static_cast<T>(delta)),
+              _mask(mask), _persistence_map(persistence_map)
+        {}
+
+        void next(const T& cur_val, T& out, T& last, uint8_t& history) const
+        {
+            T prev_val = last;
+            out = cur_val;
+
+            if (cur_val)
+            {
+                if (!prev_val)
+                {
+                    last = cur_val;
+                    history = _mask;
+                }
+                else
+                {
+                    T diff = static_cast<T>(fabs(cur_val - prev_val));
+
+                    if (diff < _delta)
+                    {
+                        history |= _mask;
+                        float filtered = _alpha * cur_val + _one_minus_alpha * prev_val;
+                        T result = static_cast<T>(filtered);
+                        out = result;
+                        last = result;
+                    }
+                    else
+                    {
+                        last = cur_val;
+                        history = _mask;
+                    }
+                }
+            }
+            else
+            {
+                if (prev_val && (_persistence_map[history] & _mask))
+                    out = prev_val;
+                history &= ~_mask;
+            }
+        }
+
+    private:
+        float _alpha, _one_minus_alpha;
+        T _delta;
+        uint8_t _mask;
+        const uint8_t* _persistence_map;
+    };
+
+    // The history of the 8 pixels of a step, updated by the masks of their valid and smoothed pixels
+    static inline __m128i next_history(__m128i history, __m128i mask, __m128i cur_valid, __m128i agree)
+    {
+        return blend(cur_valid, _mm_or_si128(_mm_and_si128(agree, history), mask), _mm_andnot_si128(mask, history));
+    }
+
+    class depth_step
+    {
+    public:
+        depth_step(float alpha, float one_minus_alpha, uint8_t delta, uint8_t mask, const uint8_t* persistence_map)
+            : _alpha(_mm_set1_ps(alpha)), _one_minus_alpha(_mm_set1_ps(one_minus_alpha)),
+              _delta(_mm_set1_epi16(delta)), _mask(_mm_set1_epi8(static_cast<char>(mask))),
+              _lookup(persistence_map, mask)
+        {}
+
+        void next(const uint16_t* in, uint16_t* out, uint16_t* last, uint8_t* history) const
+        {
+            const __m128i zero = _mm_setzero_si128();
+            // The low 16 bits of the four 32 bits lanes
+            const __m128i low_halves = _mm_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1);
+
+            auto cur = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+            auto prev = _mm_loadu_si128(reinterpret_cast<const __m128i*>(last));
+            auto hist = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(history));
+
+            auto cur_zero = _mm_cmpeq_epi16(cur, zero);
+            auto prev_zero = _mm_cmpeq_epi16(prev, zero);
+            auto diff = _mm_or_si128(_mm_subs_epu16(cur, prev), _mm_subs_epu16(prev, cur));
+            auto far = _mm_cmpeq_epi16(_mm_subs_epu16(_delta, diff), zero);         // diff >= delta
+            auto agree = _mm_andnot_si128(_mm_or_si128(far, _mm_or_si128(cur_zero, prev_zero)), _mm_set1_epi16(-1));
+
+            auto filtered_low = _mm_add_ps(
+                _mm_mul_ps(_alpha, _mm_cvtepi32_ps(_mm_unpacklo_epi16(cur, zero))),
+                _mm_mul_ps(_one_minus_alpha, _mm_cvtepi32_ps(_mm_unpacklo_epi16(prev, zero))));
+            auto filtered_high = _mm_add_ps(
+                _mm_mul_ps(_alpha, _mm_cvtepi32_ps(_mm_unpackhi_epi16(cur, zero))),
+                _mm_mul_ps(_one_minus_alpha, _mm_cvtepi32_ps(_mm_unpackhi_epi16(prev, zero))));
+            auto result = _mm_unpacklo_epi64(
+                _mm_shuffle_epi8(_mm_cvttps_epi32(filtered_low), low_halves),
+                _mm_shuffle_epi8(_mm_cvttps_epi32(filtered_high), low_halves));
+
+            auto credible = _lookup.credible(hist);
+            auto fill = _mm_andnot_si128(prev_zero, _mm_unpacklo_epi8(credible, credible));
+
+            auto value = blend(agree, result, blend(cur_zero, blend(fill, prev, cur), cur));
+            auto kept = blend(agree, result, blend(cur_zero, prev, cur));
+
+            auto cur_valid8 = _mm_packs_epi16(_mm_andnot_si128(cur_zero, _mm_set1_epi16(-1)), zero);
+            auto agree8 = _mm_packs_epi16(agree, zero);
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), value);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(last), kept);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(history), next_history(hist, _mask, cur_valid8, agree8));
+        }
+
+    private:
+        __m128 _alpha, _one_minus_alpha;
+        __m128i _delta, _mask;
+        persistence_lookup _lookup;
+    };
+
+    class disparity_step
+    {
+    public:
+        disparity_step(float alpha, float one_minus_alpha, uint8_t delta, uint8_t mask, const uint8_t* persistence_map)
+            : _alpha(_mm_set1_ps(alpha)), _one_minus_alpha(_mm_set1_ps(one_minus_alpha)),
+              _delta(_mm_set1_ps(static_cast<float>(delta))), _mask(_mm_set1_epi8(static_cast<char>(mask))),
+              _lookup(persistence_map, mask)
+        {}
+
+        void next(const float* in, float* out, float* last, uint8_t* history) const
+        {
+            auto hist = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(history));
+            auto credible = _lookup.credible(hist);
+            credible = _mm_unpacklo_epi8(credible, credible);
+
+            __m128i cur_valid[2], agree[2];
+            for (int half = 0; half < 2; half++)
+            {
+                auto cur = _mm_loadu_ps(in + 4 * half);
+                auto prev = _mm_loadu_ps(last + 4 * half);
+
+                // As in the scalar filter, any value other than 0 is valid
+                auto cur_nz = _mm_cmpneq_ps(cur, _mm_setzero_ps());
+                auto prev_nz = _mm_cmpneq_ps(prev, _mm_setzero_ps());
+                auto diff = _mm_andnot_ps(_mm_set1_ps(-0.f), _mm_sub_ps(cur, prev));
+                auto both = _mm_and_ps(_mm_and_ps(cur_nz, prev_nz), _mm_cmplt_ps(diff, _delta));
+
+                auto result = _mm_add_ps(_mm_mul_ps(_alpha, cur), _mm_mul_ps(_one_minus_alpha, prev));
+                auto lane_credible = half ? _mm_unpackhi_epi16(credible, credible) : _mm_unpacklo_epi16(credible, credible);
+                auto fill = _mm_and_ps(prev_nz, _mm_castsi128_ps(lane_credible));
+
+                _mm_storeu_ps(out + 4 * half, blend(both, result, blend(cur_nz, cur, blend(fill, prev, cur))));
+                _mm_storeu_ps(last + 4 * half, blend(both, result, blend(cur_nz, cur, prev)));
+
+                cur_valid[half] = _mm_castps_si128(cur_nz);
+                agree[half] = _mm_castps_si128(both);
+            }
+
+            auto cur_valid8 = _mm_packs_epi16(_mm_packs_epi32(cur_valid[0], cur_valid[1]), _mm_setzero_si128());
+            auto agree8 = _mm_packs_epi16(_mm_packs_epi32(agree[0], agree[1]), _mm_setzero_si128());
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(history), next_history(hist, _mask, cur_valid8, agree8));
+        }
+
+    private:
+        __m128 _alpha, _one_minus_alpha, _delta;
+        __m128i _mask;
+        persistence_lookup _lookup;
+    };
+
+    template<typename T, typename Step>
+    static void smooth_bands(const T* frame_in, T* frame_out, T* last_frame, uint8_t* history,
+        size_t width, size_t height, const Step& step, const pixel_step<T>& tail)
+    {
+        const int bands = static_cast<int>((height + rows_per_band - 1) / rows_per_band);
+
+#pragma omp parallel for
+        for (int band = 0; band < bands; band++)
+        {
+            const size_t end = std::min(height, (band + 1) * rows_per_band) * width;
+            size_t i = band * rows_per_band * width;
+
+            for (; i + pixels_per_step <= end; i += pixels_per_step)
+                step.next(frame_in + i, frame_out + i, last_frame + i, history + i);
+
+            for (; i < end; i++)
+                tail.next(frame_in[i], frame_out[i], last_frame[i], history[i]);
+        }
+    }
+
+    void temp_jw_smooth_sse(const uint16_t* frame_in, uint16_t* frame_out, uint16_t* last_frame, uint8_t* history,
+        size_t width, size_t height, float alpha, float one_minus_alpha, uint8_t delta,
+        uint8_t mask, const uint8_t* persistence_map)
+    {
+        smooth_bands(frame_in, frame_out, last_frame, history, width, height,
+            depth_step(alpha, one_minus_alpha, delta, mask, persistence_map),
+            pixel_step<uint16_t>(alpha, one_minus_alpha, delta, mask, persistence_map));
+    }
+
+    void temp_jw_smooth_sse(const float* frame_in, float* frame_out, float* last_frame, uint8_t* history,
+        size_t width, size_t height, float alpha, float one_minus_alpha, uint8_t delta,
+        uint8_t mask, const uint8_t* persistence_map)
+    {
+        smooth_bands(frame_in, frame_out, last_frame, history, width, height,
+            disparity_step(alpha, one_minus_alpha, delta, mask, persistence_map),
+            pixel_step<float>(alpha, one_minus_alpha, delta, mask, persistence_map));
+    }
+}
+
+#endif // __SSSE3__
@@ -0,0 +1,25 @@
+/* License: Apache 2.0. See LICENSE file in root directory. */
+/* Copyright(c) 2020 Intel Corporation. All Rights Reserved. */
+#pragma once
+#ifdef __SSSE3__
+
+#include <cstdint>
+#include <cstddef>
+
+namespace librealsense
+{
+    // Vectorized exponential smoothing and persistence of the temporal filter.
+    // The input frame is read and the filtered pixels are written to the output frame, so the output
+    // does not need to hold a copy of the input beforehand. last_frame and history (one byte per pixel)
+    // are updated in place, and persistence_map is the 256 entries table of the filter, looked up without
+    // gathers. Bands of rows are distributed between the OpenMP threads.
+    // The results are identical to temp_jw_smooth_pass
+    void temp_jw_smooth_sse(const uint16_t* frame_in, uint16_t* frame_out, uint16_t* last_frame, uint8_t* history,
+        size_t width, size_t height, float alpha, float one_minus_alpha, uint8_t delta,
+        uint8_t mask, const uint8_t* persistence_map);
+    void temp_jw_smooth_sse(const float* frame_in, float* frame_out, float* last_frame, uint8_t* history,
+        size_t width, size_t height, float alpha, float one_minus_alpha, uint8_t delta,
+        uint8_t mask, const uint8_t* persistence_map);
+}
+
+#endif // __SSSE3__
@@ -16,19 +16,31 @@ namespace librealsense
     {
         _matcher->set_callback([this](frame_holder f, syncronization_environment env)
         {
-            std::stringstream ss;
-            ss << "SYNCED: ";
-            auto composite = dynamic_cast<composite_frame*>(f.frame);
-            for (int i = 0; i < composite->get_embedded_frames_count(); i++)
+            if (is_log_enabled(RS2_LOG_SEVERITY_DEBUG))
             {
-                auto matched = composite->get_frame(i);
-                ss << matched->get_stream()->get_stream_type() << " " << matched->get_frame_number() << ", "<<std::fixed<< matched->get_frame_timestamp()<<" ";
-            }
+                std::stringstream ss;
+                ss << "SYNCED: ";
+                auto composite = dynamic_cast<composite_frame*>(f.frame);
+                for (int i = 0; i < composite->get_embedded_frames_count(); i++)
+                {
+                    auto matched = composite->get_frame(i);
+                    ss << matched->get_stream()->get_stream_type() << " " << matched->get_frame_number() << ", "<<std::fixed<< matched->get_frame_timestamp()<<" ";
+                }
 
-            LOG_DEBUG(ss.str());
+                LOG_DEBUG(ss.str());
+            }
             env.matches.enqueue(std::move(f));
         });
 
+        auto max_wait = std::make_shared<ptr_option<float>>(0.f, 10000.f, 1.f, 0.f, &_max_wait,
+            "Maximal time in milliseconds a frameset waits for the frames of missing streams, 0 to wait as long as they are expected");
+        max_wait->on_set([this](float val)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _matcher->set_max_wait(val);
+        });
+        register_option(RS2_OPTION_SYNC_MAX_WAIT, max_wait);
+
         auto f = [&](frame_holder frame, synthetic_source_interface* source)
         {
             // if the syncer is disabled passthrough the frame
@@ -53,15 +65,14 @@ namespace librealsense
                 return;
             }
 
-            single_consumer_frame_queue<frame_holder> matches;
-
             {
                 std::lock_guard<std::mutex> lock(_mutex);
-                _matcher->dispatch(std::move(frame), { source, matches });
+                _matcher->dispatch(std::move(frame), { source, _matches });
             }
 
+            // Framesets released for another thread may be handed over too, in their order
             frame_holder f;
-            while (matches.try_dequeue(&f))
+            while (_matches.try_dequeue(&f))
                 get_source().frame_ready(std::move(f));
 
         };
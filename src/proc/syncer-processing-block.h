@@ -36,5 +36,8 @@ namespace librealsense
     private:
         std::unique_ptr<timestamp_composite_matcher> _matcher;
         std::vector< std::weak_ptr<bool_option> > _enable_opts;
+        // Framesets released by the matcher, handed to the source outside of the lock
+        single_consumer_frame_queue<frame_holder> _matches;
+        float _max_wait = 0.f;
     };
 }
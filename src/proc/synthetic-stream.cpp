@@ -2,12 +2,14 @@
 // Copyright(c) 2017 Intel Corporation. All Rights Reserved.
 
 #include "proc/synthetic-stream.h"
+#include "proc/processing-executor.h"
 
 #include "core/video.h"
 #include "option.h"
 #include "context.h"
 #include "stream.h"
 #include "types.h"
+#include "latency-trace.h"
 
 namespace librealsense
 {
@@ -23,15 +25,139 @@ namespace librealsense
     }
 
     processing_block::processing_block(const char* name) :
-        _source_wrapper(_source)
+        _source_wrapper(_source), _trace_name(latency_tracer::instance().intern(name))
     {
         register_option(RS2_OPTION_FRAMES_QUEUE_SIZE, _source.get_published_size_option());
         register_info(RS2_CAMERA_INFO_NAME, name);
         _source.init(std::shared_ptr<metadata_parser_map>());
     }
 
+    // Frames of an asynchronous block wait in the inbox until a single task drains them on the executor,
+    // so that they are processed one at a time and in order
+    class processing_block::async_invocation : public std::enable_shared_from_this<async_invocation>
+    {
+    public:
+        async_invocation(std::weak_ptr<processing_block> owner, std::shared_ptr<processing_executor> executor,
+            unsigned int queue_size, const char* trace_name)
+            : _owner(std::move(owner)), _executor(std::move(executor)), _inbox(queue_size), _scheduled(false), _trace_name(trace_name)
+        {}
+
+        void enqueue(frame_holder f)
+        {
+            if (latency_tracer::is_enabled())
+                latency_tracer::instance().begin_wait(_trace_name, f->get_trace_span());
+
+            // A worker waiting for room in a full inbox could starve the executor of the threads
+            // that would drain it, so an upstream stage processes blocking frames in place instead
+            if (f->is_blocking() && processing_executor::is_worker_thread())
+            {
+                if (_inbox.try_enqueue(std::move(f)))
+                {
+                    schedule();
+                    return;
+                }
+
+                if (latency_tracer::is_enabled())
+                    latency_tracer::instance().end_wait(_trace_name, f->get_trace_span());
+                std::lock_guard<std::recursive_mutex> lock(_running);
+                auto owner = _attached ? _owner.lock() : nullptr;
+                frame_holder pending;
+                while (owner && _inbox.try_dequeue(&pending))
+                {
+                    if (latency_tracer::is_enabled())
+                        latency_tracer::instance().end_wait(_trace_name, pending->get_trace_span());
+                    owner->process_synchronously(std::move(pending));
+                }
+                if (owner)
+                    owner->process_synchronously(std::move(f));
+                return;
+            }
+
+            _inbox.enqueue(std::move(f), trace_dropped_wait(_trace_name));
+            schedule();
+        }
+
+        // Stop processing and wait for the frame being processed, if any
+        void detach()
+        {
+            std::lock_guard<std::recursive_mutex> lock(_running);
+            _attached = false;
+            _inbox.clear(trace_dropped_wait(_trace_name));
+        }
+
+    private:
+        void schedule()
+        {
+            // Pairs with the fence in drain(): either the drain sees the new frame or we see it is done
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!_scheduled.exchange(true))
+            {
+                auto self = shared_from_this();
+                _executor->post([self]() { self->drain(); });
+            }
+        }
+
+        void drain()
+        {
+            // Recursive, as the processing callback may change the executor of its own block
+            std::lock_guard<std::recursive_mutex> lock(_running);
+            {
+                // The block is released before the lock, so that a block released by its last owner
+                // meanwhile is destroyed here, once the processing is over
+                auto owner = _attached ? _owner.lock() : nullptr;
+                frame_holder f;
+                while (owner && _attached && _inbox.try_dequeue(&f))
+                {
+                    if (latency_tracer::is_enabled())
+                        latency_tracer::instance().end_wait(_trace_name, f->get_trace_span());
+                    owner->process_synchronously(std::move(f));
+                }
+            }
+
+            _scheduled = false;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (_attached && _inbox.size())
+                schedule();
+        }
+
+        std::weak_ptr<processing_block> _owner;
+        bool _attached = true; // guarded by _running
+        // Shared, as a frame may still be scheduled after the block moved to another executor
+        std::shared_ptr<processing_executor> _executor;
+        single_consumer_frame_queue<frame_holder, lockfree_queue> _inbox;
+        std::atomic<bool> _scheduled;
+        std::recursive_mutex _running;
+        const char* _trace_name;
+    };
+
+    void processing_block::set_executor(std::shared_ptr<processing_executor> executor, std::weak_ptr<processing_block> self,
+        unsigned int queue_size)
+    {
+        if (executor && self.expired())
+            throw invalid_value_exception("an asynchronous processing block must be owned by a shared_ptr");
+
+        std::lock_guard<std::mutex> lock(_executor_mutex);
+
+        std::shared_ptr<async_invocation> async;
+        if (executor)
+            async = std::make_shared<async_invocation>(std::move(self), executor, std::max(queue_size, 1u), _trace_name);
+
+        auto previous = std::atomic_exchange(&_async, async);
+        if (previous)
+            previous->detach();
+    }
+
     void processing_block::invoke(frame_holder f)
     {
+        if (auto async = std::atomic_load(&_async))
+            async->enqueue(std::move(f));
+        else
+            process_synchronously(std::move(f));
+    }
+
+    void processing_block::process_synchronously(frame_holder f)
+    {
+        trace_scope stage(_trace_name, f ? f->get_trace_span() : 0);
         auto callback = _source.begin_callback();
         try
         {
@@ -247,8 +373,22 @@ namespace librealsense
         }
         byte* planes[1];
         planes[0] = (byte*)ret.get_data();
+        const int actual_size = height * width * _target_bpp;
 
-        process_function(planes, static_cast<const byte*>(f.get_data()), width, height, height * width * _target_bpp, raw_size);
+        // Convert when the output data is first read, so that frames that are dropped
+        // or only inspected for their metadata are never converted
+        auto self = _deferred_self.lock();
+        auto output = dynamic_cast<librealsense::frame*>((frame_interface*)ret.get());
+        if (self && output)
+        {
+            output->defer_data([this, self, f, planes, width, height, actual_size, raw_size]()
+            {
+                process_function(planes, static_cast<const byte*>(f.get_data()), width, height, actual_size, raw_size);
+            });
+            return ret;
+        }
+
+        process_function(planes, static_cast<const byte*>(f.get_data()), width, height, actual_size, raw_size);
 
         return ret;
     }
@@ -331,6 +471,7 @@ namespace librealsense
             data.metadata_size = 0;
             data.system_time = _actual_source.get_time();
             data.is_blocking = original->is_blocking();
+            data.trace_span = original->get_trace_span();
 
             auto res = _actual_source.alloc_frame(frame_type, vid_stream->get_width() * vid_stream->get_height() * sizeof(float) * 5, data, true);
             if (!res) throw wrong_api_call_sequence_exception("Out of frame resources!");
@@ -461,6 +602,8 @@ namespace librealsense
         auto req_size = 0;
         for (auto&& f : holders)
             req_size += get_embeded_frames_size(f.frame);
+        if (!holders.empty() && holders.front())
+            d.trace_span = holders.front()->get_trace_span();
 
         auto res = _actual_source.alloc_frame(RS2_EXTENSION_COMPOSITE_FRAME, req_size * sizeof(rs2_frame*), d, true);
         if (!res) return nullptr;
@@ -550,6 +693,29 @@ namespace librealsense
         _processing_blocks.back()->set_output_callback(callback);
     }
 
+    void composite_processing_block::set_frame_allocator(frame_allocator_ptr allocator)
+    {
+        // Frames are produced by the chained blocks, not by the composite itself
+        processing_block::set_frame_allocator(allocator);
+        for (auto&& pb : _processing_blocks)
+            pb->set_frame_allocator(allocator);
+    }
+
+    void composite_processing_block::set_executor(std::shared_ptr<processing_executor> executor, std::weak_ptr<processing_block> self,
+        unsigned int queue_size)
+    {
+        // Each chained block runs as a separate stage, so consecutive frames overlap across the chain
+        for (auto&& pb : _processing_blocks)
+            pb->set_executor(executor, pb, queue_size);
+    }
+
+    void composite_processing_block::enable_deferred_processing(std::weak_ptr<processing_block> self)
+    {
+        // Only the output of the last block reaches the user, the others are read by the next block
+        if (!_processing_blocks.empty())
+            _processing_blocks.back()->enable_deferred_processing(_processing_blocks.back());
+    }
+
     void composite_processing_block::invoke(frame_holder frames)
     {
         // Invoke the first processing block.
@@ -557,6 +723,60 @@ namespace librealsense
         _processing_blocks.front()->invoke(std::move(frames));
     }
 
+    // The conversion of an interleaved frame, shared by its two outputs. The first output to be read converts
+    // both planes, and the plane of an output that was released unread is converted into a scratch buffer
+    class interleaved_conversion
+    {
+    public:
+        // An output plane, which stays a destination of the conversion while its frame holds it
+        struct plane
+        {
+            plane(std::shared_ptr<interleaved_conversion> conversion, int index) : conversion(conversion), index(index) {}
+            ~plane() { conversion->drop_plane(index); }
+
+            std::shared_ptr<interleaved_conversion> conversion;
+            int index;
+        };
+
+        interleaved_conversion(std::function<void(byte* const[])> process, byte* const planes[2], int left_size, int right_size)
+            : _process(std::move(process)), _planes{ planes[0], planes[1] }, _sizes{ left_size, right_size } {}
+
+        void convert()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_process)
+                return;
+
+            std::vector<byte> scratch;
+            byte* planes[2];
+            for (int i = 0; i < 2; i++)
+            {
+                planes[i] = _planes[i];
+                if (!planes[i])
+                {
+                    scratch.resize(_sizes[i]);
+                    planes[i] = scratch.data();
+                }
+            }
+            _process(planes);
+
+            // Release the source frame
+            _process = nullptr;
+        }
+
+    private:
+        void drop_plane(int index)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _planes[index] = nullptr;
+        }
+
+        std::mutex _mutex;
+        std::function<void(byte* const[])> _process;
+        byte* _planes[2];
+        int _sizes[2];
+    };
+
     interleaved_functional_processing_block::interleaved_functional_processing_block(const char* name,
         rs2_format source_format,
         rs2_format left_target_format,
@@ -635,7 +855,27 @@ namespace librealsense
             planes[0] = (byte*)lf.frame->get_frame_data();
             planes[1] = (byte*)rf.frame->get_frame_data();
 
-            process_function(planes, (const byte*)frame->get_frame_data(), w, h, 0, 0);
+            auto self = _deferred_self.lock();
+            auto left = dynamic_cast<librealsense::frame*>(lf.frame);
+            auto right = dynamic_cast<librealsense::frame*>(rf.frame);
+            if (self && left && right)
+            {
+                // Both outputs are converted together when either one is first read
+                auto source_frame = std::make_shared<frame_holder>(std::move(frame));
+                auto conversion = std::make_shared<interleaved_conversion>([this, self, source_frame, w, h](byte* const dest[])
+                {
+                    process_function(dest, (const byte*)(*source_frame)->get_frame_data(), w, h, 0, 0);
+                }, planes, w * h * _left_target_bpp, w * h * _right_target_bpp);
+
+                auto left_plane = std::make_shared<interleaved_conversion::plane>(conversion, 0);
+                auto right_plane = std::make_shared<interleaved_conversion::plane>(conversion, 1);
+                left->defer_data([left_plane]() { left_plane->conversion->convert(); });
+                right->defer_data([right_plane]() { right_plane->conversion->convert(); });
+            }
+            else
+            {
+                process_function(planes, (const byte*)frame->get_frame_data(), w, h, 0, 0);
+            }
 
             source->frame_ready(std::move(lf));
             source->frame_ready(std::move(rf));
@@ -45,6 +45,8 @@ namespace librealsense
         std::shared_ptr<rs2_source> _c_wrapper;
     };
 
+    class processing_executor;
+
     class LRS_EXTENSION_API processing_block : public processing_block_interface, public options_container, public info_container
     {
     public:
@@ -54,13 +56,37 @@ namespace librealsense
         void set_output_callback(frame_callback_ptr callback) override;
         void invoke(frame_holder frames) override;
         synthetic_source_interface& get_source() override { return _source_wrapper; }
-
-        virtual ~processing_block() { _source.flush(); }
+        virtual void set_frame_allocator(frame_allocator_ptr allocator) { _source.set_allocator(allocator); }
+
+        // Process the frames on the workers of the executor instead of the invoking thread.
+        // Up to queue_size frames wait for the block, older frames are dropped unless they are blocking.
+        // Frames still waiting when the executor is replaced are dropped, nullptr restores synchronous processing.
+        // The workers hold the block alive through self while they process its frames, so the block is never
+        // destroyed under a worker
+        virtual void set_executor(std::shared_ptr<processing_executor> executor, std::weak_ptr<processing_block> self,
+            unsigned int queue_size = 1);
+        bool is_asynchronous() const { return std::atomic_load(&_async) != nullptr; }
+
+        // Lets the blocks that support it defer their conversion to the first read of the output data.
+        // The output frames hold the block alive through this reference until they are converted or released
+        virtual void enable_deferred_processing(std::weak_ptr<processing_block> self) { _deferred_self = self; }
+
+        virtual ~processing_block() { set_executor(nullptr, {}); _source.flush(); }
     protected:
+        void process_synchronously(frame_holder frames);
+
         frame_source _source;
         std::mutex _mutex;
         frame_processor_callback_ptr _callback;
         synthetic_source _source_wrapper;
+        std::weak_ptr<processing_block> _deferred_self;
+
+    private:
+        class async_invocation;
+
+        std::mutex _executor_mutex;
+        std::shared_ptr<async_invocation> _async;
+        const char* _trace_name; // the block name, as recorded in the latency trace
     };
 
     class LRS_EXTENSION_API generic_processing_block : public processing_block
@@ -251,6 +277,10 @@ namespace librealsense
         void add(std::shared_ptr<processing_block> block);
         void set_output_callback(frame_callback_ptr callback) override;
         void invoke(frame_holder frames) override;
+        void set_frame_allocator(frame_allocator_ptr allocator) override;
+        void set_executor(std::shared_ptr<processing_executor> executor, std::weak_ptr<processing_block> self,
+            unsigned int queue_size = 1) override;
+        void enable_deferred_processing(std::weak_ptr<processing_block> self) override;
 
     protected:
         std::vector<std::shared_ptr<processing_block>> _processing_blocks;
@@ -0,0 +1,167 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2017 Intel Corporation. All Rights Reserved.
+
+#include <cmath>
+
+#include "proc/temporal-filter-passes.h"
+
+namespace librealsense
+{
+    template<typename T>
+    static void temporal_smoothing(const T* frame_in, T* frame, T* last_frame, uint8_t* history, size_t pixels,
+        float alpha, float one_minus_alpha, uint8_t delta, uint8_t mask, const uint8_t* persistence_map)
+    {
+        T delta_z = static_cast<T>(delta);
+
+        // pass one -- go through image and update all
+        for (size_t i = 0; i < pixels; i++)
+        {
+            T cur_val = frame_in[i];
+            T prev_val = last_frame[i];
+            frame[i] = cur_val;
+
+            if (cur_val)
+            {
+                if (!prev_val)
+                {
+                    last_frame[i] = cur_val;
+                    history[i] = mask;
+                }
+                else
+                {  // old and new val
+                    T diff = static_cast<T>(fabs(cur_val - prev_val));
+
+                    if (diff < delta_z)
+                    {  // old and new val agree
+                        history[i] |= mask;
+                        float filtered = alpha * cur_val + one_minus_alpha * prev_val;
+                        T result = static_cast<T>(filtered);
+                        frame[i] = result;
+                        last_frame[i] = result;
+                    }
+                    else
+                    {
+                        last_frame[i] = cur_val;
+                        history[i] = mask;
+                    }
+                }
+            }
+            else
+            {  // no cur_val
+                if (prev_val)
+                { // only case we can help
+                    unsigned char hist = history[i];
+                    unsigned char classification = persistence_map[hist];
+                    if (classification & mask)
+                    { // we have had enough samples lately
+                        frame[i] = prev_val;
+                    }
+                }
+                history[i] &= ~mask;
+            }
+        }
+    }
+
+    void temp_jw_smooth_pass(const uint16_t* frame_in, uint16_t* frame_out, uint16_t* last_frame, uint8_t* history,
+        size_t width, size_t height, float alpha, float one_minus_alpha, uint8_t delta,
+        uint8_t mask, const uint8_t* persistence_map)
+    {
+        temporal_smoothing(frame_in, frame_out, last_frame, history, width * height,
+            alpha, one_minus_alpha, delta, mask, persistence_map);
+    }
+
+    void temp_jw_smooth_pass(const float* frame_in, float* frame_out, float* last_frame, uint8_t* history,
+        size_t width, size_t height, float alpha, float one_minus_alpha, uint8_t delta,
+        uint8_t mask, const uint8_t* persistence_map)
+    {
+        temporal_smoothing(frame_in, frame_out, last_frame, history, width * height,
+            alpha, one_minus_alpha, delta, mask, persistence_map);
+    }
+
+    void make_persistence_map(uint8_t persistence_param, std::array<uint8_t, PRESISTENCY_LUT_SIZE>& persistence_map)
+    {
+        persistence_map.fill(0);
+
+        for (size_t i = 0; i < persistence_map.size(); i++)
+        {
+            unsigned char last_7 = !!(i & 1);  // old
+            unsigned char last_6 = !!(i & 2);
+            unsigned char last_5 = !!(i & 4);
+            unsigned char last_4 = !!(i & 8);
+            unsigned char last_3 = !!(i & 16);
+            unsigned char last_2 = !!(i & 32);
+            unsigned char last_1 = !!(i & 64);
+            unsigned char lastFrame = !!(i & 128); // new
+
+            if (persistence_param == 1)
+            {
+                int sum = lastFrame + last_1 + last_2 + last_3 + last_4 + last_5 + last_6 + last_7;
+                if (sum >= 8)  // valid in eight of the last eight frames
+                    persistence_map[i] = 1;
+            }
+            else if (persistence_param == 2) // <--- default choice in current libRS implementation
+            {
+                int sum = lastFrame + last_1 + last_2;
+                if (sum >= 2) // valid in two of the last three frames
+                    persistence_map[i] = 1;
+            }
+            else if (persistence_param == 3) // <--- default choice recommended
+            {
+                int sum = lastFrame + last_1 + last_2 + last_3;
+                if (sum >= 2)  // valid in two of the last four frames
+                    persistence_map[i] = 1;
+            }
+            else if (persistence_param == 4)
+            {
+                int sum = lastFrame + last_1 + last_2 + last_3 + last_4 + last_5 + last_6 + last_7;
+                if (sum >= 2) // valid in two of the last eight frames
+                    persistence_map[i] = 1;
+            }
+            else if (persistence_param == 5)
+            {
+                int sum = lastFrame + last_1;
+                if (sum >= 1) // valid in one of the last two frames
+                    persistence_map[i] = 1;
+            }
+            else if (persistence_param == 6)
+            {
+                int sum = lastFrame + last_1 + last_2 + last_3 + last_4;
+                if (sum >= 1)  // valid in one of the last five frames
+                    persistence_map[i] = 1;
+            }
+            else if (persistence_param == 7) //  <--- most filling
+            {
+                int sum = lastFrame + last_1 + last_2 + last_3 + last_4 + last_5 + last_6 + last_7;
+                if (sum >= 1) // valid in one of the last eight frames
+                    persistence_map[i] = 1;
+            }
+            else if (persistence_param == 8) //  <--- all 1's
+            {
+                persistence_map[i] = 1;
+            }
+            else // all others, including 0, no persistance
+            {
+            }
+        }
+
+        // Convert to credible enough
+        std::array<uint8_t, PRESISTENCY_LUT_SIZE> credible_threshold;
+        credible_threshold.fill(0);
+
+        for (auto phase = 0; phase < 8; phase++)
+        {
+            // evaluating last phase
+            //int ephase = (phase + 7) % 8;
+            unsigned char mask = 1 << phase;
+            int i;
+
+            for (i = 0; i < 256; i++) {
+                unsigned char pos = (unsigned char)((i << (8 - phase)) | (i >> phase));
+                if (persistence_map[pos])
+                    credible_threshold[i] |= mask;
+            }
+        }
+        // Store results
+        persistence_map = credible_threshold;
+    }
+}
@@ -0,0 +1,26 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2017 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+namespace librealsense
+{
+    const size_t PRESISTENCY_LUT_SIZE = 256;
+
+    // Scalar exponential smoothing and persistence of the temporal filter.
+    // The input frame is read and the filtered pixels are written to the output frame, last_frame and
+    // history (one byte per pixel) are updated in place. mask selects the bit of the current frame in the history
+    void temp_jw_smooth_pass(const uint16_t* frame_in, uint16_t* frame_out, uint16_t* last_frame, uint8_t* history,
+        size_t width, size_t height, float alpha, float one_minus_alpha, uint8_t delta,
+        uint8_t mask, const uint8_t* persistence_map);
+    void temp_jw_smooth_pass(const float* frame_in, float* frame_out, float* last_frame, uint8_t* history,
+        size_t width, size_t height, float alpha, float one_minus_alpha, uint8_t delta,
+        uint8_t mask, const uint8_t* persistence_map);
+
+    // Encodes whether a particular 8 bit history is good enough for all 8 phases of storage
+    void make_persistence_map(uint8_t persistence_param, std::array<uint8_t, PRESISTENCY_LUT_SIZE>& persistence_map);
+}
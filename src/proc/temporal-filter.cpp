@@ -113,11 +113,11 @@ namespace librealsense
         update_configuration(f);
         auto tgt = prepare_target_frame(f, source);
 
-        // Temporal filter execution
+        // Temporal filter execution, writing every pixel of the target
         if (_extension_type == RS2_EXTENSION_DISPARITY_FRAME)
-            temp_jw_smooth<float>(const_cast<void*>(tgt.get_data()), _last_frame.data(), _history.data());
+            temp_jw_smooth<float>(f.get_data(), const_cast<void*>(tgt.get_data()), _last_frame.data(), _history.data());
         else
-            temp_jw_smooth<uint16_t>(const_cast<void*>(tgt.get_data()), _last_frame.data(), _history.data());
+            temp_jw_smooth<uint16_t>(f.get_data(), const_cast<void*>(tgt.get_data()), _last_frame.data(), _history.data());
 
         return tgt;
     }
@@ -171,104 +171,19 @@ namespace librealsense
             _last_frame.resize(_current_frm_size_pixels*_bpp);
 
             _history.clear();
-            _history.resize(_current_frm_size_pixels*_bpp);
+            _history.resize(_current_frm_size_pixels);
 
         }
     }
 
     rs2::frame temporal_filter::prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source)
     {
-        // Allocate and copy the content of the original Depth data to the target
-        rs2::frame tgt = source.allocate_video_frame(_target_stream_profile, f, (int)_bpp, (int)_width, (int)_height, (int)_stride, _extension_type);
-
-        memmove(const_cast<void*>(tgt.get_data()), f.get_data(), _current_frm_size_pixels * _bpp);
-        return tgt;
+        // Allocate the target only, the filter writes all of its pixels from the original Depth data
+        return source.allocate_video_frame(_target_stream_profile, f, (int)_bpp, (int)_width, (int)_height, (int)_stride, _extension_type);
     }
 
     void temporal_filter::recalc_persistence_map()
     {
-        _persistence_map.fill(0);
-
-        for (size_t i = 0; i < _persistence_map.size(); i++)
-        {
-            unsigned char last_7 = !!(i & 1);  // old
-            unsigned char last_6 = !!(i & 2);
-            unsigned char last_5 = !!(i & 4);
-            unsigned char last_4 = !!(i & 8);
-            unsigned char last_3 = !!(i & 16);
-            unsigned char last_2 = !!(i & 32);
-            unsigned char last_1 = !!(i & 64);
-            unsigned char lastFrame = !!(i & 128); // new
-
-            if (_persistence_param == 1)
-            {
-                int sum = lastFrame + last_1 + last_2 + last_3 + last_4 + last_5 + last_6 + last_7;
-                if (sum >= 8)  // valid in eight of the last eight frames
-                    _persistence_map[i] = 1;
-            }
-            else if (_persistence_param == 2) // <--- default choice in current libRS implementation
-            {
-                int sum = lastFrame + last_1 + last_2;
-                if (sum >= 2) // valid in two of the last three frames
-                    _persistence_map[i] = 1;
-            }
-            else if (_persistence_param == 3) // <--- default choice recommended
-            {
-                int sum = lastFrame + last_1 + last_2 + last_3;
-                if (sum >= 2)  // valid in two of the last four frames
-                    _persistence_map[i] = 1;
-            }
-            else if (_persistence_param == 4)
-            {
-                int sum = lastFrame + last_1 + last_2 + last_3 + last_4 + last_5 + last_6 + last_7;
-                if (sum >= 2) // valid in two of the last eight frames
-                    _persistence_map[i] = 1;
-            }
-            else if (_persistence_param == 5)
-            {
-                int sum = lastFrame + last_1;
-                if (sum >= 1) // valid in one of the last two frames
-                    _persistence_map[i] = 1;
-            }
-            else if (_persistence_param == 6)
-            {
-                int sum = lastFrame + last_1 + last_2 + last_3 + last_4;
-                if (sum >= 1)  // valid in one of the last five frames
-                    _persistence_map[i] = 1;
-            }
-            else if (_persistence_param == 7) //  <--- most filling
-            {
-                int sum = lastFrame + last_1 + last_2 + last_3 + last_4 + last_5 + last_6 + last_7;
-                if (sum >= 1) // valid in one of the last eight frames
-                    _persistence_map[i] = 1;
-            }
-            else if (_persistence_param == 8) //  <--- all 1's
-            {
-                _persistence_map[i] = 1;
-            }
-            else // all others, including 0, no persistance
-            {
-            }
-        }
-
-        // Convert to credible enough
-        std::array<uint8_t, PRESISTENCY_LUT_SIZE> credible_threshold;
-        credible_threshold.fill(0);
-
-        for (auto phase = 0; phase < 8; phase++)
-        {
-            // evaluating last phase
-            //int ephase = (phase + 7) % 8;
-            unsigned char mask = 1 << phase;
-            int i;
-
-            for (i = 0; i < 256; i++) {
-                unsigned char pos = (unsigned char)((i << (8 - phase)) | (i >> phase));
-                if (_persistence_map[pos])
-                    credible_threshold[i] |= mask;
-            }
-        }
-        // Store results
-        _persistence_map = credible_threshold;
+        make_persistence_map(_persistence_param, _persistence_map);
     }
 }
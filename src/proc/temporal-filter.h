@@ -3,11 +3,11 @@
 
 #pragma once
 #include "types.h"
+#include "proc/temporal-filter-passes.h"
+#include "proc/sse/sse-temporal-filter.h"
 
 namespace librealsense
 {
-    const size_t PRESISTENCY_LUT_SIZE = 256;
-
     class temporal_filter : public depth_processing_block
     {
     public:
@@ -19,66 +19,26 @@ namespace librealsense
 
         rs2::frame prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source);
 
+        // Filters frame_in into frame_out, which does not need to hold a copy of the input
         template<typename T>
-        void temp_jw_smooth(void* frame_data, void * _last_frame_data, uint8_t *history)
+        void temp_jw_smooth(const void* frame_in_data, void* frame_out_data, void * _last_frame_data, uint8_t *history)
         {
             static_assert((std::is_arithmetic<T>::value), "temporal filter assumes numeric types");
 
-            const bool fp = (std::is_floating_point<T>::value);
-
-            T delta_z = static_cast<T>(_delta_param);
-
-            auto frame          = reinterpret_cast<T*>(frame_data);
+            auto frame_in       = reinterpret_cast<const T*>(frame_in_data);
+            auto frame          = reinterpret_cast<T*>(frame_out_data);
             auto _last_frame    = reinterpret_cast<T*>(_last_frame_data);
 
             unsigned char mask = 1 << _cur_frame_index;
 
-            // pass one -- go through image and update all
-            for (size_t i = 0; i < _current_frm_size_pixels; i++)
-            {
-                T cur_val = frame[i];
-                T prev_val = _last_frame[i];
-
-                if (cur_val)
-                {
-                    if (!prev_val)
-                    {
-                        _last_frame[i] = cur_val;
-                        history[i] = mask;
-                    }
-                    else
-                    {  // old and new val
-                        T diff = static_cast<T>(fabs(cur_val - prev_val));
-
-                        if (diff < delta_z)
-                        {  // old and new val agree
-                            history[i] |= mask;
-                            float filtered = _alpha_param * cur_val + _one_minus_alpha * prev_val;
-                            T result = static_cast<T>(filtered);
-                            frame[i] = result;
-                            _last_frame[i] = result;
-                        }
-                        else
-                        {
-                            _last_frame[i] = cur_val;
-                            history[i] = mask;
-                        }
-                    }
-                }
-                else
-                {  // no cur_val
-                    if (prev_val)
-                    { // only case we can help
-                        unsigned char hist = history[i];
-                        unsigned char classification = _persistence_map[hist];
-                        if (classification & mask)
-                        { // we have had enough samples lately
-                            frame[i] = prev_val;
-                        }
-                    }
-                    history[i] &= ~mask;
-                }
-            }
+#ifdef __SSSE3__
+            // Vectorized and multi-threaded, with the same results as the scalar pass
+            temp_jw_smooth_sse(frame_in, frame, _last_frame, history, _width, _height,
+                _alpha_param, _one_minus_alpha, _delta_param, mask, _persistence_map.data());
+#else
+            temp_jw_smooth_pass(frame_in, frame, _last_frame, history, _width, _height,
+                _alpha_param, _one_minus_alpha, _delta_param, mask, _persistence_map.data());
+#endif
 
             _cur_frame_index = (_cur_frame_index + 1) % 8;  // at end of cycle
         }
@@ -101,7 +61,7 @@ namespace librealsense
         rs2::stream_profile     _source_stream_profile;
         rs2::stream_profile     _target_stream_profile;
         std::vector<uint8_t>    _last_frame;                // Hold the last frame received for the current profile
-        std::vector<uint8_t>    _history;                   // represents the history over the last 8 frames, 1 bit per frame
+        std::vector<uint8_t>    _history;                   // represents the history over the last 8 frames, 1 bit per frame and 1 byte per pixel
         uint8_t                 _cur_frame_index;
         // encodes whether a particular 8 bit history is good enough for all 8 phases of storage
         std::array<uint8_t, PRESISTENCY_LUT_SIZE> _persistence_map;
@@ -6,6 +6,11 @@
 #ifdef RS2_USE_CUDA
 #include "cuda/cuda-conversion.cuh"
 #endif
+#ifdef __SSSE3__
+#include "sse/sse-deinterleave.h"
+#include "sse/avx-deinterleave.h"
+#include "sse/cpu-features.h"
+#endif
 
 namespace librealsense
 {
@@ -15,6 +20,14 @@ namespace librealsense
         auto count = width * height;
 #ifdef RS2_USE_CUDA
         rscuda::split_frame_y16_y16_from_y12i_cuda(dest, count, reinterpret_cast<const y12i_pixel *>(source));
+#elif defined(__SSSE3__)
+        static bool do_avx2 = has_avx2_support();
+        auto left = reinterpret_cast<uint16_t*>(dest[0]);
+        auto right = reinterpret_cast<uint16_t*>(dest[1]);
+        if (do_avx2)
+            unpack_y16_y16_from_y12i_10_avx2(left, right, source, count);
+        else
+            unpack_y16_y16_from_y12i_10_sse(left, right, source, count);
 #else
         split_frame(dest, count, reinterpret_cast<const y12i_pixel*>(source),
             [](const y12i_pixel & p) -> uint16_t { return p.l() << 6 | p.l() >> 4; },  // We want to convert 10-bit data to 16-bit data
@@ -8,6 +8,11 @@
 #ifdef RS2_USE_CUDA
 #include "cuda/cuda-conversion.cuh"
 #endif
+#ifdef __SSSE3__
+#include "sse/sse-deinterleave.h"
+#include "sse/avx-deinterleave.h"
+#include "sse/cpu-features.h"
+#endif
 
 namespace librealsense
 {
@@ -17,6 +22,12 @@ namespace librealsense
         auto count = width * height;
 #ifdef RS2_USE_CUDA
         rscuda::split_frame_y8_y8_from_y8i_cuda(dest, count, reinterpret_cast<const y8i_pixel *>(source));
+#elif defined(__SSSE3__)
+        static bool do_avx2 = has_avx2_support();
+        if (do_avx2)
+            unpack_y8_y8_from_y8i_avx2(dest[0], dest[1], source, count);
+        else
+            unpack_y8_y8_from_y8i_sse(dest[0], dest[1], source, count);
 #else
         split_frame(dest, count, reinterpret_cast<const y8i_pixel*>(source),
             [](const y8i_pixel & p) -> uint8_t { return p.l; },
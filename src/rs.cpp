@@ -18,6 +18,7 @@
 #include "source.h"
 #include "core/processing.h"
 #include "proc/synthetic-stream.h"
+#include "proc/processing-executor.h"
 #include "proc/processing-blocks-factory.h"
 #include "proc/colorizer.h"
 #include "proc/pointcloud.h"
@@ -38,6 +39,8 @@
 #include "../include/librealsense2/h/rs_types.h"
 #include "pipeline/pipeline.h"
 #include "environment.h"
+#include "latency-trace.h"
+#include "flight-recorder.h"
 #include "proc/temporal-filter.h"
 #include "proc/depth-decompress.h"
 #include "software-device.h"
@@ -112,7 +115,12 @@ struct rs2_frame_queue
     {
     }
 
-    single_consumer_frame_queue<librealsense::frame_holder> queue;
+    single_consumer_frame_queue<librealsense::frame_holder, lockfree_queue> queue;
+};
+
+struct rs2_processing_pool
+{
+    std::shared_ptr<librealsense::processing_executor> executor;
 };
 
 struct rs2_sensor_list
@@ -851,6 +859,16 @@ rs2_metadata_type rs2_get_frame_metadata(const rs2_frame* frame, rs2_frame_metad
 }
 HANDLE_EXCEPTIONS_AND_RETURN(0, frame, frame_metadata)
 
+int rs2_get_frame_metadata_all(const rs2_frame* frame, rs2_metadata_type* values, int* supported, int count, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(frame);
+    VALIDATE_NOT_NULL(values);
+    VALIDATE_NOT_NULL(supported);
+    VALIDATE_RANGE(count, 0, (int)::RS2_FRAME_METADATA_COUNT);
+    return ((frame_interface*)frame)->get_frame_metadata_all(values, supported, count);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, frame, values, supported, count)
+
 const char* rs2_get_notification_description(rs2_notification* notification, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(notification);
@@ -1036,6 +1054,7 @@ HANDLE_EXCEPTIONS_AND_RETURN(nullptr, capacity)
 void rs2_delete_frame_queue(rs2_frame_queue* queue) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(queue);
+    queue->queue.clear(trace_dropped_wait("frame queue"));
     delete queue;
 }
 NOEXCEPT_RETURN(, queue)
@@ -1048,6 +1067,8 @@ rs2_frame* rs2_wait_for_frame(rs2_frame_queue* queue, unsigned int timeout_ms, r
     {
         throw std::runtime_error("Frame did not arrive in time!");
     }
+    if (latency_tracer::is_enabled())
+        latency_tracer::instance().end_wait("frame queue", fh->get_trace_span());
 
     frame_interface* result = nullptr;
     std::swap(result, fh.frame);
@@ -1062,6 +1083,8 @@ int rs2_poll_for_frame(rs2_frame_queue* queue, rs2_frame** output_frame, rs2_err
     librealsense::frame_holder fh;
     if (queue->queue.try_dequeue(&fh))
     {
+        if (latency_tracer::is_enabled())
+            latency_tracer::instance().end_wait("frame queue", fh->get_trace_span());
         frame_interface* result = nullptr;
         std::swap(result, fh.frame);
         *output_frame = (rs2_frame*)result;
@@ -1081,6 +1104,8 @@ int rs2_try_wait_for_frame(rs2_frame_queue* queue, unsigned int timeout_ms, rs2_
     {
         return false;
     }
+    if (latency_tracer::is_enabled())
+        latency_tracer::instance().end_wait("frame queue", fh->get_trace_span());
 
     frame_interface* result = nullptr;
     std::swap(result, fh.frame);
@@ -1096,14 +1121,16 @@ void rs2_enqueue_frame(rs2_frame* frame, void* queue) BEGIN_API_CALL
     auto q = reinterpret_cast<rs2_frame_queue*>(queue);
     librealsense::frame_holder fh;
     fh.frame = (frame_interface*)frame;
-    q->queue.enqueue(std::move(fh));
+    if (latency_tracer::is_enabled())
+        latency_tracer::instance().begin_wait("frame queue", fh->get_trace_span());
+    q->queue.enqueue(std::move(fh), trace_dropped_wait("frame queue"));
 }
 NOEXCEPT_RETURN(, frame, queue)
 
 void rs2_flush_queue(rs2_frame_queue* queue, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(queue);
-    queue->queue.clear();
+    queue->queue.clear(trace_dropped_wait("frame queue"));
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, queue)
 
@@ -2105,10 +2132,54 @@ void rs2_delete_processing_block(rs2_processing_block* block) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(block);
 
+    // Wait for asynchronous processing before the block is destroyed
+    if (block->block.use_count() == 1)
+        if (auto pb = dynamic_cast<librealsense::processing_block*>(block->block.get()))
+            pb->set_executor(nullptr, {});
+
     delete block;
 }
 NOEXCEPT_RETURN(, block)
 
+rs2_processing_pool* rs2_create_processing_pool(int threads_count, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_RANGE(threads_count, 1, 256);
+
+    return new rs2_processing_pool{ std::make_shared<librealsense::processing_executor>(threads_count) };
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, threads_count)
+
+void rs2_delete_processing_pool(rs2_processing_pool* pool) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(pool);
+
+    delete pool;
+}
+NOEXCEPT_RETURN(, pool)
+
+void rs2_set_processing_block_executor(rs2_processing_block* block, rs2_processing_pool* pool, int queue_size, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(block);
+    VALIDATE_RANGE(queue_size, 1, 32);
+
+    auto pb = std::dynamic_pointer_cast<librealsense::processing_block>(block->block);
+    if (!pb)
+        throw not_implemented_exception("This processing block does not support asynchronous processing");
+    pb->set_executor(pool ? pool->executor : nullptr, pb, queue_size);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, block, pool, queue_size)
+
+int rs2_is_processing_block_asynchronous(const rs2_processing_block* block, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(block);
+
+    auto pb = dynamic_cast<librealsense::processing_block*>(block->block.get());
+    if (!pb)
+        throw not_implemented_exception("This processing block does not support asynchronous processing");
+    return pb->is_asynchronous();
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, block)
+
 rs2_frame* rs2_extract_frame(rs2_frame* composite, int index, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(composite);
@@ -2397,6 +2468,35 @@ void rs2_pose_frame_get_pose_data(const rs2_frame* frame, rs2_pose* pose, rs2_er
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, frame, pose)
 
+void rs2_set_frame_allocator(rs2_options* options, rs2_frame_buffer_allocate_ptr allocate, rs2_frame_buffer_deallocate_ptr deallocate, void* user, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(options);
+    frame_allocator_ptr allocator;
+    if (allocate)
+    {
+        VALIDATE_NOT_NULL(deallocate);
+        allocator = std::make_shared<frame_allocator>(allocate, deallocate, user);
+    }
+
+    if (auto sensor = dynamic_cast<rs2_sensor*>(options))
+    {
+        auto sb = dynamic_cast<librealsense::sensor_base*>(sensor->sensor);
+        if (!sb)
+            throw not_implemented_exception("This sensor does not support custom frame allocators");
+        sb->set_frame_allocator(allocator);
+    }
+    else if (auto block = dynamic_cast<rs2_processing_block*>(options))
+    {
+        auto pb = dynamic_cast<librealsense::processing_block*>(block->block.get());
+        if (!pb)
+            throw not_implemented_exception("This processing block does not support custom frame allocators");
+        pb->set_frame_allocator(allocator);
+    }
+    else
+        throw invalid_value_exception("Frame allocators can only be set on sensors and processing blocks");
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, options, allocate, deallocate, user)
+
 rs2_time_t rs2_get_time(rs2_error** error) BEGIN_API_CALL
 {
     return environment::get_instance().get_time_service()->get_time();
@@ -2604,6 +2704,51 @@ void rs2_log(rs2_log_severity severity, const char * message, rs2_error ** error
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, severity, message)
 
+void rs2_enable_latency_tracing(int enable, rs2_error** error) BEGIN_API_CALL
+{
+    latency_tracer::instance().enable(enable != 0);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, enable)
+
+void rs2_export_latency_trace(const char* file_path, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(file_path);
+    std::ofstream out(file_path);
+    if (!out)
+        throw io_exception(to_string() << "Failed to open latency trace file " << file_path);
+    out << latency_tracer::instance().to_json();
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, file_path)
+
+void rs2_clear_latency_trace(rs2_error** error) BEGIN_API_CALL
+{
+    latency_tracer::instance().clear();
+}
+NOARGS_HANDLE_EXCEPTIONS_AND_RETURN_VOID()
+
+void rs2_log_to_flight_recorder(rs2_log_severity min_severity, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_ENUM(min_severity);
+    flight_recorder::instance().enable(min_severity);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, min_severity)
+
+void rs2_dump_flight_recorder(const char* file_path, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(file_path);
+    std::ofstream out(file_path);
+    if (!out)
+        throw io_exception(to_string() << "Failed to open flight recorder file " << file_path);
+    out << flight_recorder::instance().dump();
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, file_path)
+
+void rs2_clear_flight_recorder(rs2_error** error) BEGIN_API_CALL
+{
+    flight_recorder::instance().clear();
+}
+NOARGS_HANDLE_EXCEPTIONS_AND_RETURN_VOID()
+
 void rs2_loopback_enable(const rs2_device* device, const char* from_file, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(device);
@@ -16,6 +16,8 @@
 #include "proc/decimation-filter.h"
 #include "proc/depth-decompress.h"
 #include "global_timestamp_reader.h"
+#include "latency-trace.h"
+#include "flight-recorder.h"
 
 namespace librealsense
 {
@@ -39,6 +41,10 @@ namespace librealsense
     })
     {
         register_option(RS2_OPTION_FRAMES_QUEUE_SIZE, _source.get_published_size_option());
+        register_option(RS2_OPTION_FRAME_POOL_PREWARM_SIZE, _source.get_pool_prewarm_size_option());
+        for (auto id : { RS2_OPTION_FRAME_POOL_HITS, RS2_OPTION_FRAME_POOL_MISSES,
+                         RS2_OPTION_FRAME_POOL_EVICTIONS, RS2_OPTION_FRAME_POOL_RESIDENT_BYTES })
+            register_option(id, _source.get_pool_stats_option(id));
 
         register_metadata(RS2_FRAME_METADATA_TIME_OF_ARRIVAL, std::make_shared<librealsense::md_time_of_arrival_parser>());
 
@@ -190,6 +196,11 @@ namespace librealsense
         _source_owner = owner;
     }
 
+    void sensor_base::set_frame_allocator(frame_allocator_ptr allocator)
+    {
+        _source.set_allocator(allocator);
+    }
+
     stream_profiles sensor_base::get_stream_profiles( int tag ) const
     {
         stream_profiles results;
@@ -251,9 +262,9 @@ namespace librealsense
     {
         auto system_time = environment::get_instance().get_time_service()->get_time();
         auto fr = std::make_shared<frame>();
-        byte* pix = (byte*)fo.pixels;
-        std::vector<byte> pixels(pix, pix + fo.frame_size);
-        fr->data = pixels;
+        // The intermediate frame only serves the timestamp readers, so it borrows the backend
+        // buffer instead of copying it. It must not outlive the backend callback.
+        fr->attach_continuation(frame_continuation([]() {}, fo.pixels, fo.frame_size));
         fr->set_stream(profile);
 
         // generate additional data
@@ -267,13 +278,13 @@ namespace librealsense
             last_frame_number,
             false,
             (uint32_t)fo.frame_size );
-        fr->additional_data = additional_data;
+        fr->set_additional_data(additional_data);
 
         // update additional data
         additional_data.timestamp = timestamp_reader->get_frame_timestamp(fr);
         additional_data.last_frame_number = last_frame_number;
         additional_data.frame_number = timestamp_reader->get_frame_counter(fr);
-        fr->additional_data = additional_data;
+        fr->set_additional_data(additional_data);
 
         return fr;
     }
@@ -320,12 +331,28 @@ namespace librealsense
             {
                 unsigned long long last_frame_number = 0;
                 rs2_time_t last_timestamp = 0;
+                auto borrowed_frames = std::make_shared<std::atomic<int>>(0);
+                if (auto vsp = As<video_stream_profile, stream_profile_interface>(req_profile))
+                    _source.prewarm(stream_to_frame_types(req_profile_base->get_stream_type()),
+                        vsp->get_width() * vsp->get_height() * get_image_bpp(req_profile_base->get_format()) / 8);
                 _device->probe_and_commit(req_profile_base->get_backend_profile(),
-                    [this, req_profile_base, req_profile, last_frame_number, last_timestamp](platform::stream_profile p, platform::frame_object f, std::function<void()> continuation) mutable
+                    [this, req_profile_base, req_profile, last_frame_number, last_timestamp, borrowed_frames](platform::stream_profile p, platform::frame_object f, std::function<void()> continuation) mutable
                 {
+                    // Returns the buffer to the backend on every path that does not borrow it
+                    frame_continuation release_and_enqueue(continuation, f.pixels);
+
                     const auto&& system_time = environment::get_instance().get_time_service()->get_time();
+                    const bool tracing = latency_tracer::is_enabled();
+                    const auto arrival_time = tracing ? latency_tracer::now() : 0;
                     const auto&& fr = generate_frame_from_data(f, _timestamp_reader.get(), last_timestamp, last_frame_number, req_profile_base);
-                    const auto&& requires_processing = true; // TODO - Ariel add option
+                    const auto timestamp_read_time = tracing ? latency_tracer::now() : 0;
+#ifdef ZERO_COPY
+                    // Publish the backend buffer as-is while the user holds less than the budget,
+                    // otherwise copy so that the backend always has buffers to stream into
+                    const bool requires_processing = borrowed_frames->load() >= MAX_BORROWED_FRAMES;
+#else
+                    const bool requires_processing = true;
+#endif
                     const auto&& timestamp_domain = _timestamp_reader->get_frame_timestamp_domain(fr);
                     const auto&& bpp = get_image_bpp(req_profile_base->get_format());
                     auto&& frame_counter = fr->additional_data.frame_number;
@@ -340,32 +367,33 @@ namespace librealsense
                         return;
                     }
 
-                    frame_continuation release_and_enqueue(continuation, f.pixels);
+                    const auto&& vsp = As<video_stream_profile, stream_profile_interface>(req_profile);
+                    int width = vsp ? vsp->get_width() : 0;
+                    int height = vsp ? vsp->get_height() : 0;
+                    size_t frame_size = width * height * bpp / 8;
 
-                    LOG_DEBUG("FrameAccepted," << librealsense::get_string(req_profile_base->get_stream_type())
-                        << ",Counter," << std::dec << fr->additional_data.frame_number
-                        << ",Index," << req_profile_base->get_stream_index()
-                        << ",BackEndTS," << std::fixed << f.backend_time
-                        << ",SystemTime," << std::fixed << system_time
-                        << " ,diff_ts[Sys-BE]," << system_time - f.backend_time
-                        << ",TS," << std::fixed << timestamp << ",TS_Domain," << rs2_timestamp_domain_to_string(timestamp_domain)
-                        << ",last_frame_number," << last_frame_number << ",last_timestamp," << last_timestamp);
+                    LOG_RECORD_DEBUG("FrameAccepted,{},Counter,{},Index,{},BackEndTS,{},SystemTime,{} ,diff_ts[Sys-BE],{},TS,{},TS_Domain,{},last_frame_number,{},last_timestamp,{}",
+                        librealsense::get_string(req_profile_base->get_stream_type()), fr->additional_data.frame_number,
+                        req_profile_base->get_stream_index(), f.backend_time, system_time, system_time - f.backend_time,
+                        timestamp, rs2_timestamp_domain_to_string(timestamp_domain), last_frame_number, last_timestamp);
 
                     last_frame_number = frame_counter;
                     last_timestamp = timestamp;
 
-                    const auto&& vsp = As<video_stream_profile, stream_profile_interface>(req_profile);
-                    int width = vsp ? vsp->get_width() : 0;
-                    int height = vsp ? vsp->get_height() : 0;
-
-                    frame_holder fh = _source.alloc_frame(stream_to_frame_types(req_profile_base->get_stream_type()), width * height * bpp / 8, fr->additional_data, requires_processing);
+                    frame_holder fh = _source.alloc_frame(stream_to_frame_types(req_profile_base->get_stream_type()), frame_size, fr->additional_data, requires_processing);
+                    const auto allocation_time = tracing ? latency_tracer::now() : 0;
                     auto diff = environment::get_instance().get_time_service()->get_time() - system_time;
                     if (diff >10 )
                         LOG_DEBUG("!! Frame allocation took " << diff << " msec");
 
                     if (fh.frame)
                     {
-                        memcpy((void*)fh->get_frame_data(), fr->data.data(), sizeof(byte)*fr->data.size());
+                        if (requires_processing)
+                        {
+                            memcpy((void*)fh->get_frame_data(), f.pixels, std::min(f.frame_size, frame_size));
+                            // The backend can stream into its buffer again as soon as it is copied
+                            release_and_enqueue();
+                        }
                         auto&& video = (video_frame*)fh.frame;
                         video->assign(width, height, width * bpp / 8, bpp);
                         video->set_timestamp_domain(timestamp_domain);
@@ -380,13 +408,34 @@ namespace librealsense
                     diff = environment::get_instance().get_time_service()->get_time() - system_time;
                     if (diff >10 )
                         LOG_DEBUG("!! Frame memcpy took " << diff << " msec");
+
+                    const auto span = fh->get_trace_span();
+                    if (tracing)
+                    {
+                        auto&& tracer = latency_tracer::instance();
+                        // The backend time is taken on the system clock when the OS delivers the frame
+                        const auto backend_delay = system_time - f.backend_time;
+                        if (f.backend_time > 0 && backend_delay > 0 && backend_delay < 1000)
+                            tracer.record("backend delivery", span, arrival_time - static_cast<int64_t>(backend_delay * 1e6), arrival_time);
+                        tracer.record("timestamp reading", span, arrival_time, timestamp_read_time);
+                        tracer.record("frame allocation", span, timestamp_read_time, allocation_time);
+                        if (requires_processing)
+                            tracer.record("frame copy", span, allocation_time, latency_tracer::now());
+                    }
                     if (!requires_processing)
                     {
-                        fh->attach_continuation(std::move(release_and_enqueue));
+                        ++*borrowed_frames;
+                        release_and_enqueue.reset();
+                        fh->attach_continuation(frame_continuation([continuation, borrowed_frames]()
+                        {
+                            --*borrowed_frames;
+                            continuation();
+                        }, f.pixels, std::min(f.frame_size, frame_size)));
                     }
 
                     if (fh->get_stream().get())
                     {
+                        trace_scope stage("frame callback", span);
                         _source.invoke_callback(std::move(fh));
                     }
                 });
@@ -849,14 +898,15 @@ namespace librealsense
             last_frame_number = frame_counter;
             last_timestamp = timestamp;
             frame_holder frame = _source.alloc_frame(RS2_EXTENSION_MOTION_FRAME, data_size, fr->additional_data, true);
-            memcpy((void*)frame->get_frame_data(), fr->data.data(), sizeof(byte)*fr->data.size());
             if (!frame)
             {
                 LOG_INFO("Dropped frame. alloc_frame(...) returned nullptr");
                 return;
             }
+            memcpy((void*)frame->get_frame_data(), sensor_data.fo.pixels, sizeof(byte)*data_size);
             frame->set_stream(request);
             frame->set_timestamp_domain(timestamp_domain);
+            trace_scope stage("frame callback", frame->get_trace_span());
             _source.invoke_callback(std::move(frame));
         });
         _is_streaming = true;
@@ -1045,6 +1095,11 @@ namespace librealsense
         auto& raw_fourcc_to_rs2_stream_map = _raw_sensor->get_fourcc_to_rs2_stream_map();
         _fourcc_to_rs2_stream = std::make_shared<std::map<uint32_t, rs2_stream>>(fourcc_to_rs2_stream_map);
         raw_fourcc_to_rs2_stream_map = _fourcc_to_rs2_stream;
+
+        // Frame buffers are pooled where the raw frames are allocated
+        for (auto id : { RS2_OPTION_FRAME_POOL_PREWARM_SIZE, RS2_OPTION_FRAME_POOL_HITS, RS2_OPTION_FRAME_POOL_MISSES,
+                         RS2_OPTION_FRAME_POOL_EVICTIONS, RS2_OPTION_FRAME_POOL_RESIDENT_BYTES })
+            sensor_base::register_option(id, _raw_sensor->get_option_handler(id));
     }
 
     synthetic_sensor::~synthetic_sensor()
@@ -1392,6 +1447,9 @@ namespace librealsense
             // Retrieve source profile from cached map and generate the relevant processing block.
             std::unordered_set<std::shared_ptr<stream_profile_interface>> current_resolved_reqs;
             auto best_pb = best_pbf->generate();
+            best_pb->enable_deferred_processing(best_pb);
+            if (_frame_allocator)
+                best_pb->set_frame_allocator(_frame_allocator);
             register_processing_block_options(*best_pb);
             for (auto&& req : best_reqs)
             {
@@ -1591,6 +1649,18 @@ namespace librealsense
         _post_process_callback = callback;
     }
 
+    void synthetic_sensor::set_frame_allocator(frame_allocator_ptr allocator)
+    {
+        std::lock_guard<std::mutex> lock(_synthetic_configure_lock);
+        _frame_allocator = allocator;
+        _raw_sensor->set_frame_allocator(allocator);
+        for (auto&& entry : _profiles_to_processing_block)
+        {
+            for (auto&& pb : entry.second)
+                pb->set_frame_allocator(allocator);
+        }
+    }
+
     void synthetic_sensor::register_notifications_callback(notifications_callback_ptr callback)
     {
         sensor_base::register_notifications_callback(callback);
@@ -51,6 +51,7 @@ namespace librealsense
         virtual ~sensor_base() override { _source.flush(); }
 
         void set_source_owner(sensor_base* owner); // will direct the source to the top in the source hierarchy.
+        virtual void set_frame_allocator(frame_allocator_ptr allocator);
         virtual stream_profiles init_stream_profiles() = 0;
         stream_profiles get_stream_profiles(int tag = profile_tag::PROFILE_TAG_ANY) const override;
         stream_profiles get_active_streams() const override;
@@ -224,6 +225,7 @@ namespace librealsense
         void register_metadata(rs2_frame_metadata_value metadata, std::shared_ptr<md_attribute_parser_base> metadata_parser) const override;
         bool is_streaming() const override;
         bool is_opened() const override;
+        void set_frame_allocator(frame_allocator_ptr allocator) override;
 
     protected:
         void add_source_profiles_missing_data();
@@ -250,6 +252,7 @@ namespace librealsense
         std::unordered_map<stream_profile, stream_profiles> _target_to_source_profiles_map;
         std::unordered_map<rs2_format, stream_profiles> _cached_requests;
         std::vector<rs2_option> _cached_processing_blocks_options;
+        frame_allocator_ptr _frame_allocator;
     };
 
     class iio_hid_timestamp_reader : public frame_timestamp_reader
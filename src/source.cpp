@@ -4,6 +4,7 @@
 #include "source.h"
 #include "option.h"
 #include "environment.h"
+#include "latency-trace.h"
 
 namespace librealsense
 {
@@ -36,14 +37,94 @@ namespace librealsense
         std::atomic<uint32_t>* _ptr;
     };
 
+    class frame_pool_prewarm_size : public option_base
+    {
+    public:
+        frame_pool_prewarm_size(std::atomic<uint32_t>* ptr, const option_range& opt_range)
+            : option_base(opt_range),
+              _ptr(ptr)
+        {}
+
+        void set(float value) override
+        {
+            if (!is_valid(value))
+                throw invalid_value_exception(to_string() << "set(frame_pool_prewarm_size) failed! Given value " << value << " is out of range.");
+
+            *_ptr = static_cast<uint32_t>(value);
+            _recording_function(*this);
+        }
+
+        float query() const override { return static_cast<float>(_ptr->load()); }
+
+        bool is_enabled() const override { return true; }
+
+        const char* get_description() const override
+        {
+            return "Number of frame buffers allocated per stream when the sensor is opened. Pre-allocating avoids allocations on the first frames at the cost of memory";
+        }
+    private:
+        std::atomic<uint32_t>* _ptr;
+    };
+
+    class frame_pool_counter : public readonly_option
+    {
+    public:
+        frame_pool_counter(std::function<float()> counter, const char* description)
+            : _counter(counter), _description(description)
+        {}
+
+        float query() const override { return _counter(); }
+
+        option_range get_range() const override
+        {
+            return { 0, std::numeric_limits<float>::max(), 1, 0 };
+        }
+
+        bool is_enabled() const override { return true; }
+
+        const char* get_description() const override { return _description; }
+    private:
+        std::function<float()> _counter;
+        const char* _description;
+    };
+
     std::shared_ptr<option> frame_source::get_published_size_option()
     {
         return std::make_shared<frame_queue_size>(&_max_publish_list_size, option_range{ 0, 32, 1, 16 });
     }
 
+    std::shared_ptr<option> frame_source::get_pool_prewarm_size_option()
+    {
+        return std::make_shared<frame_pool_prewarm_size>(&_pool_prewarm_size, option_range{ 0, frame_buffer_pool::BUCKET_CAPACITY, 1, 0 });
+    }
+
+    std::shared_ptr<option> frame_source::get_pool_stats_option(rs2_option id)
+    {
+        auto stats = _pool_stats;
+        switch (id)
+        {
+        case RS2_OPTION_FRAME_POOL_HITS:
+            return std::make_shared<frame_pool_counter>([stats]() { return static_cast<float>(stats->hits.load()); },
+                "Number of frame allocations served by a recycled buffer");
+        case RS2_OPTION_FRAME_POOL_MISSES:
+            return std::make_shared<frame_pool_counter>([stats]() { return static_cast<float>(stats->misses.load()); },
+                "Number of frame allocations that required a new buffer");
+        case RS2_OPTION_FRAME_POOL_EVICTIONS:
+            return std::make_shared<frame_pool_counter>([stats]() { return static_cast<float>(stats->evictions.load()); },
+                "Number of frame buffers released because they were not reused in time or the pool was full");
+        case RS2_OPTION_FRAME_POOL_RESIDENT_BYTES:
+            return std::make_shared<frame_pool_counter>([stats]() { return static_cast<float>(stats->resident_bytes.load()); },
+                "Bytes held by idle frame buffers waiting to be reused");
+        default:
+            throw invalid_value_exception(to_string() << rs2_option_to_string(id) << " is not a frame pool counter");
+        }
+    }
+
     frame_source::frame_source(uint32_t max_publish_list_size)
             : _callback(nullptr, [](rs2_frame_callback*) {}),
               _max_publish_list_size(max_publish_list_size),
+              _pool_prewarm_size(0),
+              _pool_stats(std::make_shared<frame_pool_stats>()),
               _ts(environment::get_instance().get_time_service())
     {}
 
@@ -61,10 +142,31 @@ namespace librealsense
 
         for (auto type : supported)
         {
-            _archive[type] = make_archive(type, &_max_publish_list_size, _ts, metadata_parsers);
+            _archive[type] = make_archive(type, &_max_publish_list_size, _ts, metadata_parsers, _pool_stats);
         }
 
         _metadata_parsers = metadata_parsers;
+        apply_allocator();
+    }
+
+    void frame_source::set_allocator(frame_allocator_ptr allocator)
+    {
+        std::lock_guard<std::mutex> lock(_callback_mutex);
+        _allocator = allocator;
+        apply_allocator();
+    }
+
+    void frame_source::apply_allocator()
+    {
+        // Only image-like frames have their buffers accessed exclusively through get_frame_data(),
+        // composite, motion and pose frames keep using the internal buffers
+        for (auto type : { RS2_EXTENSION_VIDEO_FRAME, RS2_EXTENSION_DEPTH_FRAME,
+                           RS2_EXTENSION_DISPARITY_FRAME, RS2_EXTENSION_POINTS })
+        {
+            auto it = _archive.find(type);
+            if (it != _archive.end() && it->second)
+                it->second->set_allocator(_allocator);
+        }
     }
 
     callback_invocation_holder frame_source::begin_callback()
@@ -88,9 +190,23 @@ namespace librealsense
     {
         auto it = _archive.find(type);
         if (it == _archive.end()) throw wrong_api_call_sequence_exception("Requested frame type is not supported!");
+        // Frames derived by processing blocks keep the span of their original frame
+        if (!additional_data.trace_span && latency_tracer::is_enabled())
+            additional_data.trace_span = latency_tracer::instance().new_span();
         return it->second->alloc_and_track(size, additional_data, requires_memory);
     }
 
+    void frame_source::prewarm(rs2_extension type, size_t size) const
+    {
+        auto count = _pool_prewarm_size.load();
+        if (!count || !size)
+            return;
+
+        auto it = _archive.find(type);
+        if (it != _archive.end() && it->second)
+            it->second->prewarm(size, count);
+    }
+
     void frame_source::set_sensor(const std::shared_ptr<sensor_interface>& s)
     {
         for (auto&& a : _archive)
@@ -25,6 +25,14 @@ namespace librealsense
         void reset();
 
         std::shared_ptr<option> get_published_size_option();
+        std::shared_ptr<option> get_pool_prewarm_size_option();
+        std::shared_ptr<option> get_pool_stats_option(rs2_option id);
+
+        // Fill the frame buffer pool of the given frame type according to the pre-warm option
+        void prewarm(rs2_extension type, size_t size) const;
+
+        // Obtain the buffers of image frames from a user-provided allocator (nullptr restores the internal pool)
+        void set_allocator(frame_allocator_ptr allocator);
 
         frame_interface* alloc_frame(rs2_extension type, size_t size, frame_additional_data additional_data, bool requires_memory) const;
 
@@ -44,7 +52,7 @@ namespace librealsense
         template<class T>
         void add_extension(rs2_extension ex)
         {
-            _archive[ex] = std::make_shared<frame_archive<T>>(&_max_publish_list_size, _ts, _metadata_parsers);
+            _archive[ex] = std::make_shared<frame_archive<T>>(&_max_publish_list_size, _ts, _metadata_parsers, _pool_stats);
         }
 
         void set_max_publish_list_size(int qsize) {_max_publish_list_size = qsize; }
@@ -52,11 +60,16 @@ namespace librealsense
     private:
         friend class syncer_process_unit;
 
+        void apply_allocator();
+
         mutable std::mutex _callback_mutex;
 
         std::map<rs2_extension, std::shared_ptr<archive_interface>> _archive;
 
         std::atomic<uint32_t> _max_publish_list_size;
+        std::atomic<uint32_t> _pool_prewarm_size;
+        std::shared_ptr<frame_pool_stats> _pool_stats;
+        frame_allocator_ptr _allocator;
         frame_callback_ptr _callback;
         std::shared_ptr<platform::time_service> _ts;
         std::shared_ptr<metadata_parser_map> _metadata_parsers;
@@ -98,9 +98,7 @@ namespace librealsense
 
     void identity_matcher::dispatch(frame_holder f, syncronization_environment env)
     {
-        std::stringstream s;
-        s <<_name<<"--> "<< f->get_stream()->get_stream_type() << " " << f->get_frame_number() << ", "<<std::fixed<< f->get_frame_timestamp()<<"\n";
-        LOG_DEBUG(s.str());
+        LOG_DEBUG(_name << "--> " << f->get_stream()->get_stream_type() << " " << f->get_frame_number() << ", " << std::fixed << f->get_frame_timestamp() << "\n");
 
         sync(std::move(f), env);
     }
@@ -121,51 +119,65 @@ namespace librealsense
     composite_matcher::composite_matcher(std::vector<std::shared_ptr<matcher>> matchers, std::string name)
     {
         for (auto&& matcher : matchers)
-        {
-            for (auto&& stream : matcher->get_streams())
-            {
-                matcher->set_callback([&](frame_holder f, syncronization_environment env)
-                {
-                    sync(std::move(f), env);
-                });
-                _matchers[stream] = matcher;
-                _streams_id.push_back(stream);
-            }
-            for (auto&& stream : matcher->get_streams_types())
-            {
-                _streams_type.push_back(stream);
-            }
-        }
+            add_matcher(matcher);
 
         _name = create_composite_name(matchers, name);
     }
 
     void composite_matcher::dispatch(frame_holder f, syncronization_environment env)
     {
-        std::stringstream s;
-        s <<"DISPATCH "<<_name<<"--> "<< frame_to_string(f) <<"\n";
-        LOG_DEBUG(s.str());
+        LOG_DEBUG("DISPATCH " << _name << "--> " << frame_to_string(f) << "\n");
 
         clean_inactive_streams(f);
-        auto matcher = find_matcher(f);
-        update_last_arrived(f, matcher.get());
-        matcher->dispatch(std::move(f), env);
+        auto slot = find_slot(f);
+        update_last_arrived(f, *slot);
+        slot->m->dispatch(std::move(f), env);
+    }
+
+    void composite_matcher::set_max_wait(rs2_time_t ms)
+    {
+        _max_wait = ms;
+        for (auto&& slot : _slots)
+        {
+            if (auto nested = dynamic_cast<composite_matcher*>(slot->m.get()))
+                nested->set_max_wait(ms);
+        }
     }
 
     std::shared_ptr<matcher> composite_matcher::find_matcher(const frame_holder& frame)
     {
-        std::shared_ptr<matcher> matcher;
+        return find_slot(frame)->m;
+    }
+
+    composite_matcher::sync_slot* composite_matcher::find_slot(const frame_holder& frame)
+    {
+        auto stream_id = frame.frame->get_stream()->get_unique_id();
+        for (auto&& entry : _stream_slots)
+        {
+            if (entry.first == stream_id)
+            {
+                auto slot = entry.second;
+                if (!slot->m->get_active())
+                {
+                    slot->m->set_active(true);
+                    slot->queue.start();
+                }
+                return slot;
+            }
+        }
+        return add_slot(frame);
+    }
+
+    composite_matcher::sync_slot* composite_matcher::add_slot(const frame_holder& frame)
+    {
         auto stream_id = frame.frame->get_stream()->get_unique_id();
         auto stream_type = frame.frame->get_stream()->get_stream_type();
 
         auto sensor = frame.frame->get_sensor().get(); //TODO: Potential deadlock if get_sensor() gets a hold of the last reference of that sensor
 
-        auto dev_exist = false;
-
+        const device_interface* dev = nullptr;
         if (sensor)
         {
-
-            const device_interface* dev = nullptr;
             try
             {
                 dev = sensor->get_device().shared_from_this().get();
@@ -174,154 +186,151 @@ namespace librealsense
             {
                 LOG_WARNING("Device destroyed");
             }
-            if (dev)
-            {
-                dev_exist = true;
-                matcher = _matchers[stream_id];
-                if (!matcher)
-                {
-                    std::ostringstream ss;
-                    for( auto const & it : _matchers )
-                        ss << ' ' << it.first;
-                    LOG_DEBUG( "stream id " << stream_id << " was not found; trying to create, existing streams=" << ss.str() );
-                    matcher = dev->create_matcher(frame);
-
-                    matcher->set_callback(
-                        [&](frame_holder f, syncronization_environment env)
-                        {
-                            sync(std::move(f), env);
-                        });
-
-                    for (auto stream : matcher->get_streams())
-                    {
-                        if (_matchers[stream])
-                        {
-                            _frames_queue.erase(_matchers[stream].get());
-                        }
-                        _matchers[stream] = matcher;
-                        _streams_id.push_back(stream);
-                    }
-                    for (auto stream : matcher->get_streams_types())
-                    {
-                        _streams_type.push_back(stream);
-                    }
-
-                    if (std::find(_streams_type.begin(), _streams_type.end(), stream_type) == _streams_type.end())
-                    {
-                        LOG_ERROR("Stream matcher not found! stream=" << rs2_stream_to_string(stream_type));
-                    }
-                }
-                else if(!matcher->get_active())
-                {
-                     matcher->set_active(true);
-                     _frames_queue[matcher.get()].start();
-                }
-            }
         }
         else
         {
             LOG_DEBUG( "sensor does not exist" );
         }
 
-        if(!dev_exist)
+        if (!dev)
         {
-            matcher = _matchers[stream_id];
             // We don't know what device this frame came from, so just store it under device NULL with ID matcher
-            if (!matcher)
-            {
-                if (_matchers[stream_id])
-                {
-                    _frames_queue.erase(_matchers[stream_id].get());
-                }
-                 _matchers[stream_id] = std::make_shared<identity_matcher>(stream_id, stream_type);
-                _streams_id.push_back(stream_id);
-                _streams_type.push_back(stream_type);
-                matcher = _matchers[stream_id];
+            return add_matcher(std::make_shared<identity_matcher>(stream_id, stream_type));
+        }
 
-                matcher->set_callback([&](frame_holder f, syncronization_environment env)
-                {
-                    sync(std::move(f), env);
-                });
+        if (is_log_enabled(RS2_LOG_SEVERITY_DEBUG))
+        {
+            std::ostringstream ss;
+            for( auto const & it : _stream_slots )
+                ss << ' ' << it.first;
+            LOG_DEBUG( "stream id " << stream_id << " was not found; trying to create, existing streams=" << ss.str() );
+        }
+        auto slot = add_matcher(dev->create_matcher(frame));
+
+        if (std::find(_streams_type.begin(), _streams_type.end(), stream_type) == _streams_type.end())
+        {
+            LOG_ERROR("Stream matcher not found! stream=" << rs2_stream_to_string(stream_type));
+        }
+        // The frames of the stream go to the new matcher even if it does not list the stream,
+        // rather than creating a matcher for each of them
+        if (std::find(slot->m->get_streams().begin(), slot->m->get_streams().end(), stream_id) == slot->m->get_streams().end())
+            _stream_slots.emplace_back(stream_id, slot);
+        return slot;
+    }
+
+    composite_matcher::sync_slot* composite_matcher::add_matcher(std::shared_ptr<matcher> matcher)
+    {
+        matcher->set_callback([&](frame_holder f, syncronization_environment env)
+        {
+            sync(std::move(f), env);
+        });
+        if (auto nested = dynamic_cast<composite_matcher*>(matcher.get()))
+            nested->set_max_wait(_max_wait);
+
+        _slots.emplace_back(new sync_slot(matcher));
+        auto slot = _slots.back().get();
+
+        for (auto stream : matcher->get_streams())
+        {
+            auto it = std::find_if(_stream_slots.begin(), _stream_slots.end(),
+                [stream](const std::pair<stream_id, sync_slot*>& entry) { return entry.first == stream; });
+            if (it != _stream_slots.end())
+            {
+                // The frames queued by the previous matcher of the stream are dropped. Its slot is kept, as its
+                // matcher may be the one that calls us
+                it->second->queue.clear();
+                it->second->queued = false;
+                it->second = slot;
+            }
+            else
+            {
+                _stream_slots.emplace_back(stream, slot);
             }
+            _streams_id.push_back(stream);
         }
-        return matcher;
+        for (auto stream : matcher->get_streams_types())
+        {
+            _streams_type.push_back(stream);
+        }
+        return slot;
     }
 
 
-    std::string composite_matcher::frames_to_string(std::vector<librealsense::matcher*> matchers)
+    std::string composite_matcher::frames_to_string(const std::vector<sync_slot*>& slots)
     {
         std::string str;
-        for (auto m : matchers)
+        for (auto slot : slots)
         {
-            frame_holder* f;
-            if(_frames_queue[m].peek(&f))
-                str += frame_to_string(*f);
+            queued_frame* q;
+            if(slot->queue.peek(&q))
+                str += frame_to_string(q->frame);
         }
         return str;
     }
 
     void composite_matcher::sync(frame_holder f, syncronization_environment env)
     {
-        std::ostringstream s;
-        s <<"SYNC "<<_name<<"--> "<< frame_to_string(f)<<"\n";
-        LOG_DEBUG(s.str());
-
-        update_next_expected(f);
-        auto matcher = find_matcher(f);
-        _frames_queue[matcher.get()].enqueue(std::move(f));
+        LOG_DEBUG("SYNC " << _name << "--> " << frame_to_string(f) << "\n");
+        // The messages below are built over several steps, only when they are logged
+        const bool log_debug = is_log_enabled(RS2_LOG_SEVERITY_DEBUG);
 
-        std::vector<frame_holder*> frames_arrived;
-        std::vector<librealsense::matcher*> frames_arrived_matchers;
-        std::vector<librealsense::matcher*> synced_frames;
-        std::vector<librealsense::matcher*> missing_streams;
+        auto now = environment::get_instance().get_time_service()->get_time();
+        auto slot = find_slot(f);
+        update_next_expected(f, *slot);
+        if (!slot->queued)
+        {
+            slot->queue.start();
+            slot->queued = true;
+        }
+        slot->queue.enqueue(queued_frame(std::move(f), now));
 
         do
         {
-            std::stringstream s;
             auto old_frames = false;
 
-            synced_frames.clear();
-            missing_streams.clear();
-            frames_arrived_matchers.clear();
-            frames_arrived.clear();
+            _synced.clear();
+            _missing.clear();
+            _arrived_slots.clear();
+            _arrived.clear();
 
-
-            for (auto s = _frames_queue.begin(); s != _frames_queue.end(); s++)
+            for (auto&& s : _slots)
             {
-                frame_holder* f;
-                if (s->second.peek(&f))
+                if (!s->queued)
+                    continue;
+
+                queued_frame* q;
+                if (s->queue.peek(&q))
                 {
-                    frames_arrived.push_back(f);
-                    frames_arrived_matchers.push_back(s->first);
+                    _arrived.push_back(q);
+                    _arrived_slots.push_back(s.get());
                 }
                 else
                 {
-                    missing_streams.push_back(s->first);
+                    _missing.push_back(s.get());
                 }
             }
 
-            if (frames_arrived.size() == 0)
+            if (_arrived.size() == 0)
                 break;
 
-            frame_holder* curr_sync;
-            if (frames_arrived.size() > 0)
-            {
-                curr_sync = frames_arrived[0];
-                synced_frames.push_back(frames_arrived_matchers[0]);
-            }
+            auto curr_sync = _arrived[0];
+            auto oldest_arrival = curr_sync->arrival;
+            _synced.push_back(_arrived_slots[0]);
 
-            for (auto i = 1; i < frames_arrived.size(); i++)
+            for (size_t i = 1; i < _arrived.size(); i++)
             {
-                if (are_equivalent(*curr_sync, *frames_arrived[i]))
+                if (are_equivalent(curr_sync->frame, _arrived[i]->frame))
                 {
-                    synced_frames.push_back(frames_arrived_matchers[i]);
+                    _synced.push_back(_arrived_slots[i]);
+                    oldest_arrival = std::min(oldest_arrival, _arrived[i]->arrival);
                 }
-                else if (is_smaller_than(*frames_arrived[i], *curr_sync))
+                else if (is_smaller_than(_arrived[i]->frame, curr_sync->frame))
                 {
                     old_frames = true;
-                    synced_frames.clear();
-                    synced_frames.push_back(frames_arrived_matchers[i]);
-                    curr_sync = frames_arrived[i];
+                    _synced.clear();
+                    _synced.push_back(_arrived_slots[i]);
+                    curr_sync = _arrived[i];
+                    oldest_arrival = curr_sync->arrival;
                 }
                 else
                 {
@@ -331,52 +340,65 @@ namespace librealsense
 
             if (!old_frames)
             {
-                for (auto i : missing_streams)
+                for (auto i : _missing)
                 {
-                    if (!skip_missing_stream(synced_frames, i))
+                    if (skip_missing_stream(_synced, *i))
                     {
-                        s <<  _name<<" "<<frames_to_string(synced_frames )<<" Wait for missing stream: ";
-
-                        for (auto&& stream : i->get_streams())
-                            s << stream<<" next expected "<<std::fixed<< _next_expected[i];
-                        synced_frames.clear();
-                        LOG_DEBUG(s.str());
-                        break;
+                        if (log_debug)
+                        {
+                            std::stringstream s;
+                            s << _name << " " << frames_to_string(_synced) << " Skipped missing stream: ";
+                            for (auto&& stream : i->m->get_streams())
+                                s << stream << " next expected " << std::fixed << i->next_expected << " ";
+                            LOG_DEBUG(s.str());
+                        }
+                    }
+                    else if (_max_wait > 0 && now - oldest_arrival >= _max_wait)
+                    {
+                        if (log_debug)
+                        {
+                            std::stringstream s;
+                            s << _name << " " << frames_to_string(_synced) << " Waited " << std::fixed << now - oldest_arrival
+                              << " ms, released without stream: ";
+                            for (auto&& stream : i->m->get_streams())
+                                s << stream << " ";
+                            LOG_DEBUG(s.str());
+                        }
                     }
                     else
                     {
-                        std::stringstream s;
-                        s << _name << " " << frames_to_string(synced_frames) << " Skipped missing stream: ";
-                        for (auto&& stream : i->get_streams())
-                            s << stream << " next expected " << std::fixed << _next_expected[i]<<" ";
-                        LOG_DEBUG(s.str());
+                        if (log_debug)
+                        {
+                            std::stringstream s;
+                            s << _name << " " << frames_to_string(_synced) << " Wait for missing stream: ";
+                            for (auto&& stream : i->m->get_streams())
+                                s << stream << " next expected " << std::fixed << i->next_expected;
+                            LOG_DEBUG(s.str());
+                        }
+                        _synced.clear();
+                        break;
                     }
-
                 }
             }
-            else
-            {
-                s << _name << " old frames: ";
-            }
-            if (synced_frames.size())
+            if (_synced.size())
             {
                 std::vector<frame_holder> match;
-                match.reserve(synced_frames.size());
+                match.reserve(_synced.size());
 
-                for (auto index : synced_frames)
+                for (auto s : _synced)
                 {
-                    frame_holder frame;
+                    queued_frame q;
                     int timeout_ms = 5000;
-                    _frames_queue[index].dequeue(&frame, timeout_ms);
-                    if (old_frames)
-                    {
-                        s  << "--> " << frame_to_string(frame) << "\n";
-                    }
-                    match.push_back(std::move(frame));
+                    s->queue.dequeue(&q, timeout_ms);
+                    match.push_back(std::move(q.frame));
                 }
 
-                if (old_frames)
+                if (old_frames && log_debug)
                 {
+                    std::stringstream s;
+                    s << _name << " old frames: ";
+                    for (auto&& frame : match)
+                        s << "--> " << frame_to_string(frame) << "\n";
                     LOG_DEBUG(s.str());
                 }
 
@@ -389,13 +411,13 @@ namespace librealsense
                 frame_holder composite = env.source->allocate_composite_frame(std::move(match));
                 if (composite.frame)
                 {
-                    s <<"SYNCED "<<_name<<"--> "<< frame_to_string(composite)<<"\n";
+                    LOG_DEBUG("SYNCED " << _name << "--> " << frame_to_string(composite) << "\n");
 
                     auto cb = begin_callback();
                     _callback(std::move(composite), env);
                 }
             }
-        } while (synced_frames.size() > 0);
+        } while (_synced.size() > 0);
     }
 
     frame_number_composite_matcher::frame_number_composite_matcher(std::vector<std::shared_ptr<matcher>> matchers)
@@ -403,9 +425,9 @@ namespace librealsense
     {
     }
 
-    void frame_number_composite_matcher::update_last_arrived(frame_holder& f, matcher* m)
+    void frame_number_composite_matcher::update_last_arrived(frame_holder& f, sync_slot& slot)
     {
-        _last_arrived[m] =f->get_frame_number();
+        slot.last_arrived = (double)f->get_frame_number();
     }
 
     bool frame_number_composite_matcher::are_equivalent(frame_holder& a, frame_holder& b)
@@ -418,52 +440,48 @@ namespace librealsense
     }
     void frame_number_composite_matcher::clean_inactive_streams(frame_holder& f)
     {
-        std::vector<stream_id> inactive_matchers;
-        for(auto m: _matchers)
+        for(auto&& slot: _slots)
         {
-            if (_last_arrived[m.second.get()] && (fabs((long long)f->get_frame_number() - (long long)_last_arrived[m.second.get()])) > 5)
+            if (slot->last_arrived && (fabs((long long)f->get_frame_number() - (long long)slot->last_arrived)) > 5)
             {
-                std::stringstream s;
-                s << "clean inactive stream in "<<_name;
-                for (auto stream : m.second->get_streams_types())
+                if (is_log_enabled(RS2_LOG_SEVERITY_DEBUG))
                 {
-                    s << stream << " ";
+                    std::stringstream s;
+                    s << "clean inactive stream in "<<_name;
+                    for (auto stream : slot->m->get_streams_types())
+                    {
+                        s << stream << " ";
+                    }
+                    LOG_DEBUG(s.str());
                 }
-                LOG_DEBUG(s.str());
 
-                inactive_matchers.push_back(m.first);
-                m.second->set_active(false);
+                slot->m->set_active(false);
+                slot->queue.clear();
             }
         }
-
-        for(auto id: inactive_matchers)
-        {
-            _frames_queue[_matchers[id].get()].clear();
-        }
     }
 
-    bool frame_number_composite_matcher::skip_missing_stream(std::vector<matcher*> synced, matcher* missing)
+    bool frame_number_composite_matcher::skip_missing_stream(const std::vector<sync_slot*>& synced, sync_slot& missing)
     {
-        frame_holder* synced_frame;
+        queued_frame* synced_frame;
 
-         if(!missing->get_active())
+         if(!missing.m->get_active())
              return true;
 
-        _frames_queue[synced[0]].peek(&synced_frame);
+        synced[0]->queue.peek(&synced_frame);
 
-        auto next_expected = _next_expected[missing];
+        auto next_expected = missing.next_expected;
 
-        if((*synced_frame)->get_frame_number() - next_expected > 4 || (*synced_frame)->get_frame_number() < next_expected)
+        if(synced_frame->frame->get_frame_number() - next_expected > 4 || synced_frame->frame->get_frame_number() < next_expected)
         {
             return true;
         }
         return false;
     }
 
-    void frame_number_composite_matcher::update_next_expected(const frame_holder& f)
+    void frame_number_composite_matcher::update_next_expected(const frame_holder& f, sync_slot& slot)
     {
-        auto matcher = find_matcher(f);
-        _next_expected[matcher.get()] = f.frame->get_frame_number()+1.;
+        slot.next_expected = f.frame->get_frame_number()+1.;
     }
 
     std::pair<double, double> extract_timestamps(frame_holder & a, frame_holder & b)
@@ -505,15 +523,15 @@ namespace librealsense
         return ts.first < ts.second;
     }
 
-    void timestamp_composite_matcher::update_last_arrived(frame_holder& f, matcher* m)
+    void timestamp_composite_matcher::update_last_arrived(frame_holder& f, sync_slot& slot)
     {
         if(f->supports_frame_metadata(RS2_FRAME_METADATA_ACTUAL_FPS))
-            _fps[m] = (uint32_t)f->get_frame_metadata(RS2_FRAME_METADATA_ACTUAL_FPS);
+            slot.fps = (uint32_t)f->get_frame_metadata(RS2_FRAME_METADATA_ACTUAL_FPS);
 
         else
-            _fps[m] = f->get_stream()->get_framerate();
+            slot.fps = f->get_stream()->get_framerate();
 
-        _last_arrived[m] = environment::get_instance().get_time_service()->get_time();
+        slot.last_arrived = environment::get_instance().get_time_service()->get_time();
     }
 
     unsigned int timestamp_composite_matcher::get_fps(const frame_holder & f)
@@ -527,16 +545,14 @@ namespace librealsense
         return fps?fps:f.frame->get_stream()->get_framerate();
     }
 
-    void timestamp_composite_matcher::update_next_expected(const frame_holder & f)
+    void timestamp_composite_matcher::update_next_expected(const frame_holder & f, sync_slot& slot)
     {
         auto fps = get_fps(f);
         auto gap = 1000.f / (float)fps;
 
-        auto matcher = find_matcher(f);
-
-        _next_expected[matcher.get()] = f.frame->get_frame_timestamp() + gap;
-        _next_expected_domain[matcher.get()] = f.frame->get_frame_timestamp_domain();
-        LOG_DEBUG(_name << frame_to_string(const_cast<frame_holder&>(f))<<"fps " <<fps<<" gap " <<gap<<" next_expected: "<< _next_expected[matcher.get()]);
+        slot.next_expected = f.frame->get_frame_timestamp() + gap;
+        slot.next_expected_domain = f.frame->get_frame_timestamp_domain();
+        LOG_DEBUG(_name << frame_to_string(const_cast<frame_holder&>(f))<<"fps " <<fps<<" gap " <<gap<<" next_expected: "<< slot.next_expected);
 
     }
 
@@ -544,62 +560,60 @@ namespace librealsense
     {
         if (f.is_blocking())
             return;
-        std::vector<stream_id> dead_matchers;
         auto now = environment::get_instance().get_time_service()->get_time();
-        for(auto m: _matchers)
+        for(auto&& slot: _slots)
         {
-            auto threshold = _fps[m.second.get()] ? (1000 / _fps[m.second.get()]) * 5 : 500; //if frame of a specific stream didn't arrive for time equivalence to 5 frames duration
-                                                                                             //this stream will be marked as "not active" in order to not stack the other streams
-            if(_last_arrived[m.second.get()] && (now - _last_arrived[m.second.get()]) > threshold)
+            auto threshold = slot->fps ? (1000 / slot->fps) * 5 : 500; //if frame of a specific stream didn't arrive for time equivalence to 5 frames duration
+                                                                       //this stream will be marked as "not active" in order to not stack the other streams
+            if(slot->last_arrived && (now - slot->last_arrived) > threshold)
             {
-                std::stringstream s;
-                s << "clean inactive stream in "<<_name;
-                for (auto stream : m.second->get_streams_types())
+                if (is_log_enabled(RS2_LOG_SEVERITY_DEBUG))
                 {
-                    s << stream << " ";
+                    std::stringstream s;
+                    s << "clean inactive stream in "<<_name;
+                    for (auto stream : slot->m->get_streams_types())
+                    {
+                        s << stream << " ";
+                    }
+                    LOG_DEBUG(s.str());
                 }
-                LOG_DEBUG(s.str());
 
-                dead_matchers.push_back(m.first);
-                m.second->set_active(false);
+                slot->m->set_active(false);
+                slot->queue.clear();
+                slot->queued = false;
             }
         }
-
-        for(auto id: dead_matchers)
-        {
-            _frames_queue[_matchers[id].get()].clear();
-            _frames_queue.erase(_matchers[id].get());
-        }
     }
 
-    bool timestamp_composite_matcher::skip_missing_stream(std::vector<matcher*> synced, matcher* missing)
+    bool timestamp_composite_matcher::skip_missing_stream(const std::vector<sync_slot*>& synced, sync_slot& missing)
     {
-        if(!missing->get_active())
+        if(!missing.m->get_active())
             return true;
 
-        frame_holder* synced_frame;
+        queued_frame* q;
 
-        _frames_queue[synced[0]].peek(&synced_frame);
+        synced[0]->queue.peek(&q);
+        auto&& synced_frame = q->frame;
 
-        auto next_expected = _next_expected[missing];
+        auto next_expected = missing.next_expected;
 
-        auto it = _next_expected_domain.find(missing);
-        if (it != _next_expected_domain.end())
+        if (missing.next_expected_domain != RS2_TIMESTAMP_DOMAIN_COUNT)
         {
-            if (it->second != (*synced_frame)->get_frame_timestamp_domain())
+            if (missing.next_expected_domain != synced_frame->get_frame_timestamp_domain())
             {
                 return false;
             }
         }
-        auto gap = 1000.f/ (float)get_fps(*synced_frame);
+        auto fps = get_fps(synced_frame);
+        auto gap = 1000.f/ (float)fps;
         //next expected of the missing stream didn't updated yet
-        if((*synced_frame)->get_frame_timestamp() > next_expected && abs((*synced_frame)->get_frame_timestamp()- next_expected)<gap*10)
+        if(synced_frame->get_frame_timestamp() > next_expected && abs(synced_frame->get_frame_timestamp()- next_expected)<gap*10)
         {
             LOG_DEBUG("next expected of the missing stream didn't updated yet");
             return false;
         }
 
-        return !are_equivalent((*synced_frame)->get_frame_timestamp(), next_expected, get_fps(*synced_frame));
+        return !are_equivalent(synced_frame->get_frame_timestamp(), next_expected, fps);
     }
 
     bool timestamp_composite_matcher::are_equivalent(double a, double b, int fps)
@@ -109,30 +109,74 @@ namespace librealsense
 
     };
 
+    // A frame waiting in a queue of a composite matcher, with the system time it was queued at
+    struct queued_frame
+    {
+        frame_holder frame;
+        rs2_time_t arrival = 0;
+
+        queued_frame() = default;
+        queued_frame(frame_holder&& f, rs2_time_t t) : frame(std::move(f)), arrival(t) {}
+
+        bool is_blocking() const { return frame.is_blocking(); }
+    };
+
     class composite_matcher : public matcher
     {
     public:
+        // The synchronization state of a matcher of the composite: a single stream, or the streams
+        // already synchronized by a nested matcher. Slots are created once per matcher and never
+        // moved, so that the frame path indexes them without lookups nor allocations
+        struct sync_slot
+        {
+            explicit sync_slot(std::shared_ptr<matcher> m) : m(std::move(m)) {}
+
+            std::shared_ptr<matcher> m;
+            single_consumer_frame_queue<queued_frame> queue;
+            bool queued = false;        // the queue takes part in the synchronization
+            double next_expected = 0;   // timestamp or frame number of the next frame
+            rs2_timestamp_domain next_expected_domain = RS2_TIMESTAMP_DOMAIN_COUNT; // until known
+            double last_arrived = 0;    // system time or frame number of the last frame
+            unsigned int fps = 0;
+        };
+
         composite_matcher(std::vector<std::shared_ptr<matcher>> matchers, std::string name);
 
 
         virtual bool are_equivalent(frame_holder& a, frame_holder& b) = 0;
         virtual bool is_smaller_than(frame_holder& a, frame_holder& b) = 0;
-        virtual bool skip_missing_stream(std::vector<matcher*> synced, matcher* missing) = 0;
+        virtual bool skip_missing_stream(const std::vector<sync_slot*>& synced, sync_slot& missing) = 0;
         virtual void clean_inactive_streams(frame_holder& f) = 0;
-        virtual void update_last_arrived(frame_holder& f, matcher* m) = 0;
+        virtual void update_last_arrived(frame_holder& f, sync_slot& slot) = 0;
 
         void dispatch(frame_holder f, syncronization_environment env) override;
-        std::string frames_to_string(std::vector<librealsense::matcher*> matchers);
+        std::string frames_to_string(const std::vector<sync_slot*>& slots);
         void sync(frame_holder f, syncronization_environment env) override;
         std::shared_ptr<matcher> find_matcher(const frame_holder& f);
 
+        // Maximal time in milliseconds the frames of a set wait for the missing streams, past which the
+        // set is released incomplete. 0 waits as long as the missing streams are expected.
+        // Applies to the nested composite matchers too
+        void set_max_wait(rs2_time_t ms);
+
     protected:
-        virtual void update_next_expected(const frame_holder& f) = 0;
+        virtual void update_next_expected(const frame_holder& f, sync_slot& slot) = 0;
+
+        sync_slot* find_slot(const frame_holder& f);
+        sync_slot* add_slot(const frame_holder& f);
+        sync_slot* add_matcher(std::shared_ptr<matcher> m);
 
-        std::map<matcher*, single_consumer_frame_queue<frame_holder>> _frames_queue;
-        std::map<stream_id, std::shared_ptr<matcher>> _matchers;
-        std::map<matcher*, double> _next_expected;
-        std::map<matcher*, rs2_timestamp_domain> _next_expected_domain;
+        std::vector<std::unique_ptr<sync_slot>> _slots;
+        // Streams are few: searched linearly, which is cheaper than a map
+        std::vector<std::pair<stream_id, sync_slot*>> _stream_slots;
+        rs2_time_t _max_wait = 0;
+
+    private:
+        // Scratch lists of sync(), kept so that they are not reallocated for every frame
+        std::vector<queued_frame*> _arrived;
+        std::vector<sync_slot*> _arrived_slots;
+        std::vector<sync_slot*> _synced;
+        std::vector<sync_slot*> _missing;
     };
 
     // composite matcher that does not synchronize between any frames, and instead just passes them on to callback
@@ -144,27 +188,24 @@ namespace librealsense
         void sync(frame_holder f, syncronization_environment env) override;
         virtual bool are_equivalent(frame_holder& a, frame_holder& b) override { return false; }
         virtual bool is_smaller_than(frame_holder& a, frame_holder& b) override { return false; }
-        virtual bool skip_missing_stream(std::vector<matcher*> synced, matcher* missing) override { return false; }
+        virtual bool skip_missing_stream(const std::vector<sync_slot*>& synced, sync_slot& missing) override { return false; }
         virtual void clean_inactive_streams(frame_holder& f) override {}
-        virtual void update_last_arrived(frame_holder& f, matcher* m) override {}
+        virtual void update_last_arrived(frame_holder& f, sync_slot& slot) override {}
 
     protected:
-        virtual void update_next_expected(const frame_holder& f) override {}
+        virtual void update_next_expected(const frame_holder& f, sync_slot& slot) override {}
     };
 
     class frame_number_composite_matcher : public composite_matcher
     {
     public:
         frame_number_composite_matcher(std::vector<std::shared_ptr<matcher>> matchers);
-        virtual void update_last_arrived(frame_holder& f, matcher* m) override;
+        virtual void update_last_arrived(frame_holder& f, sync_slot& slot) override;
         bool are_equivalent(frame_holder& a, frame_holder& b) override;
         bool is_smaller_than(frame_holder& a, frame_holder& b) override;
-        bool skip_missing_stream(std::vector<matcher*> synced, matcher* missing) override;
+        bool skip_missing_stream(const std::vector<sync_slot*>& synced, sync_slot& missing) override;
         void clean_inactive_streams(frame_holder& f) override;
-        void update_next_expected(const frame_holder& f) override;
-
-    private:
-         std::map<matcher*,unsigned long long> _last_arrived;
+        void update_next_expected(const frame_holder& f, sync_slot& slot) override;
     };
 
     class timestamp_composite_matcher : public composite_matcher
@@ -173,16 +214,13 @@ namespace librealsense
         timestamp_composite_matcher(std::vector<std::shared_ptr<matcher>> matchers);
         bool are_equivalent(frame_holder& a, frame_holder& b) override;
         bool is_smaller_than(frame_holder& a, frame_holder& b) override;
-        virtual void update_last_arrived(frame_holder& f, matcher* m) override;
+        virtual void update_last_arrived(frame_holder& f, sync_slot& slot) override;
         void clean_inactive_streams(frame_holder& f) override;
-        bool skip_missing_stream(std::vector<matcher*> synced, matcher* missing) override;
-        void update_next_expected(const frame_holder & f) override;
+        bool skip_missing_stream(const std::vector<sync_slot*>& synced, sync_slot& missing) override;
+        void update_next_expected(const frame_holder& f, sync_slot& slot) override;
 
     private:
         unsigned int get_fps(const frame_holder & f);
         bool are_equivalent(double a, double b, int fps);
-        std::map<matcher*, double> _last_arrived;
-        std::map<matcher*, unsigned int> _fps;
-
     };
 }
@@ -739,7 +739,7 @@ namespace librealsense
             f.profile.set(vframe->get_width(), vframe->get_height(), vframe->get_stride(), convertToTm2PixelFormat(vframe->get_stream()->get_format()));
             f.exposuretime = get_md_or_default(RS2_FRAME_METADATA_ACTUAL_EXPOSURE);
             f.frameLength = vframe->get_height()*vframe->get_stride()* (vframe->get_bpp() / 8);
-            f.data = vframe->data.data();
+            f.data = vframe->get_frame_data();
             f.timestamp = to_nanos(vframe->additional_data.timestamp);
             f.systemTimestamp = to_nanos(vframe->additional_data.backend_timestamp);
             f.arrivalTimeStamp = to_nanos(vframe->additional_data.system_time);
@@ -1231,7 +1231,7 @@ namespace librealsense
             frame->set_timestamp_domain(RS2_TIMESTAMP_DOMAIN_GLOBAL_TIME);
             frame->set_stream(profile);
             frame->set_sensor(this->shared_from_this()); //TODO? uvc doesn't set it?
-            video->data.assign(message->metadata.bFrameData, message->metadata.bFrameData + (height * stride));
+            memcpy((void*)video->get_frame_data(), message->metadata.bFrameData, height * stride);
         }
         else
         {
@@ -453,6 +453,12 @@ namespace librealsense
             case RS2_OPTION_ENABLE_IR_REFLECTIVITY: return "Enable IR Reflectivity";
             CASE(AUTO_EXPOSURE_LIMIT)
             CASE(AUTO_GAIN_LIMIT)
+            CASE(FRAME_POOL_PREWARM_SIZE)
+            CASE(FRAME_POOL_HITS)
+            CASE(FRAME_POOL_MISSES)
+            CASE(FRAME_POOL_EVICTIONS)
+            CASE(FRAME_POOL_RESIDENT_BYTES)
+            CASE(SYNC_MAX_WAIT)
         default: assert(!is_valid(value)); return UNKNOWN_VALUE;
         }
 #undef CASE
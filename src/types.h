@@ -33,6 +33,7 @@
 #include <vector>                           // For vector
 #include <sstream>                          // For ostringstream
 #include <mutex>                            // For mutex, unique_lock
+#include <atomic>
 #include <memory>                           // For unique_ptr
 #include <map>
 #include <limits>
@@ -207,6 +208,24 @@ namespace librealsense
     void reset_logger();
     void enable_rolling_log_file( unsigned max_size );
 
+    // Statements below LRS_MIN_LOG_LEVEL (an rs2_log_severity value) are removed at compile time
+#ifndef LRS_MIN_LOG_LEVEL
+#define LRS_MIN_LOG_LEVEL 0
+#endif
+
+    // The lowest severity consumed by any of the log outputs, kept by the logger.
+    // Statements below it are skipped before their message is formatted
+    inline std::atomic<int>& log_severity_floor()
+    {
+        static std::atomic<int> floor{ RS2_LOG_SEVERITY_DEBUG };
+        return floor;
+    }
+
+    inline bool is_log_enabled(rs2_log_severity severity)
+    {
+        return severity >= LRS_MIN_LOG_LEVEL && severity >= log_severity_floor().load(std::memory_order_relaxed);
+    }
+
 #if BUILD_EASYLOGGINGPP
 
 #ifdef RS2_USE_ANDROID_BACKEND
@@ -226,10 +245,10 @@ namespace librealsense
 
 #else //RS2_USE_ANDROID_BACKEND
 
-#define LOG_DEBUG(...)   do { CLOG(DEBUG   ,"librealsense") << __VA_ARGS__; } while(false)
-#define LOG_INFO(...)    do { CLOG(INFO    ,"librealsense") << __VA_ARGS__; } while(false)
-#define LOG_WARNING(...) do { CLOG(WARNING ,"librealsense") << __VA_ARGS__; } while(false)
-#define LOG_ERROR(...)   do { CLOG(ERROR   ,"librealsense") << __VA_ARGS__; } while(false)
+#define LOG_DEBUG(...)   do { if (librealsense::is_log_enabled(RS2_LOG_SEVERITY_DEBUG)) CLOG(DEBUG   ,"librealsense") << __VA_ARGS__; } while(false)
+#define LOG_INFO(...)    do { if (librealsense::is_log_enabled(RS2_LOG_SEVERITY_INFO))  CLOG(INFO    ,"librealsense") << __VA_ARGS__; } while(false)
+#define LOG_WARNING(...) do { if (librealsense::is_log_enabled(RS2_LOG_SEVERITY_WARN))  CLOG(WARNING ,"librealsense") << __VA_ARGS__; } while(false)
+#define LOG_ERROR(...)   do { if (librealsense::is_log_enabled(RS2_LOG_SEVERITY_ERROR)) CLOG(ERROR   ,"librealsense") << __VA_ARGS__; } while(false)
 #define LOG_FATAL(...)   do { CLOG(FATAL   ,"librealsense") << __VA_ARGS__; } while(false)
 
 #endif // RS2_USE_ANDROID_BACKEND
@@ -244,6 +263,23 @@ namespace librealsense
 
 #endif // BUILD_EASYLOGGINGPP
 
+#if LRS_MIN_LOG_LEVEL > 0
+#undef LOG_DEBUG
+#define LOG_DEBUG(...)   do { ; } while(false)
+#endif
+#if LRS_MIN_LOG_LEVEL > 1
+#undef LOG_INFO
+#define LOG_INFO(...)    do { ; } while(false)
+#endif
+#if LRS_MIN_LOG_LEVEL > 2
+#undef LOG_WARNING
+#define LOG_WARNING(...) do { ; } while(false)
+#endif
+#if LRS_MIN_LOG_LEVEL > 3
+#undef LOG_ERROR
+#define LOG_ERROR(...)   do { ; } while(false)
+#endif
+
     // Enhancement for debug mode that incurs performance penalty with STL
     // std::clamp to be introduced with c++17
     template< typename T>
@@ -1444,19 +1480,26 @@ namespace librealsense
     {
         std::function<void()> continuation;
         const void* protected_data = nullptr;
+        size_t protected_data_size = 0;
+        bool owns_protected_data = false; // the data outlives any backend buffer and need not be copied on keep()
 
         frame_continuation(const frame_continuation &) = delete;
         frame_continuation & operator=(const frame_continuation &) = delete;
     public:
         frame_continuation() : continuation([]() {}) {}
 
-        explicit frame_continuation(std::function<void()> continuation, const void* protected_data) : continuation(continuation), protected_data(protected_data) {}
+        explicit frame_continuation(std::function<void()> continuation, const void* protected_data, size_t protected_data_size = 0, bool owns_protected_data = false)
+            : continuation(continuation), protected_data(protected_data), protected_data_size(protected_data_size), owns_protected_data(owns_protected_data) {}
 
 
-        frame_continuation(frame_continuation && other) : continuation(std::move(other.continuation)), protected_data(other.protected_data)
+        frame_continuation(frame_continuation && other)
+            : continuation(std::move(other.continuation)), protected_data(other.protected_data), protected_data_size(other.protected_data_size),
+              owns_protected_data(other.owns_protected_data)
         {
             other.continuation = []() {};
             other.protected_data = nullptr;
+            other.protected_data_size = 0;
+            other.owns_protected_data = false;
         }
 
         void operator()()
@@ -1464,23 +1507,33 @@ namespace librealsense
             continuation();
             continuation = []() {};
             protected_data = nullptr;
+            protected_data_size = 0;
+            owns_protected_data = false;
         }
 
         void reset()
         {
             protected_data = nullptr;
+            protected_data_size = 0;
+            owns_protected_data = false;
             continuation = [](){};
         }
 
         const void* get_data() const { return protected_data; }
+        size_t get_data_size() const { return protected_data_size; }
+        bool owns_data() const { return owns_protected_data; }
 
         frame_continuation & operator=(frame_continuation && other)
         {
             continuation();
             protected_data = other.protected_data;
+            protected_data_size = other.protected_data_size;
+            owns_protected_data = other.owns_protected_data;
             continuation = other.continuation;
             other.continuation = []() {};
             other.protected_data = nullptr;
+            other.protected_data_size = 0;
+            other.owns_protected_data = false;
             return *this;
         }
 
@@ -30,6 +30,8 @@ namespace librealsense
             virtual void* get_native_request() const = 0;
             virtual const std::vector<uint8_t>& get_buffer() const = 0;
             virtual void set_buffer(const std::vector<uint8_t>& buffer) = 0;
+            // Exchanges the request buffer with the given one, without copying the data
+            virtual void swap_buffer(std::vector<uint8_t>& buffer) = 0;
 
         protected:
             virtual void set_native_buffer_length(int length) = 0;
@@ -55,6 +57,12 @@ namespace librealsense
                 set_native_buffer(_buffer.data());
                 set_native_buffer_length( static_cast< int >( _buffer.size() ));
             }
+            virtual void swap_buffer(std::vector<uint8_t>& buffer) override
+            {
+                _buffer.swap(buffer);
+                set_native_buffer(_buffer.data());
+                set_native_buffer_length( static_cast< int >( _buffer.size() ));
+            }
 
         protected:
             void* _client_data;
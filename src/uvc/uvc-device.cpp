@@ -103,6 +103,7 @@ namespace librealsense
 
             _profiles.push_back(profile);
             _frame_callbacks.push_back(callback);
+            _frame_buffers.push_back(buffers);
         }
 
         void rs_uvc_device::stream_on(std::function<void(const notification& n)> error_handler)
@@ -117,7 +118,7 @@ namespace librealsense
 
             try {
                 for (uint32_t i = 0; i < _profiles.size(); ++i) {
-                    play_profile(_profiles[i], _frame_callbacks[i]);
+                    play_profile(_profiles[i], _frame_callbacks[i], _frame_buffers[i]);
                 }
             }
             catch (...) {
@@ -127,6 +128,7 @@ namespace librealsense
 
                 _profiles.clear();
                 _frame_callbacks.clear();
+                _frame_buffers.clear();
 
                 throw;
             }
@@ -418,7 +420,7 @@ namespace librealsense
             return translated_value;
         }
 
-        void rs_uvc_device::play_profile(stream_profile profile, frame_callback callback) {
+        void rs_uvc_device::play_profile(stream_profile profile, frame_callback callback, int buffers) {
             bool foundFormat = false;
 
             uvc_format_t selected_format{};
@@ -451,7 +453,9 @@ namespace librealsense
             if(sts != RS2_USB_STATUS_SUCCESS)
                 throw std::runtime_error("Failed to start streaming!");
 
-            uvc_streamer_context usc = { profile, callback, ctrl, _usb_device, _messenger, _usb_request_count };
+            // Frames queued for publishing, on top of the ones the consumers may borrow without a copy
+            auto frames_pool_size = static_cast<uint32_t>(std::max(buffers, 1) + MAX_BORROWED_FRAMES);
+            uvc_streamer_context usc = { profile, callback, ctrl, _usb_device, _messenger, _usb_request_count, frames_pool_size };
 
             auto streamer = std::make_shared<uvc_streamer>(usc);
             _streamers.push_back(streamer);
@@ -477,6 +481,7 @@ namespace librealsense
             if (pos != _profiles.size()) {
                 _profiles.erase(_profiles.begin() + pos);
                 _frame_callbacks.erase(_frame_callbacks.begin() + pos);
+                _frame_buffers.erase(_frame_buffers.begin() + pos);
             }
         }
 
@@ -79,7 +79,7 @@ namespace librealsense
             bool uvc_set_ctrl(uint8_t unit, uint8_t ctrl, void *data, int len);
 
             int32_t rs2_value_translate(uvc_req_code action, rs2_option option, int32_t value) const;
-            void play_profile(stream_profile profile, frame_callback callback);
+            void play_profile(stream_profile profile, frame_callback callback, int buffers);
             void stop_stream_cleanup(const stream_profile& profile, std::vector<profile_and_callback>::iterator& elem);
             void check_connection() const;
 
@@ -97,6 +97,7 @@ namespace librealsense
             std::string                             _location;
             std::vector<stream_profile>             _profiles;
             std::vector<frame_callback>             _frame_callbacks;
+            std::vector<int>                        _frame_buffers;
 
             rs_usb_device                           _usb_device = nullptr;
             rs_usb_messenger                        _messenger;
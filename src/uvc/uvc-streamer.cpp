@@ -7,17 +7,14 @@
 const int UVC_PAYLOAD_MAX_HEADER_LENGTH         = 1024;
 const int DEQUEUE_MILLISECONDS_TIMEOUT          = 50;
 const int ENDPOINT_RESET_MILLISECONDS_TIMEOUT   = 100;
-
-void cleanup_frame(backend_frame *ptr) {
-    if (ptr) ptr->owner->deallocate(ptr);
-}
+const int FRAMES_RELEASE_MILLISECONDS_TIMEOUT   = 1000;
 
 namespace librealsense
 {
     namespace platform
     {
         uvc_streamer::uvc_streamer(uvc_streamer_context context) :
-            _context(context), _action_dispatcher(10)
+            _context(context), _action_dispatcher(10), _queue(context.frames_pool_size)
         {
             auto inf = context.usb_device->get_interface(context.control->bInterfaceNumber);
             if (inf == nullptr)
@@ -39,7 +36,7 @@ namespace librealsense
             flush();
         }
 
-        void uvc_process_bulk_payload(backend_frame_ptr fp, size_t payload_len, backend_frames_queue& queue) {
+        void uvc_process_bulk_payload(backend_frame_ptr fp, size_t payload_len, backend_frames_queue& queue, std::atomic<uint64_t>& dropped_frames) {
 
             /* ignore empty payload transfers */
             if (!fp || payload_len < 2)
@@ -67,32 +64,33 @@ namespace librealsense
                                                      fp->pixels.data() + header_len , fp->pixels.data() };
             fp->fo = fo;
 
-            queue.enqueue(std::move(fp));
+            // A full queue drops its oldest frame, which the publishing thread did not keep up with
+            queue.enqueue(std::move(fp), [&](backend_frame_ptr&) { ++dropped_frames; });
         }
 
         void uvc_streamer::init()
         {
-            _frames_archive = std::make_shared<backend_frames_archive>();
-            // Get all pointers from archive and initialize their content
-            std::vector<backend_frame *> frames;
-            for (auto i = 0; i < _frames_archive->CAPACITY; i++) {
-                auto ptr = _frames_archive->allocate();
-                ptr->pixels.resize(_read_buff_length, 0);
-                ptr->owner = _frames_archive.get();
-                frames.push_back(ptr);
-            }
-
-            for (auto ptr : frames) {
-                _frames_archive->deallocate(ptr);
-            }
+            // The requests stream into buffers of their own, which are exchanged with a free frame of the
+            // pool once a frame is received, so the receive path neither copies nor allocates.
+            // The frames are held until published and released by the consumers
+            _frames_archive = std::make_shared<backend_frames_archive>(_context.frames_pool_size, _read_buff_length);
+            LOG_INFO("endpoint " << (int)_read_endpoint->get_address() << " frames pool size: " << _frames_archive->capacity());
 
             _publish_frame_thread = std::make_shared<active_object<>>([this](dispatcher::cancellable_timer cancellable_timer)
             {
-                backend_frame_ptr fp(nullptr, [](backend_frame *) {});
+                backend_frame_ptr fp;
                 if (_queue.dequeue(&fp, DEQUEUE_MILLISECONDS_TIMEOUT))
                 {
                     if(_publish_frames && running())
-                        _context.user_cb(_context.profile, fp->fo, []() mutable {});
+                    {
+                        // The continuation owns the backend frame, so a consumer that borrows the
+                        // pixels keeps the buffer out of the archive until it is done with it.
+                        // The frame keeps the archive alive, as it may be released after the streamer is gone
+                        auto fo = fp->fo;
+                        auto archive = _frames_archive;
+                        std::shared_ptr<backend_frame> held(fp.release(), [archive](backend_frame* f) { backend_frame_deleter()(f); });
+                        _context.user_cb(_context.profile, fo, [held]() mutable { held.reset(); });
+                    }
                 }
             });
 
@@ -113,30 +111,34 @@ namespace librealsense
 
             _request_callback = std::make_shared<usb_request_callback>([this](platform::rs_usb_request r)
             {
-                _action_dispatcher.invoke([this, r](dispatcher::cancellable_timer)
+                // Runs on the USB events thread; stop() waits for it by cancelling the callback
+                if(!_running)
+                    return;
+
+                auto al = r->get_actual_length();
+                // Relax the frame size constrain for compressed streams
+                bool is_compressed = val_in_range(_context.profile.format, { 0x4d4a5047U , 0x5a313648U}); // MJPEG, Z16H
+                if(al > 0L && ((al == r->get_buffer().data()[0] + _context.control->dwMaxVideoFrameSize) || is_compressed ))
                 {
-                    if(!_running)
-                      return;
+                    _frame_arrived = true;
+                    _watchdog->kick();
 
-                    auto al = r->get_actual_length();
-                    // Relax the frame size constrain for compressed streams
-                    bool is_compressed = val_in_range(_context.profile.format, { 0x4d4a5047U , 0x5a313648U}); // MJPEG, Z16H
-                    if(al > 0L && ((al == r->get_buffer().data()[0] + _context.control->dwMaxVideoFrameSize) || is_compressed ))
+                    auto f = backend_frame_ptr(_frames_archive->allocate());
+                    if(f)
                     {
-                        auto f = backend_frame_ptr(_frames_archive->allocate(), &cleanup_frame);
-                        if(f)
-                        {
-                            _frame_arrived = true;
-                            _watchdog->kick();
-                            memcpy(f->pixels.data(), r->get_buffer().data(), r->get_buffer().size());
-                            uvc_process_bulk_payload(std::move(f), r->get_actual_length(), _queue);
-                        }
+                        // The frame takes the received data, and the request is resubmitted with the free buffer of the frame
+                        r->swap_buffer(f->pixels);
+                        uvc_process_bulk_payload(std::move(f), al, _queue, _dropped_frames);
                     }
+                    else
+                        ++_dropped_frames;
+                }
+                else if(al > 0L)
+                    ++_underruns;
 
-                    auto sts = _context.messenger->submit_request(r);
-                    if(sts != platform::RS2_USB_STATUS_SUCCESS)
-                        LOG_ERROR("failed to submit UVC request, error: " << sts);
-                });
+                auto sts = _context.messenger->submit_request(r);
+                if(sts != platform::RS2_USB_STATUS_SUCCESS)
+                    LOG_ERROR("failed to submit UVC request, error: " << sts);
             });
 
             _requests = std::vector<rs_usb_request>(_context.request_count);
@@ -194,12 +196,19 @@ namespace librealsense
 
                 _requests.clear();
 
-                _frames_archive->wait_until_empty();
+                // The consumers may keep their frames for as long as they like, the archive outlives the streamer for them
+                if(!_frames_archive->wait_until_empty(std::chrono::milliseconds(FRAMES_RELEASE_MILLISECONDS_TIMEOUT)))
+                    LOG_WARNING("endpoint " << (int)_read_endpoint->get_address() << " stopped while "
+                        << _frames_archive->in_use() << " frames are still held by the consumers");
 
                 _context.messenger->reset_endpoint(_read_endpoint, RS2_USB_ENDPOINT_DIRECTION_READ);
 
                 _publish_frame_thread->stop();
 
+                if(_dropped_frames || _underruns)
+                    LOG_INFO("endpoint " << (int)_read_endpoint->get_address() << " dropped frames: " << _dropped_frames
+                        << ", underruns: " << _underruns);
+
                 {
                     std::lock_guard<std::mutex> lock(_running_mutex);
                     _running = false;
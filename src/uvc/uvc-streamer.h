@@ -26,6 +26,7 @@ namespace librealsense
             rs_usb_device usb_device;
             rs_usb_messenger messenger;
             uint8_t request_count;
+            uint32_t frames_pool_size;  // frame buffers the received data is handed over in, see uvc_streamer::init
         };
 
         class uvc_streamer
@@ -43,12 +44,20 @@ namespace librealsense
             void disable_user_callbacks() { _publish_frames = false; }
             bool wait_for_first_frame(uint32_t timeout_ms);
 
+            // Complete frames discarded since all the buffers of the pool were still held by the consumers,
+            // or since the queue of the frames to publish was full
+            uint64_t get_dropped_frames() const { return _dropped_frames; }
+            // Transfers that ended before a complete frame was received
+            uint64_t get_underruns() const { return _underruns; }
+
         private:
             std::mutex _running_mutex;
             std::condition_variable _stopped_cv;
             bool _running = false;
             bool _frame_arrived = false;
             bool _publish_frames = true;
+            std::atomic<uint64_t> _dropped_frames{ 0 };
+            std::atomic<uint64_t> _underruns{ 0 };
 
             int64_t _watchdog_timeout;
             uvc_streamer_context _context;
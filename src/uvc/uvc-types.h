@@ -414,9 +414,7 @@ T as(const std::vector<uint8_t>& data, size_t index)
     return rv;
 }
 
-struct backend_frame;
-
-typedef librealsense::small_heap<backend_frame, 10> backend_frames_archive;
+class backend_frames_archive;
 
 struct backend_frame {
     backend_frame() {}
@@ -434,8 +432,88 @@ struct backend_frame {
     backend_frames_archive *owner; // Keep pointer to owner for light-deleter
 };
 
-typedef void(*cleanup_ptr)(backend_frame *);
+// Returns the frame to its archive
+struct backend_frame_deleter
+{
+    void operator()(backend_frame *ptr) const;
+};
+
+// Unique_ptr is used as the simplest RAII, with stateless deleter
+typedef std::unique_ptr<backend_frame, backend_frame_deleter> backend_frame_ptr;
+typedef lockfree_queue<backend_frame_ptr> backend_frames_queue;
+
+// Fixed pool of the frame buffers of a stream, sized at construction.
+// Allocation and deallocation never touch the heap, and allocate returns nullptr
+// once all the frames are in use, so the caller can drop the incoming data
+class backend_frames_archive
+{
+public:
+    backend_frames_archive(size_t capacity, size_t buffer_size)
+        : _frames(capacity)
+    {
+        _free.reserve(capacity);
+        for (auto&& f : _frames)
+        {
+            f.pixels.resize(buffer_size, 0);
+            f.owner = this;
+            _free.push_back(&f);
+        }
+    }
+
+    backend_frames_archive(const backend_frames_archive&) = delete;
+    backend_frames_archive& operator=(const backend_frames_archive&) = delete;
+
+    backend_frame *allocate()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_keep_allocating || _free.empty())
+            return nullptr;
+        auto f = _free.back();
+        _free.pop_back();
+        return f;
+    }
+
+    void deallocate(backend_frame *f)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _free.push_back(f);
+        if (_free.size() == _frames.size())
+        {
+            lock.unlock();
+            _cv.notify_one();
+        }
+    }
 
-// Unique_ptr is used as the simplest RAII, with static deleter
-typedef std::unique_ptr<backend_frame, cleanup_ptr> backend_frame_ptr;
-typedef single_consumer_queue<backend_frame_ptr> backend_frames_queue;
+    void stop_allocation()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _keep_allocating = false;
+    }
+
+    // Returns false if some frames are still in use once the timeout expires
+    bool wait_until_empty(std::chrono::milliseconds timeout)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        return _cv.wait_for(lock, timeout, [this]() { return _free.size() == _frames.size(); });
+    }
+
+    size_t capacity() const { return _frames.size(); }
+
+    size_t in_use()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _frames.size() - _free.size();
+    }
+
+private:
+    std::vector<backend_frame> _frames;
+    std::vector<backend_frame *> _free;
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    bool _keep_allocating = true;
+};
+
+inline void backend_frame_deleter::operator()(backend_frame *ptr) const
+{
+    if (ptr) ptr->owner->deallocate(ptr);
+}
@@ -54,6 +54,7 @@
 
 #include <ios>
 #include <map>
+#include <memory>
 #include <queue>
 #include <set>
 #include <stdexcept>
@@ -80,6 +81,10 @@ typedef bagmode::BagMode BagMode;
 class MessageInstance;
 class View;
 class Query;
+class ChunkWriter;
+class ChunkPrefetcher;
+class MappedFile;
+struct OutgoingChunk;
 
 class ROSBAG_DECL Bag
 {
@@ -124,6 +129,43 @@ public:
     void            setChunkThreshold(uint32_t chunk_threshold);  //!< Set the threshold for creating new chunks
     uint32_t        getChunkThreshold() const;                    //!< Get the threshold for creating new chunks
 
+    //! Set the number of threads compressing and writing the chunks (0 - on the calling thread, the default)
+    /*!
+     * With write threads, writing a message only serializes it into the current chunk, and the closed chunks
+     * are compressed in parallel and written in order. BZ2 chunks are always written on the calling thread.
+     * The messages of the bag cannot be read while it is written with write threads.
+     */
+    void            setWriteThreads(uint32_t threads);
+    uint32_t        getWriteThreads() const;                      //!< Get the number of threads compressing and writing the chunks
+
+    //! Set the number of chunks read ahead of the messages being read (0 - no read-ahead, the default)
+    /*!
+     * The chunks following the last chunk read are read and decompressed on a background thread,
+     * through a separate handle to the file. Applies to the open bag and to the bags opened later.
+     */
+    void            setPrefetchDepth(uint32_t chunks);
+    uint32_t        getPrefetchDepth()  const;                    //!< Get the number of chunks read ahead
+    uint64_t        getPrefetchHits()   const;                    //!< Get the number of chunks read ahead in time since the bag was opened
+    uint64_t        getPrefetchMisses() const;                    //!< Get the number of chunks read on demand since the bag was opened
+
+    //! Set whether the connection indexes of the bags opened for reading are cached next to them (false by default)
+    /*!
+     * The indexes are spread after each chunk, so opening a large bag seeks through all of it.
+     * When enabled, the indexes of a large bag are written to <filename>.idx the first time it is opened,
+     * and read from there as long as it matches the bag. Failing to write the cache is not an error.
+     */
+    void            setIndexCache(bool enable);
+    bool            getIndexCache() const;                        //!< Get whether the connection indexes are cached next to the bags
+
+    //! Set whether the bags opened for reading are mapped into memory (false by default)
+    /*!
+     * The records of uncompressed chunks are then read in place from the mapping rather than copied from the file,
+     * and MessageInstance::getMappedData gives access to the messages without deserializing them.
+     * If the file cannot be mapped, e.g. in a 32-bit process, it is read as usual.
+     */
+    void            setMappedRead(bool enable);
+    bool            getMappedRead() const;                        //!< Get whether the bags opened for reading are mapped into memory
+
     //! Write a message into the bag file
     /*!
      * \param topic The topic name
@@ -201,12 +243,14 @@ private:
     void appendConnectionRecordToBuffer(Buffer& buf, ConnectionInfo const* connection_info);
     template<class T>
     void writeMessageDataRecord(uint32_t conn_id, rs2rosinternal::Time const& time, T const& msg);
-    void writeIndexRecords();
+    void writeIndexRecords(std::map<uint32_t, std::multiset<IndexEntry> > const& indexes);
     void writeConnectionRecords();
     void writeChunkInfoRecords();
     void startWritingChunk(rs2rosinternal::Time time);
     void writeChunkHeader(CompressionType compression, uint32_t compressed_size, uint32_t uncompressed_size);
     void stopWritingChunk();
+    void writeChunk(OutgoingChunk& chunk);
+    void resetChunkWriter(CompressionType compression, uint32_t threads);
 
     // Reading
 
@@ -216,6 +260,8 @@ private:
     void readChunkHeader(ChunkHeader& chunk_header) const;
     void readChunkInfoRecord();
     void readConnectionIndexRecord200();
+    bool readIndexCache(std::string const& path);
+    void writeIndexCache(std::string const& path) const;
 
     void readTopicIndexRecord102();
     void readMessageDefinitionRecord102();
@@ -227,6 +273,8 @@ private:
     template<typename Stream>
     void readMessageDataIntoStream(IndexEntry const& index_entry, Stream& stream) const;
 
+    bool     readMappedMessageData(IndexEntry const& index_entry, uint8_t const*& data, uint32_t& size) const;
+
     void     decompressChunk(uint64_t chunk_pos) const;
     void     decompressRawChunk(ChunkHeader const& chunk_header) const;
     void     decompressBz2Chunk(ChunkHeader const& chunk_header) const;
@@ -310,6 +358,15 @@ private:
     mutable Buffer*  current_buffer_;
 
     mutable uint64_t decompressed_chunk_;      //!< position of decompressed chunk
+
+    uint32_t                     write_threads_;
+    std::unique_ptr<ChunkWriter> chunk_writer_;  //!< when set, owns the file while writing, see setWriteThreads
+
+    uint32_t                         prefetch_depth_;
+    std::unique_ptr<ChunkPrefetcher> prefetcher_;  //!< set while reading a version 2.0 bag with read-ahead
+    bool                             index_cache_;
+    bool                             mapped_read_;
+    std::shared_ptr<MappedFile>      mapping_;     //!< set while reading a version 2.0 bag mapped into memory
 };
 
 } // namespace rosbag
@@ -517,8 +574,10 @@ void Bag::doWrite(std::string const& topic, rs2rosinternal::Time const& time, T
 
     {
         // Seek to the end of the file (needed in case previous operation was a read)
-        seek(0, std::ios::end);
-        file_size_ = file_.getOffset();
+        if (!chunk_writer_) {
+            seek(0, std::ios::end);
+            file_size_ = file_.getOffset();
+        }
 
         // Write the chunk header if we're starting a new chunk
         if (!chunk_open_)
@@ -543,7 +602,9 @@ void Bag::doWrite(std::string const& topic, rs2rosinternal::Time const& time, T
             }
             connections_[conn_id] = connection_info;
 
-            writeConnectionRecord(connection_info);
+            // The chunk writer writes the record along with the rest of the chunk
+            if (!chunk_writer_)
+                writeConnectionRecord(connection_info);
             appendConnectionRecordToBuffer(outgoing_chunk_buffer_, connection_info);
         }
 
@@ -555,8 +616,11 @@ void Bag::doWrite(std::string const& topic, rs2rosinternal::Time const& time, T
 
         std::multiset<IndexEntry>& chunk_connection_index = curr_chunk_connection_indexes_[connection_info->id];
         chunk_connection_index.insert(chunk_connection_index.end(), index_entry);
-        std::multiset<IndexEntry>& connection_index = connection_indexes_[connection_info->id];
-        connection_index.insert(connection_index.end(), index_entry);
+        // The chunk writer indexes the messages once the position of the chunk is known
+        if (!chunk_writer_) {
+            std::multiset<IndexEntry>& connection_index = connection_indexes_[connection_info->id];
+            connection_index.insert(connection_index.end(), index_entry);
+        }
 
         // Increment the connection count
         curr_chunk_info_.connection_counts[connection_info->id]++;
@@ -585,36 +649,33 @@ void Bag::writeMessageDataRecord(uint32_t conn_id, rs2rosinternal::Time const& t
     header[CONNECTION_FIELD_NAME] = toHeaderString(&conn_id);
     header[TIME_FIELD_NAME]       = toHeaderString(&time);
 
-    // Assemble message in memory first, because we need to write its length
+    // Serialize the message straight into the chunk, after its record header
     uint32_t msg_ser_len = rs2rosinternal::serialization::serializationLength(msg);
 
-    record_buffer_.setSize(msg_ser_len);
-
-    rs2rosinternal::serialization::OStream s(record_buffer_.getData(), msg_ser_len);
-
-    // todo: serialize into the outgoing_chunk_buffer & remove record_buffer_
-    rs2rosinternal::serialization::serialize(s, msg);
-
-    // We do an extra seek here since writing our data record may
-    // have indirectly moved our file-pointer if it was a
-    // MessageInstance for our own bag
-    seek(0, std::ios::end);
-    file_size_ = file_.getOffset();
-
-    CONSOLE_BRIDGE_logDebug("Writing MSG_DATA [%llu:%d]: conn=%d sec=%d nsec=%d data_len=%d",
-              (unsigned long long) file_.getOffset(), getChunkOffset(), conn_id, time.sec, time.nsec, msg_ser_len);
-
-    writeHeader(header);
-    writeDataLength(msg_ser_len);
-    write((char*) record_buffer_.getData(), msg_ser_len);
-
     // todo: use better abstraction than appendHeaderToBuffer
     appendHeaderToBuffer(outgoing_chunk_buffer_, header);
     appendDataLengthToBuffer(outgoing_chunk_buffer_, msg_ser_len);
 
     uint32_t offset = outgoing_chunk_buffer_.getSize();
     outgoing_chunk_buffer_.setSize(outgoing_chunk_buffer_.getSize() + msg_ser_len);
-    memcpy(outgoing_chunk_buffer_.getData() + offset, record_buffer_.getData(), msg_ser_len);
+
+    rs2rosinternal::serialization::OStream s(outgoing_chunk_buffer_.getData() + offset, msg_ser_len);
+    rs2rosinternal::serialization::serialize(s, msg);
+
+    if (!chunk_writer_) {
+        // We do an extra seek here since writing our data record may
+        // have indirectly moved our file-pointer if it was a
+        // MessageInstance for our own bag
+        seek(0, std::ios::end);
+        file_size_ = file_.getOffset();
+
+        CONSOLE_BRIDGE_logDebug("Writing MSG_DATA [%llu:%d]: conn=%d sec=%d nsec=%d data_len=%d",
+                  (unsigned long long) file_.getOffset(), getChunkOffset(), conn_id, time.sec, time.nsec, msg_ser_len);
+
+        writeHeader(header);
+        writeDataLength(msg_ser_len);
+        write((char*) outgoing_chunk_buffer_.getData() + offset, msg_ser_len);
+    }
 
     // Update the current chunk time range
     if (time > curr_chunk_info_.end_time)
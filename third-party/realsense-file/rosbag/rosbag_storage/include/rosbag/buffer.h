@@ -51,6 +51,11 @@ public:
     uint32_t getSize()     const;
 
     void setSize(uint32_t size);
+    void swap(Buffer& other);                   //!< exchange the contents, without copying the data
+
+    //! refer to data owned elsewhere instead of holding a copy of it, until the next setSize
+    void setExternal(uint8_t* data, uint32_t size);
+    bool isExternal() const;
 
 private:
     void ensureCapacity(uint32_t capacity);
@@ -59,6 +64,7 @@ private:
     uint8_t* buffer_;
     uint32_t capacity_;
     uint32_t size_;
+    bool     external_;
 };
 
 } // namespace rosbag
@@ -0,0 +1,68 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#ifndef ROSBAG_CHUNK_PREFETCHER_H
+#define ROSBAG_CHUNK_PREFETCHER_H
+
+#include "buffer.h"
+#include "chunked_file.h"
+#include "structures.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace rosbag {
+
+//! Reads and decompresses the chunks following the last chunk read from a bag on a background thread,
+//! through its own handle to the file, so the chunks are ready by the time their messages are read.
+//! At most depth decompressed chunks are held, the ones behind the current position are dropped
+class ChunkPrefetcher
+{
+public:
+    //! uncompressed - whether to read ahead the uncompressed chunks too
+    ChunkPrefetcher(std::string const& filename, std::vector<ChunkInfo> const& chunks, uint32_t depth, bool uncompressed);
+    ~ChunkPrefetcher();
+
+    //! Moves the records of the chunk at chunk_pos into buffer if it was prefetched, and prefetches the chunks following it.
+    //! Returns false on a miss, in which case the caller reads the chunk itself
+    bool take(uint64_t chunk_pos, Buffer& buffer);
+
+    uint64_t getHits()   const;                                 //!< Number of chunks taken from the prefetched ones
+    uint64_t getMisses() const;                                 //!< Number of chunks that were not prefetched in time, the chunks left to the bag excluded
+
+private:
+    void work();
+    bool nextWanted(uint64_t& chunk_pos) const;
+    bool readChunk(uint64_t chunk_pos, Buffer& chunk);          //!< false for chunks left to the bag, e.g. BZ2 ones
+
+    ChunkedFile           file_;
+    std::vector<uint64_t> positions_;                           //!< positions of the chunks, in file order
+    size_t                depth_;
+    bool                  uncompressed_;
+    bool                  stopping_;
+
+    std::mutex              mutex_;
+    std::condition_variable wanted_cv_;                         //!< signals a new read-ahead window, or stopping
+    std::deque<uint64_t>    wanted_;                            //!< positions of the chunks following the last chunk taken
+    std::map<uint64_t, std::unique_ptr<Buffer> > ready_;        //!< decompressed chunks of the window, by position
+    std::vector<std::unique_ptr<Buffer> >        free_;
+    std::set<uint64_t>                           skipped_;      //!< chunks left to the bag
+
+    std::atomic<uint64_t> hits_;
+    std::atomic<uint64_t> misses_;
+
+    Buffer      header_buffer_;                                 //!< used by the prefetching thread only
+    Buffer      compressed_buffer_;                             //!< used by the prefetching thread only
+    std::thread thread_;
+};
+
+} // namespace rosbag
+
+#endif
@@ -0,0 +1,81 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#ifndef ROSBAG_CHUNK_WRITER_H
+#define ROSBAG_CHUNK_WRITER_H
+
+#include "buffer.h"
+#include "stream.h"
+#include "structures.h"
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace rosbag {
+
+//! A closed chunk on its way to the file
+struct OutgoingChunk
+{
+    uint64_t  seq;                                              //!< order of the chunk in the file
+    ChunkInfo info;                                             //!< pos is assigned when the chunk is written
+    std::map<uint32_t, std::multiset<IndexEntry> > indexes;     //!< connection indexes of the chunk, chunk_pos is assigned when written
+    Buffer    data;                                             //!< uncompressed records of the chunk
+    Buffer    compressed;                                       //!< compressed records, unused for uncompressed chunks
+};
+
+//! Compresses the chunks of a bag on a pool of threads and writes them to the file in order,
+//! so compression runs in parallel with the recording and with itself.
+//! The chunks and their buffers are recycled, and at most two chunks per thread are in flight
+class ChunkWriter
+{
+public:
+    typedef std::function<void(OutgoingChunk&)> WriteFunction;
+
+    //! write is called for one chunk at a time, in the order the chunks were submitted
+    ChunkWriter(CompressionType compression, uint32_t threads, WriteFunction write);
+    ~ChunkWriter();
+
+    //! Returns an empty chunk, blocking while the maximal number of chunks is in flight.
+    //! Can throw the BagException of a chunk that failed to be written
+    std::unique_ptr<OutgoingChunk> acquire();
+    void submit(std::unique_ptr<OutgoingChunk> chunk);
+    //! Waits until all the submitted chunks are written.
+    //! Can throw the BagException of a chunk that failed to be written
+    void flush();
+
+private:
+    void work();
+    void compress(OutgoingChunk& chunk) const;
+    void writeCompressed();
+
+    CompressionType compression_;
+    WriteFunction   write_;
+    size_t          max_chunks_;
+    uint64_t        next_seq_;
+    uint64_t        next_write_seq_;
+    size_t          in_flight_;
+    bool            stopping_;
+    std::exception_ptr error_;
+
+    std::mutex              mutex_;
+    std::condition_variable pending_cv_;                        //!< signals chunks to compress, or stopping
+    std::condition_variable written_cv_;                        //!< signals written chunks
+    std::deque<std::unique_ptr<OutgoingChunk> >  pending_;      //!< submitted, not compressed yet
+    std::vector<std::unique_ptr<OutgoingChunk> > compressed_;   //!< compressed, waiting for the previous chunks, by seq % max_chunks_
+    std::vector<std::unique_ptr<OutgoingChunk> > free_;
+
+    std::mutex               write_mutex_;                      //!< held by the thread writing chunks to the file
+    std::vector<std::thread> threads_;
+};
+
+} // namespace rosbag
+
+#endif
@@ -0,0 +1,39 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#ifndef ROSBAG_MAPPED_FILE_H
+#define ROSBAG_MAPPED_FILE_H
+
+#include "macros.h"
+
+#include <stdint.h>
+#include <string>
+
+namespace rosbag {
+
+//! A read-only mapping of a whole file into memory.
+//! Shared by the bag and by whoever refers to messages in place, the mapping lives as long as any of them
+class ROSBAG_DECL MappedFile
+{
+public:
+    //! Can throw BagIOException
+    explicit MappedFile(std::string const& filename);
+    ~MappedFile();
+
+    uint8_t const* getData() const;
+    uint64_t       getSize() const;
+
+private:
+    MappedFile(MappedFile const&);
+    MappedFile& operator=(MappedFile const&);
+
+    uint8_t const* data_;
+    uint64_t       size_;
+#ifdef _WIN32
+    void*          mapping_;                                    //!< HANDLE of the file mapping object
+#endif
+};
+
+} // namespace rosbag
+
+#endif
@@ -46,6 +46,7 @@
 namespace rosbag {
 
 class Bag;
+class MappedFile;
 
 //! A class pointing into a bag file
 /*!
@@ -93,6 +94,13 @@ public:
     //! Size of serialized message
     uint32_t size() const;
 
+    //! Get the serialized message in place in the mapping of the bag, see Bag::setMappedRead
+    /*!
+     * returns false if the bag is not mapped or the message is in a compressed chunk.
+     * The data remains valid as long as the mapping is held, also after the bag is closed
+     */
+    bool getMappedData(uint8_t const*& data, uint32_t& size, std::shared_ptr<MappedFile const>& mapping) const;
+
 private:
     MessageInstance(ConnectionInfo const* connection_info, IndexEntry const& index, Bag const& bag);
 
@@ -128,6 +128,12 @@ public:
     iterator end();
     uint32_t size();
 
+    //! Get the latest message of the view, found from the indexes without iterating the view
+    /*!
+     * Returns end() for an empty view. Incrementing the returned iterator reaches end()
+     */
+    iterator last();
+
     //! Add a query to a view
     /*!
      * param bag        The bag file on which to run this query
@@ -26,6 +26,9 @@
 // POSSIBILITY OF SUCH DAMAGE.
 
 #include "rosbag/bag.h"
+#include "rosbag/chunk_prefetcher.h"
+#include "rosbag/chunk_writer.h"
+#include "rosbag/mapped_file.h"
 #include "rosbag/message_instance.h"
 #include "rosbag/query.h"
 #include "rosbag/view.h"
@@ -37,6 +40,8 @@
 #endif
 #include <signal.h>
 #include <assert.h>
+#include <cstdio>
+#include <fstream>
 #include <iomanip>
 #include <map>
 #include <tuple>
@@ -59,6 +64,11 @@ using rs2rosinternal::Time;
 
 namespace rosbag {
 
+// Connection indexes cache, see setIndexCache
+static const std::string INDEX_CACHE_EXTENSION  = ".idx";
+static const char        INDEX_CACHE_MAGIC[]    = "#RSBAG INDEX V1\n";
+static const uint32_t    INDEX_CACHE_MIN_CHUNKS = 128;   // ~100MB with the default chunk threshold
+
 Bag::Bag() :
     mode_(bagmode::Write),
     version_(0),
@@ -73,7 +83,11 @@ Bag::Bag() :
     chunk_open_(false),
     curr_chunk_data_pos_(0),
     current_buffer_(0),
-    decompressed_chunk_(0)
+    decompressed_chunk_(0),
+    write_threads_(0),
+    prefetch_depth_(0),
+    index_cache_(false),
+    mapped_read_(false)
 {
 }
 
@@ -89,7 +103,11 @@ Bag::Bag(string const& filename, uint32_t mode) :
     chunk_open_(false),
     curr_chunk_data_pos_(0),
     current_buffer_(0),
-    decompressed_chunk_(0)
+    decompressed_chunk_(0),
+    write_threads_(0),
+    prefetch_depth_(0),
+    index_cache_(false),
+    mapped_read_(false)
 {
     open(filename, mode);
 }
@@ -128,6 +146,9 @@ void Bag::openRead(string const& filename) {
     default:
         throw BagException((format("Unsupported bag file version: %1%.%2%") % getMajorVersion() % getMinorVersion()).str());
     }
+
+    // Also starts the read-ahead, which depends on the mapping
+    setMappedRead(mapped_read_);
 }
 
 void Bag::openWrite(string const& filename) {
@@ -165,7 +186,11 @@ void Bag::close() {
     if (mode_ & bagmode::Write || mode_ & bagmode::Append)
         closeWrite();
 
+    prefetcher_.reset();
+    mapping_.reset();
     file_.close();
+    decompressed_chunk_ = 0;
+    decompress_buffer_.setSize(0);
 
     topic_connection_ids_.clear();
     header_connection_ids_.clear();
@@ -249,7 +274,70 @@ void Bag::setCompression(CompressionType compression) {
             (format("Unknown compression type: %i")  % compression).str());
     }
 
-    compression_ = compression;
+    resetChunkWriter(compression, write_threads_);
+}
+
+uint32_t Bag::getWriteThreads() const { return write_threads_; }
+
+uint32_t Bag::getPrefetchDepth()  const { return prefetch_depth_; }
+uint64_t Bag::getPrefetchHits()   const { return prefetcher_ ? prefetcher_->getHits()   : 0; }
+uint64_t Bag::getPrefetchMisses() const { return prefetcher_ ? prefetcher_->getMisses() : 0; }
+
+void Bag::setPrefetchDepth(uint32_t chunks) {
+    prefetch_depth_ = chunks;
+    prefetcher_.reset();
+
+    // Version 1.2 bags have no chunks
+    // Uncompressed chunks are not worth reading ahead when they are mapped
+    if (file_.isOpen() && mode_ == bagmode::Read && version_ == 200 && prefetch_depth_ > 0)
+        prefetcher_.reset(new ChunkPrefetcher(file_.getFileName(), chunks_, prefetch_depth_, !mapping_));
+}
+
+bool Bag::getIndexCache() const { return index_cache_; }
+
+void Bag::setIndexCache(bool enable) { index_cache_ = enable; }
+
+bool Bag::getMappedRead() const { return mapped_read_; }
+
+void Bag::setMappedRead(bool enable) {
+    mapped_read_ = enable;
+
+    // The decompressed chunk may refer to the previous mapping
+    prefetcher_.reset();
+    mapping_.reset();
+    decompressed_chunk_ = 0;
+    decompress_buffer_.setSize(0);
+
+    if (file_.isOpen() && mode_ == bagmode::Read && version_ == 200 && mapped_read_) {
+        try {
+            mapping_ = std::make_shared<MappedFile>(file_.getFileName());
+        }
+        catch (BagIOException const& e) {
+            CONSOLE_BRIDGE_logWarn("%s, reading the file instead", e.what());
+        }
+    }
+
+    setPrefetchDepth(prefetch_depth_);
+}
+
+void Bag::setWriteThreads(uint32_t threads) {
+    if (file_.isOpen() && chunk_open_)
+        stopWritingChunk();
+
+    resetChunkWriter(compression_, threads);
+}
+
+void Bag::resetChunkWriter(CompressionType compression, uint32_t threads) {
+    // The chunks in flight are written with the previous settings
+    if (chunk_writer_) {
+        chunk_writer_->flush();
+        chunk_writer_.reset();
+    }
+
+    compression_   = compression;
+    write_threads_ = threads;
+    if (write_threads_ > 0 && compression_ != compression::BZ2)
+        chunk_writer_.reset(new ChunkWriter(compression_, write_threads_, [this](OutgoingChunk& chunk) { writeChunk(chunk); }));
 }
 
 // Version
@@ -297,6 +385,8 @@ void Bag::startWriting() {
 void Bag::stopWriting() {
     if (chunk_open_)
         stopWritingChunk();
+    if (chunk_writer_)
+        chunk_writer_->flush();
 
     seek(0, std::ios::end);
 
@@ -323,6 +413,10 @@ void Bag::startReadingVersion200() {
     for (uint32_t i = 0; i < chunk_count_; i++)
         readChunkInfoRecord();
 
+    string index_cache = file_.getFileName() + INDEX_CACHE_EXTENSION;
+    if (index_cache_ && readIndexCache(index_cache))
+        return;
+
     // Read the connection indexes for each chunk
     foreach(ChunkInfo const& chunk_info, chunks_) {
         curr_chunk_info_ = chunk_info;
@@ -341,6 +435,9 @@ void Bag::startReadingVersion200() {
 
     // At this point we don't have a curr_chunk_info anymore so we reset it
     curr_chunk_info_ = ChunkInfo();
+
+    if (index_cache_ && chunk_count_ >= INDEX_CACHE_MIN_CHUNKS)
+        writeIndexCache(index_cache);
 }
 
 void Bag::startReadingVersion102() {
@@ -442,7 +539,9 @@ void Bag::readFileHeaderRecord() {
 }
 
 uint32_t Bag::getChunkOffset() const {
-    if (compression_ == compression::Uncompressed)
+    if (chunk_writer_)
+        return outgoing_chunk_buffer_.getSize();
+    else if (compression_ == compression::Uncompressed)
         return static_cast<uint32_t>(file_.getOffset() - curr_chunk_data_pos_);
     else
         return file_.getCompressedBytesIn();
@@ -450,10 +549,18 @@ uint32_t Bag::getChunkOffset() const {
 
 void Bag::startWritingChunk(Time time) {
     // Initialize chunk info
-    curr_chunk_info_.pos        = file_.getOffset();
     curr_chunk_info_.start_time = time;
     curr_chunk_info_.end_time   = time;
 
+    // The chunk is assembled in outgoing_chunk_buffer_, and positioned in the file when written
+    if (chunk_writer_) {
+        curr_chunk_info_.pos = 0;
+        chunk_open_ = true;
+        return;
+    }
+
+    curr_chunk_info_.pos = file_.getOffset();
+
     // Write the chunk header, with a place-holder for the data sizes (we'll fill in when the chunk is finished)
     writeChunkHeader(compression_, 0, 0);
 
@@ -467,6 +574,21 @@ void Bag::startWritingChunk(Time time) {
 }
 
 void Bag::stopWritingChunk() {
+    if (chunk_writer_) {
+        // Hand the chunk over to the chunk writer, in exchange for the buffers of a written one
+        std::unique_ptr<OutgoingChunk> chunk = chunk_writer_->acquire();
+        std::swap(chunk->info, curr_chunk_info_);
+        chunk->indexes.swap(curr_chunk_connection_indexes_);
+        chunk->data.swap(outgoing_chunk_buffer_);
+        chunk_writer_->submit(std::move(chunk));
+
+        curr_chunk_connection_indexes_.clear();
+        curr_chunk_info_.connection_counts.clear();
+        outgoing_chunk_buffer_.setSize(0);
+        chunk_open_ = false;
+        return;
+    }
+
     // Add this chunk to the index
     chunks_.push_back(curr_chunk_info_);
 
@@ -483,7 +605,7 @@ void Bag::stopWritingChunk() {
 
     // Write out the indexes and clear them
     seek(end_of_chunk_pos);
-    writeIndexRecords();
+    writeIndexRecords(curr_chunk_connection_indexes_);
     curr_chunk_connection_indexes_.clear();
 
     // Clear the connection counts
@@ -493,6 +615,26 @@ void Bag::stopWritingChunk() {
     chunk_open_ = false;
 }
 
+// Runs on a thread of the chunk writer, which owns the file while writing
+void Bag::writeChunk(OutgoingChunk& chunk) {
+    Buffer& data = (compression_ == compression::Uncompressed) ? chunk.data : chunk.compressed;
+
+    chunk.info.pos = file_.getOffset();
+    writeChunkHeader(compression_, data.getSize(), chunk.data.getSize());
+    write((char*) data.getData(), data.getSize());
+
+    for (map<uint32_t, multiset<IndexEntry> >::iterator i = chunk.indexes.begin(); i != chunk.indexes.end(); i++) {
+        multiset<IndexEntry>& connection_index = connection_indexes_[i->first];
+        foreach(IndexEntry index_entry, i->second) {
+            index_entry.chunk_pos = chunk.info.pos;
+            connection_index.insert(connection_index.end(), index_entry);
+        }
+    }
+    writeIndexRecords(chunk.indexes);
+
+    chunks_.push_back(chunk.info);
+}
+
 void Bag::writeChunkHeader(CompressionType compression, uint32_t compressed_size, uint32_t uncompressed_size) {
     ChunkHeader chunk_header;
     switch (compression) {
@@ -534,8 +676,8 @@ void Bag::readChunkHeader(ChunkHeader& chunk_header) const {
 
 // Index records
 
-void Bag::writeIndexRecords() {
-    for (map<uint32_t, multiset<IndexEntry> >::const_iterator i = curr_chunk_connection_indexes_.begin(); i != curr_chunk_connection_indexes_.end(); i++) {
+void Bag::writeIndexRecords(map<uint32_t, multiset<IndexEntry> > const& indexes) {
+    for (map<uint32_t, multiset<IndexEntry> >::const_iterator i = indexes.begin(); i != indexes.end(); i++) {
         uint32_t                    connection_id = i->first;
         multiset<IndexEntry> const& index         = i->second;
 
@@ -625,6 +767,115 @@ void Bag::readTopicIndexRecord102() {
     }
 }
 
+// The cache holds the identification of the bag it was written for, followed by the connection indexes:
+// file size, index position, connection count, chunk count, the position of each chunk, the number of indexes,
+// and for each index its connection id, entry count and entries (sec, nsec, chunk position, offset)
+bool Bag::readIndexCache(string const& path) {
+    std::ifstream cache(path, std::ios::binary);
+    if (!cache)
+        return false;
+
+    char magic[sizeof(INDEX_CACHE_MAGIC) - 1];
+    uint64_t file_size, index_data_pos;
+    uint32_t connection_count, chunk_count;
+    cache.read(magic, sizeof(magic));
+    cache.read((char*) &file_size,        8);
+    cache.read((char*) &index_data_pos,   8);
+    cache.read((char*) &connection_count, 4);
+    cache.read((char*) &chunk_count,      4);
+
+    seek(0, std::ios::end);
+    if (!cache || memcmp(magic, INDEX_CACHE_MAGIC, sizeof(magic)) != 0 || file_size != file_.getOffset() ||
+        index_data_pos != index_data_pos_ || connection_count != connection_count_ || chunk_count != chunk_count_)
+        return false;
+
+    foreach(ChunkInfo const& chunk_info, chunks_) {
+        uint64_t chunk_pos;
+        cache.read((char*) &chunk_pos, 8);
+        if (!cache || chunk_pos != chunk_info.pos)
+            return false;
+    }
+
+    map<uint32_t, multiset<IndexEntry> > connection_indexes;
+    uint32_t index_count = 0;
+    cache.read((char*) &index_count, 4);
+    for (uint32_t i = 0; i < index_count && cache; i++) {
+        uint32_t connection_id, count = 0;
+        cache.read((char*) &connection_id, 4);
+        cache.read((char*) &count,         4);
+
+        multiset<IndexEntry>& connection_index = connection_indexes[connection_id];
+        for (uint32_t j = 0; j < count && cache; j++) {
+            IndexEntry index_entry;
+            uint32_t sec;
+            uint32_t nsec;
+            cache.read((char*) &sec,                   4);
+            cache.read((char*) &nsec,                  4);
+            cache.read((char*) &index_entry.chunk_pos, 8);
+            cache.read((char*) &index_entry.offset,    4);
+            index_entry.time = Time(sec, nsec);
+            connection_index.insert(connection_index.end(), index_entry);
+        }
+    }
+    if (!cache)
+        return false;
+
+    CONSOLE_BRIDGE_logDebug("Read connection indexes from %s", path.c_str());
+
+    connection_indexes_.swap(connection_indexes);
+    return true;
+}
+
+void Bag::writeIndexCache(string const& path) const {
+    // Written aside and renamed, so a partial cache is never read
+    string temp_path = path + ".tmp";
+    {
+        std::ofstream cache(temp_path, std::ios::binary | std::ios::trunc);
+        if (!cache) {
+            CONSOLE_BRIDGE_logDebug("Cannot write connection indexes to %s", temp_path.c_str());
+            return;
+        }
+
+        seek(0, std::ios::end);
+        uint64_t file_size = file_.getOffset();
+        cache.write(INDEX_CACHE_MAGIC, sizeof(INDEX_CACHE_MAGIC) - 1);
+        cache.write((char const*) &file_size,         8);
+        cache.write((char const*) &index_data_pos_,   8);
+        cache.write((char const*) &connection_count_, 4);
+        cache.write((char const*) &chunk_count_,      4);
+
+        foreach(ChunkInfo const& chunk_info, chunks_)
+            cache.write((char const*) &chunk_info.pos, 8);
+
+        uint32_t index_count = static_cast<uint32_t>(connection_indexes_.size());
+        cache.write((char const*) &index_count, 4);
+        for (map<uint32_t, multiset<IndexEntry> >::const_iterator i = connection_indexes_.begin(); i != connection_indexes_.end(); i++) {
+            uint32_t connection_id = i->first;
+            uint32_t count         = static_cast<uint32_t>(i->second.size());
+            cache.write((char const*) &connection_id, 4);
+            cache.write((char const*) &count,         4);
+
+            foreach(IndexEntry const& index_entry, i->second) {
+                cache.write((char const*) &index_entry.time.sec,   4);
+                cache.write((char const*) &index_entry.time.nsec,  4);
+                cache.write((char const*) &index_entry.chunk_pos,  8);
+                cache.write((char const*) &index_entry.offset,     4);
+            }
+        }
+
+        if (!cache) {
+            cache.close();
+            std::remove(temp_path.c_str());
+            CONSOLE_BRIDGE_logDebug("Cannot write connection indexes to %s", temp_path.c_str());
+            return;
+        }
+    }
+
+    std::remove(path.c_str());
+    if (std::rename(temp_path.c_str(), path.c_str()) != 0)
+        std::remove(temp_path.c_str());
+}
+
 void Bag::readConnectionIndexRecord200() {
     rs2rosinternal::Header header;
     uint32_t data_size;
@@ -796,6 +1047,11 @@ void Bag::decompressChunk(uint64_t chunk_pos) const {
     if (decompressed_chunk_ == chunk_pos)
         return;
 
+    if (prefetcher_ && prefetcher_->take(chunk_pos, decompress_buffer_)) {
+        decompressed_chunk_ = chunk_pos;
+        return;
+    }
+
     // Seek to the start of the chunk
     seek(chunk_pos);
 
@@ -845,6 +1101,13 @@ void Bag::decompressRawChunk(ChunkHeader const& chunk_header) const {
 
     CONSOLE_BRIDGE_logDebug("compressed_size: %d uncompressed_size: %d", chunk_header.compressed_size, chunk_header.uncompressed_size);
 
+    // The records are read in place from the mapping. The buffer is never written to while it refers to them
+    uint64_t data_pos = file_.getOffset();
+    if (mapping_ && data_pos + chunk_header.compressed_size <= mapping_->getSize()) {
+        decompress_buffer_.setExternal(const_cast<uint8_t*>(mapping_->getData() + data_pos), chunk_header.compressed_size);
+        return;
+    }
+
     decompress_buffer_.setSize(chunk_header.compressed_size);
     file_.read((char*) decompress_buffer_.getData(), chunk_header.compressed_size);
 
@@ -884,6 +1147,24 @@ void Bag::decompressLz4Chunk(ChunkHeader const& chunk_header) const {
     // todo check read was successful
 }
 
+bool Bag::readMappedMessageData(IndexEntry const& index_entry, uint8_t const*& data, uint32_t& size) const {
+    if (!mapping_)
+        return false;
+
+    decompressChunk(index_entry.chunk_pos);
+    if (current_buffer_ != &decompress_buffer_ || !decompress_buffer_.isExternal())
+        return false;
+
+    rs2rosinternal::Header header;
+    uint32_t data_size;
+    uint32_t bytes_read;
+    readMessageDataHeaderFromBuffer(*current_buffer_, index_entry.offset, header, data_size, bytes_read);
+
+    data = current_buffer_->getData() + index_entry.offset + bytes_read;
+    size = data_size;
+    return true;
+}
+
 rs2rosinternal::Header Bag::readMessageDataHeader(IndexEntry const& index_entry) {
     rs2rosinternal::Header header;
     uint32_t data_size;
@@ -34,6 +34,7 @@
 
 #include <stdlib.h>
 #include <assert.h>
+#include <utility>
 
 #include "rosbag/buffer.h"
 
@@ -41,21 +42,46 @@
 
 namespace rosbag {
 
-Buffer::Buffer() : buffer_(NULL), capacity_(0), size_(0) { }
+Buffer::Buffer() : buffer_(NULL), capacity_(0), size_(0), external_(false) { }
 
 Buffer::~Buffer() {
-    free(buffer_);
+    if (!external_)
+        free(buffer_);
 }
 
 uint8_t* Buffer::getData()           { return buffer_;   }
 uint32_t Buffer::getCapacity() const { return capacity_; }
 uint32_t Buffer::getSize()     const { return size_;     }
+bool     Buffer::isExternal()  const { return external_; }
 
 void Buffer::setSize(uint32_t size) {
+    if (external_) {
+        buffer_   = NULL;
+        capacity_ = 0;
+        external_ = false;
+    }
+
     size_ = size;
     ensureCapacity(size);
 }
 
+void Buffer::setExternal(uint8_t* data, uint32_t size) {
+    if (!external_)
+        free(buffer_);
+
+    buffer_   = data;
+    capacity_ = size;
+    size_     = size;
+    external_ = true;
+}
+
+void Buffer::swap(Buffer& other) {
+    std::swap(buffer_,   other.buffer_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(size_,     other.size_);
+    std::swap(external_, other.external_);
+}
+
 void Buffer::ensureCapacity(uint32_t capacity) {
     if (capacity <= capacity_)
         return;
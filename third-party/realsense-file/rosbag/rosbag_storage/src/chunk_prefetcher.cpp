@@ -0,0 +1,183 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "rosbag/chunk_prefetcher.h"
+#include "rosbag/constants.h"
+
+#include "ros/header.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace rosbag {
+
+ChunkPrefetcher::ChunkPrefetcher(std::string const& filename, std::vector<ChunkInfo> const& chunks, uint32_t depth, bool uncompressed) :
+    depth_(depth ? depth : 1),
+    uncompressed_(uncompressed),
+    stopping_(false),
+    hits_(0),
+    misses_(0)
+{
+    file_.openRead(filename);
+
+    for (auto&& chunk_info : chunks)
+        positions_.push_back(chunk_info.pos);
+    std::sort(positions_.begin(), positions_.end());
+
+    thread_ = std::thread([this]() { work(); });
+}
+
+ChunkPrefetcher::~ChunkPrefetcher() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wanted_cv_.notify_all();
+    thread_.join();
+    file_.close();
+}
+
+uint64_t ChunkPrefetcher::getHits()   const { return hits_;   }
+uint64_t ChunkPrefetcher::getMisses() const { return misses_; }
+
+bool ChunkPrefetcher::take(uint64_t chunk_pos, Buffer& buffer) {
+    bool hit = false;
+    bool skipped;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto ready = ready_.find(chunk_pos);
+        if (ready != ready_.end()) {
+            // The previous records of buffer are recycled for the next chunks
+            buffer.swap(*ready->second);
+            free_.push_back(std::move(ready->second));
+            ready_.erase(ready);
+            hit = true;
+        }
+        skipped = skipped_.find(chunk_pos) != skipped_.end();
+
+        // Move the read-ahead window past this chunk. After a seek the chunks of the old window are dropped
+        wanted_.clear();
+        for (auto next = std::upper_bound(positions_.begin(), positions_.end(), chunk_pos);
+             next != positions_.end() && wanted_.size() < depth_; ++next)
+            wanted_.push_back(*next);
+
+        for (auto i = ready_.begin(); i != ready_.end();) {
+            if (std::find(wanted_.begin(), wanted_.end(), i->first) == wanted_.end()) {
+                free_.push_back(std::move(i->second));
+                i = ready_.erase(i);
+            }
+            else
+                ++i;
+        }
+    }
+    wanted_cv_.notify_one();
+
+    if (hit)
+        hits_++;
+    else if (!skipped)
+        misses_++;
+    return hit;
+}
+
+bool ChunkPrefetcher::nextWanted(uint64_t& chunk_pos) const {
+    for (auto pos : wanted_) {
+        if (ready_.find(pos) == ready_.end()) {
+            chunk_pos = pos;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ChunkPrefetcher::work() {
+    while (true) {
+        uint64_t chunk_pos = 0;
+        std::unique_ptr<Buffer> chunk;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wanted_cv_.wait(lock, [&]() { return stopping_ || nextWanted(chunk_pos); });
+            if (stopping_)
+                return;
+
+            if (free_.empty())
+                chunk.reset(new Buffer());
+            else {
+                chunk = std::move(free_.back());
+                free_.pop_back();
+            }
+        }
+
+        // A chunk that fails to be read is left to the bag, which reports the error
+        bool read = false;
+        bool failed = false;
+        try {
+            read = readChunk(chunk_pos, *chunk);
+        }
+        catch (...) {
+            failed = true;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto wanted = std::find(wanted_.begin(), wanted_.end(), chunk_pos);
+            if (read && wanted != wanted_.end())
+                ready_[chunk_pos] = std::move(chunk);
+            else {
+                if (wanted != wanted_.end())
+                    wanted_.erase(wanted);
+                if (!read && !failed)
+                    skipped_.insert(chunk_pos);
+                free_.push_back(std::move(chunk));
+            }
+        }
+    }
+}
+
+bool ChunkPrefetcher::readChunk(uint64_t chunk_pos, Buffer& chunk) {
+    // Same layout as read by Bag::readChunkHeader
+    file_.seek(chunk_pos);
+
+    uint32_t header_len;
+    file_.read((char*) &header_len, 4);
+    header_buffer_.setSize(header_len);
+    file_.read((char*) header_buffer_.getData(), header_len);
+
+    rs2rosinternal::Header header;
+    std::string error_msg;
+    if (!header.parse(header_buffer_.getData(), header_len, error_msg))
+        return false;
+
+    uint32_t compressed_size;
+    file_.read((char*) &compressed_size, 4);
+
+    rs2rosinternal::M_string const& fields = *header.getValues();
+    auto op          = fields.find(OP_FIELD_NAME);
+    auto compression = fields.find(COMPRESSION_FIELD_NAME);
+    auto size        = fields.find(SIZE_FIELD_NAME);
+    if (op == fields.end() || op->second.size() != 1 || (uint8_t) op->second[0] != OP_CHUNK ||
+        compression == fields.end() || size == fields.end() || size->second.size() != 4)
+        return false;
+
+    uint32_t uncompressed_size;
+    memcpy(&uncompressed_size, size->second.data(), 4);
+
+    if (compression->second == COMPRESSION_NONE && uncompressed_) {
+        chunk.setSize(compressed_size);
+        file_.read((char*) chunk.getData(), compressed_size);
+        return true;
+    }
+
+    if (compression->second == COMPRESSION_LZ4) {
+        compressed_buffer_.setSize(compressed_size);
+        file_.read((char*) compressed_buffer_.getData(), compressed_size);
+
+        chunk.setSize(uncompressed_size);
+        file_.decompress(compression::LZ4, chunk.getData(), chunk.getSize(), compressed_buffer_.getData(), compressed_buffer_.getSize());
+        return true;
+    }
+
+    return false;
+}
+
+} // namespace rosbag
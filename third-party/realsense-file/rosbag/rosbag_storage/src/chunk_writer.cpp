@@ -0,0 +1,151 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "rosbag/chunk_writer.h"
+
+namespace rosbag {
+
+// Same block size as LZ4Stream, so the chunks are identical to the ones compressed while written
+static const int LZ4_BLOCK_SIZE_ID = 6;
+
+ChunkWriter::ChunkWriter(CompressionType compression, uint32_t threads, WriteFunction write) :
+    compression_(compression),
+    write_(write),
+    max_chunks_(2 * (threads ? threads : 1)),
+    next_seq_(0),
+    next_write_seq_(0),
+    in_flight_(0),
+    stopping_(false),
+    compressed_(max_chunks_)
+{
+    for (uint32_t i = 0; i < (threads ? threads : 1); i++)
+        threads_.push_back(std::thread([this]() { work(); }));
+}
+
+ChunkWriter::~ChunkWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    pending_cv_.notify_all();
+    for (auto&& t : threads_)
+        t.join();
+}
+
+std::unique_ptr<OutgoingChunk> ChunkWriter::acquire() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    written_cv_.wait(lock, [this]() { return in_flight_ < max_chunks_ || error_; });
+    if (error_)
+        std::rethrow_exception(error_);
+
+    in_flight_++;
+    if (free_.empty())
+        return std::unique_ptr<OutgoingChunk>(new OutgoingChunk());
+
+    std::unique_ptr<OutgoingChunk> chunk = std::move(free_.back());
+    free_.pop_back();
+    return chunk;
+}
+
+void ChunkWriter::submit(std::unique_ptr<OutgoingChunk> chunk) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        chunk->seq = next_seq_++;
+        pending_.push_back(std::move(chunk));
+    }
+    pending_cv_.notify_one();
+}
+
+void ChunkWriter::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    written_cv_.wait(lock, [this]() { return next_write_seq_ == next_seq_; });
+    if (error_)
+        std::rethrow_exception(error_);
+}
+
+void ChunkWriter::work() {
+    while (true) {
+        std::unique_ptr<OutgoingChunk> chunk;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            pending_cv_.wait(lock, [this]() { return stopping_ || !pending_.empty(); });
+            if (pending_.empty())
+                return;
+            chunk = std::move(pending_.front());
+            pending_.pop_front();
+        }
+
+        try {
+            compress(*chunk);
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!error_)
+                error_ = std::current_exception();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            compressed_[chunk->seq % max_chunks_] = std::move(chunk);
+        }
+        writeCompressed();
+    }
+}
+
+void ChunkWriter::compress(OutgoingChunk& chunk) const {
+    if (compression_ != compression::LZ4)
+        return;
+
+    // Room for the frame and block headers of the LZ4 stream, in case the data does not compress
+    unsigned int size = chunk.data.getSize();
+    unsigned int compressed_size = size + size / 64 + 1024;
+    chunk.compressed.setSize(compressed_size);
+
+    int ret = roslz4_buffToBuffCompress((char*) chunk.data.getData(), size,
+                                        (char*) chunk.compressed.getData(), &compressed_size, LZ4_BLOCK_SIZE_ID);
+    switch (ret) {
+    case ROSLZ4_OK: break;
+    case ROSLZ4_MEMORY_ERROR: throw BagIOException("ROSLZ4_MEMORY_ERROR: insufficient memory available"); break;
+    case ROSLZ4_OUTPUT_SMALL: throw BagIOException("ROSLZ4_OUTPUT_SMALL: output buffer is too small"); break;
+    case ROSLZ4_PARAM_ERROR: throw BagIOException("ROSLZ4_PARAM_ERROR: bad block size"); break;
+    default: throw BagIOException("ROSLZ4_ERROR: compression error");
+    }
+    chunk.compressed.setSize(compressed_size);
+}
+
+void ChunkWriter::writeCompressed() {
+    // Whichever thread compressed the next chunk in order writes it, along with the ones following it
+    std::lock_guard<std::mutex> write_lock(write_mutex_);
+    while (true) {
+        std::unique_ptr<OutgoingChunk> chunk;
+        bool failed;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            chunk = std::move(compressed_[next_write_seq_ % max_chunks_]);
+            failed = error_ != nullptr;
+        }
+        if (!chunk)
+            return;
+
+        // Once a chunk is lost the file is corrupt, so the chunks following it are dropped
+        if (!failed) {
+            try {
+                write_(*chunk);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                error_ = std::current_exception();
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            next_write_seq_++;
+            in_flight_--;
+            free_.push_back(std::move(chunk));
+        }
+        written_cv_.notify_all();
+    }
+}
+
+} // namespace rosbag
@@ -0,0 +1,87 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "rosbag/mapped_file.h"
+#include "rosbag/exceptions.h"
+
+#include <cstdint>
+
+#ifdef _WIN32
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace rosbag {
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(std::string const& filename) : data_(NULL), size_(0), mapping_(NULL) {
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        throw BagIOException("Error opening file for mapping: " + filename);
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0 || (uint64_t) size.QuadPart > (uint64_t) SIZE_MAX) {
+        CloseHandle(file);
+        throw BagIOException("Error mapping file: " + filename);
+    }
+
+    // The mapping object keeps the file open
+    mapping_ = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (!mapping_)
+        throw BagIOException("Error mapping file: " + filename);
+
+    data_ = (uint8_t const*) MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0);
+    if (!data_) {
+        CloseHandle(mapping_);
+        throw BagIOException("Error mapping file: " + filename);
+    }
+    size_ = size.QuadPart;
+}
+
+MappedFile::~MappedFile() {
+    UnmapViewOfFile(data_);
+    CloseHandle(mapping_);
+}
+
+#else
+
+MappedFile::MappedFile(std::string const& filename) : data_(NULL), size_(0) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw BagIOException("Error opening file for mapping: " + filename);
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0 || (uint64_t) st.st_size > (uint64_t) SIZE_MAX) {
+        close(fd);
+        throw BagIOException("Error mapping file: " + filename);
+    }
+
+    // The mapping keeps the file referenced
+    void* data = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        throw BagIOException("Error mapping file: " + filename);
+
+    data_ = (uint8_t const*) data;
+    size_ = st.st_size;
+}
+
+MappedFile::~MappedFile() {
+    munmap((void*) data_, size_);
+}
+
+#endif
+
+uint8_t const* MappedFile::getData() const { return data_; }
+uint64_t       MappedFile::getSize() const { return size_; }
+
+} // namespace rosbag
@@ -62,4 +62,12 @@ uint32_t MessageInstance::size() const {
     return bag_->readMessageDataSize(index_entry_);
 }
 
+bool MessageInstance::getMappedData(uint8_t const*& data, uint32_t& size, shared_ptr<MappedFile const>& mapping) const {
+    if (!bag_->readMappedMessageData(index_entry_, data, size))
+        return false;
+
+    mapping = bag_->mapping_;
+    return true;
+}
+
 } // namespace rosbag
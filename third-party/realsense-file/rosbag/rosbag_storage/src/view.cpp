@@ -226,6 +226,31 @@ View::iterator View::begin() {
 //! Default constructed iterator signifies end
 View::iterator View::end() { return iterator(this, true); }
 
+View::iterator View::last() {
+    update();
+
+    iterator i(this, true);
+    MessageRange const* last_range = NULL;
+    multiset<IndexEntry>::const_iterator last_entry;
+    foreach(MessageRange const* range, ranges_) {
+        if (range->begin == range->end)
+            continue;
+
+        multiset<IndexEntry>::const_iterator entry = range->end;
+        --entry;
+        if (last_range == NULL || *last_entry < *entry) {
+            last_range = range;
+            last_entry = entry;
+        }
+    }
+
+    if (last_range != NULL) {
+        i.iters_.push_back(ViewIterHelper(last_entry, last_range));
+        i.view_revision_ = view_revision_;
+    }
+    return i;
+}
+
 uint32_t View::size() { 
 
   update();
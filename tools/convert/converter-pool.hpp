@@ -0,0 +1,151 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#ifndef __RS_CONVERTER_CONVERTER_POOL_H
+#define __RS_CONVERTER_CONVERTER_POOL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "converter.hpp"
+
+
+namespace rs2 {
+    namespace tools {
+        namespace converter {
+
+            // Runs the conversions of the decoded frames on a fixed number of threads.
+            // Every frame is decoded once and handed to each converter as a separate job,
+            // and at most capacity jobs wait in the queue, which bounds the frames held in memory
+            class converter_pool {
+                struct job {
+                    std::shared_ptr<converter_base> converter;
+                    rs2::frame frame;
+                };
+
+                std::mutex _mutex;
+                std::condition_variable _queueCv;
+                std::condition_variable _doneCv;
+                std::deque<job> _queue;
+                size_t _capacity;
+                size_t _running = 0;
+                bool _stopping = false;
+                std::map<std::string, double> _busySeconds;
+                std::chrono::steady_clock::time_point _started;
+                std::vector<std::thread> _threads;
+
+                void work()
+                {
+                    while (true) {
+                        job current;
+                        {
+                            std::unique_lock<std::mutex> lock(_mutex);
+                            _queueCv.wait(lock, [this]() { return _stopping || !_queue.empty(); });
+                            if (_queue.empty()) {
+                                return;
+                            }
+
+                            current = std::move(_queue.front());
+                            _queue.pop_front();
+                            _running++;
+                        }
+                        // Room for the next job
+                        _queueCv.notify_all();
+
+                        auto started = std::chrono::steady_clock::now();
+                        try {
+                            current.converter->convert(current.frame);
+                        }
+                        catch (const std::exception& e) {
+                            std::cerr << current.converter->name() << ": " << e.what() << std::endl;
+                        }
+                        std::chrono::duration<double> busy = std::chrono::steady_clock::now() - started;
+
+                        // The frame is released before the job is reported done
+                        current.frame = rs2::frame();
+                        {
+                            std::lock_guard<std::mutex> lock(_mutex);
+                            _busySeconds[current.converter->name()] += busy.count();
+                            _running--;
+                        }
+                        _doneCv.notify_all();
+                    }
+                }
+
+            public:
+                converter_pool(size_t threads, size_t capacity)
+                    : _capacity(capacity ? capacity : 1)
+                    , _started(std::chrono::steady_clock::now())
+                {
+                    for (size_t i = 0; i < (threads ? threads : 1); i++) {
+                        _threads.emplace_back([this]() { work(); });
+                    }
+                }
+
+                ~converter_pool()
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        _stopping = true;
+                    }
+                    _queueCv.notify_all();
+
+                    for (auto& thread : _threads) {
+                        thread.join();
+                    }
+                }
+
+                size_t size() const
+                {
+                    return _threads.size();
+                }
+
+                // Queues the conversion of frame, blocking while the queue is full
+                void submit(std::shared_ptr<converter_base> converter, rs2::frame frame)
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(_mutex);
+                        _queueCv.wait(lock, [this]() { return _queue.size() < _capacity; });
+                        _queue.push_back({ std::move(converter), std::move(frame) });
+                    }
+                    _queueCv.notify_all();
+                }
+
+                // Waits until all the submitted frames are converted
+                void flush()
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _doneCv.wait(lock, [this]() { return _queue.empty() && !_running; });
+                }
+
+                std::string get_statistics()
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    std::chrono::duration<double> wall = std::chrono::steady_clock::now() - _started;
+
+                    std::stringstream result;
+                    result << _threads.size() << " conversion thread(s), "
+                        << wall.count() << " s" << '\n';
+
+                    for (auto& i : _busySeconds) {
+                        result << '\t' << i.first << ": " << i.second << " s busy" << '\n';
+                    }
+
+                    return (result.str());
+                }
+            };
+
+        }
+    }
+}
+
+
+#endif
@@ -4,9 +4,9 @@
 #ifndef __RS_CONVERTER_CONVERTER_H
 #define __RS_CONVERTER_CONVERTER_H
 
+#include <mutex>
 #include <unordered_map>
 #include <unordered_set>
-#include <thread>
 #include <string>
 #include <sstream>
 
@@ -43,13 +43,14 @@ namespace rs2 {
 
             class converter_base {
             protected:
-                std::thread _worker;
-                std::vector<std::thread> _subWorkers;
+                std::mutex _framesMapMutex;
                 std::unordered_map<int, std::unordered_set<frame_number_t>> _framesMap;
 
             protected:
                 bool frames_map_get_and_set(rs2_stream streamType, frame_number_t frameNumber)
                 {
+                    std::lock_guard<std::mutex> lock(_framesMapMutex);
+
                     if (_framesMap.find(streamType) == _framesMap.end()) {
                         _framesMap.emplace(streamType, std::unordered_set<frame_number_t>());
                     }
@@ -64,32 +65,17 @@ namespace rs2 {
                     return result;
                 }
 
-                template <typename F> void start_worker(const F& f)
-                {
-                    _worker = std::thread(f);
-                }
-
-                template <typename F> void add_sub_worker(const F& f)
-                {
-                    _subWorkers.emplace_back(f);
-                }
-
-                void wait_sub_workers()
-                {
-                    for_each(_subWorkers.begin(), _subWorkers.end(),
-                        [] (std::thread& t) {
-                            t.join();
-                        });
-
-                    _subWorkers.clear();
-                }
-
             public:
+                // Converts the frame on the calling thread.
+                // The conversion pool calls it for several frames at once, so apart from the
+                // converted frames map a converter keeps no state between frames
                 virtual void convert(rs2::frame& frame) = 0;
                 virtual std::string name() const = 0;
 
                 virtual std::string get_statistics()
                 {
+                    std::lock_guard<std::mutex> lock(_framesMapMutex);
+
                     std::stringstream result;
                     result << name() << '\n';
 
@@ -103,11 +89,6 @@ namespace rs2 {
 
                     return (result.str());
                 }
-
-                void wait()
-                {
-                    _worker.join();
-                }
             };
 
         }
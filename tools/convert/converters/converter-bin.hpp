@@ -83,48 +83,35 @@ namespace rs2 {
                         return;
                     }
 
-                    start_worker(
-                        [this, &frame] {
-                            rs2::depth_frame depthframe = frame.as<rs2::depth_frame>();
-
-                            std::stringstream filename;
-                            filename << _filePath
-                                << "_" << depthframe.get_profile().stream_name()
-                                << "_" << std::setprecision(14) << std::fixed << depthframe.get_timestamp()
-                                << ".bin";
-
-                            std::stringstream metadata_file;
-                            metadata_file << _filePath
-                                << "_" << depthframe.get_profile().stream_name()
-                                << "_metadata_" << std::setprecision(14) << std::fixed << depthframe.get_timestamp()
-                                << ".txt";
-
-                            std::string filenameS = filename.str();
-                            std::string metadataS = metadata_file.str();
-
-                            add_sub_worker(
-                                [filenameS, metadataS, depthframe] {
-                                    std::ofstream fs(filenameS, std::ios::binary | std::ios::trunc);
-
-                                    if (fs) {
-                                        uint8_t buffer[4];
-
-                                        for (int y = 0; y < depthframe.get_height(); y++) {
-                                            for (int x = 0; x < depthframe.get_width(); x++) {
-                                                fs.write(
-                                                    static_cast<const char *>(to_ieee754_32(depthframe.get_distance(x, y), buffer))
-                                                    , sizeof buffer);
-                                            }
-                                        }
-
-                                        fs.flush();
-                                    }
-
-                                    metadata_to_txtfile(depthframe, metadataS);
-                            });
-
-                            wait_sub_workers();
-                    });
+                    std::stringstream filename;
+                    filename << _filePath
+                        << "_" << depthframe.get_profile().stream_name()
+                        << "_" << std::setprecision(14) << std::fixed << depthframe.get_timestamp()
+                        << ".bin";
+
+                    std::stringstream metadata_file;
+                    metadata_file << _filePath
+                        << "_" << depthframe.get_profile().stream_name()
+                        << "_metadata_" << std::setprecision(14) << std::fixed << depthframe.get_timestamp()
+                        << ".txt";
+
+                    std::ofstream fs(filename.str(), std::ios::binary | std::ios::trunc);
+
+                    if (fs) {
+                        uint8_t buffer[4];
+
+                        for (int y = 0; y < depthframe.get_height(); y++) {
+                            for (int x = 0; x < depthframe.get_width(); x++) {
+                                fs.write(
+                                    static_cast<const char *>(to_ieee754_32(depthframe.get_distance(x, y), buffer))
+                                    , sizeof buffer);
+                            }
+                        }
+
+                        fs.flush();
+                    }
+
+                    metadata_to_txtfile(depthframe, metadata_file.str());
                 }
             };
 
@@ -43,49 +43,36 @@ namespace rs2 {
                         return;
                     }
 
-                    start_worker(
-                        [this, &frame] {
-                            auto depthframe = frame.as<rs2::depth_frame>();
+                    std::stringstream filename;
+                    filename << _filePath
+                        << "_" << depthframe.get_profile().stream_name()
+                        << "_" << std::setprecision(14) << std::fixed << depthframe.get_timestamp()
+                        << ".csv";
 
-                            std::stringstream filename;
-                            filename << _filePath
-                                << "_" << depthframe.get_profile().stream_name()
-                                << "_" << std::setprecision(14) << std::fixed << depthframe.get_timestamp()
-                                << ".csv";
+                    std::stringstream metadata_file;
+                    metadata_file << _filePath
+                        << "_" << depthframe.get_profile().stream_name()
+                        << "_metadata_" << std::setprecision(14) << std::fixed << depthframe.get_timestamp()
+                        << ".txt";
 
-                            std::stringstream metadata_file;
-                            metadata_file << _filePath
-                                << "_" << depthframe.get_profile().stream_name()
-                                << "_metadata_" << std::setprecision(14) << std::fixed << depthframe.get_timestamp()
-                                << ".txt";
+                    std::ofstream fs(filename.str(), std::ios::trunc);
 
-                            std::string filenameS = filename.str();
-                            std::string metadataS = metadata_file.str();
+                    if (fs) {
+                        for (int y = 0; y < depthframe.get_height(); y++) {
+                            auto delim = "";
 
-                            add_sub_worker(
-                                [filenameS, metadataS, depthframe] {
-                                    std::ofstream fs(filenameS, std::ios::trunc);
+                            for (int x = 0; x < depthframe.get_width(); x++) {
+                                fs << delim << depthframe.get_distance(x, y);
+                                delim = ",";
+                            }
 
-                                    if (fs) {
-                                        for (int y = 0; y < depthframe.get_height(); y++) {
-                                            auto delim = "";
+                            fs << '\n';
+                        }
 
-                                            for (int x = 0; x < depthframe.get_width(); x++) {
-                                                fs << delim << depthframe.get_distance(x, y);
-                                                delim = ",";
-                                            }
-
-                                            fs << '\n';
-                                        }
-
-                                        fs.flush();
-                                    }
-
-                                    metadata_to_txtfile(depthframe, metadataS);
-                            });
+                        fs.flush();
+                    }
 
-                            wait_sub_workers();
-                    });
+                    metadata_to_txtfile(depthframe, metadata_file.str());
                 }
             };
 
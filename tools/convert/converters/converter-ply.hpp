@@ -29,37 +29,38 @@ namespace rs2 {
 
                 void convert(rs2::frame& frame) override
                 {
-                    rs2::pointcloud pc;
-                    start_worker(
-                        [this, &frame, pc]() mutable {
-                            auto frameset = frame.as<rs2::frameset>();
-                            auto frameDepth = frameset.get_depth_frame();
-                            auto frameColor = frameset.get_color_frame();
+                    auto frameset = frame.as<rs2::frameset>();
+                    if (!frameset) {
+                        return;
+                    }
 
-                            if (frameDepth && frameColor) {
-                                if (frames_map_get_and_set(rs2_stream::RS2_STREAM_ANY, frameDepth.get_frame_number())) {
-                                    return;
-                                }
+                    auto frameDepth = frameset.get_depth_frame();
+                    auto frameColor = frameset.get_color_frame();
 
-                                pc.map_to(frameColor);
+                    if (frameDepth && frameColor) {
+                        if (frames_map_get_and_set(rs2_stream::RS2_STREAM_ANY, frameDepth.get_frame_number())) {
+                            return;
+                        }
 
-                                auto points = pc.calculate(frameDepth);
+                        rs2::pointcloud pc;
+                        pc.map_to(frameColor);
 
-                                std::stringstream filename;
-                                filename << _filePath
-                                    << "_" << std::setprecision(14) << std::fixed << frameDepth.get_timestamp()
-                                    << ".ply";
+                        auto points = pc.calculate(frameDepth);
 
-                                points.export_to_ply(filename.str(), frameColor);
+                        std::stringstream filename;
+                        filename << _filePath
+                            << "_" << std::setprecision(14) << std::fixed << frameDepth.get_timestamp()
+                            << ".ply";
 
-                                std::stringstream metadata_file;
-                                metadata_file << _filePath
-                                    << "_metadata_" << std::setprecision(14) << std::fixed << frameDepth.get_timestamp()
-                                    << ".txt";
+                        points.export_to_ply(filename.str(), frameColor);
 
-                                metadata_to_txtfile(frameDepth, metadata_file.str());
-                            }
-                    });
+                        std::stringstream metadata_file;
+                        metadata_file << _filePath
+                            << "_metadata_" << std::setprecision(14) << std::fixed << frameDepth.get_timestamp()
+                            << ".txt";
+
+                        metadata_to_txtfile(frameDepth, metadata_file.str());
+                    }
                 }
             };
 
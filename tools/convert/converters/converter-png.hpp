@@ -19,7 +19,6 @@ namespace rs2 {
             class converter_png : public converter_base {
                 rs2_stream _streamType;
                 std::string _filePath;
-                rs2::colorizer _colorizer;
 
             public:
                 converter_png(const std::string& filePath, rs2_stream streamType = rs2_stream::RS2_STREAM_ANY)
@@ -44,45 +43,34 @@ namespace rs2 {
                         return;
                     }
 
-                    start_worker(
-                        [this, &frame] {
-                            rs2::video_frame videoframe = frame.as<rs2::video_frame>();
-
-                            if (videoframe.get_profile().stream_type() == rs2_stream::RS2_STREAM_DEPTH) {
-                                videoframe = _colorizer.process(videoframe);
-                            }
-
-                            std::stringstream filename;
-                            filename << _filePath
-                                << "_" << videoframe.get_profile().stream_name()
-                                << "_" << std::setprecision(14) << std::fixed << videoframe.get_timestamp()
-                                << ".png";
-
-                            std::stringstream metadata_file;
-                            metadata_file << _filePath
-                                << "_" << videoframe.get_profile().stream_name()
-                                << "_metadata_" << std::setprecision(14) << std::fixed << videoframe.get_timestamp()
-                                << ".txt";
-
-                            std::string filenameS = filename.str();
-                            std::string metadataS = metadata_file.str();
-
-                            add_sub_worker(
-                                [filenameS, metadataS, videoframe] {
-                                    stbi_write_png(
-                                        filenameS.c_str()
-                                        , videoframe.get_width()
-                                        , videoframe.get_height()
-                                        , videoframe.get_bytes_per_pixel()
-                                        , videoframe.get_data()
-                                        , videoframe.get_stride_in_bytes()
-                                    );
-
-                                    metadata_to_txtfile(videoframe, metadataS);
-                            });
-
-                            wait_sub_workers();
-                    });
+                    if (videoframe.get_profile().stream_type() == rs2_stream::RS2_STREAM_DEPTH) {
+                        // A colorizer per frame, since the frames are converted concurrently
+                        rs2::colorizer colorizer;
+                        videoframe = colorizer.process(videoframe);
+                    }
+
+                    std::stringstream filename;
+                    filename << _filePath
+                        << "_" << videoframe.get_profile().stream_name()
+                        << "_" << std::setprecision(14) << std::fixed << videoframe.get_timestamp()
+                        << ".png";
+
+                    std::stringstream metadata_file;
+                    metadata_file << _filePath
+                        << "_" << videoframe.get_profile().stream_name()
+                        << "_metadata_" << std::setprecision(14) << std::fixed << videoframe.get_timestamp()
+                        << ".txt";
+
+                    stbi_write_png(
+                        filename.str().c_str()
+                        , videoframe.get_width()
+                        , videoframe.get_height()
+                        , videoframe.get_bytes_per_pixel()
+                        , videoframe.get_data()
+                        , videoframe.get_stride_in_bytes()
+                    );
+
+                    metadata_to_txtfile(videoframe, metadata_file.str());
                 }
             };
 
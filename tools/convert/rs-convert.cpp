@@ -12,8 +12,11 @@
 #include "converters/converter-raw.hpp"
 #include "converters/converter-ply.hpp"
 #include "converters/converter-bin.hpp"
+#include "converter-pool.hpp"
 
-#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 #define SECONDS_TO_NANOSECONDS 1000000000
  
@@ -27,7 +30,7 @@ int main(int argc, char** argv) try
 
     // Parse command line arguments
     CmdLine cmd("librealsense rs-convert tool", ' ');
-    ValueArg<string> inputFilename("i", "input", "ROS-bag filename", true, "", "ros-bag-file");
+    MultiArg<string> inputFilenames("i", "input", "ROS-bag filename, can be repeated to convert several files", true, "ros-bag-file");
     ValueArg<string> outputFilenamePng("p", "output-png", "output PNG file(s) path", false, "", "png-path");
     ValueArg<string> outputFilenameCsv("v", "output-csv", "output CSV (depth matrix) file(s) path", false, "", "csv-path");
     ValueArg<string> outputFilenameRaw("r", "output-raw", "output RAW file(s) path", false, "", "raw-path");
@@ -39,9 +42,10 @@ int main(int argc, char** argv) try
     ValueArg <string> frameNumberEnd("t", "last-framenumber", "ignore frames whose frame number is greater than this value", false, "", "last-framenumber");
     ValueArg <string> startTime("s", "start-time", "ignore frames whose timestamp is less than this value (the first frame is at time 0)", false, "", "start-time");
     ValueArg <string> endTime("e", "end-time", "ignore frames whose timestamp is greater than this value (the first frame is at time 0)", false, "", "end-time");
+    ValueArg <unsigned> threadCount("j", "threads", "number of conversion threads (default - number of cores)", false, 0, "threads");
 
 
-    cmd.add(inputFilename);
+    cmd.add(inputFilenames);
     cmd.add(frameNumberEnd);
     cmd.add(frameNumberStart);
     cmd.add(endTime);
@@ -53,47 +57,15 @@ int main(int argc, char** argv) try
     cmd.add(outputFilenameBin);
     cmd.add(switchDepth);
     cmd.add(switchColor);
+    cmd.add(threadCount);
     cmd.parse(argc, argv);
 
-    vector<shared_ptr<rs2::tools::converter::converter_base>> converters;
-    shared_ptr<rs2::tools::converter::converter_ply> plyconverter;
-
     rs2_stream streamType = switchDepth.isSet() ? rs2_stream::RS2_STREAM_DEPTH
         : switchColor.isSet() ? rs2_stream::RS2_STREAM_COLOR
         : rs2_stream::RS2_STREAM_ANY;
 
-    if (outputFilenameCsv.isSet())
-    {
-        converters.push_back(
-            make_shared<rs2::tools::converter::converter_csv>(
-                outputFilenameCsv.getValue()
-                , streamType));
-    }
-
-    if (outputFilenamePng.isSet())
-    {
-        converters.push_back(
-            make_shared<rs2::tools::converter::converter_png>(
-                outputFilenamePng.getValue()
-                , streamType));
-    }
-
-    if (outputFilenameRaw.isSet())
-    {
-        converters.push_back(
-            make_shared<rs2::tools::converter::converter_raw>(
-                outputFilenameRaw.getValue()
-                , streamType));
-    }
-
-    if (outputFilenameBin.isSet())
-    {
-        converters.push_back(
-            make_shared<rs2::tools::converter::converter_bin>(
-                outputFilenameBin.getValue()));
-    }
-
-    if (converters.empty() && !outputFilenamePly.isSet())
+    if (!outputFilenameCsv.isSet() && !outputFilenamePng.isSet() && !outputFilenameRaw.isSet()
+        && !outputFilenameBin.isSet() && !outputFilenamePly.isSet())
     {
         throw runtime_error("output not defined");
     }
@@ -120,87 +92,93 @@ int main(int argc, char** argv) try
         end_time = (uint64_t) (SECONDS_TO_NANOSECONDS * (std::strtod( endTime.getValue().c_str(), nullptr )));
     }
 
-    //in order to convert frames into ply we need synced depth and color frames, 
-    //therefore we use pipeline
-    if (outputFilenamePly.isSet()) {
-
-        // Since we are running in blocking "non-real-time" mode,
-        // we don't want to prevent process termination if some of the frames
-        // did not find a match and hence were not serviced
-        auto pipe = std::shared_ptr<rs2::pipeline>(
-            new rs2::pipeline(), [](rs2::pipeline*) {});
-
-        plyconverter = make_shared<rs2::tools::converter::converter_ply>(
-            outputFilenamePly.getValue());
-
-        rs2::config cfg;
-        cfg.enable_device_from_file(inputFilename.getValue());
-        pipe->start(cfg);
-
-        auto device = pipe->get_active_profile().get_device();
-        rs2::playback playback = device.as<rs2::playback>();
-        playback.set_real_time(false);
+    size_t threads = threadCount.getValue() ? threadCount.getValue() : thread::hardware_concurrency();
+    if (!threads)
+    {
+        threads = 1;
+    }
 
-        auto duration = playback.get_duration();
-        int progress = 0;
-        auto frameNumber = 0ULL;
+    // Every frame is decoded once and its conversions, one per converter, run on the pool.
+    // The queue of the pool holds two jobs per thread, so decoding waits for slow converters
+    rs2::tools::converter::converter_pool pool(threads, 2 * threads);
 
-        rs2::frameset frameset;
-        uint64_t posCurr = playback.get_position();
+    const vector<string>& inputs = inputFilenames.getValue();
+    unsigned long long framesDecoded = 0;
+    auto started = chrono::steady_clock::now();
 
-        // try_wait_for_frames will keep repeating the last frame at the end of the file,
-        // so we need to exit the look in some other way!
-        while (pipe->try_wait_for_frames(&frameset, 1000))
+    for (auto& input : inputs)
+    {
+        // With several input files, the outputs of each file are told apart by its name
+        string suffix;
+        if (inputs.size() > 1)
         {
-            int posP = static_cast<int>(posCurr * 100. / duration.count());
-            if (posP > progress)
-            {
-                progress = posP;
-                cout << posP << "%" << "\r" << flush;
-            }
+            auto name = input.substr(input.find_last_of("/\\") + 1);
+            suffix = "_" + name.substr(0, name.find_last_of('.'));
+            cout << input << endl;
+        }
 
-            frameNumber = frameset[0].get_frame_number();
-
-            bool process_frame = true;
-            if (frameNumberStart.isSet() && frameNumber < first_frame)
-                process_frame = false;
-            else if (frameNumberEnd.isSet() && frameNumber > last_frame)
-                process_frame = false;
-            else if (startTime.isSet() && posCurr < start_time)
-                process_frame = false;
-            else if (endTime.isSet() && posCurr > end_time)
-                process_frame = false;
-         
-            if( process_frame )
-            {
-                plyconverter->convert(frameset);
-                plyconverter->wait();
-            }
+        vector<shared_ptr<rs2::tools::converter::converter_base>> converters;
+        shared_ptr<rs2::tools::converter::converter_ply> plyconverter;
 
-            auto posNext = playback.get_position();
+        if (outputFilenameCsv.isSet())
+        {
+            converters.push_back(
+                make_shared<rs2::tools::converter::converter_csv>(
+                    outputFilenameCsv.getValue() + suffix
+                    , streamType));
+        }
 
+        if (outputFilenamePng.isSet())
+        {
+            converters.push_back(
+                make_shared<rs2::tools::converter::converter_png>(
+                    outputFilenamePng.getValue() + suffix
+                    , streamType));
+        }
 
-            if (posNext < posCurr)
-                break;
+        if (outputFilenameRaw.isSet())
+        {
+            converters.push_back(
+                make_shared<rs2::tools::converter::converter_raw>(
+                    outputFilenameRaw.getValue() + suffix
+                    , streamType));
+        }
 
-            posCurr = posNext;
+        if (outputFilenameBin.isSet())
+        {
+            converters.push_back(
+                make_shared<rs2::tools::converter::converter_bin>(
+                    outputFilenameBin.getValue() + suffix));
         }
-    }
 
-    // for every converter other than ply,
-    // we get the frames from playback sensors 
-    // and convert them one by one
-    if( ! converters.empty() )
-    {
         rs2::context ctx;
-        auto playback = ctx.load_device(inputFilename.getValue());
+        auto playback = ctx.load_device(input);
         playback.set_real_time(false);
         std::vector<rs2::sensor> sensors = playback.query_sensors();
-        std::mutex mutex;
+
+        //in order to convert frames into ply we need synced depth and color frames,
+        //therefore we match the frames decoded for the other converters with a syncer
+        rs2::asynchronous_syncer sync;
+        if (outputFilenamePly.isSet())
+        {
+            plyconverter = make_shared<rs2::tools::converter::converter_ply>(
+                outputFilenamePly.getValue() + suffix);
+
+            sync.start([&](rs2::frame frame)
+            {
+                if (auto frameset = frame.as<rs2::frameset>())
+                {
+                    // Like the single frames, the frameset outlives the callback while it waits in the pool
+                    frameset.keep();
+                    pool.submit(plyconverter, frameset);
+                }
+            });
+        }
 
         auto duration = playback.get_duration();
         int progress = 0;
-        uint64_t posCurr = playback.get_position();
+        atomic<uint64_t> posCurr(playback.get_position());
+        atomic<unsigned long long> fileFrames(0);
 
         for (auto sensor : sensors)
         {
@@ -212,8 +190,6 @@ int main(int argc, char** argv) try
             sensor.open(sensor.get_stream_profiles());
             sensor.start([&](rs2::frame frame)
             {
-                std::lock_guard<std::mutex> lock(mutex);
-
                 auto frameNumber = frame.get_frame_number();
 
                 if (frameNumberStart.isSet() && frameNumber < first_frame)
@@ -225,23 +201,22 @@ int main(int argc, char** argv) try
                 if (endTime.isSet() && posCurr > end_time)
                     return;
 
-                for_each(converters.begin(), converters.end(),
-                    [&frame](shared_ptr<rs2::tools::converter::converter_base>& converter) {
-                    converter->convert(frame);
-                });
+                // The frame outlives the callback while it waits in the pool
+                frame.keep();
+                fileFrames++;
 
-                for_each(converters.begin(), converters.end(),
-                    [](shared_ptr<rs2::tools::converter::converter_base>& converter) {
-                    converter->wait();
-                });
-            });
+                for (auto& converter : converters)
+                {
+                    pool.submit(converter, frame);
+                }
 
+                if (plyconverter)
+                {
+                    sync.invoke(frame);
+                }
+            });
         }
 
-        //we need to clear the output of ply progress ("100%") before writing
-        //the progress of the other converters in the same line
-        cout << "\r    \r";
-
         while (true)
         {
             int posP = static_cast<int>(posCurr * 100. / duration.count());
@@ -257,6 +232,7 @@ int main(int argc, char** argv) try
                 break;
 
             posCurr = posNext;
+            this_thread::sleep_for(chrono::milliseconds(1));
         }
 
         for (auto sensor : sensors)
@@ -268,20 +244,30 @@ int main(int argc, char** argv) try
             sensor.stop();
             sensor.close();
         }
-    }
 
-    cout << endl;
+        pool.flush();
+        framesDecoded += fileFrames;
+
+        cout << endl;
+
+        //print statistics for ply converter.
+        if (plyconverter)
+        {
+            cout << plyconverter->get_statistics() << endl;
+        }
 
-    //print statistics for ply converter. 
-    if (outputFilenamePly.isSet()) {
-        cout << plyconverter->get_statistics() << endl;
+        for_each(converters.begin(), converters.end(),
+            [](shared_ptr<rs2::tools::converter::converter_base>& converter) {
+            cout << converter->get_statistics() << endl;
+        });
     }
 
-    for_each(converters.begin(), converters.end(),
-        [](shared_ptr<rs2::tools::converter::converter_base>& converter) {
-        cout << converter->get_statistics() << endl;
-    });
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - started;
 
+    cout << framesDecoded << " frame(s) decoded from " << inputs.size() << " file(s) in "
+        << elapsed.count() << " s, "
+        << (elapsed.count() > 0 ? framesDecoded / elapsed.count() : 0) << " frame(s)/s" << endl;
+    cout << pool.get_statistics() << endl;
 
     return EXIT_SUCCESS;
 }
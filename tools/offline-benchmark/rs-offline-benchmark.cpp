@@ -0,0 +1,612 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <numeric>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <cstdlib>
+#include <cmath>
+#include <cctype>
+
+#include "tclap/CmdLine.h"
+#include "json.hpp"
+#include "../../src/concurrency.h"
+
+using namespace std;
+using namespace TCLAP;
+using json = nlohmann::json;
+
+// Counts the frame buffers allocated by one processing block, see rs2_set_frame_allocator
+struct allocation_counter
+{
+    atomic<long long> allocations{ 0 };
+    atomic<long long> bytes{ 0 };
+};
+
+void* counting_allocate(size_t size, size_t alignment, void* user)
+{
+    auto counter = static_cast<allocation_counter*>(user);
+    counter->allocations++;
+    counter->bytes += size;
+
+    // Keep the original pointer right before the aligned buffer
+    auto raw = static_cast<char*>(malloc(size + alignment + sizeof(void*)));
+    if (!raw)
+        return nullptr;
+    auto addr = reinterpret_cast<uintptr_t>(raw + sizeof(void*));
+    auto aligned = reinterpret_cast<char*>((addr + alignment - 1) & ~uintptr_t(alignment - 1));
+    reinterpret_cast<void**>(aligned)[-1] = raw;
+    return aligned;
+}
+
+void counting_deallocate(void* buffer, size_t size, void* user)
+{
+    free(reinterpret_cast<void**>(buffer)[-1]);
+}
+
+// A processing block of the benchmarked chain, with its measurements
+struct stage
+{
+    string name;
+    json options = json::object();
+    shared_ptr<rs2::filter> block;
+    allocation_counter counter;
+    vector<double> latencies; // milliseconds
+    vector<rs2::frame> inputs; // of the last repetition, replayed back to back to measure the throughput
+    unsigned long long output_bytes = 0;
+};
+
+shared_ptr<rs2::filter> create_block(const string& name)
+{
+    if (name == "colorizer") return make_shared<rs2::colorizer>();
+    if (name == "pointcloud") return make_shared<rs2::pointcloud>();
+    if (name == "decimation_filter") return make_shared<rs2::decimation_filter>();
+    if (name == "spatial_filter") return make_shared<rs2::spatial_filter>();
+    if (name == "temporal_filter") return make_shared<rs2::temporal_filter>();
+    if (name == "hole_filling_filter") return make_shared<rs2::hole_filling_filter>();
+    if (name == "threshold_filter") return make_shared<rs2::threshold_filter>();
+    if (name == "units_transform") return make_shared<rs2::units_transform>();
+    if (name == "depth_to_disparity") return make_shared<rs2::disparity_transform>(true);
+    if (name == "disparity_to_depth") return make_shared<rs2::disparity_transform>(false);
+    if (name == "yuy_decoder") return make_shared<rs2::yuy_decoder>();
+    if (name == "hdr_merge") return make_shared<rs2::hdr_merge>();
+    if (name == "sequence_id_filter") return make_shared<rs2::sequence_id_filter>();
+    throw runtime_error("Unknown processing block \"" + name + "\"");
+}
+
+// "Filter Magnitude" -> "filter_magnitude"
+string option_key(rs2_option option)
+{
+    string key = rs2_option_to_string(option);
+    for (auto& c : key)
+        c = (c == ' ') ? '_' : static_cast<char>(tolower(c));
+    return key;
+}
+
+void set_block_option(stage& s, const string& key, float value)
+{
+    for (auto option : s.block->get_supported_options())
+    {
+        if (option_key(option) == key)
+        {
+            s.block->set_option(option, value);
+            s.options[key] = value;
+            return;
+        }
+    }
+    throw runtime_error("Processing block \"" + s.name + "\" does not support option \"" + key + "\"");
+}
+
+vector<string> split(const string& str, char delimiter)
+{
+    vector<string> tokens;
+    stringstream ss(str);
+    string token;
+    while (getline(ss, token, delimiter))
+        if (!token.empty())
+            tokens.push_back(token);
+    return tokens;
+}
+
+// "decimation_filter:filter_magnitude=4,spatial_filter,colorizer:color_scheme=2"
+vector<unique_ptr<stage>> parse_chain(const string& spec)
+{
+    vector<unique_ptr<stage>> chain;
+    for (auto&& block_spec : split(spec, ','))
+    {
+        auto tokens = split(block_spec, ':');
+        unique_ptr<stage> s(new stage());
+        s->name = tokens[0];
+        s->block = create_block(s->name);
+        for (size_t i = 1; i < tokens.size(); i++)
+        {
+            auto eq = tokens[i].find('=');
+            if (eq == string::npos)
+                throw runtime_error("Option \"" + tokens[i] + "\" should be given as <name>=<value>");
+            set_block_option(*s, tokens[i].substr(0, eq), stof(tokens[i].substr(eq + 1)));
+        }
+        chain.push_back(move(s));
+    }
+    if (chain.empty())
+        throw runtime_error("No processing blocks to benchmark");
+    return chain;
+}
+
+// The recorded or generated frames replayed through the chain
+struct input_frames
+{
+    rs2::device device; // Keeps the source of the frames alive
+    vector<rs2::frame> frames;
+    string source;
+};
+
+input_frames load_bag(const string& file, rs2_stream stream, size_t max_frames)
+{
+    input_frames input;
+    input.source = file;
+
+    rs2::context ctx;
+    input.device = ctx.load_device(file);
+    auto playback = input.device.as<rs2::playback>();
+    playback.set_real_time(false);
+
+    mutex m;
+    vector<rs2::sensor> started;
+    for (auto&& sensor : input.device.query_sensors())
+    {
+        vector<rs2::stream_profile> profiles;
+        for (auto&& profile : sensor.get_stream_profiles())
+            if (profile.stream_type() == stream)
+                profiles.push_back(profile);
+        if (profiles.empty())
+            continue;
+
+        sensor.open(profiles);
+        sensor.start([&](rs2::frame f)
+        {
+            lock_guard<mutex> lock(m);
+            if (input.frames.size() < max_frames)
+            {
+                f.keep();
+                input.frames.push_back(f);
+            }
+        });
+        started.push_back(sensor);
+    }
+    if (started.empty())
+        throw runtime_error(file + " has no " + rs2_stream_to_string(stream) + " stream");
+
+    while (playback.current_status() != RS2_PLAYBACK_STATUS_STOPPED)
+    {
+        {
+            lock_guard<mutex> lock(m);
+            if (input.frames.size() >= max_frames)
+                break;
+        }
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+
+    for (auto&& sensor : started)
+    {
+        sensor.stop();
+        sensor.close();
+    }
+    return input;
+}
+
+// Synthetic Z16 frames of a tilted plane with noise and holes, produced by a software_device
+input_frames generate_depth(int width, int height, size_t count)
+{
+    input_frames input;
+    input.source = "synthetic";
+
+    rs2::software_device dev;
+    auto depth_sensor = dev.add_sensor("Depth");
+    rs2_intrinsics intrinsics = { width, height, width / 2.f, height / 2.f, float(width), float(width), RS2_DISTORTION_BROWN_CONRADY, { 0, 0, 0, 0, 0 } };
+    auto profile = depth_sensor.add_video_stream({ RS2_STREAM_DEPTH, 0, 0, width, height, 30, 2, RS2_FORMAT_Z16, intrinsics });
+    depth_sensor.add_read_only_option(RS2_OPTION_DEPTH_UNITS, 0.001f);
+
+    mutex m;
+    depth_sensor.open(profile);
+    depth_sensor.start([&](rs2::frame f)
+    {
+        lock_guard<mutex> lock(m);
+        f.keep();
+        input.frames.push_back(f);
+    });
+
+    srand(0);
+    for (size_t i = 0; i < count; i++)
+    {
+        // Software frames reference their pixels without copying them, even when kept,
+        // so every frame owns a buffer that its deleter frees
+        auto pixels = new uint16_t[width * height];
+        for (int y = 0; y < height; y++)
+        {
+            for (int x = 0; x < width; x++)
+            {
+                auto noise = rand() % 64;
+                pixels[y * width + x] = (noise == 0) ? 0 : uint16_t(1000 + x + 2 * y + noise + i);
+            }
+        }
+
+        depth_sensor.on_video_frame({ pixels, [](void* p) { delete[] static_cast<uint16_t*>(p); }, width * 2, 2,
+            double(i) * 33.3, RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, int(i + 1), profile });
+    }
+
+    depth_sensor.stop();
+    depth_sensor.close();
+    input.device = dev;
+    return input;
+}
+
+json latency_stats(vector<double> latencies)
+{
+    sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p)
+    {
+        auto rank = static_cast<size_t>(ceil(p * latencies.size()));
+        return latencies[rank ? rank - 1 : 0];
+    };
+    auto sum = accumulate(latencies.begin(), latencies.end(), 0.0);
+    return {
+        { "p50", percentile(0.5) },
+        { "p99", percentile(0.99) },
+        { "mean", sum / latencies.size() },
+        { "max", latencies.back() },
+    };
+}
+
+// Frames completed per second of wall time
+double throughput(size_t frames, chrono::duration<double> elapsed)
+{
+    return elapsed.count() > 0 ? frames / elapsed.count() : 0;
+}
+
+// Synthetic frames of <streams> infrared streams at 30 fps, each from its own sensor of a software_device,
+// handed to a syncer one frame at a time as the sensors would. The frames are tiny so that the cost
+// measured is the synchronization rather than copies
+json benchmark_syncer(int streams, size_t frames, size_t warmup, float max_wait)
+{
+    const int width = 16, height = 16;
+
+    // All the frames share these pixels without copying them, so they are declared first to outlive the frames
+    vector<uint8_t> pixels(width * height, 128);
+
+    rs2::software_device dev;
+    vector<rs2::software_sensor> sensors;
+    vector<rs2::stream_profile> profiles;
+    vector<vector<rs2::frame>> stream_frames(streams);
+    mutex m;
+    for (int k = 0; k < streams; k++)
+    {
+        auto sensor = dev.add_sensor("Sensor " + to_string(k));
+        rs2_intrinsics intrinsics = { width, height, width / 2.f, height / 2.f, float(width), float(width), RS2_DISTORTION_NONE, { 0, 0, 0, 0, 0 } };
+        auto profile = sensor.add_video_stream({ RS2_STREAM_INFRARED, k + 1, k + 1, width, height, 30, 1, RS2_FORMAT_Y8, intrinsics });
+        sensor.open(profile);
+        sensor.start([&, k](rs2::frame f)
+        {
+            lock_guard<mutex> lock(m);
+            f.keep();
+            stream_frames[k].push_back(f);
+        });
+        sensors.push_back(sensor);
+        profiles.push_back(profile);
+    }
+
+    for (size_t i = 0; i < warmup + frames; i++)
+        for (int k = 0; k < streams; k++)
+            sensors[k].on_video_frame({ pixels.data(), [](void*) {}, width, 1,
+                double(i) * 1000 / 30, RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, int(i + 1), profiles[k] });
+
+    for (auto&& sensor : sensors)
+    {
+        sensor.stop();
+        sensor.close();
+    }
+
+    auto count = warmup + frames;
+    for (auto&& f : stream_frames)
+        count = min(count, f.size());
+
+    rs2::asynchronous_syncer syncer;
+    if (max_wait > 0)
+        syncer.set_option(RS2_OPTION_SYNC_MAX_WAIT, max_wait);
+    rs2::frame_queue results(streams);
+    syncer.start(results);
+
+    vector<double> latencies;
+    size_t framesets = 0, incomplete = 0;
+    chrono::steady_clock::time_point measure_start;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (i == warmup)
+            measure_start = chrono::steady_clock::now();
+        for (int k = 0; k < streams; k++)
+        {
+            auto start = chrono::high_resolution_clock::now();
+            syncer.invoke(stream_frames[k][i]);
+            chrono::duration<double, milli> elapsed = chrono::high_resolution_clock::now() - start;
+
+            rs2::frame f;
+            while (results.poll_for_frame(&f))
+            {
+                if (i < warmup)
+                    continue;
+                framesets++;
+                if (rs2::frameset(f).size() < size_t(streams))
+                    incomplete++;
+            }
+            if (i >= warmup)
+                latencies.push_back(elapsed.count());
+        }
+    }
+    if (latencies.empty())
+        throw runtime_error("Nothing was measured, check the number of frames");
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - measure_start;
+
+    return {
+        { "streams", streams },
+        { "frames", latencies.size() },
+        { "framesets", framesets },
+        { "incomplete_framesets", incomplete },
+        { "latency_ms", latency_stats(latencies) },
+        { "throughput_fps", throughput(latencies.size(), elapsed) },
+    };
+}
+
+// Items per second passed from <producers> threads to a single consumer through a queue of 16 items,
+// the producers waiting for room as the blocking frames of playback do
+template<template<class> class Queue>
+double queue_throughput(int producers, int items)
+{
+    Queue<int> q(16);
+    auto start = chrono::steady_clock::now();
+
+    vector<thread> threads;
+    for (int p = 0; p < producers; p++)
+        threads.emplace_back([&q, items]()
+        {
+            for (int i = 0; i < items; i++)
+            {
+                int item = i;
+                q.blocking_enqueue(move(item));
+            }
+        });
+
+    int value = 0;
+    for (int received = 0; received < producers * items; received++)
+        q.dequeue(&value, 1000);
+    for (auto&& t : threads)
+        t.join();
+
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    return producers * items / elapsed.count();
+}
+
+// Compares the lock-free queue of the frame path with single_consumer_queue
+json benchmark_queues(int producers, int items)
+{
+    return {
+        { "producers", producers },
+        { "items", producers * items },
+        { "single_consumer_queue_items_per_s", queue_throughput<single_consumer_queue>(producers, items) },
+        { "lockfree_queue_items_per_s", queue_throughput<lockfree_queue>(producers, items) },
+    };
+}
+
+// Written to the standard output when no file is given
+void write_report(const json& report, const string& file)
+{
+    if (!file.empty())
+    {
+        ofstream out(file);
+        if (!out)
+            throw runtime_error("Failed to open " + file);
+        out << report.dump(4) << endl;
+    }
+    else
+    {
+        cout << report.dump(4) << endl;
+    }
+}
+
+int main(int argc, char** argv) try
+{
+    rs2::log_to_console(RS2_LOG_SEVERITY_ERROR);
+
+    CmdLine cmd("librealsense rs-offline-benchmark tool", ' ', RS2_API_VERSION_STR);
+    ValueArg<string> input_arg("i", "input", "ROS-bag file to replay (default - synthetic depth frames)", false, "", "ros-bag-file");
+    ValueArg<string> stream_arg("s", "stream", "stream of the bag to replay: depth, color, infrared, ...", false, "depth", "stream");
+    ValueArg<string> chain_arg("c", "chain", "processing blocks to run in order, with their options, e.g. decimation_filter:filter_magnitude=4,spatial_filter,colorizer",
+        false, "decimation_filter,spatial_filter,temporal_filter,colorizer", "chain");
+    ValueArg<int> frames_arg("n", "frames", "maximal number of input frames", false, 100, "frames");
+    ValueArg<int> iterations_arg("r", "repeat", "number of times the input frames are replayed", false, 3, "repeat");
+    ValueArg<int> warmup_arg("w", "warmup", "number of frames processed before measuring", false, 10, "warmup");
+    ValueArg<int> width_arg("x", "width", "width of the synthetic frames", false, 1280, "width");
+    ValueArg<int> height_arg("y", "height", "height of the synthetic frames", false, 720, "height");
+    ValueArg<string> output_arg("o", "output", "JSON output file (default - standard output)", false, "", "json-file");
+    SwitchArg allocations_arg("a", "count-allocations", "count the frame buffers allocated by every block (bypasses the internal frame pools)", false);
+    ValueArg<int> sync_arg("S", "sync", "benchmark the syncer instead of the chain, with 2 to <streams> synthetic streams", false, 0, "streams");
+    ValueArg<float> max_wait_arg("m", "max-wait", "maximal time in milliseconds the syncer waits for missing streams (0 - as long as they are expected)", false, 0.f, "ms");
+    ValueArg<int> queue_arg("Q", "queues", "benchmark the frame queues instead of the chain, with 1 to <producers> producer threads", false, 0, "producers");
+
+    cmd.add(input_arg);
+    cmd.add(stream_arg);
+    cmd.add(chain_arg);
+    cmd.add(frames_arg);
+    cmd.add(iterations_arg);
+    cmd.add(warmup_arg);
+    cmd.add(width_arg);
+    cmd.add(height_arg);
+    cmd.add(output_arg);
+    cmd.add(allocations_arg);
+    cmd.add(sync_arg);
+    cmd.add(max_wait_arg);
+    cmd.add(queue_arg);
+    cmd.parse(argc, argv);
+
+    if (queue_arg.isSet())
+    {
+        if (queue_arg.getValue() < 1)
+            throw runtime_error("The queues need at least 1 producer");
+
+        json report;
+        report["librealsense"] = RS2_API_VERSION_STR;
+        report["threads"] = thread::hardware_concurrency();
+        report["queues"] = json::array();
+        for (int producers = 1; producers <= queue_arg.getValue(); producers++)
+            report["queues"].push_back(benchmark_queues(producers, 100000));
+        write_report(report, output_arg.getValue());
+        return EXIT_SUCCESS;
+    }
+
+    if (sync_arg.isSet())
+    {
+        if (sync_arg.getValue() < 2)
+            throw runtime_error("The syncer needs at least 2 streams");
+
+        json report;
+        report["librealsense"] = RS2_API_VERSION_STR;
+        report["max_wait_ms"] = max_wait_arg.getValue();
+        report["syncer"] = json::array();
+        for (int streams = 2; streams <= sync_arg.getValue(); streams++)
+            report["syncer"].push_back(benchmark_syncer(streams, static_cast<size_t>(max(1, frames_arg.getValue())),
+                static_cast<size_t>(max(0, warmup_arg.getValue())), max_wait_arg.getValue()));
+        write_report(report, output_arg.getValue());
+        return EXIT_SUCCESS;
+    }
+
+    auto stream = RS2_STREAM_ANY;
+    for (int i = RS2_STREAM_ANY + 1; i < RS2_STREAM_COUNT; i++)
+    {
+        string name = rs2_stream_to_string(rs2_stream(i));
+        transform(name.begin(), name.end(), name.begin(), ::tolower);
+        if (name == stream_arg.getValue())
+            stream = rs2_stream(i);
+    }
+    if (stream == RS2_STREAM_ANY)
+        throw runtime_error("Unknown stream \"" + stream_arg.getValue() + "\"");
+
+    auto max_frames = static_cast<size_t>(max(1, frames_arg.getValue()));
+    auto input = input_arg.isSet()
+        ? load_bag(input_arg.getValue(), stream, max_frames)
+        : generate_depth(width_arg.getValue(), height_arg.getValue(), max_frames);
+    if (input.frames.empty())
+        throw runtime_error("No input frames");
+
+    auto chain = parse_chain(chain_arg.getValue());
+
+    // Warm up before installing the allocators, so that lazily built tables are not counted
+    for (int i = 0; i < warmup_arg.getValue(); i++)
+    {
+        auto f = input.frames[i % input.frames.size()];
+        for (auto&& s : chain)
+            f = s->block->process(f);
+    }
+
+    if (allocations_arg.getValue())
+        for (auto&& s : chain)
+            s->block->set_frame_allocator(counting_allocate, counting_deallocate, &s->counter);
+
+    vector<double> chain_latencies;
+    auto chain_start = chrono::steady_clock::now();
+    for (int iteration = 0; iteration < iterations_arg.getValue(); iteration++)
+    {
+        for (auto&& input_frame : input.frames)
+        {
+            auto f = input_frame;
+            double total = 0;
+            for (auto&& s : chain)
+            {
+                if (iteration + 1 == iterations_arg.getValue())
+                    s->inputs.push_back(f);
+
+                auto start = chrono::high_resolution_clock::now();
+                auto out = s->block->process(f);
+                chrono::duration<double, milli> elapsed = chrono::high_resolution_clock::now() - start;
+
+                s->latencies.push_back(elapsed.count());
+                total += elapsed.count();
+                // A block that passes its input through writes nothing
+                if (out && out.get() != f.get())
+                    s->output_bytes += out.get_data_size();
+                f = out;
+            }
+            chain_latencies.push_back(total);
+        }
+    }
+    if (chain_latencies.empty())
+        throw runtime_error("Nothing was measured, check the number of repetitions");
+    chrono::duration<double> chain_elapsed = chrono::steady_clock::now() - chain_start;
+
+    auto first = input.frames.front();
+    json report;
+    report["librealsense"] = RS2_API_VERSION_STR;
+    report["threads"] = thread::hardware_concurrency();
+    report["input"] = {
+        { "source", input.source },
+        { "stream", rs2_stream_to_string(first.get_profile().stream_type()) },
+        { "format", rs2_format_to_string(first.get_profile().format()) },
+        { "frames", input.frames.size() },
+    };
+    if (auto vf = first.as<rs2::video_frame>())
+    {
+        report["input"]["width"] = vf.get_width();
+        report["input"]["height"] = vf.get_height();
+    }
+    report["repeat"] = iterations_arg.getValue();
+
+    report["blocks"] = json::array();
+    for (auto&& s : chain)
+    {
+        json block = {
+            { "name", s->name },
+            { "options", s->options },
+            { "frames", s->latencies.size() },
+            { "latency_ms", latency_stats(s->latencies) },
+            { "output_bytes", s->output_bytes },
+        };
+        if (allocations_arg.getValue())
+        {
+            block["allocations"] = s->counter.allocations.load();
+            block["allocated_bytes"] = s->counter.bytes.load();
+        }
+
+        // Counted after the allocations, which the replay would add to
+        auto start = chrono::steady_clock::now();
+        for (auto&& f : s->inputs)
+            s->block->process(f);
+        block["throughput_fps"] = throughput(s->inputs.size(), chrono::steady_clock::now() - start);
+        s->inputs.clear();
+
+        report["blocks"].push_back(block);
+    }
+    report["chain"] = {
+        { "latency_ms", latency_stats(chain_latencies) },
+        { "throughput_fps", throughput(chain_latencies.size(), chain_elapsed) },
+    };
+
+    write_report(report, output_arg.getValue());
+
+    return EXIT_SUCCESS;
+}
+catch (const rs2::error & e)
+{
+    cerr << "RealSense error calling " << e.get_failed_function() << "(" << e.get_failed_args() << "):\n    " << e.what() << endl;
+    return EXIT_FAILURE;
+}
+catch (const exception& e)
+{
+    cerr << e.what() << endl;
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,111 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+//#cmake:add-file ../../../src/algo/depth-to-rgb-calibration/sobel.cpp
+
+#include "../algo-common.h"
+#include "../../../src/algo/depth-to-rgb-calibration/sobel.h"
+
+#include <random>
+#include <functional>
+
+using namespace librealsense::algo::depth_to_rgb_calibration;
+
+// Test group description:
+//       * This tests group verifies that the Sobel kernels of the optimizer are bit-exact with the per-pixel
+//         3x3 convolution they replaced, so that the calibration results do not change.
+//
+// The convolution below is the one the optimizer used before, with the same masks, and the images cover
+// the pixel types the optimizer convolves: 8-bit IR and luminance, 16-bit depth and double edges.
+
+
+namespace
+{
+    template< class T >
+    std::vector< double > reference_convolution( std::vector< T > const & image,
+                                                 size_t image_width,
+                                                 size_t image_height,
+                                                 std::vector< double > const & mask )
+    {
+        std::vector< double > res( image.size(), 0 );
+
+        for( size_t i = 0; i < image_height - 2; i++ )
+        {
+            for( size_t j = 0; j < image_width - 2; j++ )
+            {
+                std::vector< T > sub_image( 9, 0 );
+                auto ind = 0;
+                for( size_t l = 0; l < 3; l++ )
+                    for( size_t k = 0; k < 3; k++ )
+                        sub_image[ind++] = image[( i + l ) * image_width + j + k];
+
+                double dot = 0;
+                for( size_t k = 0; k < 9; k++ )
+                    dot += sub_image[k] * mask[k];
+
+                res[( i + 1 ) * image_width + j + 1] = dot / (double)8;
+            }
+        }
+        return res;
+    }
+
+    std::vector< double > const vertical_mask = { -1, 0, 1,
+                                                  -2, 0, 2,
+                                                  -1, 0, 1 };
+    std::vector< double > const horizontal_mask = { -1, -2, -1,
+                                                     0,  0,  0,
+                                                     1,  2,  1 };
+
+    template< class T >
+    void check_sobel( std::function< T() > const & pixel )
+    {
+        for( auto size : { std::make_pair( 3, 3 ), std::make_pair( 17, 5 ), std::make_pair( 64, 48 ), std::make_pair( 103, 77 ) } )
+        {
+            size_t width = size.first, height = size.second;
+
+            std::vector< T > image( width * height );
+            for( auto & p : image )
+                p = pixel();
+
+            auto expected_vertical = reference_convolution( image, width, height, vertical_mask );
+            auto expected_horizontal = reference_convolution( image, width, height, horizontal_mask );
+            std::vector< double > expected_edges( image.size() );
+            for( size_t i = 0; i < image.size(); i++ )
+                expected_edges[i] = sqrt( pow( expected_vertical[i], 2 ) + pow( expected_horizontal[i], 2 ) );
+
+            // The outputs are dirty and of the wrong size, as when reused from a previous frame
+            std::vector< double > vertical( 7, -1. ), horizontal( image.size(), -1. ), edges( image.size() * 2, -1. );
+            calc_gradients( image, width, height, vertical, horizontal );
+            calc_edges( image, width, height, edges );
+
+            REQUIRE( vertical == expected_vertical );
+            REQUIRE( horizontal == expected_horizontal );
+            REQUIRE( edges == expected_edges );
+
+            std::vector< double > intensity;
+            calc_intensity( vertical, horizontal, intensity );
+            REQUIRE( intensity == expected_edges );
+        }
+    }
+}
+
+
+TEST_CASE( "Sobel of 8-bit images", "[d2rgb]" )
+{
+    std::mt19937 gen( 1 );
+    check_sobel< uint8_t >( [&]() { return uint8_t( gen() ); } );
+}
+
+TEST_CASE( "Sobel of 16-bit images", "[d2rgb]" )
+{
+    std::mt19937 gen( 2 );
+    // Depth frames have many holes
+    check_sobel< uint16_t >( [&]() { return gen() % 4 ? uint16_t( gen() ) : uint16_t( 0 ); } );
+}
+
+TEST_CASE( "Sobel of double images", "[d2rgb]" )
+{
+    std::mt19937 gen( 3 );
+    std::uniform_real_distribution< double > dist( -1000., 1000. );
+    check_sobel< double >( [&]() { return gen() % 4 ? dist( gen ) : 0.; } );
+}
@@ -0,0 +1,171 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+//#cmake:add-file ../../src/concurrency.h
+
+#include <thread>
+#include <vector>
+#include <chrono>
+#include "../test.h"
+#include <concurrency.h>
+
+// Test group description:
+//       * This tests group verifies the lockfree_queue class against the semantics of single_consumer_queue.
+
+TEST_CASE( "enqueue drops the oldest item", "[lockfree_queue]" )
+{
+    lockfree_queue< int > q( 3 );
+    for( int i = 1; i <= 5; i++ )
+    {
+        int item = i;
+        q.enqueue( std::move( item ) );
+    }
+    REQUIRE( q.size() == 3 );
+
+    int value = 0;
+    for( int expected = 3; expected <= 5; expected++ )
+    {
+        REQUIRE( q.try_dequeue( &value ) );
+        CHECK( value == expected );
+    }
+    CHECK_FALSE( q.try_dequeue( &value ) );
+    CHECK_FALSE( q.dequeue( &value, 10 ) );
+}
+
+TEST_CASE( "blocking enqueue waits for the consumer", "[lockfree_queue]" )
+{
+    lockfree_queue< int > q( 1 );
+    int first = 1;
+    q.blocking_enqueue( std::move( first ) );
+
+    std::atomic< bool > enqueued( false );
+    std::thread producer( [&]() {
+        int second = 2;
+        q.blocking_enqueue( std::move( second ) );
+        enqueued = true;
+    } );
+
+    std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+    CHECK_FALSE( enqueued );
+
+    int value = 0;
+    REQUIRE( q.dequeue( &value, 1000 ) );
+    CHECK( value == 1 );
+    REQUIRE( q.dequeue( &value, 1000 ) );
+    CHECK( value == 2 );
+    producer.join();
+    CHECK( enqueued );
+}
+
+template< class Queue >
+static void check_try_enqueue()
+{
+    Queue q( 2 );
+    for( int i = 1; i <= 2; i++ )
+    {
+        int item = i;
+        REQUIRE( q.try_enqueue( std::move( item ) ) );
+    }
+
+    // A full queue keeps its items and leaves the rejected one to the caller
+    int item = 3;
+    CHECK_FALSE( q.try_enqueue( std::move( item ) ) );
+    CHECK( item == 3 );
+    CHECK( q.size() == 2 );
+
+    int value = 0;
+    REQUIRE( q.try_dequeue( &value ) );
+    CHECK( value == 1 );
+    REQUIRE( q.try_enqueue( std::move( item ) ) );
+    REQUIRE( q.try_dequeue( &value ) );
+    CHECK( value == 2 );
+    REQUIRE( q.try_dequeue( &value ) );
+    CHECK( value == 3 );
+}
+
+TEST_CASE( "try_enqueue neither drops nor waits", "[lockfree_queue]" )
+{
+    check_try_enqueue< lockfree_queue< int > >();
+    check_try_enqueue< single_consumer_queue< int > >();
+}
+
+template< class Queue >
+static void check_dropped()
+{
+    Queue q( 2 );
+    std::vector< int > dropped;
+    auto drop = [&]( int & item ) { dropped.push_back( item ); };
+    for( int i = 1; i <= 3; i++ )
+    {
+        int item = i;
+        q.enqueue( std::move( item ), drop );
+    }
+
+    // The oldest item makes room for the newest, and clear hands over the rest
+    REQUIRE( dropped.size() == 1 );
+    CHECK( dropped[0] == 1 );
+    q.clear( drop );
+    REQUIRE( dropped.size() == 3 );
+    CHECK( dropped[1] == 2 );
+    CHECK( dropped[2] == 3 );
+}
+
+TEST_CASE( "dropped items are handed to the caller", "[lockfree_queue]" )
+{
+    check_dropped< lockfree_queue< int > >();
+    check_dropped< single_consumer_queue< int > >();
+}
+
+TEST_CASE( "clear releases a waiting consumer", "[lockfree_queue]" )
+{
+    lockfree_queue< int > q( 2 );
+    std::thread consumer( [&]() {
+        int value = 0;
+        CHECK_FALSE( q.dequeue( &value, 5000 ) );
+    } );
+    std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+
+    auto start = std::chrono::steady_clock::now();
+    q.clear();
+    consumer.join();
+    CHECK( std::chrono::steady_clock::now() - start < std::chrono::seconds( 1 ) );
+
+    // A cleared queue does not accept items until it is started again
+    int item = 1;
+    q.enqueue( std::move( item ) );
+    CHECK( q.size() == 0 );
+    q.start();
+    item = 2;
+    q.enqueue( std::move( item ) );
+    CHECK( q.size() == 1 );
+}
+
+TEST_CASE( "multiple producers keep their order", "[lockfree_queue]" )
+{
+    const int producers = 4;
+    const int items = 10000;
+    lockfree_queue< int > q( 8 );
+
+    std::vector< std::thread > threads;
+    for( int p = 0; p < producers; p++ )
+        threads.emplace_back( [&q, p, items]() {
+            for( int i = 0; i < items; i++ )
+            {
+                int item = p * items + i;
+                q.blocking_enqueue( std::move( item ) );
+            }
+        } );
+
+    std::vector< int > last( producers, -1 );
+    int value = 0;
+    for( int received = 0; received < producers * items; received++ )
+    {
+        REQUIRE( q.dequeue( &value, 1000 ) );
+        auto p = value / items;
+        CHECK( value % items > last[p] );
+        last[p] = value % items;
+    }
+    for( auto& t : threads )
+        t.join();
+    CHECK( q.size() == 0 );
+}
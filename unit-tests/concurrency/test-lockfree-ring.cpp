@@ -0,0 +1,81 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+//#cmake:add-file ../../src/concurrency.h
+
+#include <thread>
+#include <vector>
+#include "../test.h"
+#include <concurrency.h>
+
+// Test group description:
+//       * This tests group verifies the lockfree_ring class.
+
+TEST_CASE( "push and pop in order", "[lockfree_ring]" )
+{
+    lockfree_ring< int > ring( 5 );
+    REQUIRE( ring.capacity() == 8 );
+
+    int value = 0;
+    CHECK_FALSE( ring.try_pop( &value ) );
+
+    for( int i = 0; i < 8; i++ )
+        CHECK( ring.try_push( int( i ) ) );
+    CHECK_FALSE( ring.try_push( 8 ) );  // full
+    CHECK( ring.size() == 8 );
+
+    for( int i = 0; i < 8; i++ )
+    {
+        REQUIRE( ring.try_pop( &value ) );
+        CHECK( value == i );
+    }
+    CHECK_FALSE( ring.try_pop( &value ) );
+    CHECK( ring.size() == 0 );
+}
+
+TEST_CASE( "multiple producers and consumers", "[lockfree_ring]" )
+{
+    const int producers = 4;
+    const int items = 10000;
+
+    lockfree_ring< int > ring( 64 );
+    std::vector< std::atomic< int > > seen( producers * items );
+    for( auto && s : seen )
+        s = 0;
+
+    std::atomic< int > consumed = { 0 };
+    std::vector< std::thread > threads;
+    for( int p = 0; p < producers; p++ )
+    {
+        threads.emplace_back( [&, p]() {
+            for( int i = 0; i < items; i++ )
+            {
+                int value = p * items + i;
+                while( ! ring.try_push( std::move( value ) ) )
+                    std::this_thread::yield();
+            }
+        } );
+    }
+    for( int c = 0; c < 2; c++ )
+    {
+        threads.emplace_back( [&]() {
+            int value;
+            while( consumed < producers * items )
+            {
+                if( ring.try_pop( &value ) )
+                {
+                    ++seen[value];
+                    ++consumed;
+                }
+                else
+                    std::this_thread::yield();
+            }
+        } );
+    }
+    for( auto && t : threads )
+        t.join();
+
+    // Every item was delivered exactly once
+    for( auto && s : seen )
+        REQUIRE( s == 1 );
+}
@@ -0,0 +1,92 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+//#cmake:add-file ../../src/flight-recorder.h
+//#cmake:add-file ../../src/flight-recorder.cpp
+
+#include <sstream>
+#include <thread>
+#include <vector>
+#include "../test.h"
+#include "../../src/flight-recorder.h"
+
+using namespace librealsense;
+
+// Test group description:
+//       * This tests group verifies the per-thread rings of the flight recorder, the formatting of
+//         its binary records and the LOG_RECORD statements that feed it.
+
+static std::vector< std::string > split_lines( const std::string & text )
+{
+    std::vector< std::string > lines;
+    std::istringstream in( text );
+    std::string line;
+    while( std::getline( in, line ) )
+        lines.push_back( line );
+    return lines;
+}
+
+static bool ends_with( const std::string & str, const std::string & suffix )
+{
+    return str.size() >= suffix.size() && str.compare( str.size() - suffix.size(), suffix.size(), suffix ) == 0;
+}
+
+TEST_CASE( "record messages are formatted from their arguments", "[flight-recorder]" )
+{
+    CHECK( format_log_message( "no arguments" ) == "no arguments" );
+    CHECK( format_log_message( "{},{},{},{}", -3, 7u, uint64_t( 1 ) << 40, "Depth" ) == "-3,7,1099511627776,Depth" );
+    CHECK( format_log_message( "TS,{}", 1.5 ) == "TS,1.500000" );
+    // Placeholders without arguments are kept
+    CHECK( format_log_message( "{} {}", 1 ) == "1 {}" );
+}
+
+TEST_CASE( "ring keeps the latest records", "[flight-recorder]" )
+{
+    log_ring ring( 1, 4 );
+    for( int i = 0; i < 6; ++i )
+    {
+        log_record r = { i, "{}", __FILE__, __LINE__, RS2_LOG_SEVERITY_DEBUG, 1, 1, { log_record_arg( i ) } };
+        ring.push( r );
+    }
+
+    std::vector< log_record > records;
+    ring.copy_to( records );
+    REQUIRE( records.size() == 4 );
+    for( size_t i = 0; i < records.size(); ++i )
+        CHECK( records[i].args[0].i == int64_t( i + 2 ) );
+
+    ring.clear();
+    records.clear();
+    ring.copy_to( records );
+    CHECK( records.empty() );
+}
+
+TEST_CASE( "statements are recorded from the enabled severity", "[flight-recorder]" )
+{
+    auto & recorder = flight_recorder::instance();
+    recorder.clear();
+    recorder.enable( RS2_LOG_SEVERITY_INFO );
+
+    std::thread worker( []() {
+        LOG_RECORD_INFO( "FrameAccepted,{},Counter,{}", "Depth", 12 );
+    } );
+    worker.join();
+    LOG_RECORD_DEBUG( "not recorded {}", 1 );
+    LOG_RECORD_WARNING( "CallbackFinished,{},{}", "Color", 13.25 );
+
+    recorder.enable( RS2_LOG_SEVERITY_NONE );
+    LOG_RECORD_ERROR( "not recorded {}", 2 );
+
+    auto lines = split_lines( recorder.dump() );
+    REQUIRE( lines.size() == 2 );
+    CHECK( lines[0].find( " INFO [" ) != std::string::npos );
+    CHECK( lines[0].find( "(test-flight-recorder.cpp:" ) != std::string::npos );
+    CHECK( ends_with( lines[0], ") FrameAccepted,Depth,Counter,12" ) );
+    CHECK( lines[1].find( " WARNING [" ) != std::string::npos );
+    CHECK( ends_with( lines[1], ") CallbackFinished,Color,13.250000" ) );
+
+    // The ring of the exited worker is released once dumped
+    CHECK( split_lines( recorder.dump() ).size() == 1 );
+    recorder.clear();
+    CHECK( recorder.dump().empty() );
+}
@@ -0,0 +1,87 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+//#cmake:add-file ../../src/latency-trace.h
+//#cmake:add-file ../../src/latency-trace.cpp
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include "../test.h"
+#include "../../src/latency-trace.h"
+#include "../../third-party/json.hpp"
+
+using namespace librealsense;
+
+// Test group description:
+//       * This tests group verifies the per-thread event rings of the latency tracer
+//         and their export to the Chrome trace event format.
+
+TEST_CASE( "ring keeps the latest events", "[latency-trace]" )
+{
+    trace_ring ring( 1, 4 );
+    for( int i = 0; i < 6; ++i )
+        ring.push( { "stage", uint64_t( i ), i * 10, 5, 'X' } );
+
+    std::vector< trace_event > events;
+    ring.copy_to( events );
+    REQUIRE( events.size() == 4 );
+    for( size_t i = 0; i < events.size(); ++i )
+        CHECK( events[i].span == i + 2 );
+
+    ring.clear();
+    events.clear();
+    ring.copy_to( events );
+    CHECK( events.empty() );
+}
+
+TEST_CASE( "trace is exported as Chrome trace JSON", "[latency-trace]" )
+{
+    auto & tracer = latency_tracer::instance();
+    tracer.clear();
+    tracer.enable( true );
+
+    auto span = tracer.new_span();
+    auto name = tracer.intern( std::string( "block \"1\"" ) );
+    CHECK( name == tracer.intern( "block \"1\"" ) );
+
+    std::thread worker( [&]() {
+        trace_scope stage( name, span );
+        tracer.begin_wait( "frame queue", span );
+    } );
+    worker.join();
+    {
+        trace_scope stage( "frame callback", span );
+    }
+    tracer.end_wait( "frame queue", span );
+    tracer.enable( false );
+    {
+        trace_scope stage( "frame callback", span );
+    }
+
+    auto trace = nlohmann::json::parse( tracer.to_json() );
+    auto & events = trace["traceEvents"];
+    REQUIRE( events.size() == 4 );
+
+    std::vector< std::string > phases;
+    for( auto & e : events )
+    {
+        CHECK( e["args"]["span"] == span );
+        CHECK( e["ts"].get< double >() >= 0 );
+        phases.push_back( e["ph"] );
+        if( e["ph"] == "X" )
+            CHECK( e["dur"].get< double >() >= 0 );
+        else
+            CHECK( e["id"] == span );
+    }
+    CHECK( std::count( phases.begin(), phases.end(), "X" ) == 2 );
+    CHECK( std::count( phases.begin(), phases.end(), "b" ) == 1 );
+    CHECK( std::count( phases.begin(), phases.end(), "e" ) == 1 );
+    CHECK( events[0]["name"] == "block \"1\"" );
+    CHECK( events[0]["tid"] != events[3]["tid"] );
+
+    // The ring of the exited worker is released once exported
+    CHECK( nlohmann::json::parse( tracer.to_json() )["traceEvents"].size() == 2 );
+    tracer.clear();
+    CHECK( nlohmann::json::parse( tracer.to_json() )["traceEvents"].empty() );
+}
@@ -0,0 +1,48 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+//#cmake:add-file ../../src/proc/sse/sse-colorizer.h
+//#cmake:add-file ../../src/proc/sse/sse-colorizer.cpp
+
+#include <vector>
+#include <random>
+#include "../test.h"
+#include "../../src/proc/sse/sse-colorizer.h"
+
+using namespace librealsense;
+
+// Test group description:
+//       * This tests group verifies the vectorized coloring of depth frames by a color table against the
+//         byte by byte lookup of the R, G and B bytes of every pixel, the bytes after the frame being left untouched.
+
+#ifdef __SSSE3__
+
+TEST_CASE( "SSE colorizer lookup", "[colorizer][sse]" )
+{
+    std::mt19937 gen( 4 );
+    std::vector< uint32_t > lut( 0x10000 );
+    for( auto & color : lut )
+        color = gen() & 0xffffff;
+
+    for( size_t pixels : { size_t( 1 ), size_t( 15 ), size_t( 16 ), size_t( 1027 ), size_t( 85 * 43 ) } )
+    {
+        std::vector< uint16_t > depth( pixels );
+        for( auto & d : depth )
+            d = uint16_t( gen() );
+
+        std::vector< uint8_t > expected( pixels * 3 + 16, 0xcd );
+        for( size_t i = 0; i < pixels; i++ )
+        {
+            expected[i * 3 + 0] = uint8_t( lut[depth[i]] );
+            expected[i * 3 + 1] = uint8_t( lut[depth[i]] >> 8 );
+            expected[i * 3 + 2] = uint8_t( lut[depth[i]] >> 16 );
+        }
+
+        std::vector< uint8_t > actual( pixels * 3 + 16, 0xcd );
+        colorize_lut_sse( depth.data(), actual.data(), pixels, lut.data() );
+
+        REQUIRE( expected == actual );
+    }
+}
+
+#endif // __SSSE3__
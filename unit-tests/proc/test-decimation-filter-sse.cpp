@@ -0,0 +1,73 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+//#cmake:add-file ../../src/proc/sse/sse-decimation-filter.h
+//#cmake:add-file ../../src/proc/sse/sse-decimation-filter.cpp
+//#cmake:add-file ../../src/proc/decimation-filter-passes.h
+//#cmake:add-file ../../src/proc/decimation-filter-passes.cpp
+
+#include <vector>
+#include <random>
+#include "../test.h"
+#include "../../src/proc/sse/sse-decimation-filter.h"
+#include "../../src/proc/decimation-filter-passes.h"
+
+using namespace librealsense;
+
+// Test group description:
+//       * This tests group verifies the vectorized median decimation and row sums of decimation_filter
+//         against the scalar passes used in builds without SSSE3.
+
+#ifdef __SSSE3__
+
+TEST_CASE( "SSE median decimation matches scalar", "[decimation-filter][sse]" )
+{
+    std::mt19937 gen( 5 );
+    const size_t widths[] = { 64, 85, 203 };
+
+    for( size_t scale = 2; scale <= 3; scale++ )
+    {
+        for( auto width : widths )
+        {
+            const size_t height = 43;
+            size_t real_width = width / scale, real_height = height / scale;
+            size_t padded_width = ( real_width + 3 ) / 4 * 4;
+
+            // Many holes and few distinct values, so that all the counts of valid pixels and the ties occur
+            std::vector< uint16_t > in( width * height );
+            for( auto & pixel : in )
+                pixel = ( gen() % 3 == 0 ) ? 0 : uint16_t( gen() % ( gen() % 2 ? 8 : 65535 ) );
+
+            std::vector< uint16_t > expected( real_height * padded_width, 0xffff );
+            decimate_depth_median( in.data(), expected.data(), width, real_width, real_height, padded_width, scale );
+            std::vector< uint16_t > actual( real_height * padded_width, 0xffff );
+            decimate_depth_median_sse( in.data(), actual.data(), width, real_width, real_height, padded_width, scale );
+
+            REQUIRE( expected == actual );
+        }
+    }
+}
+
+TEST_CASE( "SSE row sums", "[decimation-filter][sse]" )
+{
+    std::mt19937 gen( 9 );
+    const size_t stride = 203;
+    std::vector< uint8_t > in( stride * 8 );
+    for( auto & byte : in )
+        byte = uint8_t( gen() );
+
+    for( size_t rows = 1; rows <= 8; rows++ )
+    {
+        for( size_t length : { size_t( 16 ), size_t( 150 ), stride } )
+        {
+            std::vector< uint16_t > expected( length );
+            sum_rows( in.data(), stride, rows, length, expected.data() );
+            std::vector< uint16_t > sums( length );
+            sum_rows_sse( in.data(), stride, rows, length, sums.data() );
+
+            REQUIRE( sums == expected );
+        }
+    }
+}
+
+#endif // __SSSE3__
@@ -0,0 +1,184 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <cstring>
+#include "../test.h"
+#include "../../src/source.h"
+#include "../../src/stream.h"
+#include "../../src/proc/y8i-to-y8y8.h"
+
+using namespace librealsense;
+
+// Test group description:
+//       * This tests group verifies the frames whose data is produced on the first read, and the Y8I
+//         outputs that share a single deferred conversion.
+
+static librealsense::frame* as_frame( const frame_holder & f )
+{
+    return dynamic_cast< librealsense::frame * >( f.frame );
+}
+
+static frame_holder alloc_frame( frame_source & source, size_t size )
+{
+    frame_holder f = source.alloc_frame( RS2_EXTENSION_VIDEO_FRAME, size, frame_additional_data(), true );
+    REQUIRE( f );
+    return f;
+}
+
+TEST_CASE( "Frame released unread never runs its producer", "[deferred-data]" )
+{
+    frame_source source;
+    source.init( nullptr );
+
+    bool produced = false;
+    auto token = std::make_shared< int >( 0 );
+    {
+        auto f = alloc_frame( source, 16 );
+        as_frame( f )->defer_data( [&produced, token]() { produced = true; } );
+    }
+
+    CHECK_FALSE( produced );
+    // The producer and what it holds are released with the frame
+    CHECK( token.use_count() == 1 );
+}
+
+TEST_CASE( "Concurrent reads produce the data once", "[deferred-data]" )
+{
+    frame_source source;
+    source.init( nullptr );
+
+    const size_t size = 1024;
+    auto f = alloc_frame( source, size );
+    auto data = as_frame( f )->data.data();
+
+    std::atomic< int > productions( 0 );
+    as_frame( f )->defer_data( [&productions, data, size]() {
+        ++productions;
+        std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+        for( size_t i = 0; i < size; i++ )
+            data[i] = byte( i );
+    } );
+
+    std::atomic< bool > go( false );
+    std::atomic< int > complete( 0 );
+    std::vector< std::thread > readers;
+    for( int t = 0; t < 8; t++ )
+    {
+        readers.emplace_back( [&]() {
+            while( ! go )
+                std::this_thread::yield();
+            auto read = f->get_frame_data();
+            bool filled = true;
+            for( size_t i = 0; i < size; i++ )
+                filled = filled && read[i] == byte( i );
+            if( filled )
+                ++complete;
+        } );
+    }
+    go = true;
+    for( auto & reader : readers )
+        reader.join();
+
+    CHECK( productions == 1 );
+    // No reader sees the data before it is produced
+    CHECK( complete == 8 );
+}
+
+TEST_CASE( "keep() produces the data and releases the source frame", "[deferred-data]" )
+{
+    frame_source source;
+    source.init( nullptr );
+
+    const size_t size = 64;
+    auto input = alloc_frame( source, size );
+    for( size_t i = 0; i < size; i++ )
+        as_frame( input )->data[i] = byte( 3 * i );
+
+    auto f = alloc_frame( source, size );
+    auto data = as_frame( f )->data.data();
+    auto source_frame = std::make_shared< frame_holder >( std::move( input ) );
+    std::weak_ptr< frame_holder > source_ref = source_frame;
+    as_frame( f )->defer_data( [source_frame, data, size]() {
+        memcpy( data, ( *source_frame )->get_frame_data(), size );
+    } );
+    source_frame.reset();
+    REQUIRE_FALSE( source_ref.expired() );
+
+    f->keep();
+
+    CHECK( source_ref.expired() );
+    // The data was produced by keep() itself, without reading it
+    for( size_t i = 0; i < size; i++ )
+        REQUIRE( as_frame( f )->data[i] == byte( 3 * i ) );
+}
+
+// Invokes the converter on a Y8I frame whose left bytes are i and right bytes are ~i
+static std::vector< frame_holder > convert_y8i( frame_source & source, std::shared_ptr< y8i_to_y8y8 > block, int width, int height )
+{
+    auto profile = std::make_shared< video_stream_profile >( platform::stream_profile{} );
+    profile->set_format( RS2_FORMAT_Y8I );
+    profile->set_stream_type( RS2_STREAM_INFRARED );
+    profile->set_dims( width, height );
+
+    auto input = alloc_frame( source, width * height * 2 );
+    input->set_stream( profile );
+    for( int i = 0; i < width * height; i++ )
+    {
+        as_frame( input )->data[i * 2] = byte( i );
+        as_frame( input )->data[i * 2 + 1] = byte( ~i );
+    }
+
+    // The left output is the first one, with stream index 1
+    std::vector< frame_holder > outputs;
+    auto on_frame = [&outputs]( frame_interface * f ) { outputs.emplace_back( f ); };
+    block->set_output_callback( std::make_shared< internal_frame_callback< decltype( on_frame ) > >( on_frame ) );
+    block->invoke( std::move( input ) );
+
+    REQUIRE( outputs.size() == 2 );
+    REQUIRE( outputs[0]->get_stream()->get_stream_index() == 1 );
+    REQUIRE( outputs[1]->get_stream()->get_stream_index() == 2 );
+    return outputs;
+}
+
+static void check_plane( const byte * plane, int count, bool right )
+{
+    for( int i = 0; i < count; i++ )
+        REQUIRE( plane[i] == ( right ? byte( ~i ) : byte( i ) ) );
+}
+
+TEST_CASE( "Reading one Y8I output converts the other", "[deferred-data]" )
+{
+    frame_source source;
+    source.init( nullptr );
+    auto block = std::make_shared< y8i_to_y8y8 >();
+    block->enable_deferred_processing( block );
+
+    const int width = 85, height = 43;
+    auto outputs = convert_y8i( source, block, width, height );
+
+    check_plane( outputs[0]->get_frame_data(), width * height, false );
+    // The right plane was written by the same pass, before it is read
+    check_plane( as_frame( outputs[1] )->data.data(), width * height, true );
+    check_plane( outputs[1]->get_frame_data(), width * height, true );
+}
+
+TEST_CASE( "Y8I output released unread lets the other one convert", "[deferred-data]" )
+{
+    frame_source source;
+    source.init( nullptr );
+    auto block = std::make_shared< y8i_to_y8y8 >();
+    block->enable_deferred_processing( block );
+
+    const int width = 85, height = 43;
+    auto outputs = convert_y8i( source, block, width, height );
+
+    // The left plane is converted into a scratch buffer instead of the released frame
+    outputs[0] = frame_holder();
+    check_plane( outputs[1]->get_frame_data(), width * height, true );
+}
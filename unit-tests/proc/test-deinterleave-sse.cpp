@@ -0,0 +1,115 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+//#cmake:add-file ../../src/proc/sse/sse-deinterleave.h
+//#cmake:add-file ../../src/proc/sse/sse-deinterleave.cpp
+//#cmake:add-file ../../src/proc/sse/avx-deinterleave.h
+//#cmake:add-file ../../src/proc/sse/avx-deinterleave.cpp
+//#cmake:add-file ../../src/proc/sse/cpu-features.h
+//#cmake:add-file ../../src/proc/sse/cpu-features.cpp
+
+#include <vector>
+#include <random>
+#include "../test.h"
+#include "../../src/proc/sse/sse-deinterleave.h"
+#include "../../src/proc/sse/avx-deinterleave.h"
+#include "../../src/proc/sse/cpu-features.h"
+
+using namespace librealsense;
+
+// Test group description:
+//       * This tests group verifies the SSSE3 and AVX2 splitting of Y8I and Y12I infrared frames against the
+//         per-pixel split of y8i-to-y8y8.cpp and y12i-to-y16y16.cpp, whose pixel layouts are reproduced here.
+//
+// The source buffers are exactly the frame size, as the Y12I kernels must not read past it.
+// The AVX2 kernels are verified only on CPUs that support them.
+
+#ifdef __SSSE3__
+
+struct y8i_pixel { uint8_t l, r; };
+struct y12i_pixel { uint8_t rl : 8, rh : 4, ll : 4, lh : 8; int l() const { return lh << 4 | ll; } int r() const { return rh << 8 | rl; } };
+
+typedef void( *y8i_kernel )( uint8_t *, uint8_t *, const uint8_t *, size_t );
+typedef void( *y12i_kernel )( uint16_t *, uint16_t *, const uint8_t *, size_t );
+
+static const std::pair< size_t, size_t > resolutions[] = { { 1, 1 }, { 7, 3 }, { 33, 5 }, { 641, 11 }, { 1281, 9 } };
+
+static void check_y8i( y8i_kernel kernel )
+{
+    std::mt19937 gen( 6 );
+    for( auto res : resolutions )
+    {
+        const size_t count = res.first * res.second;
+        std::vector< uint8_t > source( count * sizeof( y8i_pixel ) );
+        for( auto & byte : source )
+            byte = uint8_t( gen() );
+
+        auto pixels = reinterpret_cast< const y8i_pixel * >( source.data() );
+        std::vector< uint8_t > expected_left( count + 32, 0xcd ), expected_right( count + 32, 0xcd );
+        for( size_t i = 0; i < count; i++ )
+        {
+            expected_left[i] = pixels[i].l;
+            expected_right[i] = pixels[i].r;
+        }
+
+        std::vector< uint8_t > left( count + 32, 0xcd ), right( count + 32, 0xcd );
+        kernel( left.data(), right.data(), source.data(), count );
+
+        REQUIRE( left == expected_left );
+        REQUIRE( right == expected_right );
+    }
+}
+
+static void check_y12i( y12i_kernel kernel )
+{
+    REQUIRE( sizeof( y12i_pixel ) == 3 );
+
+    std::mt19937 gen( 7 );
+    for( auto res : resolutions )
+    {
+        const size_t count = res.first * res.second;
+        std::vector< uint8_t > source( count * sizeof( y12i_pixel ) );
+        for( auto & byte : source )
+            byte = uint8_t( gen() );
+
+        auto pixels = reinterpret_cast< const y12i_pixel * >( source.data() );
+        std::vector< uint16_t > expected_left( count + 16, 0xcdcd ), expected_right( count + 16, 0xcdcd );
+        for( size_t i = 0; i < count; i++ )
+        {
+            expected_left[i] = uint16_t( pixels[i].l() << 6 | pixels[i].l() >> 4 );
+            expected_right[i] = uint16_t( pixels[i].r() << 6 | pixels[i].r() >> 4 );
+        }
+
+        std::vector< uint16_t > left( count + 16, 0xcdcd ), right( count + 16, 0xcdcd );
+        kernel( left.data(), right.data(), source.data(), count );
+
+        REQUIRE( left == expected_left );
+        REQUIRE( right == expected_right );
+    }
+}
+
+TEST_CASE( "SSE Y8I split", "[y8i][sse]" )
+{
+    check_y8i( unpack_y8_y8_from_y8i_sse );
+}
+
+TEST_CASE( "SSE Y12I split", "[y12i][sse]" )
+{
+    check_y12i( unpack_y16_y16_from_y12i_10_sse );
+}
+
+TEST_CASE( "AVX2 Y8I split", "[y8i][avx]" )
+{
+    if( ! has_avx2_support() )
+        return;
+    check_y8i( unpack_y8_y8_from_y8i_avx2 );
+}
+
+TEST_CASE( "AVX2 Y12I split", "[y12i][avx]" )
+{
+    if( ! has_avx2_support() )
+        return;
+    check_y12i( unpack_y16_y16_from_y12i_10_avx2 );
+}
+
+#endif // __SSSE3__
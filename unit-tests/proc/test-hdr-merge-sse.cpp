@@ -0,0 +1,100 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+//#cmake:add-file ../../src/proc/sse/sse-hdr-merge.h
+//#cmake:add-file ../../src/proc/sse/sse-hdr-merge.cpp
+
+#include <vector>
+#include <random>
+#include "../test.h"
+#include "../../src/proc/sse/sse-hdr-merge.h"
+
+using namespace librealsense;
+
+// Test group description:
+//       * This tests group verifies the vectorized HDR merge of 2 to 4 depth frames against the per-pixel merge
+//         of hdr_merge, which takes every pixel from the first frame where it is valid: a non-zero depth and,
+//         when infrared is used, an infrared value strictly between the under and over saturation values.
+//
+// The values are drawn around the saturation values and zero so that all the cases occur.
+
+#ifdef __SSSE3__
+
+template< class T >
+static std::vector< uint16_t > reference_merge( const std::vector< std::vector< uint16_t > > & depth,
+                                                const std::vector< std::vector< T > > * ir,
+                                                int low, int high )
+{
+    std::vector< uint16_t > out( depth[0].size(), 0 );
+    for( size_t i = 0; i < out.size(); i++ )
+    {
+        for( size_t k = 0; k < depth.size(); k++ )
+        {
+            bool valid_ir = ! ir || ( ( *ir )[k][i] > low && ( *ir )[k][i] < high );
+            if( valid_ir && depth[k][i] )
+            {
+                out[i] = depth[k][i];
+                break;
+            }
+        }
+    }
+    return out;
+}
+
+template< class T >
+static void check_merge( int low, int high, T max_ir )
+{
+    std::mt19937 gen( 8 );
+    for( size_t frames = 2; frames <= 4; frames++ )
+    {
+        for( size_t count : { size_t( 1 ), size_t( 13 ), size_t( 4096 + 9 ), size_t( 85 * 43 ) } )
+        {
+            std::vector< std::vector< uint16_t > > depth( frames, std::vector< uint16_t >( count ) );
+            std::vector< std::vector< T > > ir( frames, std::vector< T >( count ) );
+            std::vector< const uint16_t * > depth_planes;
+            std::vector< const T * > ir_planes;
+            for( size_t k = 0; k < frames; k++ )
+            {
+                for( auto & d : depth[k] )
+                    d = gen() % 3 ? uint16_t( gen() ) : 0;
+                for( auto & v : ir[k] )
+                {
+                    switch( gen() % 4 )
+                    {
+                    case 0: v = T( low + int( gen() % 3 ) - 1 ); break;
+                    case 1: v = T( high + int( gen() % 3 ) - 1 ); break;
+                    case 2: v = T( gen() % ( int( max_ir ) + 1 ) ); break;
+                    default: v = T( low + 1 + gen() % ( high - low - 1 ) ); break;
+                    }
+                }
+                depth_planes.push_back( depth[k].data() );
+                ir_planes.push_back( ir[k].data() );
+            }
+
+            std::vector< uint16_t > actual( count + 8, 0xcdcd );
+            merge_depth_sse( actual.data(), depth_planes.data(), frames, count );
+            auto expected = reference_merge< T >( depth, nullptr, low, high );
+            expected.resize( count + 8, 0xcdcd );
+            REQUIRE( actual == expected );
+
+            std::fill( actual.begin(), actual.end(), 0xcdcd );
+            merge_depth_with_ir_sse( actual.data(), depth_planes.data(), ir_planes.data(), frames, count, low, high );
+            expected = reference_merge< T >( depth, &ir, low, high );
+            expected.resize( count + 8, 0xcdcd );
+            REQUIRE( actual == expected );
+        }
+    }
+}
+
+TEST_CASE( "SSE HDR merge with Y8 infrared", "[hdr-merge][sse]" )
+{
+    check_merge< uint8_t >( 0x05, 0xfa, 0xff );
+}
+
+TEST_CASE( "SSE HDR merge with Y16 infrared", "[hdr-merge][sse]" )
+{
+    // Infrared values above 0x7fff must be invalid too
+    check_merge< uint16_t >( 0x14, 0x3eb, 0xffff );
+}
+
+#endif // __SSSE3__
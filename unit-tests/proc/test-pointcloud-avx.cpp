@@ -0,0 +1,169 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+//#cmake:add-file ../../src/proc/sse/avx-pointcloud.h
+//#cmake:add-file ../../src/proc/sse/avx-pointcloud.cpp
+//#cmake:add-file ../../src/proc/sse/cpu-features.h
+//#cmake:add-file ../../src/proc/sse/cpu-features.cpp
+
+#include <vector>
+#include <random>
+#include <cstring>
+#include "../test.h"
+#include "../approx.h"
+#include "../../src/proc/sse/avx-pointcloud.h"
+#include "../../src/proc/sse/cpu-features.h"
+#include <librealsense2/rsutil.h>
+
+using namespace librealsense;
+
+// Test group description:
+//       * This tests group verifies the AVX2 / AVX-512 pointcloud kernels against the scalar
+//         rsutil.h functions used by the generic pointcloud.
+//
+// Deprojection is expected to be bit-exact.
+// Projection is expected to be bit-exact as well, but is compared with the default approx() tolerance,
+// since compilers may contract the scalar reference into FMA instructions.
+
+typedef void( *deproject_kernel )( float *, const uint16_t *, const float *, const float *, size_t, float );
+typedef void( *texture_kernel )( float *, float *, const float *, size_t, const rs2_intrinsics &, const rs2_extrinsics & );
+
+static rs2_intrinsics make_intrinsics( int width, int height, rs2_distortion model, const float coeffs[5] )
+{
+    rs2_intrinsics intrin = { width, height, width / 2.f + 1.3f, height / 2.f - 2.1f, width * 0.7f, width * 0.71f, model };
+    for( int i = 0; i < 5; i++ )
+        intrin.coeffs[i] = coeffs[i];
+    return intrin;
+}
+
+static std::vector< uint16_t > make_depth( size_t count )
+{
+    std::mt19937 gen( 17 );
+    std::uniform_int_distribution< int > dist( 0, 65535 );
+    std::vector< uint16_t > depth( count );
+    for( auto & d : depth )
+        d = ( dist( gen ) % 5 == 0 ) ? 0 : uint16_t( dist( gen ) );
+    return depth;
+}
+
+static void check_deprojection( deproject_kernel kernel, rs2_distortion model, const float coeffs[5] )
+{
+    const int width = 101, height = 37;
+    const float depth_scale = 0.001f;
+    auto intrin = make_intrinsics( width, height, model, coeffs );
+    auto depth = make_depth( width * height );
+
+    std::vector< float > map_x( width * height ), map_y( width * height );
+    std::vector< float > expected( width * height * 3 ), actual( width * height * 3 );
+    for( int y = 0; y < height; ++y )
+    {
+        for( int x = 0; x < width; ++x )
+        {
+            const float pixel[] = { (float)x, (float)y };
+            auto i = y * width + x;
+            float unit[3];
+            rs2_deproject_pixel_to_point( unit, &intrin, pixel, 1.f );
+            map_x[i] = unit[0];
+            map_y[i] = unit[1];
+            rs2_deproject_pixel_to_point( &expected[i * 3], &intrin, pixel, depth_scale * depth[i] );
+        }
+    }
+
+    kernel( actual.data(), depth.data(), map_x.data(), map_y.data(), depth.size(), depth_scale );
+    CHECK( std::memcmp( expected.data(), actual.data(), expected.size() * sizeof( float ) ) == 0 );
+}
+
+static void check_texture_map( texture_kernel kernel, rs2_distortion model, const float coeffs[5] )
+{
+    const int width = 83, height = 29;
+    const float no_distortion[5] = { 0 };
+    auto depth_intrin = make_intrinsics( width, height, RS2_DISTORTION_BROWN_CONRADY, no_distortion );
+    auto other_intrin = make_intrinsics( 1280, 720, model, coeffs );
+    const rs2_extrinsics extr = { { 0.9999f, 0.0100f, -0.0050f, -0.0101f, 0.9998f, 0.0150f, 0.0049f, -0.0151f, 0.9999f },
+                                  { 0.0148f, 0.0002f, 0.0003f } };
+    auto depth = make_depth( width * height );
+
+    std::vector< float > points( width * height * 3 );
+    for( int i = 0; i < width * height; ++i )
+    {
+        const float pixel[] = { float( i % width ), float( i / width ) };
+        rs2_deproject_pixel_to_point( &points[i * 3], &depth_intrin, pixel, 0.001f * depth[i] );
+    }
+
+    std::vector< float > expected_pixels( width * height * 2, 0.f ), expected_tex( width * height * 2, 0.f );
+    for( int i = 0; i < width * height; ++i )
+    {
+        if( ! points[i * 3 + 2] )
+            continue;
+        float trans[3];
+        rs2_transform_point_to_point( trans, &extr, &points[i * 3] );
+        rs2_project_point_to_pixel( &expected_pixels[i * 2], &other_intrin, trans );
+        expected_tex[i * 2] = expected_pixels[i * 2] / other_intrin.width;
+        expected_tex[i * 2 + 1] = expected_pixels[i * 2 + 1] / other_intrin.height;
+    }
+
+    std::vector< float > pixels( width * height * 2, -1.f ), tex( width * height * 2, -1.f );
+    kernel( tex.data(), pixels.data(), points.data(), width * height, other_intrin, extr );
+
+    for( size_t i = 0; i < pixels.size(); ++i )
+    {
+        REQUIRE( pixels[i] == approx( expected_pixels[i] ) );
+        REQUIRE( tex[i] == approx( expected_tex[i] ) );
+    }
+}
+
+static const float inverse_brown_conrady[5] = { -0.0551f, 0.0625f, -0.0007f, 0.0012f, -0.0203f };
+static const float brown_conrady[5] = { 0.1522f, -0.4926f, 0.0011f, -0.0004f, 0.4438f };
+static const float no_distortion[5] = { 0 };
+
+TEST_CASE( "AVX2 deprojection matches scalar", "[pointcloud][avx]" )
+{
+    if( ! has_avx2_support() )
+        return;
+
+    check_deprojection( deproject_depth_avx2, RS2_DISTORTION_NONE, no_distortion );
+    check_deprojection( deproject_depth_avx2, RS2_DISTORTION_BROWN_CONRADY, no_distortion );
+    check_deprojection( deproject_depth_avx2, RS2_DISTORTION_INVERSE_BROWN_CONRADY, inverse_brown_conrady );
+}
+
+TEST_CASE( "AVX-512 deprojection matches scalar", "[pointcloud][avx]" )
+{
+    if( ! has_avx512_support() )
+        return;
+
+    check_deprojection( deproject_depth_avx512, RS2_DISTORTION_NONE, no_distortion );
+    check_deprojection( deproject_depth_avx512, RS2_DISTORTION_BROWN_CONRADY, no_distortion );
+    check_deprojection( deproject_depth_avx512, RS2_DISTORTION_INVERSE_BROWN_CONRADY, inverse_brown_conrady );
+}
+
+TEST_CASE( "AVX2 texture map matches scalar", "[pointcloud][avx]" )
+{
+    if( ! has_avx2_support() )
+        return;
+
+    check_texture_map( get_texture_map_avx2, RS2_DISTORTION_NONE, no_distortion );
+    check_texture_map( get_texture_map_avx2, RS2_DISTORTION_BROWN_CONRADY, brown_conrady );
+    check_texture_map( get_texture_map_avx2, RS2_DISTORTION_MODIFIED_BROWN_CONRADY, brown_conrady );
+    check_texture_map( get_texture_map_avx2, RS2_DISTORTION_INVERSE_BROWN_CONRADY, inverse_brown_conrady );
+}
+
+TEST_CASE( "AVX-512 texture map matches scalar", "[pointcloud][avx]" )
+{
+    if( ! has_avx512_support() )
+        return;
+
+    check_texture_map( get_texture_map_avx512, RS2_DISTORTION_NONE, no_distortion );
+    check_texture_map( get_texture_map_avx512, RS2_DISTORTION_BROWN_CONRADY, brown_conrady );
+    check_texture_map( get_texture_map_avx512, RS2_DISTORTION_MODIFIED_BROWN_CONRADY, brown_conrady );
+    check_texture_map( get_texture_map_avx512, RS2_DISTORTION_INVERSE_BROWN_CONRADY, inverse_brown_conrady );
+}
+
+TEST_CASE( "vectorized texture map models", "[pointcloud][avx]" )
+{
+    CHECK( is_texture_map_vectorized( RS2_DISTORTION_NONE ) );
+    CHECK( is_texture_map_vectorized( RS2_DISTORTION_BROWN_CONRADY ) );
+    CHECK( is_texture_map_vectorized( RS2_DISTORTION_MODIFIED_BROWN_CONRADY ) );
+    CHECK( is_texture_map_vectorized( RS2_DISTORTION_INVERSE_BROWN_CONRADY ) );
+    CHECK_FALSE( is_texture_map_vectorized( RS2_DISTORTION_FTHETA ) );
+    CHECK_FALSE( is_texture_map_vectorized( RS2_DISTORTION_KANNALA_BRANDT4 ) );
+}
@@ -0,0 +1,91 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+//#cmake:add-file ../../src/proc/spatial-filter-passes.h
+//#cmake:add-file ../../src/proc/spatial-filter-passes.cpp
+//#cmake:add-file ../../src/proc/sse/sse-spatial-filter.h
+//#cmake:add-file ../../src/proc/sse/sse-spatial-filter.cpp
+
+#include <vector>
+#include <random>
+#include <cstring>
+#include "../test.h"
+#include "../../src/proc/spatial-filter-passes.h"
+#include "../../src/proc/sse/sse-spatial-filter.h"
+
+using namespace librealsense;
+
+// Test group description:
+//       * This tests group verifies the vectorized passes of the spatial filter against the scalar passes.
+
+#ifdef __SSSE3__
+
+template< class T >
+static std::vector< T > make_frame( size_t width, size_t height, T max_value )
+{
+    // Smooth surfaces with depth steps and holes, so that all the branches of the filters are taken
+    std::mt19937 gen( 7 );
+    std::uniform_real_distribution< float > noise( -3.f, 3.f );
+    std::uniform_int_distribution< int > event( 0, 99 );
+    std::vector< T > frame( width * height );
+    float level = float( max_value ) / 4;
+    for( auto & pixel : frame )
+    {
+        auto e = event( gen );
+        if( e < 3 )
+            level = float( max_value ) / 8 * ( 1 + event( gen ) % 6 );
+        if( e >= 3 && e < 15 )
+            pixel = e < 8 ? T( 0 ) : T( 1 );
+        else
+            pixel = T( level + noise( gen ) * float( max_value ) / 2000 );
+    }
+    return frame;
+}
+
+TEST_CASE( "SSE depth passes match scalar", "[spatial-filter][sse]" )
+{
+    const size_t width = 85, height = 43;
+    const uint8_t radii[] = { 0, 2, 16, 0xff };
+    const float alphas[] = { 0.25f, 0.5f, 0.77f, 1.f };
+
+    for( auto radius : radii )
+    {
+        for( auto alpha : alphas )
+        {
+            auto expected = make_frame< uint16_t >( width, height, 4000 );
+            auto actual = expected;
+
+            for( int i = 0; i < 2; ++i )
+            {
+                dxf_horizontal_pass( expected.data(), width, height, alpha, 20.f, radius );
+                dxf_vertical_pass( expected.data(), width, height, alpha, 20.f );
+                dxf_horizontal_pass_sse( actual.data(), width, height, alpha, 20.f, radius );
+                dxf_vertical_pass_sse( actual.data(), width, height, alpha, 20.f );
+            }
+            REQUIRE( std::memcmp( expected.data(), actual.data(), expected.size() * sizeof( uint16_t ) ) == 0 );
+        }
+    }
+}
+
+TEST_CASE( "SSE disparity passes match scalar", "[spatial-filter][sse]" )
+{
+    const size_t width = 85, height = 43;
+    const float alphas[] = { 0.25f, 0.5f, 0.77f, 1.f };
+
+    for( auto alpha : alphas )
+    {
+        auto expected = make_frame< float >( width, height, 20000.f );
+        auto actual = expected;
+
+        for( int i = 0; i < 2; ++i )
+        {
+            dxf_horizontal_pass( expected.data(), width, height, alpha, 20.f );
+            dxf_vertical_pass( expected.data(), width, height, alpha, 20.f );
+            dxf_horizontal_pass_sse( actual.data(), width, height, alpha, 20.f );
+            dxf_vertical_pass_sse( actual.data(), width, height, alpha, 20.f );
+        }
+        REQUIRE( std::memcmp( expected.data(), actual.data(), expected.size() * sizeof( float ) ) == 0 );
+    }
+}
+
+#endif // __SSSE3__
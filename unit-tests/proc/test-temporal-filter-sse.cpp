@@ -0,0 +1,104 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+//#cmake:add-file ../../src/proc/temporal-filter-passes.h
+//#cmake:add-file ../../src/proc/temporal-filter-passes.cpp
+//#cmake:add-file ../../src/proc/sse/sse-temporal-filter.h
+//#cmake:add-file ../../src/proc/sse/sse-temporal-filter.cpp
+
+#include <vector>
+#include <array>
+#include <random>
+#include <cstring>
+#include "../test.h"
+#include "../../src/proc/temporal-filter-passes.h"
+#include "../../src/proc/sse/sse-temporal-filter.h"
+
+using namespace librealsense;
+
+// Test group description:
+//       * This tests group verifies the vectorized smoothing of the temporal filter against the scalar smoothing.
+
+#ifdef __SSSE3__
+
+// A noisy surface with depth steps that drift between the frames, and flickering holes
+template< class T >
+static std::vector< std::vector< T > > make_frames( size_t width, size_t height, T max_value, int count )
+{
+    std::mt19937 gen( 11 );
+    std::uniform_real_distribution< float > noise( -15.f, 15.f );
+    std::uniform_int_distribution< int > event( 0, 99 );
+
+    std::vector< float > surface( width * height );
+    float level = float( max_value ) / 4;
+    for( auto & pixel : surface )
+    {
+        if( event( gen ) < 2 )
+            level = float( max_value ) / 8 * ( 1 + event( gen ) % 6 );
+        pixel = level;
+    }
+
+    std::vector< std::vector< T > > frames;
+    for( int f = 0; f < count; f++ )
+    {
+        std::vector< T > frame( width * height );
+        for( size_t i = 0; i < frame.size(); i++ )
+        {
+            auto e = event( gen );
+            if( e < 20 )
+                frame[i] = T( 0 );
+            else if( e < 23 )
+                frame[i] = T( surface[i] * 1.5f );
+            else
+                frame[i] = T( surface[i] + noise( gen ) );
+        }
+        frames.push_back( frame );
+    }
+    return frames;
+}
+
+template< class T >
+static void check_matches_scalar( T max_value )
+{
+    const size_t width = 85, height = 43;
+    const float alphas[] = { 0.1f, 0.4f, 1.f };
+    auto frames = make_frames< T >( width, height, max_value, 19 );
+
+    for( uint8_t persistence = 0; persistence <= 8; persistence++ )
+    {
+        for( auto alpha : alphas )
+        {
+            std::array< uint8_t, PRESISTENCY_LUT_SIZE > persistence_map;
+            make_persistence_map( persistence, persistence_map );
+
+            std::vector< T > expected_last( width * height ), actual_last( width * height );
+            std::vector< uint8_t > expected_history( width * height ), actual_history( width * height );
+            std::vector< T > expected( width * height ), actual( width * height );
+
+            for( size_t f = 0; f < frames.size(); f++ )
+            {
+                auto mask = uint8_t( 1 << f % 8 );
+                temp_jw_smooth_pass( frames[f].data(), expected.data(), expected_last.data(), expected_history.data(),
+                                     width, height, alpha, 1.f - alpha, 20, mask, persistence_map.data() );
+                temp_jw_smooth_sse( frames[f].data(), actual.data(), actual_last.data(), actual_history.data(),
+                                    width, height, alpha, 1.f - alpha, 20, mask, persistence_map.data() );
+
+                REQUIRE( std::memcmp( expected.data(), actual.data(), expected.size() * sizeof( T ) ) == 0 );
+                REQUIRE( std::memcmp( expected_last.data(), actual_last.data(), expected_last.size() * sizeof( T ) ) == 0 );
+                REQUIRE( expected_history == actual_history );
+            }
+        }
+    }
+}
+
+TEST_CASE( "SSE temporal depth smoothing matches scalar", "[temporal-filter][sse]" )
+{
+    check_matches_scalar< uint16_t >( 4000 );
+}
+
+TEST_CASE( "SSE temporal disparity smoothing matches scalar", "[temporal-filter][sse]" )
+{
+    check_matches_scalar< float >( 20000.f );
+}
+
+#endif // __SSSE3__
@@ -0,0 +1,141 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "../test.h"
+#include "../../src/source.h"
+#include "../../src/metadata-parser.h"
+
+using namespace librealsense;
+
+// Test group description:
+//       * This tests group verifies the metadata attributes parsed once into the frame metadata cache.
+
+// Reports a fixed exposure
+class exposure_parser : public md_attribute_parser_base
+{
+public:
+    rs2_metadata_type get( const frame & frm ) const override { return 10000; }
+    bool supports( const frame & frm ) const override { return true; }
+};
+
+// Derives the fps from the exposure of the same frame, as the D400 actual fps parser does
+class fps_from_exposure_parser : public md_attribute_parser_base
+{
+public:
+    rs2_metadata_type get( const frame & frm ) const override
+    {
+        if( ! frm.supports_frame_metadata( RS2_FRAME_METADATA_ACTUAL_EXPOSURE ) )
+            throw invalid_value_exception( "no exposure" );
+        return 1000000 / frm.get_frame_metadata( RS2_FRAME_METADATA_ACTUAL_EXPOSURE );
+    }
+    bool supports( const frame & frm ) const override { return true; }
+};
+
+// Reports the frame timestamp
+class timestamp_parser : public md_attribute_parser_base
+{
+public:
+    rs2_metadata_type get( const frame & frm ) const override { return rs2_metadata_type( frm.get_frame_timestamp() ); }
+    bool supports( const frame & frm ) const override { return true; }
+};
+
+// Supported, but its value cannot be read
+class failing_parser : public md_attribute_parser_base
+{
+public:
+    rs2_metadata_type get( const frame & frm ) const override { throw invalid_value_exception( "not available" ); }
+    bool supports( const frame & frm ) const override { return true; }
+};
+
+static frame_holder alloc_frame( frame_source & source, std::shared_ptr< metadata_parser_map > parsers )
+{
+    frame_holder f = source.alloc_frame( RS2_EXTENSION_VIDEO_FRAME, 16, frame_additional_data(), true );
+    REQUIRE( f );
+    dynamic_cast< librealsense::frame * >( f.frame )->metadata_parsers = parsers;
+    return f;
+}
+
+TEST_CASE( "Parser querying another attribute of its frame", "[frame-metadata]" )
+{
+    frame_source source;
+    source.init( nullptr );
+
+    // The fps parser queries the exposure while the cache it is part of is being parsed
+    auto parsers = std::make_shared< metadata_parser_map >();
+    parsers->emplace( RS2_FRAME_METADATA_ACTUAL_FPS, std::make_shared< fps_from_exposure_parser >() );
+    parsers->emplace( RS2_FRAME_METADATA_ACTUAL_EXPOSURE, std::make_shared< exposure_parser >() );
+
+    auto f = alloc_frame( source, parsers );
+    REQUIRE( f->supports_frame_metadata( RS2_FRAME_METADATA_ACTUAL_FPS ) );
+    CHECK( f->get_frame_metadata( RS2_FRAME_METADATA_ACTUAL_FPS ) == 100 );
+    CHECK( f->get_frame_metadata( RS2_FRAME_METADATA_ACTUAL_EXPOSURE ) == 10000 );
+}
+
+TEST_CASE( "All the attributes agree with the single queries", "[frame-metadata]" )
+{
+    frame_source source;
+    source.init( nullptr );
+
+    auto parsers = std::make_shared< metadata_parser_map >();
+    parsers->emplace( RS2_FRAME_METADATA_ACTUAL_EXPOSURE, std::make_shared< exposure_parser >() );
+    parsers->emplace( RS2_FRAME_METADATA_ACTUAL_FPS, std::make_shared< fps_from_exposure_parser >() );
+    auto f = alloc_frame( source, parsers );
+
+    std::vector< rs2_metadata_type > values( ::RS2_FRAME_METADATA_COUNT );
+    std::vector< int > supported( ::RS2_FRAME_METADATA_COUNT );
+    CHECK( f->get_frame_metadata_all( values.data(), supported.data(), ::RS2_FRAME_METADATA_COUNT ) == 2 );
+    for( int id = 0; id < ::RS2_FRAME_METADATA_COUNT; id++ )
+        CHECK( !! supported[id] == f->supports_frame_metadata( rs2_frame_metadata_value( id ) ) );
+    CHECK( values[RS2_FRAME_METADATA_ACTUAL_EXPOSURE] == 10000 );
+    CHECK( values[RS2_FRAME_METADATA_ACTUAL_FPS] == 100 );
+
+    // A supported attribute whose value cannot be read fails both queries alike
+    parsers->emplace( RS2_FRAME_METADATA_GAIN_LEVEL, std::make_shared< failing_parser >() );
+    auto g = alloc_frame( source, parsers );
+    CHECK( g->supports_frame_metadata( RS2_FRAME_METADATA_GAIN_LEVEL ) );
+    CHECK_THROWS( g->get_frame_metadata( RS2_FRAME_METADATA_GAIN_LEVEL ) );
+    CHECK_THROWS( g->get_frame_metadata_all( values.data(), supported.data(), ::RS2_FRAME_METADATA_COUNT ) );
+}
+
+TEST_CASE( "Readers follow the cache while it is parsed again", "[frame-metadata]" )
+{
+    frame_source source;
+    source.init( nullptr );
+
+    auto parsers = std::make_shared< metadata_parser_map >();
+    parsers->emplace( RS2_FRAME_METADATA_FRAME_TIMESTAMP, std::make_shared< timestamp_parser >() );
+    auto f = alloc_frame( source, parsers );
+
+    std::atomic< bool > done( false );
+    std::atomic< int > stale( 0 );
+    std::vector< std::thread > readers;
+    for( int t = 0; t < 4; t++ )
+    {
+        readers.emplace_back( [&]() {
+            rs2_metadata_type last = 0;
+            while( ! done )
+            {
+                // A published cache is replaced only by the parse of a later timestamp
+                auto value = f->get_frame_metadata( RS2_FRAME_METADATA_FRAME_TIMESTAMP );
+                if( value < last )
+                    ++stale;
+                last = value;
+            }
+        } );
+    }
+    for( int i = 1; i <= 1000; i++ )
+    {
+        f->set_timestamp( i );
+        REQUIRE( f->get_frame_metadata( RS2_FRAME_METADATA_FRAME_TIMESTAMP ) == i );
+    }
+    done = true;
+    for( auto & reader : readers )
+        reader.join();
+
+    CHECK( stale == 0 );
+}
@@ -88,7 +88,13 @@ public enum Option {
     NOISE_ESTIMATION(83),
     ENABLE_IR_REFLECTIVITY(84),
     AUTO_EXPOSURE_LIMIT(85),
-    AUTO_GAIN_LIMIT(86);
+    AUTO_GAIN_LIMIT(86),
+    FRAME_POOL_PREWARM_SIZE(87),
+    FRAME_POOL_HITS(88),
+    FRAME_POOL_MISSES(89),
+    FRAME_POOL_EVICTIONS(90),
+    FRAME_POOL_RESIDENT_BYTES(91),
+    SYNC_MAX_WAIT(92);
     private final int mValue;
 
     private Option(int value) { mValue = value; }
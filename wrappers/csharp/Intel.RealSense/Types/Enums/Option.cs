@@ -273,6 +273,24 @@ namespace Intel.RealSense
         auto_exposure_limit = 85,
 
         /// <summary>auto gain limit - for D400 SKUs</summary>
-        auto_gain_limit = 86
+        auto_gain_limit = 86,
+
+        /// <summary>Number of frame buffers pre-allocated per stream when the sensor is opened</summary>
+        FramePoolPrewarmSize = 87,
+
+        /// <summary>Number of frame allocations served by a recycled buffer (read-only)</summary>
+        FramePoolHits = 88,
+
+        /// <summary>Number of frame allocations that required a new buffer (read-only)</summary>
+        FramePoolMisses = 89,
+
+        /// <summary>Number of frame buffers released by the frame pool (read-only)</summary>
+        FramePoolEvictions = 90,
+
+        /// <summary>Bytes held by idle buffers in the frame pool (read-only)</summary>
+        FramePoolResidentBytes = 91,
+
+        /// <summary>Maximal time in milliseconds a frameset waits for the frames of missing streams before it is released incomplete. Default is 0 which means the syncer waits as long as the missing streams are expected</summary>
+        SyncMaxWait = 92
     }
 }
@@ -88,6 +88,12 @@ classdef option < int64
         enable_ir_reclectivity          (84)
         auto_exposure_limit             (85)
         auto_gain_limit                 (86)
-        count                           (87)
+        frame_pool_prewarm_size         (87)
+        frame_pool_hits                 (88)
+        frame_pool_misses               (89)
+        frame_pool_evictions            (90)
+        frame_pool_resident_bytes       (91)
+        sync_max_wait                   (92)
+        count                           (93)
     end
 end
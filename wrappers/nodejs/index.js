@@ -4969,6 +4969,36 @@ const option = {
    * @type {Integer}
    */
   OPTION_AUTO_GAIN_LIMIT: RS2.RS2_OPTION_AUTO_GAIN_LIMIT,
+  /**
+   * Number of frame buffers pre-allocated per stream when the sensor is opened
+   * @type {Integer}
+   */
+  OPTION_FRAME_POOL_PREWARM_SIZE: RS2.RS2_OPTION_FRAME_POOL_PREWARM_SIZE,
+  /**
+   * Number of frame allocations served by a recycled buffer (read-only)
+   * @type {Integer}
+   */
+  OPTION_FRAME_POOL_HITS: RS2.RS2_OPTION_FRAME_POOL_HITS,
+  /**
+   * Number of frame allocations that required a new buffer (read-only)
+   * @type {Integer}
+   */
+  OPTION_FRAME_POOL_MISSES: RS2.RS2_OPTION_FRAME_POOL_MISSES,
+  /**
+   * Number of frame buffers released by the frame pool (read-only)
+   * @type {Integer}
+   */
+  OPTION_FRAME_POOL_EVICTIONS: RS2.RS2_OPTION_FRAME_POOL_EVICTIONS,
+  /**
+   * Bytes held by idle buffers in the frame pool (read-only)
+   * @type {Integer}
+   */
+  OPTION_FRAME_POOL_RESIDENT_BYTES: RS2.RS2_OPTION_FRAME_POOL_RESIDENT_BYTES,
+  /**
+   * Maximal time in milliseconds a frameset waits for the frames of missing streams before it is released incomplete. Default is 0 which means the syncer waits as long as the missing streams are expected
+   * @type {Integer}
+   */
+  OPTION_SYNC_MAX_WAIT: RS2.RS2_OPTION_SYNC_MAX_WAIT,
   /**
    * Number of enumeration values. Not a valid input: intended to be used in for-loops.
    * @type {Integer}
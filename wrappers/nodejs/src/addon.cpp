@@ -4768,6 +4768,12 @@ void InitModule(v8::Local<v8::Object> exports) {
   _FORCE_SET_ENUM(RS2_OPTION_ENABLE_IR_REFLECTIVITY);
   _FORCE_SET_ENUM(RS2_OPTION_AUTO_EXPOSURE_LIMIT);
   _FORCE_SET_ENUM(RS2_OPTION_AUTO_GAIN_LIMIT);
+  _FORCE_SET_ENUM(RS2_OPTION_FRAME_POOL_PREWARM_SIZE);
+  _FORCE_SET_ENUM(RS2_OPTION_FRAME_POOL_HITS);
+  _FORCE_SET_ENUM(RS2_OPTION_FRAME_POOL_MISSES);
+  _FORCE_SET_ENUM(RS2_OPTION_FRAME_POOL_EVICTIONS);
+  _FORCE_SET_ENUM(RS2_OPTION_FRAME_POOL_RESIDENT_BYTES);
+  _FORCE_SET_ENUM(RS2_OPTION_SYNC_MAX_WAIT);
   _FORCE_SET_ENUM(RS2_OPTION_COUNT);
 
   // rs2_camera_info
@@ -187,6 +187,12 @@ PYBIND11_MODULE(NAME, m) {
         .value("enable_ir_reflectivity", RS2_OPTION_ENABLE_IR_REFLECTIVITY)
         .value("auto_exposure_limit", RS2_OPTION_AUTO_EXPOSURE_LIMIT)
         .value("auto_gain_limit", RS2_OPTION_AUTO_GAIN_LIMIT)
+        .value("frame_pool_prewarm_size", RS2_OPTION_FRAME_POOL_PREWARM_SIZE)
+        .value("frame_pool_hits", RS2_OPTION_FRAME_POOL_HITS)
+        .value("frame_pool_misses", RS2_OPTION_FRAME_POOL_MISSES)
+        .value("frame_pool_evictions", RS2_OPTION_FRAME_POOL_EVICTIONS)
+        .value("frame_pool_resident_bytes", RS2_OPTION_FRAME_POOL_RESIDENT_BYTES)
+        .value("sync_max_wait", RS2_OPTION_SYNC_MAX_WAIT)
         .value("count", RS2_OPTION_COUNT);
 
     py::enum_<platform::power_state> power_state(m, "power_state");
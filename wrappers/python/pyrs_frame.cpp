@@ -116,6 +116,12 @@ void init_frame(py::module &m) {
         .def_property_readonly("frame_timestamp_domain", &rs2::frame::get_frame_timestamp_domain, "The timestamp domain. Identical to calling get_frame_timestamp_domain.")
         .def("get_frame_metadata", &rs2::frame::get_frame_metadata, "Retrieve the current value of a single frame_metadata.", "frame_metadata"_a)
         .def("supports_frame_metadata", &rs2::frame::supports_frame_metadata, "Determine if the device allows a specific metadata to be queried.", "frame_metadata"_a)
+        .def("get_frame_metadata_all", [](const rs2::frame& f) {
+            std::map<rs2_frame_metadata_value, rs2_metadata_type> all;
+            for (auto&& md : f.get_frame_metadata_all())
+                all[md.first] = md.second;
+            return all;
+        }, "Retrieve all the frame_metadata supported by the frame, as a dictionary from frame_metadata to value.")
         .def("get_frame_number", &rs2::frame::get_frame_number, "Retrieve the frame number.")
         .def_property_readonly("frame_number", &rs2::frame::get_frame_number, "The frame number. Identical to calling get_frame_number.")
         .def("get_data_size", &rs2::frame::get_data_size, "Retrieve data size from frame handle.")
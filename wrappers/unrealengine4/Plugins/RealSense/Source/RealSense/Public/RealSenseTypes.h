@@ -141,6 +141,12 @@ enum class ERealSenseOptionType : uint8
     ENABLE_IR_REFLECTIVITY                     , /**< Enables data collection for calculating IR pixel reflectivity */
     AUTO_EXPOSURE_LIMIT                        , /**< Set and get auto exposure limit in microseconds. Default is 0 which means full exposure range. If the requested exposure limit is greater than frame time, it will be set to frame time at runtime. Setting will not take effect until next streaming session. */
     AUTO_GAIN_LIMIT                            , /**< Set and get auto gain limits ranging from 16 to 248. Default is 0 which means full gain. If the requested gain limit is less than 16, it will be set to 16. If the requested gain limit is greater than 248, it will be set to 248. Setting will not take effect until next streaming session. */
+    FRAME_POOL_PREWARM_SIZE                    , /**< Number of frame buffers pre-allocated per stream when the sensor is opened */
+    FRAME_POOL_HITS                            , /**< Number of frame allocations served by a recycled buffer (read-only) */
+    FRAME_POOL_MISSES                          , /**< Number of frame allocations that required a new buffer (read-only) */
+    FRAME_POOL_EVICTIONS                       , /**< Number of frame buffers released by the frame pool (read-only) */
+    FRAME_POOL_RESIDENT_BYTES                  , /**< Bytes held by idle buffers in the frame pool (read-only) */
+    SYNC_MAX_WAIT                              , /**< Maximal time in milliseconds a frameset waits for the frames of missing streams before it is released incomplete. Default is 0 which means the syncer waits as long as the missing streams are expected */
 };
 
 UENUM(Blueprintable)